@@ -0,0 +1,83 @@
+#include <chip8/core/cpu.h>
+#include <chip8/core/rom_image.h>
+#include <chip8/verify/lockstep.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+
+// libFuzzer target: ./chip8-fuzz-cpu [corpus_dir] (see libFuzzer flags)
+// Input layout: frame count F (1 byte), F little endian key masks (2 bytes
+// each), then ROM bytes. The ROM runs for F frames on the fast paths in
+// lockstep with the plain interpreter; any divergence, broken invariant or
+// sanitizer report is a crash. Cpus are reset in place between inputs.
+
+namespace {
+
+/// <summary>
+/// Cycles in every fuzzed frame, bounding an input to 255 * 16 cycles.
+/// </summary>
+constexpr size_t kCyclesPerFrame{16};
+
+/// <summary>
+/// Largest ROM which fits in memory.
+/// </summary>
+constexpr size_t kMaxRomSize{chip8::core::kMemorySize -
+                             chip8::core::kRomStartAddress};
+
+void Prepare(chip8::core::Cpu& cpu, const chip8::core::RomImage& rom) {
+  cpu.Reset();
+  cpu.SeedRNG(0);
+  cpu.LoadROM(rom);
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static chip8::core::Cpu reference;
+  static chip8::core::Cpu candidate;
+
+  if (size < 1) {
+    return 0;
+  }
+  const size_t frames{data[0]};
+  const size_t script_size{std::min(frames * 2, size - 1)};
+  const std::span<const uint8_t> script{data + 1, script_size};
+  const std::span<const uint8_t> rom_bytes{
+      data + 1 + script_size,
+      std::min(size - 1 - script_size, kMaxRomSize)};
+
+  const std::optional<chip8::core::RomImage> rom{
+      chip8::core::RomImage::FromBytes(rom_bytes)};
+  if (!rom) {
+    return 0;
+  }
+  Prepare(reference, *rom);
+  Prepare(candidate, *rom);
+
+  chip8::verify::LockstepConfig config;
+  config.frames = frames;
+  config.cycles_per_frame = kCyclesPerFrame;
+  config.compare_interval = kCyclesPerFrame;
+  config.keys = [script](uint64_t frame) -> uint16_t {
+    const size_t offset{static_cast<size_t>(frame) * 2};
+    if (offset + 1 >= script.size()) {
+      return 0;
+    }
+    return static_cast<uint16_t>(script[offset] | (script[offset + 1] << 8));
+  };
+
+  chip8::verify::LockstepHarness harness(reference, candidate, config);
+  if (const std::optional<chip8::verify::Divergence> divergence{
+          harness.Run()}) {
+    std::fputs(divergence->Format().c_str(), stderr);
+    std::abort();
+  }
+  if (candidate.GetStackPointer() > candidate.GetStack().size()) {
+    std::fprintf(stderr, "stack pointer out of range: %u\n",
+                 candidate.GetStackPointer());
+    std::abort();
+  }
+  return 0;
+}
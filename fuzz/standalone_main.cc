@@ -0,0 +1,53 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Usage: ./chip8-fuzz-cpu-replay <input_or_directory>...
+// Runs the fuzz target over given inputs without libFuzzer, e.g. to check
+// the seed corpus or reproduce a crash with any compiler.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+bool RunInput(const std::filesystem::path& path) {
+  std::ifstream in_stream(path, std::ios::binary);
+  if (!in_stream.is_open()) {
+    std::fprintf(stderr, "Failed to read input ('%s')\n",
+                 path.string().c_str());
+    return false;
+  }
+  const std::vector<uint8_t> data{std::istreambuf_iterator<char>(in_stream),
+                                  std::istreambuf_iterator<char>()};
+  LLVMFuzzerTestOneInput(data.data(), data.size());
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t inputs{};
+  for (int i{1}; i < argc; ++i) {
+    const std::filesystem::path path{argv[i]};
+    if (!std::filesystem::is_directory(path)) {
+      if (!RunInput(path)) {
+        return 1;
+      }
+      ++inputs;
+      continue;
+    }
+    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+      if (entry.is_regular_file()) {
+        if (!RunInput(entry.path())) {
+          return 1;
+        }
+        ++inputs;
+      }
+    }
+  }
+  std::printf("Executed %zu inputs\n", inputs);
+  return 0;
+}
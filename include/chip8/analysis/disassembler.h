@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// Namespace for static ROM analysis tools like disassembler and control flow
+/// analyzer.
+/// </summary>
+namespace chip8::analysis {
+
+/// <summary>
+/// Converts an opcode into its assembly mnemonic, e.g. "LD V0, 0x05".
+/// </summary>
+/// <param name="opcode">Opcode to disassemble.</param>
+/// <returns>
+/// Human readable instruction or "DW 0xXXXX" for unknown opcodes.
+/// </returns>
+std::string Disassemble(uint16_t opcode);
+
+}  // namespace chip8::analysis
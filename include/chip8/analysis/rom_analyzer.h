@@ -0,0 +1,189 @@
+#pragma once
+
+#include <chip8/core/constants.h>
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// Namespace for static ROM analysis tools like disassembler and control flow
+/// analyzer.
+/// </summary>
+namespace chip8::analysis {
+
+/// <summary>
+/// Classification of a single memory byte.
+/// </summary>
+enum class ByteKind : uint8_t { kUnknown, kCode, kSprite, kData };
+
+/// <summary>
+/// Sequence of instructions with a single entry and a single exit.
+/// </summary>
+struct BasicBlock {
+  /// <summary>
+  /// Address of the first instruction.
+  /// </summary>
+  uint16_t start;
+
+  /// <summary>
+  /// Address right after the last instruction.
+  /// </summary>
+  uint16_t end;
+
+  /// <summary>
+  /// Addresses of blocks that can be executed right after this one.
+  /// </summary>
+  std::vector<uint16_t> successors;
+
+  /// <summary>
+  /// True if the block ends with BNNN whose target could not be resolved.
+  /// </summary>
+  bool computed_jump;
+};
+
+/// <summary>
+/// Memory write (FX33 or FX55) that overwrites reachable code.
+/// </summary>
+struct SelfModifyingWrite {
+  /// <summary>
+  /// Address of the writing instruction.
+  /// </summary>
+  uint16_t instruction;
+
+  /// <summary>
+  /// First written address.
+  /// </summary>
+  uint16_t address;
+
+  /// <summary>
+  /// Amount of written bytes.
+  /// </summary>
+  uint16_t size;
+};
+
+/// <summary>
+/// Result of static ROM analysis: control flow graph and code/data map.
+/// </summary>
+struct CodeMap {
+  /// <summary>
+  /// Classification of every memory byte.
+  /// </summary>
+  std::array<ByteKind, 4096> kinds{};
+
+  /// <summary>
+  /// Set bits mark addresses where a reachable instruction starts.
+  /// </summary>
+  std::bitset<4096> instructions;
+
+  /// <summary>
+  /// Basic blocks sorted by start address.
+  /// </summary>
+  std::vector<BasicBlock> blocks;
+
+  /// <summary>
+  /// Writes which target reachable code.
+  /// </summary>
+  std::vector<SelfModifyingWrite> self_modifying;
+};
+
+/// <summary>
+/// Recursively disassembles a ROM starting at kRomStartAddress and builds a
+/// control flow graph of basic blocks.
+/// <para>
+/// Targets of 1NNN and 2NNN are always followed, BNNN is resolved when V0
+/// holds a known constant inside the block. Values of I and V0-VF are tracked
+/// within blocks to mark sprites drawn by DXYN, data read by FX65 and writes
+/// of FX33/FX55 which overwrite code.
+/// </para>
+/// </summary>
+class RomAnalyzer {
+ public:
+  /// <summary>
+  /// Prepares analysis of a ROM loaded at kRomStartAddress.
+  /// </summary>
+  /// <param name="rom">Raw ROM bytes.</param>
+  explicit RomAnalyzer(std::span<const uint8_t> rom) noexcept;
+
+  /// <summary>
+  /// Runs the analysis.
+  /// </summary>
+  /// <returns>Control flow graph and code/data map of the ROM.</returns>
+  CodeMap Analyze();
+
+  /// <summary>
+  /// Saves code map in a line based text format.
+  /// </summary>
+  static bool Save(const CodeMap& map, const std::filesystem::path& path);
+
+  /// <summary>
+  /// Loads code map saved by Save().
+  /// </summary>
+  /// <returns>Loaded map or std::nullopt if file is malformed.</returns>
+  static std::optional<CodeMap> Load(const std::filesystem::path& path);
+
+ private:
+  /// <summary>
+  /// Returns opcode stored at given address.
+  /// </summary>
+  uint16_t Fetch(size_t address) const noexcept;
+
+  /// <summary>
+  /// Follows control flow from all queued addresses and marks reachable
+  /// instructions.
+  /// </summary>
+  void Explore();
+
+  /// <summary>
+  /// Splits reachable instructions into basic blocks.
+  /// </summary>
+  void BuildBlocks();
+
+  /// <summary>
+  /// Tracks constants within every block to resolve BNNN targets and mark
+  /// referenced data.
+  /// </summary>
+  /// <returns>True if new code was discovered.</returns>
+  bool PropagateConstants();
+
+  /// <summary>
+  /// Queues an address for exploration and marks it as a block leader.
+  /// </summary>
+  void AddTarget(size_t address);
+
+  /// <summary>
+  /// Marks bytes with given kind unless they are already known to be code.
+  /// </summary>
+  void MarkData(size_t address, size_t size, ByteKind kind) noexcept;
+
+  /// <summary>
+  /// Memory image with ROM loaded at kRomStartAddress.
+  /// </summary>
+  std::array<uint8_t, 4096> memory_;
+
+  /// <summary>
+  /// Result being built.
+  /// </summary>
+  CodeMap map_;
+
+  /// <summary>
+  /// Set bits mark addresses where a basic block starts.
+  /// </summary>
+  std::bitset<4096> leaders_;
+
+  /// <summary>
+  /// Addresses waiting for exploration.
+  /// </summary>
+  std::vector<uint16_t> worklist_;
+
+  /// <summary>
+  /// Memory writes found in blocks, checked against code once analysis ends.
+  /// </summary>
+  std::vector<SelfModifyingWrite> writes_;
+};
+
+}  // namespace chip8::analysis
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// Namespace for ahead-of-time compilation of ROMs into native plugins.
+/// </summary>
+namespace chip8::aot {
+
+/// <summary>
+/// Version of the plugin interface. Plugins built against a different
+/// version are rejected. Version 2 blocks exit to the interpreter on
+/// unknown opcodes instead of skipping them.
+/// </summary>
+constexpr uint32_t kAbiVersion{2};
+
+/// <summary>
+/// Name of the function every plugin exports (see AotGetModuleFn).
+/// </summary>
+constexpr const char* kEntryPoint{"chip8_aot_get_module"};
+
+/// <summary>
+/// View of cpu state passed to compiled blocks. Pointers refer directly to
+/// Cpu members, callbacks let compiled code use the interpreter's RNG and
+/// memory write tracking.
+/// </summary>
+struct AotState {
+  uint8_t* registers;
+  uint8_t* memory;
+  uint16_t* index_register;
+  uint16_t* program_counter;
+  uint16_t* stack;
+  uint8_t* stack_pointer;
+  uint8_t* delay_timer;
+  uint8_t* sound_timer;
+  const uint8_t* keys;
+  bool* screen;
+  uint16_t* opcode;
+
+  /// <summary>
+  /// Opaque pointer passed back to callbacks.
+  /// </summary>
+  void* cpu;
+
+  /// <summary>
+  /// Returns the next random byte, used by CXKK.
+  /// </summary>
+  uint8_t (*random)(void* cpu);
+
+  /// <summary>
+  /// Must be called after every memory write. Returns true if compiled code
+  /// was overwritten and the running block has to exit.
+  /// </summary>
+  bool (*on_write)(void* cpu, uint16_t address, uint16_t size);
+};
+
+/// <summary>
+/// Compiled basic block. Executes instructions starting at program counter
+/// and returns how many of them were executed. Returning less than
+/// AotBlock::instructions means that execution stopped early (taken branch
+/// or an instruction which has to be handled by the interpreter); program
+/// counter and opcode are always left exactly as the interpreter would leave
+/// them.
+/// </summary>
+using AotBlockFn = uint32_t (*)(AotState* state);
+
+/// <summary>
+/// Entry of the block table exported by a plugin.
+/// </summary>
+struct AotBlock {
+  /// <summary>
+  /// Address of the first instruction.
+  /// </summary>
+  uint16_t start;
+
+  /// <summary>
+  /// Address right after the last instruction.
+  /// </summary>
+  uint16_t end;
+
+  /// <summary>
+  /// Maximal amount of instructions executed by the block.
+  /// </summary>
+  uint32_t instructions;
+
+  /// <summary>
+  /// Compiled code.
+  /// </summary>
+  AotBlockFn function;
+};
+
+/// <summary>
+/// Description of a compiled ROM.
+/// </summary>
+struct AotModule {
+  uint32_t abi_version;
+
+  /// <summary>
+  /// ROM bytes the blocks were compiled from. Blocks whose bytes differ from
+  /// cpu memory are not executed.
+  /// </summary>
+  const uint8_t* rom;
+  uint32_t rom_size;
+
+  const AotBlock* blocks;
+  uint32_t block_count;
+};
+
+/// <summary>
+/// Signature of the function exported by plugins.
+/// </summary>
+using AotGetModuleFn = const AotModule* (*)();
+
+}  // namespace chip8::aot
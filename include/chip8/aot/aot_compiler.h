@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chip8/analysis/rom_analyzer.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Namespace for ahead-of-time compilation of ROMs into native plugins.
+/// </summary>
+namespace chip8::aot {
+
+/// <summary>
+/// Translates a ROM into a C++ translation unit with one function per basic
+/// block found by analysis::RomAnalyzer. Generated code follows the same
+/// semantics as Cpu::Opcode* handlers and exports an AotModule (see
+/// aot_abi.h), so it can be compiled into a plugin and loaded by AotPlugin.
+/// </summary>
+class AotCompiler {
+ public:
+  /// <summary>
+  /// Prepares compilation of a ROM loaded at kRomStartAddress.
+  /// </summary>
+  explicit AotCompiler(std::span<const uint8_t> rom);
+
+  /// <summary>
+  /// Generates C++ source of the plugin.
+  /// </summary>
+  std::string Generate();
+
+  /// <summary>
+  /// Returns amount of blocks emitted by the last Generate() call.
+  /// </summary>
+  size_t GetBlockCount() const noexcept;
+
+ private:
+  /// <summary>
+  /// Appends the function implementing a single basic block.
+  /// </summary>
+  void EmitBlock(const analysis::BasicBlock& block, std::string& out) const;
+
+  /// <summary>
+  /// Appends statements implementing a single instruction.
+  /// </summary>
+  /// <param name="address">Address of the instruction.</param>
+  /// <param name="index">Index of the instruction within its block.</param>
+  /// <param name="previous">Opcode of the previous instruction in block.</param>
+  void EmitInstruction(uint16_t address, uint32_t index, uint16_t previous,
+                       std::string& out) const;
+
+  /// <summary>
+  /// Returns opcode stored at given address.
+  /// </summary>
+  uint16_t Fetch(size_t address) const noexcept;
+
+  /// <summary>
+  /// Raw ROM bytes.
+  /// </summary>
+  std::vector<uint8_t> rom_;
+
+  /// <summary>
+  /// Memory image with ROM loaded at kRomStartAddress.
+  /// </summary>
+  std::array<uint8_t, 4096> memory_;
+
+  /// <summary>
+  /// Blocks which lie entirely inside the ROM.
+  /// </summary>
+  std::vector<analysis::BasicBlock> blocks_;
+};
+
+}  // namespace chip8::aot
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chip8/aot/aot_abi.h>
+
+#include <filesystem>
+#include <memory>
+
+/// <summary>
+/// Namespace for ahead-of-time compilation of ROMs into native plugins.
+/// </summary>
+namespace chip8::aot {
+
+/// <summary>
+/// Shared library produced from the output of AotCompiler. Keeps the library
+/// loaded for as long as the object lives.
+/// </summary>
+class AotPlugin {
+ public:
+  /// <summary>
+  /// Loads a plugin and checks its ABI version.
+  /// </summary>
+  /// <param name="path">Path to the shared library.</param>
+  /// <returns>Loaded plugin or nullptr on failure.</returns>
+  static std::unique_ptr<AotPlugin> Load(const std::filesystem::path& path);
+
+  AotPlugin(const AotPlugin&) = delete;
+  AotPlugin& operator=(const AotPlugin&) = delete;
+
+  /// <summary>
+  /// Unloads the shared library. Cpus using the module have to be detached
+  /// first.
+  /// </summary>
+  ~AotPlugin() noexcept;
+
+  /// <summary>
+  /// Returns the module exported by the plugin.
+  /// </summary>
+  const AotModule* GetModule() const noexcept;
+
+ private:
+  AotPlugin(void* handle, const AotModule* module) noexcept;
+
+  /// <summary>
+  /// Native handle of the shared library.
+  /// </summary>
+  void* handle_;
+
+  /// <summary>
+  /// Module exported by the plugin.
+  /// </summary>
+  const AotModule* module_;
+};
+
+}  // namespace chip8::aot
@@ -0,0 +1,186 @@
+#pragma once
+
+// Stable C interface of the emulator core, exported by the libchip8 shared
+// library. All functions accept a NULL instance, in which case they do
+// nothing and return an error or zero.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(CHIP8_CAPI_BUILD)
+#define CHIP8_API __declspec(dllexport)
+#else
+#define CHIP8_API __declspec(dllimport)
+#endif
+#else
+#define CHIP8_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// <summary>
+/// Version of this interface. Incremented on every incompatible change.
+/// </summary>
+#define CHIP8_ABI_VERSION 1
+
+/// <summary>
+/// Emulated screen resolution.
+/// </summary>
+#define CHIP8_FRAMEBUFFER_WIDTH 64
+#define CHIP8_FRAMEBUFFER_HEIGHT 32
+
+/// <summary>
+/// Size of emulated memory in bytes.
+/// </summary>
+#define CHIP8_MEMORY_SIZE 4096
+
+/// <summary>
+/// Result codes.
+/// </summary>
+typedef enum chip8_result {
+  CHIP8_OK = 0,
+  CHIP8_ERROR_INVALID_ARGUMENT = -1,
+  CHIP8_ERROR_INVALID_ROM = -2,
+  CHIP8_ERROR_OUT_OF_MEMORY = -3
+} chip8_result;
+
+/// <summary>
+/// Errors which halt the emulated cpu. A halted instance executes no further
+/// cycles until chip8_reset().
+/// </summary>
+typedef enum chip8_cpu_error {
+  CHIP8_CPU_OK = 0,
+  CHIP8_CPU_STACK_UNDERFLOW = 1,
+  CHIP8_CPU_STACK_OVERFLOW = 2
+} chip8_cpu_error;
+
+/// <summary>
+/// Emulator instance.
+/// </summary>
+typedef struct chip8_instance chip8_instance;
+
+/// <summary>
+/// Saved state of an instance.
+/// </summary>
+typedef struct chip8_snapshot chip8_snapshot;
+
+/// <summary>
+/// Returns CHIP8_ABI_VERSION the library was built with. Hosts should
+/// compare it with the version of the header they were compiled against.
+/// </summary>
+CHIP8_API uint32_t chip8_abi_version(void);
+
+/// <summary>
+/// Creates an instance in its power-on state.
+/// </summary>
+/// <returns>New instance or NULL if allocation failed.</returns>
+CHIP8_API chip8_instance* chip8_create(void);
+
+/// <summary>
+/// Destroys an instance. Pointers returned by chip8_framebuffer() and
+/// chip8_memory() become invalid.
+/// </summary>
+CHIP8_API void chip8_destroy(chip8_instance* instance);
+
+/// <summary>
+/// Restores power-on state and clears errors. RNG is not reseeded.
+/// </summary>
+CHIP8_API void chip8_reset(chip8_instance* instance);
+
+/// <summary>
+/// Seeds random number generator used by CXKK.
+/// </summary>
+CHIP8_API void chip8_seed(chip8_instance* instance, uint32_t seed);
+
+/// <summary>
+/// Copies ROM from a memory buffer into emulated memory at 0x200.
+/// </summary>
+CHIP8_API chip8_result chip8_load_rom(chip8_instance* instance,
+                                      const uint8_t* data, size_t size);
+
+/// <summary>
+/// Executes given amount of cycles without ticking timers. Stops early if
+/// the cpu halts, see chip8_get_error().
+/// </summary>
+CHIP8_API void chip8_run_cycles(chip8_instance* instance, size_t cycles);
+
+/// <summary>
+/// Emulates frames, each consisting of cycles_per_frame cycles followed by
+/// one 60 Hz timer tick. Idle loops are fast-forwarded. A halted cpu
+/// executes no cycles, but timers still tick.
+/// </summary>
+/// <returns>Amount of cycles that were actually interpreted.</returns>
+CHIP8_API size_t chip8_run_frames(chip8_instance* instance, size_t frames,
+                                  size_t cycles_per_frame);
+
+/// <summary>
+/// Sets state of a single key (0x0-0xF). Non-zero pressed means held down.
+/// </summary>
+CHIP8_API void chip8_set_key(chip8_instance* instance, uint8_t key,
+                             int pressed);
+
+/// <summary>
+/// Sets state of all keys at once: bit N holds key N.
+/// </summary>
+CHIP8_API void chip8_set_keys(chip8_instance* instance, uint16_t keys);
+
+/// <summary>
+/// Returns the framebuffer: CHIP8_FRAMEBUFFER_WIDTH * CHIP8_FRAMEBUFFER_HEIGHT
+/// bytes in row-major order, 1 for a lit pixel and 0 otherwise. The pointer
+/// stays valid and is updated in place until the instance is destroyed.
+/// </summary>
+CHIP8_API const uint8_t* chip8_framebuffer(const chip8_instance* instance);
+
+/// <summary>
+/// Returns emulated memory (CHIP8_MEMORY_SIZE bytes). The pointer stays valid
+/// until the instance is destroyed.
+/// </summary>
+CHIP8_API const uint8_t* chip8_memory(const chip8_instance* instance);
+
+/// <summary>
+/// Returns value of the sound timer. Buzzer sounds while it is non-zero.
+/// </summary>
+CHIP8_API uint8_t chip8_sound_timer(const chip8_instance* instance);
+
+/// <summary>
+/// Returns value of the delay timer.
+/// </summary>
+CHIP8_API uint8_t chip8_delay_timer(const chip8_instance* instance);
+
+/// <summary>
+/// Returns program counter.
+/// </summary>
+CHIP8_API uint16_t chip8_program_counter(const chip8_instance* instance);
+
+/// <summary>
+/// Returns the error which halted the cpu, CHIP8_CPU_OK while it runs.
+/// </summary>
+CHIP8_API chip8_cpu_error chip8_get_error(const chip8_instance* instance);
+
+/// <summary>
+/// Saves emulated state of an instance: registers, memory, stack, timers,
+/// keys, screen and RNG. Settings of the instance are not saved.
+/// </summary>
+/// <returns>New snapshot or NULL on failure.</returns>
+CHIP8_API chip8_snapshot* chip8_snapshot_create(
+    const chip8_instance* instance);
+
+/// <summary>
+/// Restores state saved by chip8_snapshot_create(). A snapshot can be
+/// restored any amount of times, into any instance. Framebuffer and memory
+/// pointers of the instance stay valid.
+/// </summary>
+CHIP8_API chip8_result chip8_snapshot_restore(chip8_instance* instance,
+                                              const chip8_snapshot* snapshot);
+
+/// <summary>
+/// Destroys a snapshot.
+/// </summary>
+CHIP8_API void chip8_snapshot_destroy(chip8_snapshot* snapshot);
+
+#ifdef __cplusplus
+}
+#endif
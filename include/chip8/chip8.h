@@ -1,7 +1,44 @@
 #pragma once
 
+#include <chip8/utils/histogram.h>
 #include <chip8/utils/logger.h>
+#include <chip8/utils/mapped_file.h>
+#include <chip8/utils/metrics.h>
+#include <chip8/utils/perf_counters.h>
+#include <chip8/utils/profiler.h>
+#include <chip8/utils/thread_pool.h>
+
+#include <chip8/analysis/disassembler.h>
+#include <chip8/analysis/rom_analyzer.h>
+
+#include <chip8/aot/aot_compiler.h>
+#include <chip8/aot/aot_plugin.h>
 
 #include <chip8/core/constants.h>
 #include <chip8/core/cpu.h>
+#include <chip8/core/cpu_pool.h>
+#include <chip8/core/machine.h>
+#include <chip8/core/rom_image.h>
 #include <chip8/core/screen.h>
+#include <chip8/core/terminal_screen.h>
+
+#include <chip8/debug/debugger.h>
+
+#include <chip8/library/rom_library.h>
+
+#include <chip8/runtime/emulation_thread.h>
+#include <chip8/runtime/emulator_metrics.h>
+#include <chip8/runtime/environment.h>
+#include <chip8/runtime/executor.h>
+#include <chip8/runtime/metrics_exporter.h>
+#include <chip8/runtime/movie.h>
+#include <chip8/runtime/netplay.h>
+#include <chip8/runtime/rollback.h>
+#include <chip8/runtime/shared_state.h>
+#include <chip8/runtime/vector_environment.h>
+
+#include <chip8/search/state_search.h>
+
+#include <chip8/video/recorder.h>
+#include <chip8/video/terminal_renderer.h>
+#include <chip8/video/upscaler.h>
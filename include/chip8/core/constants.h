@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <string>
 
 /// <summary>
@@ -13,6 +14,27 @@ namespace chip8::core {
 /// </summary>
 enum class CritErrors { kNone, kStackUnderflow, kStackOverflow };
 
+/// <summary>
+/// Idle patterns recognized by the cpu. While cpu is idle, executing further
+/// cycles does not change its state until the next timer tick or key event.
+/// </summary>
+enum class IdleState { kNone, kJumpToSelf, kKeyWait, kTimerWait };
+
+/// <summary>
+/// Superinstructions - pairs of opcodes executed by a single dispatch.
+/// kUnknown marks addresses which were not decoded yet.
+/// </summary>
+enum class Fusion : uint8_t {
+  kUnknown,
+  kNone,
+  kSkipEqualJump,     // 3XKK + 1NNN
+  kSkipNotEqualJump,  // 4XKK + 1NNN
+  kIndexDraw,         // ANNN + DXYN
+  kIndexLoad,         // ANNN + FX65
+  kAddSkipEqual,      // 7XKK + 3XKK (same X)
+  kAddSkipNotEqual    // 7XKK + 4XKK (same X)
+};
+
 /// <summary>
 /// Constant inline float variable representing volume. It should always stay
 /// between 0 and 1. In extreme cases it can be set to >1.
@@ -24,11 +46,22 @@ inline float kVolume{};
 /// </summary>
 inline uint16_t kCycleDelay{};
 
+/// <summary>
+/// Inline variable overriding the cycles per frame derived from kCycleDelay
+/// when nonzero, e.g. with the speed stored in a ROM library.
+/// </summary>
+inline uint32_t kCyclesPerFrame{};
+
 /// <summary>
 /// Inline variable to store the ROM path as a string.
 /// </summary>
 inline std::string kRomPath{};
 
+/// <summary>
+/// Size of cpu memory in bytes.
+/// </summary>
+constexpr size_t kMemorySize{4096};
+
 /// <summary>
 /// Memory addres specifying where ROM will be loaded.
 /// </summary>
@@ -49,6 +82,12 @@ constexpr size_t kScreenHeight{512};
 /// </summary>
 constexpr size_t kPixelSize{16};
 
+/// <summary>
+/// Frequency of delay and sound timers in Hz. Every emulated frame ends with
+/// exactly one timer tick.
+/// </summary>
+constexpr size_t kTimerFrequency{60};
+
 /// <summary>
 /// Constant sample rate value.
 /// </summary>
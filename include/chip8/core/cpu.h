@@ -1,487 +1,476 @@
 #pragma once
 
+#include <chip8/analysis/rom_analyzer.h>
+#include <chip8/aot/aot_abi.h>
 #include <chip8/core/constants.h>
+#include <chip8/core/machine.h>
+#include <chip8/core/memory.h>
+#include <chip8/core/rom_image.h>
 #include <chip8/utils/logger.h>
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <optional>
 #include <random>
+#include <vector>
 
 /// <summary>
 /// Namespace for core components like cpu and screen in the program.
 /// </summary>
 namespace chip8::core {
 
-class Screen;
+/// <summary>
+/// Architectural state of a cpu together with its RNG, enough to continue
+/// emulation exactly where it was saved. Settings, decoded code, counters and
+/// the frame callback are left out.
+/// </summary>
+struct CpuSnapshot {
+  MachineState state;
+  std::mt19937 generator;
+  std::uniform_int_distribution<> distribution;
+};
 
 /// <summary>
 /// Represents the CPU. Handles all cpu components and execution of programs.
 /// </summary>
 class Cpu {
  public:
-  friend class Screen;
-
+  /// <summary>
+  /// Called at the end of every frame emulated by RunFrame().
+  /// </summary>
+  using FrameCallback = std::function<void(const Cpu&)>;
   /// <summary>
   /// Initialises all Cpu components to a known state.
   /// </summary>
   Cpu() noexcept;
 
+  /// <summary>
+  /// Restores the state of a newly constructed cpu in place: clears memory,
+  /// registers, screen and keys, reloads fonts, restores default settings and
+  /// detaches AOT module and frame callback. RNG is not reseeded, use SeedRNG() when
+  /// reproducible runs are needed.
+  /// </summary>
+  void Reset() noexcept;
+
+  /// <summary>
+  /// Seeds random number generator used by CXKK.
+  /// </summary>
+  void SeedRNG(unsigned int seed) noexcept;
+
   /// <summary>
   /// Loads ROM using given path to memory. ROM is always loaded into a
   /// specified section of cpu memory.
   /// </summary>
   bool LoadROM(std::filesystem::path rom_path) noexcept;
 
- protected:
   /// <summary>
-  /// Returns a constant reference to the array of pixel states.
+  /// Copies ROM image into memory. Cheaper than loading from a path when
+  /// the same ROM is loaded many times.
   /// </summary>
-  /// <returns>
-  /// A constant reference to a std::array of 2048 boolean values
-  /// representing the pixel states on screen.
-  /// </returns>
-  const std::array<bool, 64 * 32>& GetPixels() const noexcept;
+  void LoadROM(const RomImage& rom) noexcept;
 
- private:
   /// <summary>
-  /// Loads font character data into memory. Charset is defined in
-  /// core/constants.h.
+  /// Performs a single cycle of cpu. Timers are not affected, they are
+  /// decremented separately by TickTimers().
   /// </summary>
-  void LoadFontChars() noexcept;
+  void Cycle();
 
   /// <summary>
-  /// Initialises random number generator.
+  /// Decrements delay and sound timers if they are above zero. Should be
+  /// called kTimerFrequency times per second.
   /// </summary>
-  /// <returns>RNG seed.</returns>
-  unsigned int InitRNG() noexcept;
+  void TickTimers() noexcept;
 
   /// <summary>
-  /// Generates random unsigned 1 byte integer.
+  /// Emulates a single frame: executes given amount of cycles followed by one
+  /// timer tick.
+  /// <para>
+  /// Idle loops (see IdleState) are fast-forwarded to the end of the frame.
+  /// Resulting state is exactly the same as if all cycles were interpreted.
+  /// </para>
   /// </summary>
-  /// <returns>
-  /// Random unsigned 1 byte integer.
-  /// </returns>
-  uint8_t GenUint8() noexcept;
+  /// <param name="cycles">Amount of cycles in one frame.</param>
+  /// <returns>Amount of cycles that were actually interpreted.</returns>
+  size_t RunFrame(size_t cycles);
 
   /// <summary>
-  /// Removes and returns the top value from the stack, if available.
+  /// Executes the next unit of work the way RunFrame() would: an idle loop
+  /// fast-forwarded through the whole budget, a compiled block, a
+  /// superinstruction or a single instruction. Timers are not affected.
+  /// Lets tools follow fast paths instruction by instruction, see
+  /// verify::LockstepHarness.
   /// </summary>
+  /// <param name="budget">Amount of cycles left in the frame.</param>
   /// <returns>
-  /// An optional containing the top uint16_t value if the stack is not empty;
-  /// otherwise, an empty optional.
+  /// Amount of cycles consumed, 0 for empty budget or halted cpu.
   /// </returns>
-  std::optional<uint16_t> PopStack() noexcept;
+  size_t Step(size_t budget);
 
   /// <summary>
-  /// Pushes a 16-bit unsigned integer value onto the stack.
+  /// Sets a callback invoked after every RunFrame(), once the timers have
+  /// ticked, e.g. to record presented frames. It runs on the thread driving
+  /// the cpu. Passing an empty callback removes it.
   /// </summary>
-  /// <param name="value">
-  /// The 16-bit unsigned integer to push onto the stack.
-  /// </param>
-  void PushStack(uint16_t value) noexcept;
+  void SetFrameCallback(FrameCallback callback) noexcept;
 
   /// <summary>
-  /// A fixed-size array of 16 8-bit unsigned integer registers.
+  /// Checks whether instructions at program counter form an idle loop which
+  /// cannot change cpu state before the next timer tick or key event.
   /// </summary>
-  std::array<uint8_t, 16> registers_;
+  /// <returns>Detected idle pattern or IdleState::kNone.</returns>
+  IdleState GetIdleState() const noexcept;
 
   /// <summary>
-  /// A fixed-size array representing whole cpu memory.
+  /// Enables or disables fast-forwarding of idle loops in RunFrame(). Enabled
+  /// by default.
   /// </summary>
-  std::array<uint8_t, 4096> memory_;
+  void SetIdleSkipping(bool enabled) noexcept;
 
   /// <summary>
-  /// A 16-bit unsigned integer representing an index register.
+  /// Enables or disables superinstruction fusion in RunFrame(). Enabled by
+  /// default.
   /// </summary>
-  uint16_t index_register_;
+  void SetFusion(bool enabled) noexcept;
 
   /// <summary>
-  /// Represents the current value of the program counter.
+  /// Returns amount of instructions executed as a part of superinstructions
+  /// since the last loaded ROM.
   /// </summary>
-  uint16_t program_counter_;
+  uint64_t GetFusedInstructionCount() const noexcept;
 
   /// <summary>
-  /// A fixed-size array representing a stack with 16 elements of type uint16_t.
+  /// Decodes superinstructions at every instruction found by static analysis
+  /// and reports writes which modify code. Must be called after LoadROM(),
+  /// as loading a ROM clears the decode cache.
   /// </summary>
-  std::array<uint16_t, 16> stack_;
+  /// <param name="code_map">Result of analysis::RomAnalyzer.</param>
+  void PrewarmDecodeCache(const analysis::CodeMap& code_map) noexcept;
 
   /// <summary>
-  /// Represents the current position of the stack pointer.
+  /// Attaches a ROM compiled ahead of time (see aot::AotPlugin). RunFrame()
+  /// executes a compiled block whenever program counter is at its start and
+  /// memory still holds the bytes it was compiled from; everything else is
+  /// interpreted. Passing nullptr detaches the module.
   /// </summary>
-  uint8_t stack_pointer_;
+  void AttachAotModule(const aot::AotModule* module) noexcept;
 
   /// <summary>
-  /// Represents the value of a delay timer.
+  /// Returns amount of instructions executed by compiled blocks.
   /// </summary>
-  uint8_t delay_timer_;
+  uint64_t GetAotInstructionCount() const noexcept;
 
   /// <summary>
-  /// Represents the value of the sound timer.
+  /// Sets state of a single key on the keypad.
   /// </summary>
-  uint8_t sound_timer_;
+  /// <param name="key">Key index (0x0-0xF).</param>
+  /// <param name="pressed">True if key is held down.</param>
+  void SetKey(uint8_t key, bool pressed) noexcept;
 
   /// <summary>
-  /// A fixed-size array holding 16 unsigned 8-bit integers, representing state
-  /// of keypad.
+  /// Sets state of all keys at once.
   /// </summary>
-  std::array<uint8_t, 16> keys_;
+  /// <param name="mask">Bit N set if key N is held down.</param>
+  void SetKeyMask(uint16_t mask) noexcept;
 
   /// <summary>
-  /// Represents a fixed-size screen buffer as an array of boolean values.
+  /// Returns state of all keys, bit N is set if key N is held down.
   /// </summary>
-  std::array<bool, 64 * 32> screen_;
+  uint16_t GetKeyMask() const noexcept;
 
   /// <summary>
-  /// Represents a current opcode value.
+  /// Returns a constant reference to the array of pixel states.
   /// </summary>
-  uint16_t opcode_;
+  /// <returns>
+  /// A constant reference to a std::array of 2048 boolean values
+  /// representing the pixel states on screen.
+  /// </returns>
+  const std::array<bool, 64 * 32>& GetPixels() const noexcept;
 
   /// <summary>
-  /// Random number generation utility.
+  /// Returns a constant reference to V0-VF registers.
   /// </summary>
-  std::random_device rd_;
+  const std::array<uint8_t, 16>& GetRegisters() const noexcept;
 
   /// <summary>
-  /// Random number generation utility.
+  /// Returns a constant reference to whole cpu memory.
   /// </summary>
-  std::mt19937 gen_;
+  const std::array<uint8_t, 4096>& GetMemory() const noexcept;
 
   /// <summary>
-  /// Random number generation utility.
+  /// Returns a constant reference to the stack.
   /// </summary>
-  std::uniform_int_distribution<> dist_;
+  const std::array<uint16_t, 16>& GetStack() const noexcept;
 
   /// <summary>
-  /// Holds error value in case it occurs. 
+  /// Returns current value of the index register.
   /// </summary>
-  CritErrors critical_error_;
+  uint16_t GetIndexRegister() const noexcept;
 
   /// <summary>
-  /// Performs a single cycle of cpu.
+  /// Returns current value of the program counter.
   /// </summary>
-  void Cycle();
+  uint16_t GetProgramCounter() const noexcept;
 
   /// <summary>
-  /// CLS - Clears the display.
+  /// Returns current position of the stack pointer.
   /// </summary>
-  void Opcode00E0() noexcept;
+  uint8_t GetStackPointer() const noexcept;
 
   /// <summary>
-  /// RET - Returns from a subroutine.
-  /// <para>
-  /// The interpreter sets the program counter to the address at the top of the
-  /// stack then subtracts 1 from the stack pointer.
-  /// </para>
+  /// Returns current value of the delay timer.
   /// </summary>
-  void Opcode00EE() noexcept;
+  uint8_t GetDelayTimer() const noexcept;
 
   /// <summary>
-  /// JP addr - Jump to location nnn.
-  /// <para>
-  /// The interpreter sets the program counter to nnn.
-  /// </para>
+  /// Returns current value of the sound timer.
   /// </summary>
-  void Opcode1NNN() noexcept;
+  uint8_t GetSoundTimer() const noexcept;
 
   /// <summary>
-  /// CALL addr - Call subroutine at nnn.
-  /// <para>
-  /// The interpreter increments the stack pointer, then puts the current PC on
-  /// the top of the stack. The PC is then set to nnn.
-  /// </para>
+  /// Returns the last fetched opcode.
   /// </summary>
-  void Opcode2NNN() noexcept;
+  uint16_t GetOpcode() const noexcept;
 
   /// <summary>
-  /// SE Vx, byte - Skip next instruction if Vx = kk.
-  /// <para>
-  /// The interpreter compares register Vx to kk, and if they are equal,
-  /// increments the program counter by 2.
-  /// </para>
+  /// Returns the stack error which halted the cpu, CritErrors::kNone while
+  /// it runs. A halted cpu executes no further instructions in RunFrame()
+  /// and Step() until Reset().
   /// </summary>
-  void Opcode3XKK() noexcept;
+  CritErrors GetCriticalError() const noexcept;
 
   /// <summary>
-  /// SNE Vx, byte - Skip next instruction if Vx != kk.
-  /// <para>
-  /// The interpreter compares register Vx to kk, and if they are not equal,
-  /// increments the program counter by 2.
-  /// </para>
+  /// Returns amount of unknown opcodes interpreted since the last loaded ROM.
+  /// Compiled blocks leave unknown opcodes to the interpreter, so they count.
   /// </summary>
-  void Opcode4XKK() noexcept;
+  uint64_t GetUnknownOpcodeCount() const noexcept;
 
   /// <summary>
-  /// SE Vx, Vy - Skip next instruction if Vx = Vy.
-  /// <para>
-  /// The interpreter compares register Vx to register Vy, and if they are
-  /// equal, increments the program counter by 2.
-  /// </para>
+  /// Returns a hash of every observable part of the state: registers,
+  /// memory, stack, timers, keys and screen. Two cpus with equal hashes
+  /// behave the same, given the same RNG state.
   /// </summary>
-  void Opcode5XY0() noexcept;
+  uint64_t GetStateHash() const noexcept;
 
   /// <summary>
-  /// LD Vx, byte - Set Vx = kk.
-  /// <para>
-  /// The interpreter puts the value kk into register Vx.
-  /// </para>
+  /// Returns the architectural state of the cpu.
   /// </summary>
-  void Opcode6XKK() noexcept;
+  const MachineState& GetState() const noexcept;
 
   /// <summary>
-  /// ADD Vx, byte - Set Vx = Vx + kk.
-  /// <para>
-  /// Adds the value kk to the value of register Vx, then stores the result in
-  /// Vx.
-  /// </para>
+  /// Replaces the architectural state, e.g. with one computed at compile
+  /// time by Boot(). Decoded superinstructions and compiled blocks are
+  /// rechecked against the new memory.
   /// </summary>
-  void Opcode7XKK() noexcept;
+  void SetState(const MachineState& state) noexcept;
 
   /// <summary>
-  /// LD Vx, Vy - Set Vx = Vy.
-  /// <para>
-  /// Stores the value of register Vy in register Vx.
-  /// </para>
+  /// Saves the architectural state and the RNG into a snapshot, reusing its
+  /// storage.
   /// </summary>
-  void Opcode8XY0() noexcept;
+  void SaveSnapshot(CpuSnapshot& snapshot) const noexcept;
 
   /// <summary>
-  /// OR Vx, Vy - Set Vx = Vx OR Vy.
-  /// <para>
-  /// Performs a bitwise OR on the values of Vx and Vy, then stores the result
-  /// in Vx. A bitwise OR compares the corrseponding bits from two values, and
-  /// if either bit is 1, then the same bit in the result is also 1. Otherwise,
-  /// it is 0.
-  /// </para>
+  /// Continues from a snapshot saved by SaveSnapshot(). Like SetState(),
+  /// rechecks decoded superinstructions and compiled blocks.
   /// </summary>
-  void Opcode8XY1() noexcept;
+  void RestoreSnapshot(const CpuSnapshot& snapshot) noexcept;
 
+ private:
   /// <summary>
-  /// AND Vx, Vy - Set Vx = Vx AND Vy.
-  /// <para>
-  /// Performs a bitwise AND on the values of Vx and Vy, then stores the result
-  /// in Vx. A bitwise AND compares the corrseponding bits from two values, and
-  /// if both bits are 1, then the same bit in the result is also 1. Otherwise,
-  /// it is 0.
-  /// </para>
+  /// Applies the effect of interpreting given amount of cycles of a detected
+  /// idle loop without executing them one by one.
   /// </summary>
-  void Opcode8XY2() noexcept;
+  /// <param name="state">Idle pattern found at program counter.</param>
+  /// <param name="cycles">Amount of cycles to skip.</param>
+  void SkipIdleCycles(IdleState state, size_t cycles) noexcept;
 
   /// <summary>
-  /// XOR Vx, Vy - Set Vx = Vx XOR Vy.
-  /// <para>
-  /// Performs a bitwise exclusive OR on the values of Vx and Vy, then stores
-  /// the result in Vx. An exclusive OR compares the corrseponding bits from two
-  /// values, and if the bits are not both the same, then the corresponding bit
-  /// in the result is set to 1. Otherwise, it is 0.
-  /// </para>
+  /// Executes an instruction at program counter, or a superinstruction if the
+  /// next two instructions can be fused and the budget allows it.
   /// </summary>
-  void Opcode8XY3() noexcept;
+  /// <param name="budget">Amount of cycles left in the frame.</param>
+  /// <returns>Amount of executed cycles (1 or 2).</returns>
+  size_t CycleFused(size_t budget);
 
   /// <summary>
-  /// ADD Vx, Vy - Set Vx = Vx + Vy, set VF = carry.
-  /// <para>
-  /// The values of Vx and Vy are added together. If the result is greater than
-  /// 8 bits (i.e., > 255,) VF is set to 1, otherwise 0. Only the lowest 8 bits
-  /// of the result are kept, and stored in Vx.
-  /// </para>
+  /// Executes a compiled block, a superinstruction or a single instruction,
+  /// whichever is enabled and available at program counter.
   /// </summary>
-  void Opcode8XY4() noexcept;
+  /// <param name="budget">Amount of cycles left in the frame.</param>
+  /// <returns>Amount of executed cycles.</returns>
+  size_t CycleFastest(size_t budget);
 
   /// <summary>
-  /// SUB Vx, Vy - Set Vx = Vx - Vy, set VF = NOT borrow.
-  /// <para>
-  /// If Vx > Vy, then VF is set to 1, otherwise 0. Then Vy is subtracted from
-  /// Vx, and the results stored in Vx.
-  /// </para>
+  /// Executes the fetched DXYN opcode. Every path drawing sprites goes through
+  /// here so draws are profiled the same way.
   /// </summary>
-  void Opcode8XY5() noexcept;
+  void Draw() noexcept;
 
   /// <summary>
-  /// SHR Vx {, Vy} - Set Vx = Vx SHR 1.
-  /// <para>
-  /// If the least-significant bit of Vx is 1, then VF is set to 1, otherwise 0.
-  /// Then Vx is divided by 2.
-  /// </para>
+  /// Checks whether two instructions starting at given address form a
+  /// superinstruction.
   /// </summary>
-  void Opcode8XY6() noexcept;
+  Fusion DecodeFusion(uint16_t address) const noexcept;
 
   /// <summary>
-  /// SUBN Vx, Vy - Set Vx = Vy - Vx, set VF = NOT borrow.
-  /// <para>
-  /// If Vy > Vx, then VF is set to 1, otherwise 0. Then Vx is subtracted from
-  /// Vy, and the results stored in Vx.
-  /// </para>
+  /// Marks decoded superinstructions overlapping given memory range as
+  /// unknown. Must be called after every write to memory.
   /// </summary>
-  void Opcode8XY7() noexcept;
+  void InvalidateFusion(size_t address, size_t size) noexcept;
 
   /// <summary>
-  /// SHL Vx {, Vy} - Set Vx = Vx SHL 1.
-  /// <para>
-  /// If the most-significant bit of Vx is 1, then VF is set to 1, otherwise to
-  /// 0. Then Vx is multiplied by 2.
-  /// </para>
-  /// <remarks>
-  /// <strong>Warning:</strong> This instruction might cause some issues due to
-  /// inaccurate specification of what should it do.
-  /// </remarks>
+  /// Executes a compiled block starting at program counter, if there is a
+  /// valid one which fits in the budget.
   /// </summary>
-  void Opcode8XYE() noexcept;
+  /// <param name="budget">Amount of cycles left in the frame.</param>
+  /// <returns>Amount of executed cycles, 0 if nothing was executed.</returns>
+  size_t CycleAot(size_t budget);
 
   /// <summary>
-  /// SNE Vx, Vy - Skip next instruction if Vx != Vy.
-  /// <para>
-  /// The values of Vx and Vy are compared, and if they are not equal, the
-  /// program counter is increased by 2.
-  /// </para>
+  /// Rechecks compiled blocks overlapping given memory range against memory.
   /// </summary>
-  void Opcode9XY0() noexcept;
+  /// <returns>True if the range overlaps compiled code.</returns>
+  bool ValidateAotBlocks(size_t address, size_t size) noexcept;
 
   /// <summary>
-  /// LD I, addr - Set I = nnn.
-  /// <para>
-  /// The value of register I is set to nnn.
-  /// </para>
+  /// Invalidates everything decoded from a memory range after it was
+  /// written. The range wraps around the end of memory like the write did.
   /// </summary>
-  void OpcodeANNN() noexcept;
+  /// <returns>True if compiled code was overwritten.</returns>
+  bool OnMemoryWrite(size_t address, size_t size) noexcept;
 
   /// <summary>
-  /// JP V0, addr - Jump to location nnn + V0.
-  /// <para>
-  /// The program counter is set to nnn plus the value of V0.
-  /// </para>
+  /// RNG callback for compiled blocks.
   /// </summary>
-  void OpcodeBNNN() noexcept;
+  static uint8_t AotRandom(void* cpu) noexcept;
 
   /// <summary>
-  /// RND Vx, byte - Set Vx = random byte AND kk.
-  /// <para>
-  /// The interpreter generates a random number from 0 to 255, which is then
-  /// ANDed with the value kk. The results are stored in Vx. See instruction
-  /// 8xy2 for more information on AND.
-  /// </para>
+  /// Memory write callback for compiled blocks.
   /// </summary>
-  void OpcodeCXKK() noexcept;
+  static bool AotOnWrite(void* cpu, uint16_t address, uint16_t size) noexcept;
 
   /// <summary>
-  /// DRW Vx, Vy, nibble - Display n-byte sprite starting at memory location I
-  /// at (Vx, Vy), set VF = collision.
-  /// <para>
-  /// The interpreter reads n bytes from
-  /// memory, starting at the address stored in I. These bytes are then
-  /// displayed as sprites on screen at coordinates (Vx, Vy). Sprites are XORed
-  /// onto the existing screen. If this causes any pixels to be erased, VF is
-  /// set to 1, otherwise it is set to 0. If the sprite is positioned so part of
-  /// it is outside the coordinates of the display, it wraps around to the
-  /// opposite side of the screen.
-  /// </para>
+  /// Initialises random number generator.
   /// </summary>
-  void OpcodeDXYN() noexcept;
+  /// <returns>RNG seed.</returns>
+  unsigned int InitRNG() noexcept;
 
   /// <summary>
-  /// Ex9E - SKP Vx - Skip next instruction if key with the value of Vx is
-  /// pressed.
-  /// <para>
-  /// Checks the keyboard, and if the key corresponding to the
-  /// value of Vx is currently in the down position, PC is increased by 2.
-  /// </para>
+  /// Generates random unsigned 1 byte integer.
   /// </summary>
-  void OpcodeEX9E() noexcept;
+  /// <returns>
+  /// Random unsigned 1 byte integer.
+  /// </returns>
+  uint8_t GenUint8() noexcept;
 
   /// <summary>
-  /// ExA1 - SKNP Vx - Skip next instruction if key with the value of Vx is not
-  /// pressed.
-  /// <para>
-  /// Checks the keyboard, and if the key corresponding to the
-  /// value of Vx is currently in the up position, PC is increased by 2.
-  /// </para>
+  /// Connects instructions executed by the machine core to the cpu: random
+  /// numbers come from its generator, memory writes invalidate decoded and
+  /// compiled code, unknown opcodes and errors are counted and logged.
   /// </summary>
-  void OpcodeEXA1() noexcept;
+  class Policy {
+   public:
+    explicit Policy(Cpu& cpu) noexcept : cpu_(cpu) {}
+
+    uint8_t Random() noexcept { return cpu_.GenUint8(); }
+
+    void OnMemoryWrite(size_t address, size_t size) noexcept {
+      cpu_.OnMemoryWrite(address, size);
+    }
+
+    void OnUnknownOpcode(uint16_t opcode) noexcept {
+      LOG_WARN("Opcode unknown: {:#x}", opcode);
+      ++cpu_.unknown_opcodes_;
+    }
+
+    void OnCriticalError(CritErrors error) noexcept {
+      LOG_CRITICAL(error == CritErrors::kStackUnderflow ? "Stack underflow."
+                                                        : "Stack overflow.");
+    }
+
+   private:
+    Cpu& cpu_;
+  };
 
   /// <summary>
-  /// Fx07 - LD Vx, DT - Set Vx = delay timer value.
-  /// <para>
-  /// The value of DT is placed into Vx.
-  /// </para>
+  /// Registers, memory, stack, timers, keys and screen, see ExecuteCycle().
   /// </summary>
-  void OpcodeFX07() noexcept;
+  MachineState state_;
 
   /// <summary>
-  /// Fx0A - LD Vx, K - Wait for a key press, store the value of the key in Vx.
-  /// <para>
-  /// All execution stops until a key is pressed, then the value of that key is
-  /// stored in Vx.
-  /// </para>
+  /// Random number generation utility.
   /// </summary>
-  void OpcodeFX0A() noexcept;
+  std::mt19937 gen_;
 
   /// <summary>
-  /// Fx15 - LD DT, Vx - Set delay timer = Vx.
-  /// <para>
-  /// DT is set equal to the value of Vx.
-  /// </para>
+  /// Random number generation utility.
   /// </summary>
-  void OpcodeFX15() noexcept;
+  std::uniform_int_distribution<> dist_;
 
   /// <summary>
-  /// Fx18 - LD ST, Vx - Set sound timer = Vx.
-  /// <para>
-  /// ST is set equal to the value of Vx.
-  /// </para>
+  /// True if idle loops should be fast-forwarded in RunFrame().
   /// </summary>
-  void OpcodeFX18() noexcept;
+  bool idle_skipping_;
 
   /// <summary>
-  /// Fx1E - ADD I, Vx - Set I = I + Vx.
-  /// <para>
-  /// The values of I and Vx are added, and the results are stored in I.
-  /// </para>
+  /// True if superinstructions should be used in RunFrame().
   /// </summary>
-  void OpcodeFX1E() noexcept;
+  bool fusion_enabled_;
 
   /// <summary>
-  /// Fx29 - LD F, Vx - Set I = location of sprite for digit Vx.
-  /// <para>
-  /// The value of I is set to the location for the hexadecimal sprite
-  /// corresponding to the value of Vx.
-  /// </para>
+  /// Superinstruction found at every memory address. Entries are decoded
+  /// lazily, a jump into the middle of a pair simply uses the entry of the
+  /// second instruction.
   /// </summary>
-  void OpcodeFX29() noexcept;
+  std::array<Fusion, 4096> fusion_cache_;
 
   /// <summary>
-  /// Fx33 - LD B, Vx - Store BCD representation of Vx in memory locations I,
-  /// I+1, and I+2.
-  /// <para>
-  /// The interpreter takes the decimal value of Vx, and
-  /// places the hundreds digit in memory at location in I, the tens digit at
-  /// location I+1, and the ones digit at location I+2.
-  /// </para>
+  /// Amount of instructions executed as a part of superinstructions.
   /// </summary>
-  void OpcodeFX33() noexcept;
+  uint64_t fused_instructions_;
 
   /// <summary>
-  /// Fx55 - LD [I], Vx - Store registers V0 through Vx in memory starting at
-  /// location I.
-  /// <para>
-  /// The interpreter copies the values of registers V0
-  /// through Vx into memory, starting at the address in I.
-  /// </para>
+  /// Attached ahead-of-time compiled module or nullptr.
   /// </summary>
-  void OpcodeFX55() noexcept;
+  const aot::AotModule* aot_module_;
 
   /// <summary>
-  /// Fx65 - LD Vx, [I] - Read registers V0 through Vx from memory starting at
-  /// location I.
-  /// <para>
-  /// The interpreter reads values from memory starting at
-  /// location I into registers V0 through Vx.
-  /// </para>
+  /// Index + 1 of the compiled block starting at every address, 0 if there is
+  /// none.
+  /// </summary>
+  std::array<uint16_t, 4096> aot_blocks_;
+
+  /// <summary>
+  /// True for compiled blocks whose bytes match memory.
+  /// </summary>
+  std::vector<bool> aot_valid_;
+
+  /// <summary>
+  /// Set bits mark bytes covered by compiled blocks.
+  /// </summary>
+  std::bitset<4096> aot_code_;
+
+  /// <summary>
+  /// Amount of instructions executed by compiled blocks.
+  /// </summary>
+  uint64_t aot_instructions_;
+
+  /// <summary>
+  /// Called at the end of every RunFrame(), may be empty.
+  /// </summary>
+  FrameCallback frame_callback_;
+
+  /// <summary>
+  /// Amount of executed unknown opcodes.
   /// </summary>
-  void OpcodeFX65() noexcept;
+  uint64_t unknown_opcodes_;
 };
 
 }  // namespace chip8::core
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// <summary>
+/// Namespace for core components like cpu and screen in the program.
+/// </summary>
+namespace chip8::core {
+
+/// <summary>
+/// Thread safe pool of reusable cpus. Released cpus are Reset() and handed
+/// out again instead of being constructed from scratch.
+/// </summary>
+class CpuPool {
+ public:
+  /// <summary>
+  /// Returns the cpu to the pool when destroyed.
+  /// </summary>
+  struct Releaser {
+    CpuPool* pool;
+
+    void operator()(Cpu* cpu) const noexcept;
+  };
+
+  /// <summary>
+  /// Cpu borrowed from a pool. The pool must outlive it.
+  /// </summary>
+  using Handle = std::unique_ptr<Cpu, Releaser>;
+
+  /// <summary>
+  /// Creates a pool with given amount of cpus constructed up front.
+  /// </summary>
+  explicit CpuPool(size_t initial_size = 0);
+
+  CpuPool(const CpuPool&) = delete;
+  CpuPool& operator=(const CpuPool&) = delete;
+
+  /// <summary>
+  /// Returns a cpu in its power-on state, reusing an idle one if available.
+  /// </summary>
+  Handle Acquire();
+
+  /// <summary>
+  /// Returns amount of idle cpus waiting in the pool.
+  /// </summary>
+  size_t GetIdleCount() const noexcept;
+
+ private:
+  /// <summary>
+  /// Resets a cpu and puts it back into the pool. Never allocates, idle_
+  /// already has room for every cpu the pool created.
+  /// </summary>
+  void Release(Cpu* cpu) noexcept;
+
+  /// <summary>
+  /// Guards idle_ and created_.
+  /// </summary>
+  mutable std::mutex mutex_;
+
+  /// <summary>
+  /// Cpus ready to be acquired.
+  /// </summary>
+  std::vector<std::unique_ptr<Cpu>> idle_;
+
+  /// <summary>
+  /// Amount of cpus created by the pool, idle or acquired.
+  /// </summary>
+  size_t created_;
+};
+
+}  // namespace chip8::core
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+/// <summary>
+/// Namespace for core components like cpu and screen in the program.
+/// </summary>
+namespace chip8::core {
+
+/// <summary>
+/// Emulation speed as a fraction: cycles executed over a span of frames.
+/// Rates which do not divide evenly into frames alternate between the two
+/// neighbouring amounts of cycles, so the remainder of one frame is carried
+/// into the next and the average stays exact.
+/// </summary>
+struct CycleRate {
+  uint32_t cycles{10};
+  uint32_t frames{1};
+
+  /// <summary>
+  /// Returns the rate of a cycle delay in milliseconds (see kCycleDelay),
+  /// 1000 / delay cycles per second at given frame frequency.
+  /// </summary>
+  static constexpr CycleRate FromCycleDelay(uint16_t delay,
+                                            uint32_t frequency) noexcept {
+    const uint32_t cycles{1000};
+    const uint32_t frames{frequency * std::max<uint16_t>(delay, 1)};
+    const uint32_t divisor{std::gcd(cycles, frames)};
+    return CycleRate{cycles / divisor, frames / divisor};
+  }
+
+  /// <summary>
+  /// Returns amount of cycles to execute in given frame, counted from 0.
+  /// </summary>
+  constexpr size_t GetCycles(uint64_t frame) const noexcept {
+    return static_cast<size_t>((frame + 1) * cycles / frames -
+                               frame * cycles / frames);
+  }
+
+  /// <summary>
+  /// Returns the whole amount of cycles closest to the rate, at least 1,
+  /// for consumers which need the same amount in every frame.
+  /// </summary>
+  constexpr size_t GetRoundedCycles() const noexcept {
+    return std::max<size_t>(1, (cycles + frames / 2) / frames);
+  }
+};
+
+}  // namespace chip8::core
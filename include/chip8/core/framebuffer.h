@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Namespace for core components like cpu and screen in the program.
+/// </summary>
+namespace chip8::core {
+
+/// <summary>
+/// Screen packed to one bit per pixel. Row y is Framebuffer[y], pixel x is
+/// bit x of the row.
+/// </summary>
+using Framebuffer = std::array<uint64_t, 32>;
+
+/// <summary>
+/// Packs screen pixels (see Cpu::GetPixels()) to one bit per pixel.
+/// </summary>
+inline void PackFramebuffer(const std::array<bool, 64 * 32>& pixels,
+                            Framebuffer& out) noexcept {
+  for (size_t y{}; y < out.size(); ++y) {
+    uint64_t row{};
+    for (size_t x{}; x < 64; ++x) {
+      row |= static_cast<uint64_t>(pixels[y * 64 + x]) << x;
+    }
+    out[y] = row;
+  }
+}
+
+}  // namespace chip8::core
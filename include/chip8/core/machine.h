@@ -0,0 +1,769 @@
+#pragma once
+
+#include <chip8/core/constants.h>
+#include <chip8/core/memory.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/// <summary>
+/// Namespace for core components like cpu and screen in the program.
+/// </summary>
+namespace chip8::core {
+
+/// <summary>
+/// Builds memory of a newly powered on machine: zeroes with fontset loaded.
+/// </summary>
+constexpr Memory MakePowerOnMemory() noexcept {
+  Memory memory{};
+  for (size_t i{}; i < kFontsetCharAmount; ++i) {
+    std::copy(kFontset[i].begin(), kFontset[i].end(),
+              memory.begin() + kFontsetStartAddress + i * 5);
+  }
+  return memory;
+}
+
+/// <summary>
+/// Memory of a newly powered on machine.
+/// </summary>
+inline constexpr Memory kPowerOnMemory{MakePowerOnMemory()};
+
+/// <summary>
+/// Architectural state of the machine: everything instructions read or write.
+/// Default constructed state is the power-on state.
+/// </summary>
+struct MachineState {
+  std::array<uint8_t, 16> registers{};
+  Memory memory{kPowerOnMemory};
+  uint16_t index_register{};
+  uint16_t program_counter{kRomStartAddress};
+  std::array<uint16_t, 16> stack{};
+  uint8_t stack_pointer{};
+  uint8_t delay_timer{};
+  uint8_t sound_timer{};
+
+  /// <summary>
+  /// Nonzero for keys held down.
+  /// </summary>
+  std::array<uint8_t, 16> keys{};
+
+  std::array<bool, 64 * 32> screen{};
+
+  /// <summary>
+  /// The last fetched opcode.
+  /// </summary>
+  uint16_t opcode{};
+
+  /// <summary>
+  /// Stack error which halted the machine, CritErrors::kNone while it runs.
+  /// </summary>
+  CritErrors critical_error{CritErrors::kNone};
+
+  constexpr bool operator==(const MachineState&) const = default;
+};
+
+/// <summary>
+/// Everything instructions need from outside of the machine state: random
+/// numbers and notifications about memory writes, unknown opcodes and
+/// critical errors. Runtime policies log and invalidate caches (see Cpu),
+/// StaticPolicy does neither, so machines using it run in constant
+/// expressions.
+/// </summary>
+template <typename Policy>
+concept MachinePolicy = requires(Policy& policy, size_t address, size_t size,
+                                 uint16_t opcode, CritErrors error) {
+  { policy.Random() } -> std::convertible_to<uint8_t>;
+  policy.OnMemoryWrite(address, size);
+  policy.OnUnknownOpcode(opcode);
+  policy.OnCriticalError(error);
+};
+
+/// <summary>
+/// Policy usable in constant evaluation. Random numbers come from a seeded
+/// xorshift generator, so runs are reproducible.
+/// </summary>
+struct StaticPolicy {
+  /// <summary>
+  /// State of the random number generator, must not be 0.
+  /// </summary>
+  uint32_t seed{0x2545F491u};
+
+  /// <summary>
+  /// Amount of unknown opcodes executed.
+  /// </summary>
+  uint64_t unknown_opcodes{};
+
+  constexpr uint8_t Random() noexcept {
+    seed ^= seed << 13u;
+    seed ^= seed >> 17u;
+    seed ^= seed << 5u;
+    return static_cast<uint8_t>(seed >> 24u);
+  }
+
+  constexpr void OnMemoryWrite(size_t, size_t) noexcept {}
+
+  constexpr void OnUnknownOpcode(uint16_t) noexcept { ++unknown_opcodes; }
+
+  constexpr void OnCriticalError(CritErrors) noexcept {}
+};
+
+/// <summary>
+/// CLS - Clears the display.
+/// </summary>
+constexpr void Opcode00E0(MachineState& state) noexcept {
+  state.screen.fill(false);
+}
+
+/// <summary>
+/// RET - Returns from a subroutine.
+/// <para>
+/// The interpreter sets the program counter to the address at the top of the
+/// stack then subtracts 1 from the stack pointer. An empty stack halts the
+/// machine and jumps to 0.
+/// </para>
+/// </summary>
+template <MachinePolicy Policy>
+constexpr void Opcode00EE(MachineState& state, Policy& policy) noexcept {
+  if (state.stack_pointer == 0) {
+    state.critical_error = CritErrors::kStackUnderflow;
+    policy.OnCriticalError(state.critical_error);
+    state.program_counter = 0;
+    return;
+  }
+  state.program_counter = state.stack[--state.stack_pointer];
+}
+
+/// <summary>
+/// JP addr - Jump to location nnn.
+/// <para>
+/// The interpreter sets the program counter to nnn.
+/// </para>
+/// </summary>
+constexpr void Opcode1NNN(MachineState& state) noexcept {
+  state.program_counter = state.opcode & 0x0FFFu;
+}
+
+/// <summary>
+/// CALL addr - Call subroutine at nnn.
+/// <para>
+/// The interpreter increments the stack pointer, then puts the current PC on
+/// the top of the stack. The PC is then set to nnn. A full stack halts the
+/// machine.
+/// </para>
+/// </summary>
+template <MachinePolicy Policy>
+constexpr void Opcode2NNN(MachineState& state, Policy& policy) noexcept {
+  if (state.stack_pointer >= state.stack.size()) {
+    state.critical_error = CritErrors::kStackOverflow;
+    policy.OnCriticalError(state.critical_error);
+  } else {
+    state.stack[state.stack_pointer++] = state.program_counter;
+  }
+  state.program_counter = state.opcode & 0x0FFFu;
+}
+
+/// <summary>
+/// SE Vx, byte - Skip next instruction if Vx = kk.
+/// <para>
+/// The interpreter compares register Vx to kk, and if they are equal,
+/// increments the program counter by 2.
+/// </para>
+/// </summary>
+constexpr void Opcode3XKK(MachineState& state) noexcept {
+  if (state.registers[(state.opcode & 0x0F00u) >> 8u] ==
+      (state.opcode & 0x00FFu)) {
+    state.program_counter += 2;
+  }
+}
+
+/// <summary>
+/// SNE Vx, byte - Skip next instruction if Vx != kk.
+/// <para>
+/// The interpreter compares register Vx to kk, and if they are not equal,
+/// increments the program counter by 2.
+/// </para>
+/// </summary>
+constexpr void Opcode4XKK(MachineState& state) noexcept {
+  if (state.registers[(state.opcode & 0x0F00u) >> 8u] !=
+      (state.opcode & 0x00FFu)) {
+    state.program_counter += 2;
+  }
+}
+
+/// <summary>
+/// SE Vx, Vy - Skip next instruction if Vx = Vy.
+/// <para>
+/// The interpreter compares register Vx to register Vy, and if they are
+/// equal, increments the program counter by 2.
+/// </para>
+/// </summary>
+constexpr void Opcode5XY0(MachineState& state) noexcept {
+  if (state.registers[(state.opcode & 0x0F00u) >> 8u] ==
+      state.registers[(state.opcode & 0x00F0u) >> 4u]) {
+    state.program_counter += 2;
+  }
+}
+
+/// <summary>
+/// LD Vx, byte - Set Vx = kk.
+/// <para>
+/// The interpreter puts the value kk into register Vx.
+/// </para>
+/// </summary>
+constexpr void Opcode6XKK(MachineState& state) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] = state.opcode & 0x00FFu;
+}
+
+/// <summary>
+/// ADD Vx, byte - Set Vx = Vx + kk.
+/// <para>
+/// Adds the value kk to the value of register Vx, then stores the result in
+/// Vx.
+/// </para>
+/// </summary>
+constexpr void Opcode7XKK(MachineState& state) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] += state.opcode & 0x00FFu;
+}
+
+/// <summary>
+/// LD Vx, Vy - Set Vx = Vy.
+/// <para>
+/// Stores the value of register Vy in register Vx.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY0(MachineState& state) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] =
+      state.registers[(state.opcode & 0x00F0u) >> 4u];
+}
+
+/// <summary>
+/// OR Vx, Vy - Set Vx = Vx OR Vy.
+/// <para>
+/// Performs a bitwise OR on the values of Vx and Vy, then stores the result
+/// in Vx. A bitwise OR compares the corrseponding bits from two values, and
+/// if either bit is 1, then the same bit in the result is also 1. Otherwise,
+/// it is 0.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY1(MachineState& state) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] |=
+      state.registers[(state.opcode & 0x00F0u) >> 4u];
+}
+
+/// <summary>
+/// AND Vx, Vy - Set Vx = Vx AND Vy.
+/// <para>
+/// Performs a bitwise AND on the values of Vx and Vy, then stores the result
+/// in Vx. A bitwise AND compares the corrseponding bits from two values, and
+/// if both bits are 1, then the same bit in the result is also 1. Otherwise,
+/// it is 0.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY2(MachineState& state) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] &=
+      state.registers[(state.opcode & 0x00F0u) >> 4u];
+}
+
+/// <summary>
+/// XOR Vx, Vy - Set Vx = Vx XOR Vy.
+/// <para>
+/// Performs a bitwise exclusive OR on the values of Vx and Vy, then stores
+/// the result in Vx. An exclusive OR compares the corrseponding bits from two
+/// values, and if the bits are not both the same, then the corresponding bit
+/// in the result is set to 1. Otherwise, it is 0.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY3(MachineState& state) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] ^=
+      state.registers[(state.opcode & 0x00F0u) >> 4u];
+}
+
+/// <summary>
+/// ADD Vx, Vy - Set Vx = Vx + Vy, set VF = carry.
+/// <para>
+/// The values of Vx and Vy are added together. If the result is greater than
+/// 8 bits (i.e., > 255,) VF is set to 1, otherwise 0. Only the lowest 8 bits
+/// of the result are kept, and stored in Vx.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY4(MachineState& state) noexcept {
+  const uint16_t sum{
+      static_cast<uint16_t>(state.registers[(state.opcode & 0x0F00u) >> 8u] +
+                            state.registers[(state.opcode & 0x00F0u) >> 4u])};
+  state.registers[0xFu] = (sum > 0xFFu) ? 1 : 0;
+  state.registers[(state.opcode & 0x0F00u) >> 8u] = sum & 0xFFu;
+}
+
+/// <summary>
+/// SUB Vx, Vy - Set Vx = Vx - Vy, set VF = NOT borrow.
+/// <para>
+/// If Vx > Vy, then VF is set to 1, otherwise 0. Then Vy is subtracted from
+/// Vx, and the results stored in Vx.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY5(MachineState& state) noexcept {
+  state.registers[0xFu] = (state.registers[(state.opcode & 0x0F00u) >> 8u] >
+                           state.registers[(state.opcode & 0x00F0u) >> 4u])
+                              ? 1
+                              : 0;
+  state.registers[(state.opcode & 0x0F00u) >> 8u] -=
+      state.registers[(state.opcode & 0x00F0u) >> 4u];
+}
+
+/// <summary>
+/// SHR Vx {, Vy} - Set Vx = Vx SHR 1.
+/// <para>
+/// If the least-significant bit of Vx is 1, then VF is set to 1, otherwise 0.
+/// Then Vx is divided by 2.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY6(MachineState& state) noexcept {
+  state.registers[0xFu] = state.registers[(state.opcode & 0x0F00u) >> 8u] & 1u;
+  state.registers[(state.opcode & 0x0F00u) >> 8u] >>= 1u;
+}
+
+/// <summary>
+/// SUBN Vx, Vy - Set Vx = Vy - Vx, set VF = NOT borrow.
+/// <para>
+/// If Vy > Vx, then VF is set to 1, otherwise 0. Then Vx is subtracted from
+/// Vy, and the results stored in Vx.
+/// </para>
+/// </summary>
+constexpr void Opcode8XY7(MachineState& state) noexcept {
+  state.registers[0xFu] = (state.registers[(state.opcode & 0x0F00u) >> 8u] <
+                           state.registers[(state.opcode & 0x00F0u) >> 4u])
+                              ? 1
+                              : 0;
+  state.registers[(state.opcode & 0x0F00u) >> 8u] =
+      state.registers[(state.opcode & 0x00F0u) >> 4u] -
+      state.registers[(state.opcode & 0x0F00u) >> 8u];
+}
+
+/// <summary>
+/// SHL Vx {, Vy} - Set Vx = Vx SHL 1.
+/// <para>
+/// If the most-significant bit of Vx is 1, then VF is set to 1, otherwise to
+/// 0. Then Vx is multiplied by 2.
+/// </para>
+/// <remarks>
+/// <strong>Warning:</strong> Some ROMs expect Vy to be shifted instead, see
+/// library::kShiftUsesVy.
+/// </remarks>
+/// </summary>
+constexpr void Opcode8XYE(MachineState& state) noexcept {
+  state.registers[0xFu] = state.registers[(state.opcode & 0x0F00u) >> 8u] >> 7u;
+  state.registers[(state.opcode & 0x0F00u) >> 8u] <<= 1u;
+}
+
+/// <summary>
+/// SNE Vx, Vy - Skip next instruction if Vx != Vy.
+/// <para>
+/// The values of Vx and Vy are compared, and if they are not equal, the
+/// program counter is increased by 2.
+/// </para>
+/// </summary>
+constexpr void Opcode9XY0(MachineState& state) noexcept {
+  if (state.registers[(state.opcode & 0x0F00u) >> 8u] !=
+      state.registers[(state.opcode & 0x00F0u) >> 4u]) {
+    state.program_counter += 2;
+  }
+}
+
+/// <summary>
+/// LD I, addr - Set I = nnn.
+/// <para>
+/// The value of register I is set to nnn.
+/// </para>
+/// </summary>
+constexpr void OpcodeANNN(MachineState& state) noexcept {
+  state.index_register = state.opcode & 0x0FFFu;
+}
+
+/// <summary>
+/// JP V0, addr - Jump to location nnn + V0.
+/// <para>
+/// The program counter is set to nnn plus the value of V0.
+/// </para>
+/// </summary>
+constexpr void OpcodeBNNN(MachineState& state) noexcept {
+  state.program_counter = (state.opcode & 0x0FFFu) + state.registers[0];
+}
+
+/// <summary>
+/// RND Vx, byte - Set Vx = random byte AND kk.
+/// <para>
+/// The interpreter generates a random number from 0 to 255, which is then
+/// ANDed with the value kk. The results are stored in Vx. See instruction
+/// 8xy2 for more information on AND.
+/// </para>
+/// </summary>
+template <MachinePolicy Policy>
+constexpr void OpcodeCXKK(MachineState& state, Policy& policy) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] =
+      static_cast<uint8_t>(policy.Random()) & (state.opcode & 0x00FFu);
+}
+
+/// <summary>
+/// DRW Vx, Vy, nibble - Display n-byte sprite starting at memory location I
+/// at (Vx, Vy), set VF = collision.
+/// <para>
+/// The interpreter reads n bytes from
+/// memory, starting at the address stored in I. These bytes are then
+/// displayed as sprites on screen at coordinates (Vx, Vy). Sprites are XORed
+/// onto the existing screen. If this causes any pixels to be erased, VF is
+/// set to 1, otherwise it is set to 0. If the sprite is positioned so part of
+/// it is outside the coordinates of the display, it wraps around to the
+/// opposite side of the screen.
+/// </para>
+/// </summary>
+constexpr void OpcodeDXYN(MachineState& state) noexcept {
+  const uint8_t start_x{state.registers[(state.opcode & 0x0F00u) >> 8u]};
+  const uint8_t start_y{state.registers[(state.opcode & 0x00F0u) >> 4u]};
+  const uint8_t height = state.opcode & 0x000Fu;
+
+  state.registers[0xF] = 0;
+  for (uint8_t row_idx{}; row_idx < height; ++row_idx) {
+    const size_t screen_y{(start_y + row_idx) % 32u};
+    const uint8_t sprite_byte{
+        ReadByte(state.memory, state.index_register + row_idx)};
+
+    for (uint8_t pixel_idx{}; pixel_idx < 8; ++pixel_idx) {
+      if ((sprite_byte & (0x80u >> pixel_idx)) == 0) {
+        continue;
+      }
+      bool& pixel{state.screen[screen_y * 64 + (start_x + pixel_idx) % 64u]};
+      if (pixel) {
+        state.registers[0xF] = 1;
+      }
+      pixel = !pixel;
+    }
+  }
+}
+
+/// <summary>
+/// Ex9E - SKP Vx - Skip next instruction if key with the value of Vx is
+/// pressed.
+/// <para>
+/// Checks the keyboard, and if the key corresponding to the
+/// value of Vx is currently in the down position, PC is increased by 2.
+/// </para>
+/// </summary>
+constexpr void OpcodeEX9E(MachineState& state) noexcept {
+  if (state.keys[(state.opcode & 0x0F00u) >> 8u]) {
+    state.program_counter += 2;
+  }
+}
+
+/// <summary>
+/// ExA1 - SKNP Vx - Skip next instruction if key with the value of Vx is not
+/// pressed.
+/// <para>
+/// Checks the keyboard, and if the key corresponding to the
+/// value of Vx is currently in the up position, PC is increased by 2.
+/// </para>
+/// </summary>
+constexpr void OpcodeEXA1(MachineState& state) noexcept {
+  if (!state.keys[(state.opcode & 0x0F00u) >> 8u]) {
+    state.program_counter += 2;
+  }
+}
+
+/// <summary>
+/// Fx07 - LD Vx, DT - Set Vx = delay timer value.
+/// <para>
+/// The value of DT is placed into Vx.
+/// </para>
+/// </summary>
+constexpr void OpcodeFX07(MachineState& state) noexcept {
+  state.registers[(state.opcode & 0x0F00u) >> 8u] = state.delay_timer;
+}
+
+/// <summary>
+/// Fx0A - LD Vx, K - Wait for a key press, store the value of the key in Vx.
+/// <para>
+/// All execution stops until a key is pressed, then the value of that key is
+/// stored in Vx.
+/// </para>
+/// </summary>
+constexpr void OpcodeFX0A(MachineState& state) noexcept {
+  bool pressed{false};
+  for (uint8_t i{}; i <= 0xFu; ++i) {
+    if (state.keys[i]) {
+      state.registers[(state.opcode & 0x0F00u) >> 8u] = i;
+      pressed = true;
+    }
+  }
+
+  if (!pressed) {
+    state.program_counter -= 2;
+  }
+}
+
+/// <summary>
+/// Fx15 - LD DT, Vx - Set delay timer = Vx.
+/// <para>
+/// DT is set equal to the value of Vx.
+/// </para>
+/// </summary>
+constexpr void OpcodeFX15(MachineState& state) noexcept {
+  state.delay_timer = state.registers[(state.opcode & 0x0F00u) >> 8u];
+}
+
+/// <summary>
+/// Fx18 - LD ST, Vx - Set sound timer = Vx.
+/// <para>
+/// ST is set equal to the value of Vx.
+/// </para>
+/// </summary>
+constexpr void OpcodeFX18(MachineState& state) noexcept {
+  state.sound_timer = state.registers[(state.opcode & 0x0F00u) >> 8u];
+}
+
+/// <summary>
+/// Fx1E - ADD I, Vx - Set I = I + Vx.
+/// <para>
+/// The values of I and Vx are added, and the results are stored in I. VF is
+/// set to 1 if the result leaves addressable memory, otherwise 0.
+/// </para>
+/// </summary>
+constexpr void OpcodeFX1E(MachineState& state) noexcept {
+  const uint16_t vx_value{state.registers[(state.opcode & 0x0F00u) >> 8u]};
+  state.registers[0xF] = (state.index_register + vx_value > 0xFFFu) ? 1 : 0;
+  state.index_register += vx_value;
+}
+
+/// <summary>
+/// Fx29 - LD F, Vx - Set I = location of sprite for digit Vx.
+/// <para>
+/// The value of I is set to the location for the hexadecimal sprite
+/// corresponding to the value of Vx.
+/// </para>
+/// </summary>
+constexpr void OpcodeFX29(MachineState& state) noexcept {
+  state.index_register = static_cast<uint16_t>(
+      kFontsetStartAddress +
+      5 * state.registers[(state.opcode & 0x0F00u) >> 8u]);
+}
+
+/// <summary>
+/// Fx33 - LD B, Vx - Store BCD representation of Vx in memory locations I,
+/// I+1, and I+2.
+/// <para>
+/// The interpreter takes the decimal value of Vx, and
+/// places the hundreds digit in memory at location in I, the tens digit at
+/// location I+1, and the ones digit at location I+2.
+/// </para>
+/// </summary>
+template <MachinePolicy Policy>
+constexpr void OpcodeFX33(MachineState& state, Policy& policy) noexcept {
+  uint8_t num{state.registers[(state.opcode & 0x0F00u) >> 8u]};
+  WriteByte(state.memory, state.index_register + 2, num % 10);
+  num /= 10;
+  WriteByte(state.memory, state.index_register + 1, num % 10);
+  num /= 10;
+  WriteByte(state.memory, state.index_register, num % 10);
+  policy.OnMemoryWrite(state.index_register, 3);
+}
+
+/// <summary>
+/// Fx55 - LD [I], Vx - Store registers V0 through Vx in memory starting at
+/// location I.
+/// <para>
+/// The interpreter copies the values of registers V0
+/// through Vx into memory, starting at the address in I, then increments I
+/// past the last of them.
+/// </para>
+/// </summary>
+template <MachinePolicy Policy>
+constexpr void OpcodeFX55(MachineState& state, Policy& policy) noexcept {
+  const size_t count{((state.opcode & 0x0F00u) >> 8u) + 1u};
+  WriteRange(state.memory, state.index_register, state.registers.data(),
+             count);
+  policy.OnMemoryWrite(state.index_register, count);
+  state.index_register += count;
+}
+
+/// <summary>
+/// Fx65 - LD Vx, [I] - Read registers V0 through Vx from memory starting at
+/// location I.
+/// <para>
+/// The interpreter reads values from memory starting at
+/// location I into registers V0 through Vx, then increments I past the last
+/// of them.
+/// </para>
+/// </summary>
+constexpr void OpcodeFX65(MachineState& state) noexcept {
+  const size_t count{((state.opcode & 0x0F00u) >> 8u) + 1u};
+  ReadRange(state.memory, state.index_register, state.registers.data(),
+            count);
+  state.index_register += count;
+}
+
+/// <summary>
+/// Executes the last fetched opcode. Program counter must already point past
+/// it. Opcodes which do not match any instruction only notify the policy.
+/// </summary>
+template <MachinePolicy Policy>
+constexpr void ExecuteOpcode(MachineState& state, Policy& policy) noexcept {
+  switch (state.opcode & 0xF000u) {
+    case 0x0000:
+      switch (state.opcode) {
+        case 0x00E0:
+          return Opcode00E0(state);
+        case 0x00EE:
+          return Opcode00EE(state, policy);
+      }
+      break;
+    case 0x1000:
+      return Opcode1NNN(state);
+    case 0x2000:
+      return Opcode2NNN(state, policy);
+    case 0x3000:
+      return Opcode3XKK(state);
+    case 0x4000:
+      return Opcode4XKK(state);
+    case 0x5000:
+      return Opcode5XY0(state);
+    case 0x6000:
+      return Opcode6XKK(state);
+    case 0x7000:
+      return Opcode7XKK(state);
+    case 0x8000:
+      switch (state.opcode & 0x000Fu) {
+        case 0x0000:
+          return Opcode8XY0(state);
+        case 0x0001:
+          return Opcode8XY1(state);
+        case 0x0002:
+          return Opcode8XY2(state);
+        case 0x0003:
+          return Opcode8XY3(state);
+        case 0x0004:
+          return Opcode8XY4(state);
+        case 0x0005:
+          return Opcode8XY5(state);
+        case 0x0006:
+          return Opcode8XY6(state);
+        case 0x0007:
+          return Opcode8XY7(state);
+        case 0x000E:
+          return Opcode8XYE(state);
+      }
+      break;
+    case 0x9000:
+      return Opcode9XY0(state);
+    case 0xA000:
+      return OpcodeANNN(state);
+    case 0xB000:
+      return OpcodeBNNN(state);
+    case 0xC000:
+      return OpcodeCXKK(state, policy);
+    case 0xD000:
+      return OpcodeDXYN(state);
+    case 0xE000:
+      switch (state.opcode & 0x000Fu) {
+        case 0x000E:
+          return OpcodeEX9E(state);
+        case 0x0001:
+          return OpcodeEXA1(state);
+      }
+      break;
+    case 0xF000:
+      switch (state.opcode & 0x00FFu) {
+        case 0x0007:
+          return OpcodeFX07(state);
+        case 0x000A:
+          return OpcodeFX0A(state);
+        case 0x0015:
+          return OpcodeFX15(state);
+        case 0x0018:
+          return OpcodeFX18(state);
+        case 0x001E:
+          return OpcodeFX1E(state);
+        case 0x0029:
+          return OpcodeFX29(state);
+        case 0x0033:
+          return OpcodeFX33(state, policy);
+        case 0x0055:
+          return OpcodeFX55(state, policy);
+        case 0x0065:
+          return OpcodeFX65(state);
+      }
+      break;
+  }
+  policy.OnUnknownOpcode(state.opcode);
+}
+
+/// <summary>
+/// Fetches the opcode at program counter and executes it. Timers are not
+/// affected.
+/// </summary>
+template <MachinePolicy Policy>
+constexpr void ExecuteCycle(MachineState& state, Policy& policy) noexcept {
+  state.opcode = ReadWord(state.memory, state.program_counter);
+  state.program_counter += 2;
+  ExecuteOpcode(state, policy);
+}
+
+/// <summary>
+/// Decrements delay and sound timers if they are above zero.
+/// </summary>
+constexpr void TickTimers(MachineState& state) noexcept {
+  if (state.delay_timer > 0) {
+    --state.delay_timer;
+  }
+  if (state.sound_timer > 0) {
+    --state.sound_timer;
+  }
+}
+
+/// <summary>
+/// Emulates a single frame: executes given amount of cycles, or fewer if
+/// the machine halts, followed by one timer tick.
+/// </summary>
+/// <returns>Amount of executed cycles.</returns>
+template <MachinePolicy Policy>
+constexpr size_t ExecuteFrame(MachineState& state, size_t cycles,
+                              Policy& policy) noexcept {
+  size_t executed{};
+  while (executed < cycles && state.critical_error == CritErrors::kNone) {
+    ExecuteCycle(state, policy);
+    ++executed;
+  }
+  TickTimers(state);
+  return executed;
+}
+
+/// <summary>
+/// Copies a ROM into memory at kRomStartAddress. Bytes which do not fit are
+/// dropped.
+/// </summary>
+constexpr void LoadRom(MachineState& state,
+                       std::span<const uint8_t> rom) noexcept {
+  const size_t size{
+      std::min(rom.size(), state.memory.size() - kRomStartAddress)};
+  std::copy(rom.begin(), rom.begin() + size,
+            state.memory.begin() + kRomStartAddress);
+}
+
+/// <summary>
+/// Runs a ROM from power-on for given amount of frames with StaticPolicy,
+/// e.g. to compute the state an embedded ROM boots into at compile time
+/// (see Cpu::SetState()).
+/// </summary>
+constexpr MachineState Boot(std::span<const uint8_t> rom, size_t frames,
+                            size_t cycles_per_frame,
+                            StaticPolicy policy = {}) noexcept {
+  MachineState state{};
+  LoadRom(state, rom);
+  for (size_t frame{}; frame < frames; ++frame) {
+    ExecuteFrame(state, cycles_per_frame, policy);
+  }
+  return state;
+}
+
+}  // namespace chip8::core
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chip8/core/constants.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/// <summary>
+/// Namespace for core components like cpu and screen in the program.
+/// </summary>
+namespace chip8::core {
+
+/// <summary>
+/// Cpu memory.
+/// </summary>
+using Memory = std::array<uint8_t, kMemorySize>;
+
+/// <summary>
+/// Mask applied to every memory address. Like the original hardware, cpu
+/// addresses memory with 12 bits, so accesses past 0xFFF wrap around to 0x000.
+/// </summary>
+constexpr size_t kAddressMask{kMemorySize - 1};
+
+static_assert((kMemorySize & kAddressMask) == 0,
+              "Memory size must be a power of two");
+
+/// <summary>
+/// How memory accesses are performed. Both modes wrap addresses, so emulated
+/// behavior is identical; kChecked additionally reports every access which
+/// had to be wrapped. Selected at build time with CHIP8_CHECKED_MEMORY.
+/// </summary>
+enum class MemoryMode { kFast, kChecked };
+
+#ifdef CHIP8_CHECKED_MEMORY
+constexpr MemoryMode kMemoryMode{MemoryMode::kChecked};
+#else
+constexpr MemoryMode kMemoryMode{MemoryMode::kFast};
+#endif
+
+/// <summary>
+/// Logs an access which crossed the end of memory. Used in kChecked mode.
+/// </summary>
+void ReportWrappedAccess(size_t address, size_t size) noexcept;
+
+/// <summary>
+/// Reports accesses of given size which do not fit in memory, if enabled.
+/// Nothing is reported during constant evaluation.
+/// </summary>
+constexpr void CheckAccess(size_t address, size_t size) noexcept {
+  if constexpr (kMemoryMode == MemoryMode::kChecked) {
+    if (!std::is_constant_evaluated() && address + size > kMemorySize) {
+      ReportWrappedAccess(address, size);
+    }
+  }
+}
+
+/// <summary>
+/// Returns address wrapped to 12 bits.
+/// </summary>
+constexpr size_t WrapAddress(size_t address) noexcept {
+  return address & kAddressMask;
+}
+
+/// <summary>
+/// Reads a single byte.
+/// </summary>
+constexpr uint8_t ReadByte(const Memory& memory, size_t address) noexcept {
+  CheckAccess(address, 1);
+  return memory[WrapAddress(address)];
+}
+
+/// <summary>
+/// Writes a single byte.
+/// </summary>
+constexpr void WriteByte(Memory& memory, size_t address,
+                         uint8_t value) noexcept {
+  CheckAccess(address, 1);
+  memory[WrapAddress(address)] = value;
+}
+
+/// <summary>
+/// Reads a big-endian opcode.
+/// </summary>
+constexpr uint16_t ReadWord(const Memory& memory, size_t address) noexcept {
+  CheckAccess(address, 2);
+  return static_cast<uint16_t>((memory[WrapAddress(address)] << 8u) |
+                               memory[WrapAddress(address + 1)]);
+}
+
+/// <summary>
+/// Copies bytes starting at given address, wrapping each of them separately.
+/// </summary>
+constexpr void ReadRange(const Memory& memory, size_t address, uint8_t* out,
+                         size_t size) noexcept {
+  CheckAccess(address, size);
+  for (size_t i{}; i < size; ++i) {
+    out[i] = memory[WrapAddress(address + i)];
+  }
+}
+
+/// <summary>
+/// Stores bytes starting at given address, wrapping each of them separately.
+/// </summary>
+constexpr void WriteRange(Memory& memory, size_t address, const uint8_t* in,
+                          size_t size) noexcept {
+  CheckAccess(address, size);
+  for (size_t i{}; i < size; ++i) {
+    memory[WrapAddress(address + i)] = in[i];
+  }
+}
+
+}  // namespace chip8::core
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// Namespace for core components like cpu and screen in the program.
+/// </summary>
+namespace chip8::core {
+
+/// <summary>
+/// ROM read and validated once, which can then be copied into any amount of
+/// cpus without touching the file system (see Cpu::LoadROM()).
+/// </summary>
+class RomImage {
+ public:
+  /// <summary>
+  /// Reads ROM file into memory. Files too large for cpu memory are rejected
+  /// before reading them.
+  /// </summary>
+  /// <returns>Loaded image or std::nullopt if file cannot be used.</returns>
+  static std::optional<RomImage> Load(const std::filesystem::path& rom_path);
+
+  /// <summary>
+  /// Creates image from raw ROM bytes.
+  /// </summary>
+  /// <returns>Image or std::nullopt if bytes do not fit in memory.</returns>
+  static std::optional<RomImage> FromBytes(std::span<const uint8_t> bytes);
+
+  /// <summary>
+  /// Returns raw ROM bytes.
+  /// </summary>
+  std::span<const uint8_t> GetBytes() const noexcept;
+
+  /// <summary>
+  /// Returns FNV-1a hash of ROM bytes, identifying the ROM in recordings.
+  /// </summary>
+  uint64_t GetHash() const noexcept;
+
+ private:
+  explicit RomImage(std::vector<uint8_t> bytes) noexcept;
+
+  /// <summary>
+  /// Raw ROM bytes, never empty.
+  /// </summary>
+  std::vector<uint8_t> bytes_;
+};
+
+}  // namespace chip8::core
@@ -4,7 +4,11 @@
 #include <SDL2/SDL_audio.h>
 #include <chip8/core/constants.h>
 #include <chip8/core/cpu.h>
+#include <chip8/core/cycle_rate.h>
+#include <chip8/core/framebuffer.h>
+#include <chip8/runtime/emulation_thread.h>
 
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
@@ -18,7 +22,7 @@ namespace chip8::core {
 
 /// <summary>
 /// Class representing CHIP-8 screen. Handles rendering, input and playing
-/// sound.
+/// sound, while the cpu runs on a runtime::EmulationThread.
 /// </summary>
 class Screen {
  public:
@@ -31,11 +35,30 @@ class Screen {
   Screen(Cpu& cpu) noexcept;
 
   /// <summary>
-  /// Runs the main rendering loop, invoking the provided CPU cycle function on
-  /// each iteration.
+  /// Reports emulation and presentation health to given metrics, nullptr
+  /// disables reporting. Must be called before RenderLoop().
+  /// </summary>
+  void SetMetrics(runtime::EmulatorMetrics* metrics) noexcept;
+
+  /// <summary>
+  /// Runs frames through given netplay session, nullptr runs the cpu alone.
+  /// Must be called before RenderLoop().
+  /// </summary>
+  void SetNetplay(runtime::Netplay* netplay) noexcept;
+
+  /// <summary>
+  /// Runs the cpu on an emulation thread and presents its frames until the
+  /// window is closed. This thread only polls events, forwards key changes
+  /// and presents the latest published frame.
   /// </summary>
   void RenderLoop() noexcept;
 
+  /// <summary>
+  /// Returns emulation speed, kCyclesPerFrame in every frame or 1000 /
+  /// kCycleDelay cycles per second.
+  /// </summary>
+  static CycleRate GetCycleRate() noexcept;
+
   /// <summary>
   /// Destroys the Screen object, releasing any associated resources.
   /// </summary>
@@ -53,15 +76,16 @@ class Screen {
   void PlayBeep() noexcept;
 
   /// <summary>
-  /// Updates the display to reflect the current state found in linked Cpu
-  /// object.
+  /// Updates the display to reflect a frame published by the emulation
+  /// thread.
   /// </summary>
-  void UpdateDisplay() noexcept;
-  
+  void UpdateDisplay(const Framebuffer& pixels) noexcept;
+
   /// <summary>
-  /// Updates the current state of the keys.
+  /// Sends keys whose state changed since the last call to the emulation
+  /// thread.
   /// </summary>
-  void UpdateKeysState() noexcept;
+  void UpdateKeysState(runtime::EmulationThread& emulation) noexcept;
 
   /// <summary>
   /// Pointer to an SDL_Window object representing a window in an SDL application.
@@ -88,6 +112,21 @@ class Screen {
   /// </summary>
   std::vector<Sint16> audio_buffer_;
 
+  /// <summary>
+  /// Key states last sent to the emulation thread.
+  /// </summary>
+  std::array<bool, 16> keys_;
+
+  /// <summary>
+  /// Metrics updated by RenderLoop(), may be nullptr.
+  /// </summary>
+  runtime::EmulatorMetrics* metrics_;
+
+  /// <summary>
+  /// Netplay session driving the emulation thread, may be nullptr.
+  /// </summary>
+  runtime::Netplay* netplay_;
+
   /// <summary>
   /// A reference to a Cpu object.
   /// </summary>
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/runtime/emulation_thread.h>
+#include <chip8/video/terminal_renderer.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/// <summary>
+/// Namespace for core components like cpu and screen in the program.
+/// </summary>
+namespace chip8::core {
+
+/// <summary>
+/// Text mode counterpart of Screen for SSH sessions and machines without a
+/// display. Draws frames on the controlling terminal with
+/// video::TerminalRenderer and reads keys from stdin, while the cpu runs on
+/// a runtime::EmulationThread.
+/// <para>
+/// Terminals report key presses but no releases, so a key counts as held
+/// until kKeyHoldTime passes without it, which keyboard auto-repeat keeps
+/// extending. Ctrl-C or Escape quits.
+/// </para>
+/// </summary>
+class TerminalScreen {
+ public:
+  /// <summary>
+  /// Time a key stays held after its last press or repeat.
+  /// </summary>
+  static constexpr std::chrono::milliseconds kKeyHoldTime{300};
+
+  /// <param name="cpu">Cpu to run.</param>
+  /// <param name="cycle_rate">See Screen::GetCycleRate().</param>
+  /// <param name="cells">Characters to draw with.</param>
+  TerminalScreen(
+      Cpu& cpu, CycleRate cycle_rate,
+      video::TerminalCells cells = video::TerminalCells::kHalfBlock) noexcept;
+
+  /// <summary>
+  /// Reports emulation and presentation health to given metrics, nullptr
+  /// disables reporting. Must be called before RenderLoop().
+  /// </summary>
+  void SetMetrics(runtime::EmulatorMetrics* metrics) noexcept;
+
+  /// <summary>
+  /// Runs frames through given netplay session, nullptr runs the cpu alone.
+  /// Must be called before RenderLoop().
+  /// </summary>
+  void SetNetplay(runtime::Netplay* netplay) noexcept;
+
+  /// <summary>
+  /// Switches the terminal to raw mode, runs the cpu on an emulation thread
+  /// and draws its frames until the user quits, then restores the terminal.
+  /// Console logging is muted meanwhile, logs still go to the file.
+  /// </summary>
+  void RenderLoop() noexcept;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /// <summary>
+  /// Waits a moment for input and handles it.
+  /// </summary>
+  /// <returns>False if the user asked to quit.</returns>
+  bool ReadInput() noexcept;
+
+  /// <summary>
+  /// Sends keys whose state changed since the last call to the emulation
+  /// thread, releasing keys not seen for kKeyHoldTime.
+  /// </summary>
+  void UpdateKeysState(runtime::EmulationThread& emulation) noexcept;
+
+  Cpu& cpu_;
+  CycleRate cycle_rate_;
+  video::TerminalCells cells_;
+
+  /// <summary>
+  /// Last time every key was pressed or repeated.
+  /// </summary>
+  std::array<Clock::time_point, 16> pressed_at_;
+
+  /// <summary>
+  /// Key states last sent to the emulation thread.
+  /// </summary>
+  std::array<bool, 16> keys_;
+
+  /// <summary>
+  /// Metrics updated by RenderLoop(), may be nullptr.
+  /// </summary>
+  runtime::EmulatorMetrics* metrics_;
+
+  /// <summary>
+  /// Netplay session driving the emulation thread, may be nullptr.
+  /// </summary>
+  runtime::Netplay* netplay_;
+};
+
+}  // namespace chip8::core
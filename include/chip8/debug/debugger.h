@@ -0,0 +1,243 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Namespace for interactive debugging of running ROMs.
+/// </summary>
+namespace chip8::debug {
+
+/// <summary>
+/// Comparison used by conditional breakpoints.
+/// </summary>
+enum class Comparison {
+  kEqual,
+  kNotEqual,
+  kLess,
+  kLessEqual,
+  kGreater,
+  kGreaterEqual
+};
+
+/// <summary>
+/// Condition on a register value, e.g. V3 == 0x10.
+/// </summary>
+struct BreakCondition {
+  uint8_t register_index{};
+  Comparison comparison{Comparison::kEqual};
+  uint8_t value{};
+
+  /// <summary>
+  /// Returns true if the condition holds for the cpu.
+  /// </summary>
+  bool Matches(const core::Cpu& cpu) const noexcept;
+};
+
+/// <summary>
+/// Kind of memory access reported by a watchpoint.
+/// </summary>
+enum class WatchKind : uint8_t { kRead = 1, kWrite = 2, kReadWrite = 3 };
+
+/// <summary>
+/// Reason why execution stopped.
+/// </summary>
+enum class StopReason {
+  /// <summary>
+  /// Requested amount of frames or instructions completed.
+  /// </summary>
+  kDone,
+  kBreakpoint,
+  kWatchRead,
+  kWatchWrite,
+
+  /// <summary>
+  /// Cpu is halted by a stack error (see core::Cpu::GetCriticalError()).
+  /// </summary>
+  kHalted
+};
+
+/// <summary>
+/// Where and why execution stopped. Breakpoints and watchpoints stop before
+/// the instruction at program counter is executed.
+/// </summary>
+struct Stop {
+  StopReason reason{StopReason::kDone};
+
+  /// <summary>
+  /// Program counter for breakpoints, first watched address touched by the
+  /// next instruction for watchpoints.
+  /// </summary>
+  uint16_t address{};
+};
+
+/// <summary>
+/// Drives a Cpu frame by frame like RunFrame() does, stopping at program
+/// counter breakpoints (optionally conditional on register values), memory
+/// watchpoints and after single steps.
+/// <para>
+/// While nothing is armed, frames run through Cpu::RunFrame() untouched, so
+/// debugging costs nothing. Once something is armed, the debugger executes
+/// one instruction at a time with Cpu::Step(), checking a 4 KB breakpoint
+/// bitmap before each one. Watchpoints are checked only for the
+/// instructions that access memory through I (DXYN, FX33, FX55, FX65), by
+/// decoding the next opcode. Checking loops with and without watchpoints
+/// are separate instantiations.
+/// </para>
+/// </summary>
+class Debugger {
+ public:
+  /// <summary>
+  /// Attaches to a cpu which must outlive the debugger.
+  /// </summary>
+  /// <param name="cycles_per_frame">Cycles between timer ticks.</param>
+  Debugger(core::Cpu& cpu, size_t cycles_per_frame) noexcept;
+
+  /// <summary>
+  /// Stops before executing the instruction at given address.
+  /// </summary>
+  void AddBreakpoint(uint16_t address) noexcept;
+
+  /// <summary>
+  /// Stops before executing the instruction at given address if the
+  /// condition holds. Several conditions at one address stop when any holds.
+  /// </summary>
+  void AddBreakpoint(uint16_t address, BreakCondition condition);
+
+  /// <summary>
+  /// Removes every breakpoint at given address.
+  /// </summary>
+  void RemoveBreakpoint(uint16_t address) noexcept;
+
+  /// <summary>
+  /// Stops before an instruction reads or writes given memory range.
+  /// </summary>
+  void AddWatchpoint(uint16_t address, uint16_t size, WatchKind kind) noexcept;
+
+  /// <summary>
+  /// Removes watchpoints of given kind from a memory range.
+  /// </summary>
+  void RemoveWatchpoint(uint16_t address, uint16_t size,
+                        WatchKind kind = WatchKind::kReadWrite) noexcept;
+
+  /// <summary>
+  /// Removes every breakpoint and watchpoint.
+  /// </summary>
+  void Clear() noexcept;
+
+  /// <summary>
+  /// Returns true if any breakpoint or watchpoint is set.
+  /// </summary>
+  bool IsArmed() const noexcept;
+
+  /// <summary>
+  /// Runs given amount of frames, finishing a frame interrupted by an
+  /// earlier stop first.
+  /// </summary>
+  Stop RunFrames(uint64_t frames);
+
+  /// <summary>
+  /// Executes a single instruction.
+  /// </summary>
+  Stop StepInstruction();
+
+  /// <summary>
+  /// Like StepInstruction(), but runs a called subroutine until it returns.
+  /// </summary>
+  /// <param name="max_instructions">Gives up after this many.</param>
+  Stop StepOver(uint64_t max_instructions = 1'000'000);
+
+  /// <summary>
+  /// Runs until the current subroutine returns.
+  /// </summary>
+  /// <param name="max_instructions">Gives up after this many.</param>
+  Stop StepOut(uint64_t max_instructions = 1'000'000);
+
+  /// <summary>
+  /// Returns amount of frames completed since the debugger was attached.
+  /// </summary>
+  uint64_t GetFrameCount() const noexcept;
+
+  /// <summary>
+  /// Returns program counter, index register, timers, stack, registers and
+  /// the disassembled next instruction.
+  /// </summary>
+  std::string FormatRegisters() const;
+
+  /// <summary>
+  /// Returns a hex dump of memory, 16 bytes per line.
+  /// </summary>
+  std::string FormatMemory(uint16_t address, uint16_t size) const;
+
+ private:
+  /// <summary>
+  /// Executes instructions one by one until a stop, until the cpu leaves
+  /// the given stack depth or until the instruction limit is reached.
+  /// </summary>
+  /// <param name="max_instructions">Instruction limit.</param>
+  /// <param name="return_depth">
+  /// Stops once stack pointer drops below this depth, if set.
+  /// </param>
+  template <bool kWatchpoints>
+  Stop Execute(uint64_t max_instructions, std::optional<uint8_t> return_depth);
+
+  /// <summary>
+  /// Dispatches to Execute() with watchpoint checks only if any is set.
+  /// </summary>
+  Stop ExecuteChecked(uint64_t max_instructions,
+                      std::optional<uint8_t> return_depth);
+
+  /// <summary>
+  /// Returns the stop caused by the instruction at program counter, if any.
+  /// </summary>
+  template <bool kWatchpoints>
+  std::optional<Stop> Check() const noexcept;
+
+  /// <summary>
+  /// Returns the watchpoint hit by the instruction at program counter.
+  /// </summary>
+  std::optional<Stop> CheckWatchpoints() const noexcept;
+
+  /// <summary>
+  /// Executes a single instruction and ends the frame after its last cycle.
+  /// </summary>
+  /// <returns>False if the cpu is halted.</returns>
+  bool ExecuteOne();
+
+  core::Cpu& cpu_;
+  size_t cycles_per_frame_;
+
+  /// <summary>
+  /// Cycles of the current frame executed so far.
+  /// </summary>
+  size_t frame_cycle_;
+  uint64_t frames_;
+
+  /// <summary>
+  /// Set bits mark addresses with a breakpoint, conditional or not.
+  /// </summary>
+  std::bitset<4096> breakpoints_;
+
+  /// <summary>
+  /// Set bits mark addresses with an unconditional breakpoint.
+  /// </summary>
+  std::bitset<4096> unconditional_;
+
+  std::vector<std::pair<uint16_t, BreakCondition>> conditions_;
+
+  std::bitset<4096> watch_reads_;
+  std::bitset<4096> watch_writes_;
+
+  /// <summary>
+  /// Program counter of the last stop. Resuming executes that instruction
+  /// without checking it again.
+  /// </summary>
+  std::optional<uint16_t> stopped_at_;
+};
+
+}  // namespace chip8::debug
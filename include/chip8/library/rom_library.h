@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Namespace for cataloguing ROM collections.
+/// </summary>
+namespace chip8::library {
+
+/// <summary>
+/// Platform a ROM was written for.
+/// </summary>
+enum class Platform : uint8_t { kChip8, kSuperChip, kXoChip };
+
+/// <summary>
+/// Behaviours differing from core::Cpu, combined into a quirk profile (see
+/// runtime::MovieHeader::quirks). 0 is the profile the core implements.
+/// </summary>
+enum Quirk : uint32_t {
+  /// <summary>
+  /// 8XY1, 8XY2 and 8XY3 clear VF.
+  /// </summary>
+  kVfReset = 1u << 0,
+
+  /// <summary>
+  /// 8XY6 and 8XYE shift VY into VX instead of shifting VX.
+  /// </summary>
+  kShiftUsesVy = 1u << 1,
+
+  /// <summary>
+  /// FX55 and FX65 leave I unchanged.
+  /// </summary>
+  kMemoryKeepsIndex = 1u << 2,
+
+  /// <summary>
+  /// BXNN jumps to XNN + VX instead of NNN + V0.
+  /// </summary>
+  kJumpWithVx = 1u << 3,
+
+  /// <summary>
+  /// Sprites are clipped at screen edges instead of wrapping.
+  /// </summary>
+  kClipSprites = 1u << 4,
+
+  /// <summary>
+  /// DXYN waits for the next frame.
+  /// </summary>
+  kDisplayWait = 1u << 5,
+};
+
+/// <summary>
+/// Everything known about a ROM, keyed by the hash of its bytes.
+/// </summary>
+struct RomProfile {
+  /// <summary>
+  /// Hash of the ROM (see core::RomImage::GetHash()).
+  /// </summary>
+  uint64_t hash{};
+
+  /// <summary>
+  /// Size of the ROM in bytes.
+  /// </summary>
+  uint32_t size{};
+
+  Platform platform{Platform::kChip8};
+
+  /// <summary>
+  /// Combination of Quirk flags the ROM expects.
+  /// </summary>
+  uint32_t quirks{};
+
+  /// <summary>
+  /// Amount of cycles per frame the ROM runs well at.
+  /// </summary>
+  uint32_t cycles_per_frame{};
+
+  std::string title;
+
+  /// <summary>
+  /// Where the ROM was last found.
+  /// </summary>
+  std::filesystem::path path;
+};
+
+/// <summary>
+/// Result of RomLibrary::Scan().
+/// </summary>
+struct ScanStats {
+  /// <summary>
+  /// ROM files found.
+  /// </summary>
+  size_t files{};
+
+  /// <summary>
+  /// ROMs which were not in the library yet.
+  /// </summary>
+  size_t added{};
+
+  /// <summary>
+  /// Files with the same contents as another file.
+  /// </summary>
+  size_t duplicates{};
+
+  /// <summary>
+  /// Files which could not be read.
+  /// </summary>
+  size_t failed{};
+};
+
+/// <summary>
+/// Returns "CHIP-8", "SCHIP" or "XO-CHIP".
+/// </summary>
+const char* GetPlatformName(Platform platform) noexcept;
+
+/// <summary>
+/// Guesses the platform from instructions reachable from the entry point
+/// (see analysis::RomAnalyzer) and from the size of the ROM.
+/// </summary>
+Platform DetectPlatform(std::span<const uint8_t> rom);
+
+/// <summary>
+/// Returns the quirk profile most ROMs of a platform expect.
+/// </summary>
+uint32_t GetDefaultQuirks(Platform platform) noexcept;
+
+/// <summary>
+/// Returns the speed most ROMs of a platform expect.
+/// </summary>
+uint32_t GetDefaultCyclesPerFrame(Platform platform) noexcept;
+
+/// <summary>
+/// Catalogue of ROMs with a compact on-disk index.
+/// <para>
+/// The index starts with "C8L", a version byte and the amount of ROMs
+/// (32-bit), padded to 16 bytes. 32-byte records sorted by hash follow:
+/// hash (64-bit), size, cycles per frame, quirks, offset of the strings
+/// (32-bit each), title and path length (16-bit each), platform (8-bit) and
+/// 3 reserved bytes. The title and path of every ROM, UTF-8 without
+/// terminators, fill the rest of the file. All integers are little endian.
+/// Lookup() finds a ROM by binary search over the mapped file, without
+/// parsing the index.
+/// </para>
+/// </summary>
+class RomLibrary {
+ public:
+  /// <summary>
+  /// Maps a ROM file, hashes it and detects its platform. Title comes from
+  /// the file name, quirks and speed are the platform defaults.
+  /// </summary>
+  /// <returns>Profile or std::nullopt if the file cannot be read.</returns>
+  static std::optional<RomProfile> Inspect(const std::filesystem::path& path);
+
+  /// <summary>
+  /// Looks up a single ROM in an index file.
+  /// </summary>
+  /// <returns>
+  /// Profile or std::nullopt if the ROM is unknown or the index is missing
+  /// or malformed.
+  /// </returns>
+  static std::optional<RomProfile> Lookup(
+      const std::filesystem::path& index_path, uint64_t hash);
+
+  /// <summary>
+  /// Loads an index written by Save().
+  /// </summary>
+  /// <returns>Library or std::nullopt if the index is malformed.</returns>
+  static std::optional<RomLibrary> Load(const std::filesystem::path& path);
+
+  /// <summary>
+  /// Writes the index, replacing the file at once.
+  /// </summary>
+  bool Save(const std::filesystem::path& path) const;
+
+  /// <summary>
+  /// Inspects every ROM file (.ch8, .c8, .sc8, .xo8) below a directory on
+  /// given amount of threads. Known ROMs keep their profile, only the path
+  /// is updated if the old one no longer exists.
+  /// </summary>
+  ScanStats Scan(const std::filesystem::path& directory,
+                 size_t threads = 1);
+
+  /// <summary>
+  /// Adds a profile or replaces the one with the same hash.
+  /// </summary>
+  void Add(RomProfile profile);
+
+  /// <summary>
+  /// Returns the profile of a ROM, nullptr if unknown.
+  /// </summary>
+  const RomProfile* Find(uint64_t hash) const noexcept;
+
+  /// <summary>
+  /// Returns all profiles sorted by hash.
+  /// </summary>
+  const std::vector<RomProfile>& GetProfiles() const noexcept;
+
+ private:
+  /// <summary>
+  /// Profiles sorted by hash.
+  /// </summary>
+  std::vector<RomProfile> profiles_;
+};
+
+}  // namespace chip8::library
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/core/cycle_rate.h>
+#include <chip8/core/framebuffer.h>
+#include <chip8/runtime/emulator_metrics.h>
+#include <chip8/runtime/netplay.h>
+#include <chip8/utils/histogram.h>
+#include <chip8/utils/spsc_queue.h>
+#include <chip8/utils/triple_buffer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Completed frame published by EmulationThread.
+/// </summary>
+struct PresentedFrame {
+  /// <summary>
+  /// Screen at the end of the frame.
+  /// </summary>
+  core::Framebuffer pixels{};
+
+  /// <summary>
+  /// Sound timer at the end of the frame.
+  /// </summary>
+  uint8_t sound_timer{};
+
+  /// <summary>
+  /// Number of the frame, starting from 1.
+  /// </summary>
+  uint64_t number{};
+};
+
+/// <summary>
+/// Change of a single key state sent to EmulationThread.
+/// </summary>
+struct KeyEvent {
+  uint8_t key{};
+  bool pressed{};
+};
+
+/// <summary>
+/// Runs a Cpu on its own thread at kTimerFrequency frames per second.
+/// Completed frames are published through a lock-free triple buffer and key
+/// events are received through a lock-free queue, so the presenting thread
+/// never blocks on emulation and vice versa.
+/// <para>
+/// While the cpu waits for a key or spins in a jump to itself (see
+/// core::IdleState) with both timers stopped, or is halted by a stack
+/// error, the thread sleeps until a key event or Stop() arrives.
+/// </para>
+/// </summary>
+class EmulationThread {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// <summary>
+  /// Prepares the thread. The cpu must not be touched by anybody else
+  /// between Start() and Stop().
+  /// </summary>
+  /// <param name="on_publish">
+  /// Called on the emulation thread after every published frame, e.g. to
+  /// wake up the presenting thread.
+  /// </param>
+  EmulationThread(core::Cpu& cpu, core::CycleRate cycle_rate,
+                  Clock::duration frame_duration =
+                      std::chrono::duration_cast<Clock::duration>(
+                          std::chrono::seconds{1}) /
+                      core::kTimerFrequency,
+                  std::function<void()> on_publish = {});
+
+  EmulationThread(const EmulationThread&) = delete;
+  EmulationThread& operator=(const EmulationThread&) = delete;
+
+  /// <summary>
+  /// Stops the thread.
+  /// </summary>
+  ~EmulationThread() noexcept;
+
+  /// <summary>
+  /// Reports emulation health to given metrics, nullptr disables reporting.
+  /// Must be called before Start().
+  /// </summary>
+  void SetMetrics(EmulatorMetrics* metrics) noexcept;
+
+  /// <summary>
+  /// Runs frames through a netplay session instead of the cpu directly, so
+  /// key events become the input of the local player. nullptr runs the cpu
+  /// alone. Must be called before Start().
+  /// </summary>
+  void SetNetplay(Netplay* netplay) noexcept;
+
+  /// <summary>
+  /// Starts emulation.
+  /// </summary>
+  void Start();
+
+  /// <summary>
+  /// Stops emulation and waits for the thread to finish.
+  /// </summary>
+  void Stop() noexcept;
+
+  /// <summary>
+  /// Queues a key event. Must be called from a single thread.
+  /// </summary>
+  /// <returns>False if the queue is full and the event was dropped.</returns>
+  bool PushKey(uint8_t key, bool pressed) noexcept;
+
+  /// <summary>
+  /// Picks up the newest published frame. Must be called from a single
+  /// thread.
+  /// </summary>
+  /// <returns>True if a new frame is available in GetFrame().</returns>
+  bool Update() noexcept;
+
+  /// <summary>
+  /// Returns the frame picked up by the last Update() call.
+  /// </summary>
+  const PresentedFrame& GetFrame() const noexcept;
+
+  /// <summary>
+  /// Returns time spent emulating every frame. Safe to read after Stop().
+  /// </summary>
+  const utils::Histogram& GetFrameTimes() const noexcept;
+
+  /// <summary>
+  /// Returns amount of key events dropped because the queue was full.
+  /// </summary>
+  uint64_t GetDroppedKeyCount() const noexcept;
+
+ private:
+  /// <summary>
+  /// Body of the emulation thread.
+  /// </summary>
+  void Run() noexcept;
+
+  /// <summary>
+  /// Applies queued key events to the cpu, or to the local input of the
+  /// netplay session.
+  /// </summary>
+  void ApplyKeys() noexcept;
+
+  /// <summary>
+  /// Returns true if no frame can change the cpu until a key event arrives.
+  /// </summary>
+  bool IsStalled() const noexcept;
+
+  /// <summary>
+  /// Reports a finished frame to metrics_.
+  /// </summary>
+  /// <param name="executed">Instructions executed during the frame.</param>
+  /// <param name="frame_time">Time spent emulating the frame.</param>
+  void UpdateMetrics(size_t executed, Clock::duration frame_time) noexcept;
+
+  core::Cpu& cpu_;
+  core::CycleRate cycle_rate_;
+  Clock::duration frame_duration_;
+  std::function<void()> on_publish_;
+
+  /// <summary>
+  /// Frames passed to the presenting thread.
+  /// </summary>
+  utils::TripleBuffer<PresentedFrame> frames_;
+
+  /// <summary>
+  /// Key events passed to the emulation thread.
+  /// </summary>
+  utils::SpscQueue<KeyEvent, 64> keys_;
+
+  /// <summary>
+  /// Incremented on every pushed key event and on Stop(), waited on while
+  /// the cpu waits for a key.
+  /// </summary>
+  std::atomic<uint32_t> wakeups_;
+
+  std::atomic<bool> running_;
+  uint64_t dropped_keys_;
+  utils::Histogram frame_times_;
+  EmulatorMetrics* metrics_;
+  Netplay* netplay_;
+
+  /// <summary>
+  /// Keys held by the local player during netplay.
+  /// </summary>
+  uint16_t local_keys_;
+
+  /// <summary>
+  /// Cpu counters seen by the last UpdateMetrics() call.
+  /// </summary>
+  uint64_t reported_unknown_opcodes_;
+  bool reported_halt_;
+
+  /// <summary>
+  /// Start and instruction count of the current instructions per second
+  /// window.
+  /// </summary>
+  Clock::time_point rate_start_;
+  uint64_t rate_instructions_;
+  std::thread thread_;
+};
+
+}  // namespace chip8::runtime
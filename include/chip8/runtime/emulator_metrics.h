@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chip8/utils/metrics.h>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Health metrics of a running emulator, registered in a MetricsRegistry.
+/// EmulationThread updates the emulation side once per frame and the
+/// presenting thread updates the presentation side, so the cost is a few
+/// relaxed atomic additions per frame.
+/// </summary>
+struct EmulatorMetrics {
+  explicit EmulatorMetrics(utils::MetricsRegistry& registry);
+
+  /// <summary>
+  /// Instructions interpreted by the cpu, fast-forwarded idle cycles are
+  /// not counted.
+  /// </summary>
+  utils::Counter& instructions;
+
+  /// <summary>
+  /// Instructions per second over the last second of emulation.
+  /// </summary>
+  utils::Gauge& instructions_per_second;
+
+  /// <summary>
+  /// Frames emulated and published.
+  /// </summary>
+  utils::Counter& frames_emulated;
+
+  /// <summary>
+  /// Frames shown by the presenting thread.
+  /// </summary>
+  utils::Counter& frames_presented;
+
+  /// <summary>
+  /// Published frames overwritten before the presenting thread picked them
+  /// up.
+  /// </summary>
+  utils::Counter& frames_skipped;
+
+  /// <summary>
+  /// Time spent emulating every frame.
+  /// </summary>
+  utils::MetricHistogram& frame_time;
+
+  /// <summary>
+  /// Bytes of audio queued for playback.
+  /// </summary>
+  utils::Gauge& audio_queue_bytes;
+
+  /// <summary>
+  /// Unknown opcodes executed by the cpu.
+  /// </summary>
+  utils::Counter& unknown_opcodes;
+
+  /// <summary>
+  /// Stack errors which halted the cpu.
+  /// </summary>
+  utils::Counter& critical_errors;
+};
+
+}  // namespace chip8::runtime
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/core/framebuffer.h>
+#include <chip8/core/rom_image.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+using core::Framebuffer;
+
+/// <summary>
+/// Computes reward of a step from values of watched memory addresses before
+/// and after it.
+/// </summary>
+using RewardFn = std::function<float(std::span<const uint8_t> before,
+                                     std::span<const uint8_t> after)>;
+
+/// <summary>
+/// Decides from values of watched memory addresses whether episode ended.
+/// </summary>
+using TerminalFn = std::function<bool(std::span<const uint8_t> values)>;
+
+/// <summary>
+/// Settings of an environment.
+/// </summary>
+struct EnvironmentConfig {
+  /// <summary>
+  /// Amount of cycles executed in every frame.
+  /// </summary>
+  size_t cycles_per_frame{10};
+
+  /// <summary>
+  /// Amount of frames executed by every step with the same action.
+  /// </summary>
+  size_t frame_skip{4};
+
+  /// <summary>
+  /// Episode is truncated after this many frames, 0 means never.
+  /// </summary>
+  uint64_t max_episode_frames{};
+
+  /// <summary>
+  /// Memory addresses passed to reward and terminal hooks, e.g. score and
+  /// lives counters of a game.
+  /// </summary>
+  std::vector<uint16_t> watched_addresses;
+
+  /// <summary>
+  /// Reward hook. Reward is 0 if not set.
+  /// </summary>
+  RewardFn reward;
+
+  /// <summary>
+  /// Terminal hook. Without it episodes only end by truncation, or when a
+  /// stack error halts the cpu.
+  /// </summary>
+  TerminalFn terminal;
+};
+
+/// <summary>
+/// Result of a single step. Observation is read with
+/// Environment::GetObservation().
+/// </summary>
+struct StepResult {
+  float reward{};
+  bool terminated{};
+  bool truncated{};
+};
+
+/// <summary>
+/// Headless, Gym-style environment running a single ROM.
+/// <para>
+/// Action is a bitmask of pressed keys: bit N holds key N. Observation is
+/// the screen packed to a Framebuffer, written in place after every Reset()
+/// and Step() so it can be read without copying.
+/// </para>
+/// </summary>
+class Environment {
+ public:
+  /// <summary>
+  /// Creates an environment. Reset() must be called before the first step.
+  /// </summary>
+  /// <param name="rom">ROM shared between environments.</param>
+  /// <param name="config">Environment settings.</param>
+  /// <param name="observation">
+  /// Where observations are written, e.g. a slot of a batch buffer. If
+  /// nullptr, environment uses its own buffer.
+  /// </param>
+  Environment(std::shared_ptr<const core::RomImage> rom,
+              EnvironmentConfig config, Framebuffer* observation = nullptr);
+
+  Environment(const Environment&) = delete;
+  Environment& operator=(const Environment&) = delete;
+
+  /// <summary>
+  /// Starts a new episode: resets the cpu, seeds its RNG and loads the ROM.
+  /// </summary>
+  /// <returns>First observation.</returns>
+  const Framebuffer& Reset(unsigned int seed) noexcept;
+
+  /// <summary>
+  /// Holds given keys down for frame_skip frames.
+  /// </summary>
+  /// <param name="action">Bitmask of pressed keys.</param>
+  StepResult Step(uint16_t action);
+
+  /// <summary>
+  /// Returns the latest observation.
+  /// </summary>
+  const Framebuffer& GetObservation() const noexcept;
+
+  /// <summary>
+  /// Returns amount of frames emulated in the current episode.
+  /// </summary>
+  uint64_t GetEpisodeFrames() const noexcept;
+
+  /// <summary>
+  /// Returns the emulated cpu.
+  /// </summary>
+  const core::Cpu& GetCpu() const noexcept;
+
+ private:
+  /// <summary>
+  /// Reads watched addresses into given buffer.
+  /// </summary>
+  void ReadWatched(std::vector<uint8_t>& out) const noexcept;
+
+  /// <summary>
+  /// Shared ROM image.
+  /// </summary>
+  std::shared_ptr<const core::RomImage> rom_;
+
+  /// <summary>
+  /// Environment settings.
+  /// </summary>
+  EnvironmentConfig config_;
+
+  /// <summary>
+  /// Emulated cpu.
+  /// </summary>
+  core::Cpu cpu_;
+
+  /// <summary>
+  /// Own observation buffer, used if no external one was given.
+  /// </summary>
+  Framebuffer own_observation_;
+
+  /// <summary>
+  /// Where observations are written.
+  /// </summary>
+  Framebuffer* observation_;
+
+  /// <summary>
+  /// Values of watched addresses before and after the current step.
+  /// </summary>
+  std::vector<uint8_t> before_;
+  std::vector<uint8_t> after_;
+
+  /// <summary>
+  /// Frames emulated in the current episode.
+  /// </summary>
+  uint64_t episode_frames_;
+};
+
+}  // namespace chip8::runtime
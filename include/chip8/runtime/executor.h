@@ -0,0 +1,278 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/runtime/session_task.h>
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Settings of a single session.
+/// </summary>
+struct SessionConfig {
+  /// <summary>
+  /// Amount of cycles executed in every frame.
+  /// </summary>
+  size_t cycles_per_frame{10};
+
+  /// <summary>
+  /// Session finishes after this many frames, 0 means never.
+  /// </summary>
+  uint64_t max_frames{};
+
+  /// <summary>
+  /// Called after every emulated frame, e.g. to send the screen to a client.
+  /// </summary>
+  std::function<void(const core::Cpu&)> on_frame;
+};
+
+/// <summary>
+/// Scheduling statistics of a single session.
+/// </summary>
+struct SessionStats {
+  /// <summary>
+  /// Amount of emulated frames.
+  /// </summary>
+  uint64_t frames{};
+
+  /// <summary>
+  /// Amount of times session suspended waiting for a key (FX0A).
+  /// </summary>
+  uint64_t key_waits{};
+
+  /// <summary>
+  /// Amount of frames fast-forwarded through an idle loop (see
+  /// core::IdleState).
+  /// </summary>
+  uint64_t idle_frames{};
+
+  /// <summary>
+  /// Amount of frames resumed a whole frame or more after their deadline.
+  /// Deadlines are moved forward after every miss.
+  /// </summary>
+  uint64_t deadline_misses{};
+
+  /// <summary>
+  /// Largest delay between a deadline and resuming the session.
+  /// </summary>
+  std::chrono::nanoseconds max_lateness{};
+
+  /// <summary>
+  /// Time spent by the executor between waking up and resuming the session.
+  /// </summary>
+  std::chrono::nanoseconds scheduling_overhead{};
+
+  /// <summary>
+  /// Time spent emulating frames, including on_frame callbacks.
+  /// </summary>
+  std::chrono::nanoseconds emulation_time{};
+
+  /// <summary>
+  /// Stack error which halted the cpu and finished the session, if any.
+  /// </summary>
+  core::CritErrors error{core::CritErrors::kNone};
+};
+
+/// <summary>
+/// Single threaded executor hosting many emulator sessions, each running as
+/// a coroutine.
+/// <para>
+/// A session emulates one frame per kTimerFrequency tick and suspends until
+/// the next frame deadline. Idle timer polls are already fast-forwarded by
+/// Cpu::RunFrame(), so they cost a single resume per frame. Sessions blocked
+/// on FX0A with both timers stopped are not resumed at all until SetKey()
+/// presses a key. Sessions are resumed in deadline order. A session finishes
+/// when its cpu halts on a stack error.
+/// </para>
+/// </summary>
+class Executor {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// <summary>
+  /// Creates an executor.
+  /// </summary>
+  /// <param name="real_time">
+  /// If false, time is simulated: instead of sleeping until a deadline the
+  /// executor jumps to it. Useful for tests and batch runs.
+  /// </param>
+  /// <param name="frame_duration">Time between frames of a session.</param>
+  explicit Executor(bool real_time = true,
+                    Clock::duration frame_duration =
+                        std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::seconds{1}) /
+                        core::kTimerFrequency);
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  /// <summary>
+  /// Adds a session which starts at the current time. The cpu is not owned
+  /// and must outlive the session.
+  /// </summary>
+  /// <returns>Identifier of the session.</returns>
+  size_t Spawn(core::Cpu& cpu, SessionConfig config);
+
+  /// <summary>
+  /// Updates a key of a session, waking it up if it waits for a key press.
+  /// </summary>
+  void SetKey(size_t session, uint8_t key, bool pressed);
+
+  /// <summary>
+  /// Asks a session to finish. It exits the next time it is resumed.
+  /// </summary>
+  void Stop(size_t session);
+
+  /// <summary>
+  /// Resumes sessions until none is scheduled. Sessions waiting for keys are
+  /// left suspended.
+  /// </summary>
+  void Run();
+
+  /// <summary>
+  /// Resumes sessions whose deadlines are not later than given time.
+  /// </summary>
+  void RunUntil(Clock::time_point end);
+
+  /// <summary>
+  /// Returns current time: real or simulated.
+  /// </summary>
+  Clock::time_point Now() const noexcept;
+
+  /// <summary>
+  /// Returns true if session has finished.
+  /// </summary>
+  bool IsFinished(size_t session) const noexcept;
+
+  /// <summary>
+  /// Returns true if session is suspended waiting for a key press.
+  /// </summary>
+  bool IsWaitingForKey(size_t session) const noexcept;
+
+  /// <summary>
+  /// Returns scheduling statistics of a session.
+  /// </summary>
+  const SessionStats& GetStats(size_t session) const noexcept;
+
+  /// <summary>
+  /// Returns amount of sessions which have not finished yet.
+  /// </summary>
+  size_t GetActiveCount() const noexcept;
+
+ private:
+  /// <summary>
+  /// State of a hosted session.
+  /// </summary>
+  struct Session {
+    size_t id;
+    core::Cpu* cpu;
+    SessionConfig config;
+    SessionStats stats;
+    SessionTask task;
+    Clock::time_point deadline;
+    bool waiting_for_key;
+    bool stop_requested;
+    bool finished;
+  };
+
+  /// <summary>
+  /// Entry of the run queue.
+  /// </summary>
+  struct Scheduled {
+    Clock::time_point deadline;
+    uint64_t sequence;
+    size_t session;
+
+    bool operator>(const Scheduled& other) const noexcept {
+      return deadline != other.deadline ? deadline > other.deadline
+                                        : sequence > other.sequence;
+    }
+  };
+
+  /// <summary>
+  /// Suspends a session until its next frame deadline.
+  /// </summary>
+  struct FrameAwaiter {
+    Executor* executor;
+    Session* session;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<>) const;
+    void await_resume() const noexcept {}
+  };
+
+  /// <summary>
+  /// Suspends a session until a key is pressed or it is stopped.
+  /// </summary>
+  struct KeyAwaiter {
+    Session* session;
+
+    bool await_ready() const noexcept;
+    void await_suspend(std::coroutine_handle<>) const noexcept;
+    void await_resume() const noexcept {}
+  };
+
+  /// <summary>
+  /// Body of every session coroutine.
+  /// </summary>
+  SessionTask RunSession(Session& session);
+
+  /// <summary>
+  /// Queues a session to be resumed at its deadline.
+  /// </summary>
+  void Schedule(Session& session);
+
+  /// <summary>
+  /// Returns true if cpu is blocked on FX0A and timers have nothing to do.
+  /// </summary>
+  static bool IsBlockedOnKey(const core::Cpu& cpu) noexcept;
+
+  /// <summary>
+  /// True if executor sleeps until deadlines, false if time is simulated.
+  /// </summary>
+  bool real_time_;
+
+  /// <summary>
+  /// Time between frames of a session.
+  /// </summary>
+  Clock::duration frame_duration_;
+
+  /// <summary>
+  /// Simulated time, used when real_time_ is false.
+  /// </summary>
+  Clock::time_point simulated_now_;
+
+  /// <summary>
+  /// Counter keeping queue order stable for equal deadlines.
+  /// </summary>
+  uint64_t sequence_;
+
+  /// <summary>
+  /// Amount of sessions which have not finished yet.
+  /// </summary>
+  size_t active_;
+
+  /// <summary>
+  /// Hosted sessions, indexed by identifier.
+  /// </summary>
+  std::vector<std::unique_ptr<Session>> sessions_;
+
+  /// <summary>
+  /// Sessions waiting for their deadlines, earliest first.
+  /// </summary>
+  std::priority_queue<Scheduled, std::vector<Scheduled>, std::greater<>>
+      queue_;
+};
+
+}  // namespace chip8::runtime
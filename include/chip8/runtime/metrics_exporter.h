@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chip8/utils/metrics.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <thread>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Settings of MetricsExporter. Every output is optional.
+/// </summary>
+struct MetricsExporterConfig {
+  /// <summary>
+  /// Port of the HTTP endpoint on 127.0.0.1, 0 picks a free one. No
+  /// endpoint is served if empty.
+  /// </summary>
+  std::optional<uint16_t> http_port;
+
+  /// <summary>
+  /// File periodically replaced with a JSON dump. No dump is written if
+  /// empty.
+  /// </summary>
+  std::filesystem::path json_path;
+
+  /// <summary>
+  /// Time between JSON dumps.
+  /// </summary>
+  std::chrono::milliseconds json_interval{5000};
+};
+
+/// <summary>
+/// Publishes a MetricsRegistry from a background thread: serves
+/// GET /metrics (Prometheus text format) and GET /metrics.json over HTTP on
+/// the loopback interface, and rewrites a JSON dump file periodically and
+/// on Stop(). Rendering happens on the exporter thread only, so emulation
+/// never waits for a scrape.
+/// </summary>
+class MetricsExporter {
+ public:
+  /// <summary>
+  /// Opens the endpoint and starts the thread. The registry must outlive
+  /// the exporter.
+  /// </summary>
+  /// <returns>Exporter or nullptr if the port cannot be bound.</returns>
+  static std::unique_ptr<MetricsExporter> Start(
+      const utils::MetricsRegistry& registry, MetricsExporterConfig config);
+
+  MetricsExporter(const MetricsExporter&) = delete;
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+  /// <summary>
+  /// Stops the thread.
+  /// </summary>
+  ~MetricsExporter() noexcept;
+
+  /// <summary>
+  /// Stops the thread, closes the endpoint and writes the final JSON dump.
+  /// </summary>
+  void Stop() noexcept;
+
+  /// <summary>
+  /// Returns the port the endpoint listens on, 0 if there is none.
+  /// </summary>
+  uint16_t GetPort() const noexcept;
+
+ private:
+  /// <summary>
+  /// Platform socket handle, wide enough for both POSIX and Winsock.
+  /// </summary>
+  using Socket = intptr_t;
+
+  MetricsExporter(const utils::MetricsRegistry& registry,
+                  MetricsExporterConfig config, Socket listener,
+                  uint16_t port) noexcept;
+
+  /// <summary>
+  /// Body of the exporter thread.
+  /// </summary>
+  void Run() noexcept;
+
+  /// <summary>
+  /// Answers a single HTTP request and closes the connection.
+  /// </summary>
+  void Serve(Socket client) const noexcept;
+
+  /// <summary>
+  /// Replaces the JSON dump file, going through a temporary file so readers
+  /// never see a partial dump.
+  /// </summary>
+  void DumpJson() const noexcept;
+
+  const utils::MetricsRegistry& registry_;
+  MetricsExporterConfig config_;
+
+  /// <summary>
+  /// Listening socket, -1 if there is no endpoint.
+  /// </summary>
+  Socket listener_;
+  uint16_t port_;
+  std::atomic<bool> running_;
+  std::thread thread_;
+};
+
+}  // namespace chip8::runtime
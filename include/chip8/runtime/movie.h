@@ -0,0 +1,225 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/core/rom_image.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Everything besides inputs that decides how a recorded run behaves.
+/// </summary>
+struct MovieHeader {
+  /// <summary>
+  /// Hash of the ROM (see core::RomImage::GetHash()).
+  /// </summary>
+  uint64_t rom_hash{};
+
+  /// <summary>
+  /// Seed passed to Cpu::SeedRNG() before the first frame.
+  /// </summary>
+  uint32_t seed{};
+
+  /// <summary>
+  /// Amount of cycles passed to Cpu::RunFrame().
+  /// </summary>
+  uint32_t cycles_per_frame{10};
+
+  /// <summary>
+  /// Quirk profile of the interpreter. The core implements a single set of
+  /// behaviours, so 0 is the only supported value.
+  /// </summary>
+  uint32_t quirks{};
+};
+
+/// <summary>
+/// Streams inputs of a run into a .c8m movie.
+/// <para>
+/// The file starts with "C8M", a version byte and the MovieHeader fields as
+/// little endian integers. Every change of the key mask is stored as the
+/// amount of frames the previous mask was held (LEB128) followed by the XOR
+/// of both masks (16-bit little endian). A record with XOR 0 ends the
+/// movie and is followed by the amount of frames (LEB128) and the state
+/// hash after the last frame (64-bit little endian). Movies cut short by a
+/// crash can still be replayed up to the last flushed record.
+/// </para>
+/// </summary>
+class MovieWriter {
+ public:
+  /// <summary>
+  /// Creates the file and writes the header.
+  /// </summary>
+  /// <returns>Writer or nullptr if the file cannot be created.</returns>
+  static std::unique_ptr<MovieWriter> Open(const std::filesystem::path& path,
+                                           const MovieHeader& header);
+
+  /// <summary>
+  /// Closes the movie without a state hash.
+  /// </summary>
+  ~MovieWriter() noexcept;
+
+  /// <summary>
+  /// Adds keys held during the next frame. When called from
+  /// Cpu::SetFrameCallback(), pass Cpu::GetKeyMask(): keys only change
+  /// between frames, so they are still the ones the frame ran with.
+  /// </summary>
+  void AddFrame(uint16_t keys) noexcept;
+
+  /// <summary>
+  /// Writes the end of the movie and closes the file.
+  /// </summary>
+  /// <param name="state_hash">
+  /// Cpu::GetStateHash() after the last frame, checked by replays. 0 skips
+  /// the check.
+  /// </param>
+  /// <returns>False if any write failed.</returns>
+  bool Close(uint64_t state_hash = 0) noexcept;
+
+  /// <summary>
+  /// Returns amount of added frames.
+  /// </summary>
+  uint64_t GetFrameCount() const noexcept;
+
+ private:
+  explicit MovieWriter(std::ofstream out_stream);
+
+  /// <summary>
+  /// Writes a record: frames held with the current mask and XOR to the next
+  /// one.
+  /// </summary>
+  void WriteRecord(uint64_t frames, uint16_t delta) noexcept;
+
+  std::ofstream out_stream_;
+
+  /// <summary>
+  /// Mask of the frames counted by held_.
+  /// </summary>
+  uint16_t keys_;
+
+  /// <summary>
+  /// Frames added with the current mask and not written yet.
+  /// </summary>
+  uint64_t held_;
+
+  uint64_t frames_;
+};
+
+/// <summary>
+/// Reads a .c8m movie written by MovieWriter frame by frame.
+/// </summary>
+class MovieReader {
+ public:
+  /// <summary>
+  /// Opens the file and reads the header.
+  /// </summary>
+  /// <returns>Reader or nullptr if the file is not a supported movie.</returns>
+  static std::unique_ptr<MovieReader> Open(const std::filesystem::path& path);
+
+  /// <summary>
+  /// Returns settings of the recorded run.
+  /// </summary>
+  const MovieHeader& GetHeader() const noexcept;
+
+  /// <summary>
+  /// Returns keys held during the next frame.
+  /// </summary>
+  /// <returns>Key mask or std::nullopt after the last frame.</returns>
+  std::optional<uint16_t> NextFrame() noexcept;
+
+  /// <summary>
+  /// Returns amount of frames returned by NextFrame().
+  /// </summary>
+  uint64_t GetFrameCount() const noexcept;
+
+  /// <summary>
+  /// Returns true once the end of a movie which was closed properly was
+  /// read.
+  /// </summary>
+  bool IsComplete() const noexcept;
+
+  /// <summary>
+  /// Returns state hash stored at the end of the movie, 0 if there is none.
+  /// </summary>
+  uint64_t GetStateHash() const noexcept;
+
+ private:
+  MovieReader(std::ifstream in_stream, const MovieHeader& header);
+
+  /// <summary>
+  /// Applies the previous record and reads the next one.
+  /// </summary>
+  /// <returns>False if the movie is cut short.</returns>
+  bool ReadRecord() noexcept;
+
+  std::ifstream in_stream_;
+  MovieHeader header_;
+  uint16_t keys_;
+
+  /// <summary>
+  /// XOR applied to keys_ once remaining_ frames are returned.
+  /// </summary>
+  uint16_t next_delta_;
+
+  /// <summary>
+  /// Frames left with the current mask.
+  /// </summary>
+  uint64_t remaining_;
+
+  uint64_t frames_;
+  bool last_record_;
+  bool complete_;
+  uint64_t state_hash_;
+};
+
+/// <summary>
+/// Result of Replay().
+/// </summary>
+struct ReplayResult {
+  /// <summary>
+  /// Amount of replayed frames.
+  /// </summary>
+  uint64_t frames{};
+
+  /// <summary>
+  /// Cpu::GetStateHash() after the last frame.
+  /// </summary>
+  uint64_t state_hash{};
+
+  /// <summary>
+  /// True if the whole movie was replayed.
+  /// </summary>
+  bool complete{};
+
+  /// <summary>
+  /// True if the movie was complete and stored state hash equals
+  /// state_hash.
+  /// </summary>
+  bool matched{};
+};
+
+/// <summary>
+/// Resets the cpu, loads the ROM and runs every frame of the movie as fast
+/// as possible.
+/// </summary>
+/// <param name="on_frame">
+/// Optional frame callback set after the reset, e.g. to record video of the
+/// replay.
+/// </param>
+/// <returns>
+/// Result or std::nullopt if the movie was recorded with another ROM or
+/// quirk profile.
+/// </returns>
+std::optional<ReplayResult> Replay(const core::RomImage& rom,
+                                   MovieReader& movie, core::Cpu& cpu,
+                                   core::Cpu::FrameCallback on_frame = {});
+
+}  // namespace chip8::runtime
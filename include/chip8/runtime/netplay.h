@@ -0,0 +1,149 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/runtime/rollback.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Settings of a Netplay connection.
+/// </summary>
+struct NetplayConfig {
+  /// <summary>
+  /// UDP port to receive on, 0 picks a free one.
+  /// </summary>
+  uint16_t local_port{};
+
+  /// <summary>
+  /// IPv4 host of the other player. Empty waits for the other player and
+  /// replies to whoever sends input first.
+  /// </summary>
+  std::string remote_host;
+
+  uint16_t remote_port{};
+
+  /// <summary>
+  /// Hash of the loaded ROM (see core::RomImage::GetHash()). Players with
+  /// another ROM or another RollbackConfig::cycles_per_frame are rejected.
+  /// </summary>
+  uint64_t rom_hash{};
+
+  RollbackConfig rollback;
+};
+
+/// <summary>
+/// Two-player session exchanging input over UDP, with rollbacks hiding the
+/// latency (see RollbackSession).
+/// <para>
+/// Every frame sends the local input of the last frames to the other player
+/// in one datagram: "C8N", a version byte, the ROM hash (64-bit little
+/// endian), cycles per frame (32-bit), the first frame (64-bit), the amount
+/// of inputs (8-bit) and the key masks (16-bit). Datagrams of a player
+/// running another ROM or speed would desync the session, so they are
+/// dropped and reported. Resending the whole rollback window twice over makes lost and
+/// reordered datagrams harmless, without acknowledgements.
+/// </para>
+/// </summary>
+class Netplay {
+ public:
+  /// <summary>
+  /// Opens the socket. Both players must load the same ROM and seed the RNG
+  /// of their cpus the same way before the first frame.
+  /// </summary>
+  /// <param name="cpu">Cpu to run, must outlive the session.</param>
+  /// <returns>Session or nullptr if the socket cannot be opened.</returns>
+  static std::unique_ptr<Netplay> Open(core::Cpu& cpu, NetplayConfig config);
+
+  Netplay(const Netplay&) = delete;
+  Netplay& operator=(const Netplay&) = delete;
+
+  /// <summary>
+  /// Closes the socket.
+  /// </summary>
+  ~Netplay() noexcept;
+
+  /// <summary>
+  /// Exchanges input and runs the next frame.
+  /// </summary>
+  /// <returns>
+  /// Amount of executed cycles, or std::nullopt while waiting for the other
+  /// player.
+  /// </returns>
+  std::optional<size_t> RunFrame(uint16_t local_keys);
+
+  /// <summary>
+  /// Exchanges input and applies rollbacks without running a new frame.
+  /// </summary>
+  void Poll();
+
+  /// <summary>
+  /// Returns the bound UDP port.
+  /// </summary>
+  uint16_t GetPort() const noexcept;
+
+  /// <summary>
+  /// Returns true once input of the other player has arrived.
+  /// </summary>
+  bool IsConnected() const noexcept;
+
+  /// <summary>
+  /// Returns true if the other player runs another ROM or speed. Its input
+  /// is ignored, so the session stalls instead of desyncing.
+  /// </summary>
+  bool IsMismatched() const noexcept;
+
+  const RollbackSession& GetSession() const noexcept;
+
+ private:
+  using Socket = intptr_t;
+
+  Netplay(core::Cpu& cpu, const NetplayConfig& config, Socket socket,
+          uint16_t port, uint32_t remote_ip);
+
+  /// <summary>
+  /// Feeds every datagram waiting in the socket to the session.
+  /// </summary>
+  void Receive() noexcept;
+
+  /// <summary>
+  /// Sends recent local input to the other player, if known.
+  /// </summary>
+  void Send() noexcept;
+
+  /// <summary>
+  /// Sends local input of count frames starting with first_frame.
+  /// </summary>
+  void SendTo(uint32_t ip, uint16_t port, uint64_t first_frame,
+              size_t count) noexcept;
+
+  RollbackSession session_;
+  Socket socket_;
+  uint16_t port_;
+
+  /// <summary>
+  /// IPv4 address and port of the other player in host byte order, 0 until
+  /// known.
+  /// </summary>
+  uint32_t remote_ip_;
+  uint16_t remote_port_;
+
+  /// <summary>
+  /// Sent in every datagram and checked in received ones.
+  /// </summary>
+  uint64_t rom_hash_;
+  uint32_t cycles_per_frame_;
+
+  bool connected_;
+  bool mismatched_;
+};
+
+}  // namespace chip8::runtime
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/utils/histogram.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Settings of a RollbackSession.
+/// </summary>
+struct RollbackConfig {
+  /// <summary>
+  /// Amount of cycles in every frame.
+  /// </summary>
+  size_t cycles_per_frame{10};
+
+  /// <summary>
+  /// Keys owned by the local player, bit N for key N. The remaining keys
+  /// come from the remote player.
+  /// </summary>
+  uint16_t local_keys{0x0FFF};
+
+  /// <summary>
+  /// Most frames the session runs ahead of confirmed remote input, which is
+  /// also the deepest possible rollback.
+  /// </summary>
+  size_t max_rollback{8};
+};
+
+/// <summary>
+/// Counters of a RollbackSession.
+/// </summary>
+struct RollbackStats {
+  /// <summary>
+  /// Amount of frames advanced, not counting re-simulated ones.
+  /// </summary>
+  uint64_t frames{};
+
+  /// <summary>
+  /// Amount of mispredicted remote inputs which caused a rollback.
+  /// </summary>
+  uint64_t rollbacks{};
+
+  uint64_t resimulated_frames{};
+
+  /// <summary>
+  /// Amount of AdvanceFrame() calls refused while waiting for the remote
+  /// player.
+  /// </summary>
+  uint64_t stalls{};
+
+  /// <summary>
+  /// Amount of frames re-simulated by the latest and the deepest rollback.
+  /// </summary>
+  size_t last_depth{};
+  size_t max_depth{};
+
+  /// <summary>
+  /// Time spent restoring a snapshot and re-simulating, per rollback.
+  /// </summary>
+  utils::Histogram resimulation_times;
+};
+
+/// <summary>
+/// Runs a cpu shared by a local and a remote player without waiting for
+/// remote input. Missing remote input is predicted to repeat the last known
+/// one. When the real input turns out different, the cpu is restored from
+/// the snapshot taken before the mispredicted frame and the frames since are
+/// simulated again with corrected input.
+/// <para>
+/// Snapshots hold the architectural state and RNG of the cpu (see
+/// core::CpuSnapshot), one per frame in a ring covering the rollback window.
+/// The frame callback of the cpu also runs for
+/// re-simulated frames. Both players must start from the same state, with
+/// the same RNG seed. The session only tracks input; exchanging it is up to
+/// the caller (see Netplay).
+/// </para>
+/// </summary>
+class RollbackSession {
+ public:
+  /// <summary>
+  /// Attaches to a cpu which must outlive the session.
+  /// </summary>
+  RollbackSession(core::Cpu& cpu, RollbackConfig config);
+
+  /// <summary>
+  /// Rolls back if needed, then runs the next frame with given local keys.
+  /// </summary>
+  /// <param name="local_keys">
+  /// Key mask of the local player, keys it does not own are ignored.
+  /// </param>
+  /// <returns>
+  /// Amount of executed cycles, or std::nullopt if the session is already
+  /// RollbackConfig::max_rollback frames ahead of remote input and nothing
+  /// was run.
+  /// </returns>
+  std::optional<size_t> AdvanceFrame(uint16_t local_keys);
+
+  /// <summary>
+  /// Records remote input of a frame. Inputs may arrive repeatedly and out
+  /// of order; inputs already confirmed or too far ahead are ignored.
+  /// </summary>
+  void AddRemoteInput(uint64_t frame, uint16_t keys) noexcept;
+
+  /// <summary>
+  /// Applies a rollback caused by remote input added since the last frame,
+  /// so the cpu reflects every known input. AdvanceFrame() does this first.
+  /// </summary>
+  void Synchronize();
+
+  /// <summary>
+  /// Returns amount of frames run.
+  /// </summary>
+  uint64_t GetFrame() const noexcept;
+
+  /// <summary>
+  /// Returns amount of frames whose remote input is known, counted from the
+  /// first frame without gaps.
+  /// </summary>
+  uint64_t GetConfirmedFrame() const noexcept;
+
+  /// <summary>
+  /// Returns local keys a frame was run with. Only the last
+  /// GetHistorySize() frames are available.
+  /// </summary>
+  uint16_t GetLocalInput(uint64_t frame) const noexcept;
+
+  /// <summary>
+  /// Returns amount of recent frames kept for rollbacks and resending.
+  /// </summary>
+  size_t GetHistorySize() const noexcept;
+
+  const RollbackStats& GetStats() const noexcept;
+
+ private:
+  /// <summary>
+  /// Everything needed to run a frame again.
+  /// </summary>
+  struct Slot {
+    uint64_t frame;
+
+    /// <summary>
+    /// Cpu state before the frame.
+    /// </summary>
+    core::CpuSnapshot state;
+
+    uint16_t local_keys;
+
+    /// <summary>
+    /// Remote keys the frame was run with, predicted or confirmed.
+    /// </summary>
+    uint16_t remote_keys;
+  };
+
+  /// <summary>
+  /// Remote input received for a frame.
+  /// </summary>
+  struct RemoteInput {
+    uint64_t frame;
+    uint16_t keys;
+  };
+
+  /// <summary>
+  /// Returns the remote keys for a frame, predicted if not received yet.
+  /// </summary>
+  uint16_t GetRemoteKeys(uint64_t frame) const noexcept;
+
+  /// <summary>
+  /// Saves a snapshot and runs a frame with given local keys.
+  /// </summary>
+  size_t RunFrame(uint64_t frame, uint16_t local_keys);
+
+  core::Cpu& cpu_;
+  RollbackConfig config_;
+
+  /// <summary>
+  /// Frames in a ring, indexed by frame modulo its size.
+  /// </summary>
+  std::vector<Slot> slots_;
+  std::vector<RemoteInput> remote_;
+
+  uint64_t frame_;
+  uint64_t confirmed_;
+
+  /// <summary>
+  /// Remote keys of the last confirmed frame, the prediction for later ones.
+  /// </summary>
+  uint16_t predicted_keys_;
+
+  /// <summary>
+  /// Earliest frame run with a mispredicted remote input, if any.
+  /// </summary>
+  std::optional<uint64_t> rollback_from_;
+
+  RollbackStats stats_;
+};
+
+}  // namespace chip8::runtime
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Coroutine running a single emulator session. Starts suspended and is
+/// resumed only by Executor; owns the coroutine frame.
+/// </summary>
+class SessionTask {
+ public:
+  struct promise_type {
+    SessionTask get_return_object() noexcept {
+      return SessionTask{Handle::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_always final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  SessionTask() noexcept : handle_() {}
+
+  SessionTask(SessionTask&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  SessionTask& operator=(SessionTask&& other) noexcept {
+    if (this != &other) {
+      Destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  SessionTask(const SessionTask&) = delete;
+  SessionTask& operator=(const SessionTask&) = delete;
+
+  ~SessionTask() noexcept { Destroy(); }
+
+  /// <summary>
+  /// Resumes the coroutine until its next suspension point.
+  /// </summary>
+  void Resume() const { handle_.resume(); }
+
+  /// <summary>
+  /// Returns true if the coroutine has finished.
+  /// </summary>
+  bool IsDone() const noexcept { return !handle_ || handle_.done(); }
+
+ private:
+  explicit SessionTask(Handle handle) noexcept : handle_(handle) {}
+
+  void Destroy() noexcept {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  /// <summary>
+  /// Owned coroutine frame.
+  /// </summary>
+  Handle handle_;
+};
+
+}  // namespace chip8::runtime
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Emulator state at the end of a frame, as exported to shared memory. The
+/// layout is fixed so that readers in other languages can map it: no
+/// implicit padding, host byte order.
+/// </summary>
+struct SharedFrame {
+  /// <summary>
+  /// Number of the frame, starting from 1.
+  /// </summary>
+  uint64_t number;
+
+  /// <summary>
+  /// Screen, row y is pixels[y] and pixel x is bit x (see core::Framebuffer).
+  /// </summary>
+  uint64_t pixels[32];
+
+  uint8_t memory[4096];
+  uint16_t stack[16];
+  uint16_t index_register;
+  uint16_t program_counter;
+
+  /// <summary>
+  /// Held keys, bit n is key n.
+  /// </summary>
+  uint16_t keys;
+
+  uint8_t registers[16];
+  uint8_t stack_pointer;
+  uint8_t delay_timer;
+  uint8_t sound_timer;
+
+  /// <summary>
+  /// Nonzero if a stack error halted the cpu.
+  /// </summary>
+  uint8_t halted;
+
+  uint8_t reserved[6];
+};
+
+static_assert(std::is_standard_layout_v<SharedFrame> &&
+              std::is_trivially_copyable_v<SharedFrame>);
+static_assert(sizeof(SharedFrame) == 4424 && sizeof(SharedFrame) % 8 == 0,
+              "SharedFrame layout is a part of the shared memory format");
+
+/// <summary>
+/// Publishes emulator state to a named shared memory segment (POSIX
+/// shm_open, a named file mapping on Windows) for other processes.
+/// <para>
+/// The segment starts with a header: magic "C8SM" (offset 0), format version
+/// (4, 32-bit), size of SharedFrame (8, 32-bit) and a closed flag (12,
+/// 32-bit, nonzero once the writer is gone). A 64-bit sequence counter
+/// follows at offset 64 and the SharedFrame at offset 128.
+/// </para>
+/// <para>
+/// The sequence counter is a seqlock: it is odd while a frame is being
+/// written and grows by 2 with every frame. A reader loads it, copies the
+/// frame, loads it again and retries if it changed or was odd. The writer
+/// never waits for readers, any number of which may attach.
+/// </para>
+/// </summary>
+class SharedStateWriter {
+ public:
+  /// <summary>
+  /// Creates the segment, replacing a stale one of the same name.
+  /// </summary>
+  /// <param name="name">Segment name, e.g. "/chip8".</param>
+  /// <returns>Writer or nullptr if shared memory is not available.</returns>
+  static std::unique_ptr<SharedStateWriter> Create(const std::string& name);
+
+  SharedStateWriter(const SharedStateWriter&) = delete;
+  SharedStateWriter& operator=(const SharedStateWriter&) = delete;
+
+  /// <summary>
+  /// Marks the segment closed and removes its name. Attached readers keep
+  /// their mapping.
+  /// </summary>
+  ~SharedStateWriter() noexcept;
+
+  /// <summary>
+  /// Publishes the state of given cpu as the next frame, e.g. from
+  /// core::Cpu::SetFrameCallback().
+  /// </summary>
+  void Publish(const core::Cpu& cpu) noexcept;
+
+  /// <summary>
+  /// Publishes given frame as is.
+  /// </summary>
+  void Publish(const SharedFrame& frame) noexcept;
+
+  /// <summary>
+  /// Returns amount of published frames.
+  /// </summary>
+  uint64_t GetPublishedCount() const noexcept;
+
+ private:
+  struct Mapping;
+
+  SharedStateWriter(std::unique_ptr<Mapping> mapping) noexcept;
+
+  std::unique_ptr<Mapping> mapping_;
+  uint64_t published_;
+};
+
+/// <summary>
+/// Reads frames published by a SharedStateWriter, possibly in another
+/// process. Reading never blocks the writer.
+/// </summary>
+class SharedStateReader {
+ public:
+  /// <summary>
+  /// Maps an existing segment.
+  /// </summary>
+  /// <returns>
+  /// Reader or nullptr if the segment does not exist or has another format.
+  /// </returns>
+  static std::unique_ptr<SharedStateReader> Open(const std::string& name);
+
+  SharedStateReader(const SharedStateReader&) = delete;
+  SharedStateReader& operator=(const SharedStateReader&) = delete;
+
+  /// <summary>
+  /// Unmaps the segment.
+  /// </summary>
+  ~SharedStateReader() noexcept;
+
+  /// <summary>
+  /// Returns the sequence counter, which changes with every published
+  /// frame. Cheap enough to poll for new frames.
+  /// </summary>
+  uint64_t GetSequence() const noexcept;
+
+  /// <summary>
+  /// Copies the latest frame consistently, retrying while the writer
+  /// replaces it.
+  /// </summary>
+  /// <returns>
+  /// The frame, or std::nullopt if nothing was published yet or the writer
+  /// kept changing it during all attempts.
+  /// </returns>
+  std::optional<SharedFrame> Read(size_t max_attempts = 1000) noexcept;
+
+  /// <summary>
+  /// Returns true once the writer was destroyed.
+  /// </summary>
+  bool IsClosed() const noexcept;
+
+  /// <summary>
+  /// Returns amount of copies discarded because the writer changed the
+  /// frame meanwhile.
+  /// </summary>
+  uint64_t GetRetryCount() const noexcept;
+
+ private:
+  struct Mapping;
+
+  SharedStateReader(std::unique_ptr<Mapping> mapping) noexcept;
+
+  std::unique_ptr<Mapping> mapping_;
+  uint64_t retries_;
+};
+
+}  // namespace chip8::runtime
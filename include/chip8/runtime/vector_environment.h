@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chip8/runtime/environment.h>
+#include <chip8/utils/thread_pool.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// Namespace for hosting emulator sessions: schedulers and environments
+/// built on top of core::Cpu.
+/// </summary>
+namespace chip8::runtime {
+
+/// <summary>
+/// Batch of environments running the same ROM, stepped in parallel on a
+/// thread pool.
+/// <para>
+/// Observations of all environments are stored contiguously. An environment
+/// whose episode ended is reset at the beginning of the next Step(), so the
+/// observation returned for the final step of an episode is its last frame.
+/// </para>
+/// </summary>
+class VectorEnvironment {
+ public:
+  /// <summary>
+  /// Creates a batch of environments.
+  /// </summary>
+  /// <param name="threads">
+  /// Threads used for stepping, including the caller.
+  /// </param>
+  VectorEnvironment(std::shared_ptr<const core::RomImage> rom,
+                    const EnvironmentConfig& config, size_t count,
+                    size_t threads = std::thread::hardware_concurrency());
+
+  /// <summary>
+  /// Resets all environments. Environment i is seeded with seed + i, later
+  /// episodes continue with seed + i + count, seed + i + 2 * count, etc.
+  /// </summary>
+  std::span<const Framebuffer> Reset(unsigned int seed);
+
+  /// <summary>
+  /// Steps every environment with its action.
+  /// </summary>
+  /// <param name="actions">
+  /// One key bitmask per environment.
+  /// </param>
+  /// <returns>
+  /// One result per environment, or an empty span if the amount of actions
+  /// does not match and nothing was stepped.
+  /// </returns>
+  std::span<const StepResult> Step(std::span<const uint16_t> actions);
+
+  /// <summary>
+  /// Returns the latest observations, one per environment.
+  /// </summary>
+  std::span<const Framebuffer> GetObservations() const noexcept;
+
+  /// <summary>
+  /// Returns a single environment.
+  /// </summary>
+  const Environment& GetEnvironment(size_t index) const noexcept;
+
+  /// <summary>
+  /// Returns amount of environments.
+  /// </summary>
+  size_t GetSize() const noexcept;
+
+ private:
+  /// <summary>
+  /// Observations of all environments.
+  /// </summary>
+  std::vector<Framebuffer> observations_;
+
+  /// <summary>
+  /// Environments writing into observations_.
+  /// </summary>
+  std::vector<std::unique_ptr<Environment>> environments_;
+
+  /// <summary>
+  /// Results of the latest step.
+  /// </summary>
+  std::vector<StepResult> results_;
+
+  /// <summary>
+  /// Seed of the next episode of every environment.
+  /// </summary>
+  std::vector<unsigned int> seeds_;
+
+  /// <summary>
+  /// Threads stepping environments.
+  /// </summary>
+  utils::ThreadPool pool_;
+};
+
+}  // namespace chip8::runtime
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Namespace for searching input sequences which reach given game states.
+/// </summary>
+namespace chip8::search {
+
+/// <summary>
+/// How the states kept for the next decision point are chosen.
+/// </summary>
+enum class Strategy {
+  /// <summary>
+  /// Every new state, in the order found, up to SearchConfig::frontier_size.
+  /// </summary>
+  kBreadthFirst,
+
+  /// <summary>
+  /// The best scored new states.
+  /// </summary>
+  kBeam,
+
+  /// <summary>
+  /// States reaching a new cell of the novelty archive, or a better score in
+  /// a known cell, followed by the best scored other new states if the
+  /// frontier has room left. Cells are the values of
+  /// SearchConfig::novelty_addresses.
+  /// </summary>
+  kNovelty
+};
+
+/// <summary>
+/// Memory byte contributing to a score.
+/// </summary>
+struct MemoryWeight {
+  uint16_t address{};
+  double weight{1.0};
+};
+
+/// <summary>
+/// Rates a state, higher is better.
+/// </summary>
+using ScoreFunction = std::function<double(const core::Cpu&)>;
+
+/// <summary>
+/// Returns a score summing memory bytes multiplied by their weights, e.g.
+/// the score counter of a game.
+/// </summary>
+ScoreFunction ScoreMemory(std::vector<MemoryWeight> weights);
+
+/// <summary>
+/// Settings of a search.
+/// </summary>
+struct SearchConfig {
+  Strategy strategy{Strategy::kBeam};
+
+  /// <summary>
+  /// Amount of cycles in every frame.
+  /// </summary>
+  size_t cycles_per_frame{10};
+
+  /// <summary>
+  /// Frames every input is held before the next decision point.
+  /// </summary>
+  size_t frames_per_decision{6};
+
+  /// <summary>
+  /// Amount of decision points after which the search ends.
+  /// </summary>
+  size_t max_depth{60};
+
+  /// <summary>
+  /// Amount of states expanded at every decision point.
+  /// </summary>
+  size_t frontier_size{256};
+
+  /// <summary>
+  /// Key masks tried at every decision point. Empty tries no key and each
+  /// of the 16 keys alone.
+  /// </summary>
+  std::vector<uint16_t> inputs;
+
+  /// <summary>
+  /// Scores states for kBeam and kNovelty and picks the best path. States
+  /// score 0 if empty.
+  /// </summary>
+  ScoreFunction score;
+
+  /// <summary>
+  /// Ends the search at the first state for which it returns true.
+  /// </summary>
+  std::function<bool(const core::Cpu&)> goal;
+
+  /// <summary>
+  /// Memory bytes whose values form a cell of the novelty archive. Empty
+  /// makes every new state a cell of its own.
+  /// </summary>
+  std::vector<uint16_t> novelty_addresses;
+
+  /// <summary>
+  /// Amount of threads expanding states, including the caller.
+  /// </summary>
+  size_t threads{std::thread::hardware_concurrency()};
+};
+
+/// <summary>
+/// Outcome of a search.
+/// </summary>
+struct SearchResult {
+  /// <summary>
+  /// True if a state satisfying SearchConfig::goal was reached.
+  /// </summary>
+  bool found{};
+
+  /// <summary>
+  /// Key masks leading to the goal, or to the best scored state if none was
+  /// reached. Every mask is held for SearchConfig::frames_per_decision
+  /// frames.
+  /// </summary>
+  std::vector<uint16_t> inputs;
+
+  double best_score{};
+
+  /// <summary>
+  /// Amount of decision points expanded.
+  /// </summary>
+  size_t depth{};
+
+  /// <summary>
+  /// Amount of forked states emulated.
+  /// </summary>
+  uint64_t states_explored{};
+
+  /// <summary>
+  /// Amount of forked states dropped because an equal state was seen before.
+  /// </summary>
+  uint64_t duplicates{};
+
+  /// <summary>
+  /// Amount of cells in the novelty archive.
+  /// </summary>
+  size_t cells{};
+
+  double seconds{};
+  double states_per_second{};
+};
+
+/// <summary>
+/// Hashes the parts of a state that decide how it continues: memory,
+/// registers, screen, stack and timers. Held keys are left out, since every
+/// decision point sets them anew. RNG state is left out as well.
+/// </summary>
+uint64_t HashState(const core::Cpu& cpu) noexcept;
+
+/// <summary>
+/// Searches input sequences by forking cpu states at decision points. Every
+/// state of the frontier is copied once per input, and the copies run for
+/// SearchConfig::frames_per_decision frames in parallel. New states are
+/// deduplicated by HashState() across the whole search, and the strategy
+/// picks the next frontier among them.
+/// </summary>
+/// <param name="start">State to search from, e.g. right after LoadROM().</param>
+SearchResult Search(const core::Cpu& start, const SearchConfig& config);
+
+}  // namespace chip8::search
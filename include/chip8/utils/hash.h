@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Initial value of Fnv1a().
+/// </summary>
+constexpr uint64_t kFnv1aOffset{0xCBF29CE484222325u};
+
+/// <summary>
+/// Hashes bytes with 64-bit FNV-1a. Pass the previous result as basis to
+/// hash several ranges as one.
+/// </summary>
+constexpr uint64_t Fnv1a(std::span<const uint8_t> bytes,
+                         uint64_t basis = kFnv1aOffset) noexcept {
+  for (const uint8_t byte : bytes) {
+    basis = (basis ^ byte) * 0x100000001B3u;
+  }
+  return basis;
+}
+
+}  // namespace chip8::utils
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Histogram of durations with logarithmic buckets: every power of two
+/// range is split into 8 linear buckets, so recorded values are kept with
+/// 12.5% precision. Recording is not thread safe, every thread should use
+/// its own histogram.
+/// </summary>
+class Histogram {
+ public:
+  Histogram() noexcept;
+
+  /// <summary>
+  /// Adds a duration.
+  /// </summary>
+  void Record(std::chrono::nanoseconds duration) noexcept;
+
+  /// <summary>
+  /// Returns amount of recorded durations.
+  /// </summary>
+  uint64_t GetCount() const noexcept;
+
+  /// <summary>
+  /// Returns the largest recorded duration.
+  /// </summary>
+  std::chrono::nanoseconds GetMax() const noexcept;
+
+  /// <summary>
+  /// Returns the mean of recorded durations.
+  /// </summary>
+  std::chrono::nanoseconds GetMean() const noexcept;
+
+  /// <summary>
+  /// Returns lower bound of the bucket holding given percentile.
+  /// </summary>
+  /// <param name="percentile">Value between 0 and 100.</param>
+  std::chrono::nanoseconds GetPercentile(double percentile) const noexcept;
+
+  /// <summary>
+  /// Returns a single line summary: count, mean, p50, p90, p99 and max.
+  /// </summary>
+  std::string Summarize() const;
+
+ private:
+  /// <summary>
+  /// Returns index of the bucket holding given value.
+  /// </summary>
+  static size_t GetBucket(uint64_t value) noexcept;
+
+  /// <summary>
+  /// Returns the smallest value held by given bucket.
+  /// </summary>
+  static uint64_t GetBucketStart(size_t bucket) noexcept;
+
+  /// <summary>
+  /// Amount of values in every bucket.
+  /// </summary>
+  std::array<uint64_t, 62 * 8> buckets_;
+
+  /// <summary>
+  /// Amount of recorded values.
+  /// </summary>
+  uint64_t count_;
+
+  /// <summary>
+  /// Sum of recorded values in nanoseconds.
+  /// </summary>
+  uint64_t sum_;
+
+  /// <summary>
+  /// Largest recorded value in nanoseconds.
+  /// </summary>
+  uint64_t max_;
+};
+
+}  // namespace chip8::utils
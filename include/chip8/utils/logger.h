@@ -22,6 +22,12 @@ class Logger {
   /// </summary>
   static void Init() noexcept;
 
+  /// <summary>
+  /// Mutes or restores console output, e.g. while the console shows the
+  /// emulated screen. Logs are still written to the file.
+  /// </summary>
+  static void SetConsoleEnabled(bool enabled) noexcept;
+
   /// <summary>
   /// Returns a reference to the shared pointer of the logger instance.
   /// </summary>
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// File mapped read-only into memory (mmap, a file mapping on Windows), so
+/// its bytes can be hashed or searched without reading them into a buffer.
+/// </summary>
+class MappedFile {
+ public:
+  /// <summary>
+  /// Maps the whole file.
+  /// </summary>
+  /// <returns>Mapping or nullptr if the file cannot be opened.</returns>
+  static std::unique_ptr<MappedFile> Open(const std::filesystem::path& path);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// <summary>
+  /// Unmaps the file.
+  /// </summary>
+  ~MappedFile() noexcept;
+
+  /// <summary>
+  /// Returns contents of the file, empty for an empty file.
+  /// </summary>
+  std::span<const uint8_t> GetBytes() const noexcept;
+
+ private:
+  MappedFile(const uint8_t* data, size_t size) noexcept;
+
+  const uint8_t* data_;
+  size_t size_;
+};
+
+}  // namespace chip8::utils
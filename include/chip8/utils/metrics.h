@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Monotonic counter. Updates are single relaxed atomic additions, so it can
+/// be bumped from hot paths of any thread.
+/// </summary>
+class alignas(64) Counter {
+ public:
+  void Add(uint64_t value = 1) noexcept {
+    value_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t Get() const noexcept {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint64_t> value_{};
+};
+
+/// <summary>
+/// Value which can go up and down, e.g. a queue depth.
+/// </summary>
+class alignas(64) Gauge {
+ public:
+  void Set(double value) noexcept {
+    value_.store(value, std::memory_order_relaxed);
+  }
+
+  double Get() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<double> value_{};
+};
+
+/// <summary>
+/// Distribution of durations over fixed buckets. Unlike Histogram, it can be
+/// recorded from one thread while another one reads it, at the price of
+/// coarse buckets chosen up front.
+/// </summary>
+class MetricHistogram {
+ public:
+  /// <summary>
+  /// Creates a histogram with given ascending bucket upper bounds. Values
+  /// above the last bound land in an implicit +Inf bucket.
+  /// </summary>
+  explicit MetricHistogram(std::vector<std::chrono::nanoseconds> bounds);
+
+  /// <summary>
+  /// Adds a duration.
+  /// </summary>
+  void Record(std::chrono::nanoseconds duration) noexcept;
+
+  /// <summary>
+  /// Returns bucket upper bounds, without the +Inf bucket.
+  /// </summary>
+  const std::vector<std::chrono::nanoseconds>& GetBounds() const noexcept;
+
+  /// <summary>
+  /// Returns amount of values in every bucket, the last one being +Inf.
+  /// Buckets are not cumulative.
+  /// </summary>
+  std::vector<uint64_t> GetBuckets() const;
+
+  /// <summary>
+  /// Returns sum of recorded durations.
+  /// </summary>
+  std::chrono::nanoseconds GetSum() const noexcept;
+
+ private:
+  std::vector<std::chrono::nanoseconds> bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<uint64_t> sum_;
+};
+
+/// <summary>
+/// Named collection of metrics which can be rendered in Prometheus text
+/// exposition format or as JSON. Registration and rendering take a lock,
+/// updating registered metrics does not. Registered metrics live as long as
+/// the registry.
+/// </summary>
+class MetricsRegistry {
+ public:
+  MetricsRegistry() = default;
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+  /// <summary>
+  /// Registers a counter.
+  /// </summary>
+  /// <param name="name">Prometheus metric name, e.g. chip8_frames_total.</param>
+  /// <param name="help">Single line description.</param>
+  Counter& AddCounter(std::string name, std::string help);
+
+  /// <summary>
+  /// Registers a gauge.
+  /// </summary>
+  Gauge& AddGauge(std::string name, std::string help);
+
+  /// <summary>
+  /// Registers a histogram of durations, rendered in seconds.
+  /// </summary>
+  MetricHistogram& AddHistogram(std::string name, std::string help,
+                                std::vector<std::chrono::nanoseconds> bounds);
+
+  /// <summary>
+  /// Renders every metric in Prometheus text exposition format 0.0.4.
+  /// </summary>
+  std::string FormatPrometheus() const;
+
+  /// <summary>
+  /// Renders every metric as a single line JSON object keyed by name.
+  /// Histograms become objects with count, sum and cumulative buckets.
+  /// </summary>
+  std::string FormatJson() const;
+
+ private:
+  struct Entry {
+    std::string name;
+    std::string help;
+    std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>,
+                 std::unique_ptr<MetricHistogram>>
+        metric;
+  };
+
+  mutable std::mutex mutex_;
+  std::deque<Entry> entries_;
+};
+
+}  // namespace chip8::utils
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Parts of the emulator hardware counters are attributed to.
+/// </summary>
+enum class PerfPhase : uint8_t {
+  /// <summary>
+  /// Fetching, decoding and executing instructions in Cpu::RunFrame(),
+  /// without sprite drawing. Units are emulated instructions.
+  /// </summary>
+  kDispatch,
+
+  /// <summary>
+  /// Cpu::OpcodeDXYN(). Units are drawn sprites.
+  /// </summary>
+  kDraw,
+
+  /// <summary>
+  /// Presenting a frame on screen. Units are presented frames.
+  /// </summary>
+  kRender,
+
+  /// <summary>
+  /// Queueing audio. Units are queued beeps.
+  /// </summary>
+  kAudio,
+
+  kCount
+};
+
+/// <summary>
+/// Hardware counter values of the calling thread, user space only.
+/// </summary>
+struct PerfSample {
+  uint64_t cycles{};
+  uint64_t instructions{};
+  uint64_t branches{};
+  uint64_t branch_misses{};
+  uint64_t l1d_misses{};
+
+  PerfSample& operator+=(const PerfSample& other) noexcept;
+  PerfSample operator-(const PerfSample& other) const noexcept;
+};
+
+/// <summary>
+/// Totals of a single phase.
+/// </summary>
+struct PerfPhaseTotals {
+  PerfSample counters;
+  uint64_t units{};
+};
+
+/// <summary>
+/// Attributes hardware performance counters (cycles, instructions,
+/// branches, branch misses and L1d read misses) to PerfPhase scopes,
+/// using perf_event_open on Linux. Every thread opens its own counter group
+/// on its first scope; values are read in user space with rdpmc where the
+/// kernel allows it and with read() otherwise.
+/// <para>
+/// Nested scopes are exclusive: time inside OpcodeDXYN is not counted as
+/// dispatch. Elsewhere, or when the PMU is not accessible (e.g. in most
+/// virtual machines), scopes do nothing and IsAvailable() returns false.
+/// </para>
+/// </summary>
+class PerfCounters {
+ public:
+  /// <summary>
+  /// Returns true if counters can be opened on the calling thread.
+  /// </summary>
+  static bool IsAvailable() noexcept;
+
+  /// <summary>
+  /// Starts attributing counters of the calling thread to a phase.
+  /// </summary>
+  static void Begin(PerfPhase phase) noexcept;
+
+  /// <summary>
+  /// Ends the innermost scope, which must belong to given phase.
+  /// </summary>
+  /// <param name="units">Work done in the scope, see PerfPhase.</param>
+  static void End(PerfPhase phase, uint64_t units) noexcept;
+
+  /// <summary>
+  /// Returns totals of every phase summed over all threads. Threads which
+  /// are still recording may be counted partially.
+  /// </summary>
+  static std::array<PerfPhaseTotals, static_cast<size_t>(PerfPhase::kCount)>
+  GetTotals();
+
+  /// <summary>
+  /// Returns a table with cycles, instructions, IPC, branch misses and L1d
+  /// misses per unit of every phase.
+  /// </summary>
+  static std::string Report();
+
+  /// <summary>
+  /// Forgets all totals. Must not be called while other threads record.
+  /// </summary>
+  static void Clear() noexcept;
+};
+
+/// <summary>
+/// Attributes counters to a phase for its lifetime. Use through
+/// CHIP8_PERF_SCOPE, which compiles out unless CHIP8_PERF_COUNTERS is
+/// defined.
+/// </summary>
+class PerfScope {
+ public:
+  explicit PerfScope(PerfPhase phase, uint64_t units = 1) noexcept
+      : phase_(phase), units_(units) {
+    PerfCounters::Begin(phase_);
+  }
+
+  PerfScope(const PerfScope&) = delete;
+  PerfScope& operator=(const PerfScope&) = delete;
+
+  ~PerfScope() noexcept { PerfCounters::End(phase_, units_); }
+
+  /// <summary>
+  /// Replaces the amount of work reported when the scope ends.
+  /// </summary>
+  void SetUnits(uint64_t units) noexcept { units_ = units; }
+
+ private:
+  PerfPhase phase_;
+  uint64_t units_;
+};
+
+}  // namespace chip8::utils
+
+// Macros for counter scopes, one scope per block
+#ifdef CHIP8_PERF_COUNTERS
+
+#define CHIP8_PERF_SCOPE(phase) \
+  ::chip8::utils::PerfScope chip8_perf_scope { ::chip8::utils::PerfPhase::phase }
+#define CHIP8_PERF_UNITS(units) chip8_perf_scope.SetUnits(units)
+
+#else
+
+#define CHIP8_PERF_SCOPE(phase) (void)0
+#define CHIP8_PERF_UNITS(units) (void)0
+
+#endif
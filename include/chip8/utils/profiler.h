@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Collects instrumentation zones recorded by ScopedZone and exports them in
+/// Chrome trace_event format, viewable in chrome://tracing or Perfetto.
+/// <para>
+/// Every thread appends to its own fixed-size buffer, published with a
+/// single release store, so recording takes no locks and never allocates
+/// after the first zone of a thread. Zones past kThreadCapacity are dropped.
+/// Buffers outlive their threads, so a trace can be exported after the
+/// instrumented threads have finished.
+/// </para>
+/// </summary>
+class Profiler {
+ public:
+  /// <summary>
+  /// Maximal amount of zones kept for every thread.
+  /// </summary>
+  static constexpr size_t kThreadCapacity{size_t{1} << 18};
+
+  /// <summary>
+  /// Returns nanoseconds since the first call, on a steady clock.
+  /// </summary>
+  static int64_t Now() noexcept;
+
+  /// <summary>
+  /// Adds a finished zone to the calling thread's buffer.
+  /// </summary>
+  /// <param name="name">Zone name, must outlive the profiler.</param>
+  static void Record(const char* name, int64_t start, int64_t end) noexcept;
+
+  /// <summary>
+  /// Names the calling thread in exported traces.
+  /// </summary>
+  /// <param name="name">Thread name, must outlive the profiler.</param>
+  static void SetThreadName(const char* name) noexcept;
+
+  /// <summary>
+  /// Renders every recorded zone as Chrome trace_event JSON.
+  /// </summary>
+  static std::string FormatChromeTrace();
+
+  /// <summary>
+  /// Writes FormatChromeTrace() to a file.
+  /// </summary>
+  /// <returns>False if the file cannot be written.</returns>
+  static bool WriteChromeTrace(const std::filesystem::path& path);
+
+  /// <summary>
+  /// Returns amount of zones dropped because a thread buffer was full.
+  /// </summary>
+  static uint64_t GetDroppedCount() noexcept;
+
+  /// <summary>
+  /// Forgets every recorded zone. Must not be called while other threads
+  /// record zones.
+  /// </summary>
+  static void Clear() noexcept;
+};
+
+/// <summary>
+/// Records the time between its construction and destruction as a zone of
+/// the calling thread. Use through CHIP8_ZONE, which compiles out unless
+/// CHIP8_PROFILE is defined.
+/// </summary>
+class ScopedZone {
+ public:
+  explicit ScopedZone(const char* name) noexcept
+      : name_(name), start_(Profiler::Now()) {}
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+  ~ScopedZone() noexcept { Profiler::Record(name_, start_, Profiler::Now()); }
+
+ private:
+  const char* name_;
+  int64_t start_;
+};
+
+}  // namespace chip8::utils
+
+// Macros for instrumentation, names must be string literals
+#ifdef CHIP8_PROFILE
+
+#define CHIP8_ZONE_CONCAT_IMPL(a, b) a##b
+#define CHIP8_ZONE_CONCAT(a, b) CHIP8_ZONE_CONCAT_IMPL(a, b)
+#define CHIP8_ZONE(name)                                            \
+  const ::chip8::utils::ScopedZone CHIP8_ZONE_CONCAT(chip8_zone_, \
+                                                     __LINE__) {    \
+    name                                                            \
+  }
+#define CHIP8_THREAD_NAME(name) ::chip8::utils::Profiler::SetThreadName(name)
+
+#else
+
+#define CHIP8_ZONE(name) (void)0
+#define CHIP8_THREAD_NAME(name) (void)0
+
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Bounded lock-free queue for a single producer and a single consumer.
+/// </summary>
+template <typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+ public:
+  SpscQueue() : slots_(), head_(0), tail_(0) {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /// <summary>
+  /// Appends a value. Producer only.
+  /// </summary>
+  /// <returns>False if queue is full.</returns>
+  bool TryPush(const T& value) noexcept {
+    const size_t tail{tail_.load(std::memory_order_relaxed)};
+    if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    slots_[tail & (Capacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// <summary>
+  /// Removes the oldest value. Consumer only.
+  /// </summary>
+  /// <returns>Removed value or std::nullopt if queue is empty.</returns>
+  std::optional<T> TryPop() noexcept {
+    const size_t head{head_.load(std::memory_order_relaxed)};
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    T value{slots_[head & (Capacity - 1)]};
+    head_.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+ private:
+  /// <summary>
+  /// Queued values.
+  /// </summary>
+  std::array<T, Capacity> slots_;
+
+  /// <summary>
+  /// Index of the next value to pop, advanced by the consumer.
+  /// </summary>
+  alignas(64) std::atomic<size_t> head_;
+
+  /// <summary>
+  /// Index of the next free slot, advanced by the producer.
+  /// </summary>
+  alignas(64) std::atomic<size_t> tail_;
+};
+
+}  // namespace chip8::utils
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Fixed set of worker threads executing parallel loops. The calling thread
+/// takes part in every loop, so a pool of N threads starts N - 1 workers.
+/// </summary>
+class ThreadPool {
+ public:
+  /// <summary>
+  /// Starts worker threads.
+  /// </summary>
+  /// <param name="threads">Amount of threads including the caller.</param>
+  explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// <summary>
+  /// Stops and joins worker threads.
+  /// </summary>
+  ~ThreadPool() noexcept;
+
+  /// <summary>
+  /// Calls body for every index in [0, count) and waits until all calls
+  /// return. Indices are handed out one by one to whichever thread is free.
+  /// </summary>
+  void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+  /// <summary>
+  /// Returns amount of threads taking part in loops, including the caller.
+  /// </summary>
+  size_t GetThreadCount() const noexcept;
+
+ private:
+  /// <summary>
+  /// Waits for loops and takes part in them until the pool is destroyed.
+  /// </summary>
+  void WorkerLoop();
+
+  /// <summary>
+  /// Executes indices of the current loop until none is left.
+  /// </summary>
+  void Drain() noexcept;
+
+  /// <summary>
+  /// Worker threads.
+  /// </summary>
+  std::vector<std::thread> workers_;
+
+  /// <summary>
+  /// Guards loop state below.
+  /// </summary>
+  std::mutex mutex_;
+
+  /// <summary>
+  /// Signals a new loop or shutdown to workers.
+  /// </summary>
+  std::condition_variable start_cv_;
+
+  /// <summary>
+  /// Signals the caller that all workers left the current loop.
+  /// </summary>
+  std::condition_variable done_cv_;
+
+  /// <summary>
+  /// Body of the current loop.
+  /// </summary>
+  const std::function<void(size_t)>* body_;
+
+  /// <summary>
+  /// Amount of indices in the current loop.
+  /// </summary>
+  size_t count_;
+
+  /// <summary>
+  /// Next index to execute.
+  /// </summary>
+  std::atomic<size_t> next_;
+
+  /// <summary>
+  /// Incremented for every loop, so workers notice new work.
+  /// </summary>
+  size_t generation_;
+
+  /// <summary>
+  /// Amount of workers still executing the current loop.
+  /// </summary>
+  size_t busy_;
+
+  /// <summary>
+  /// True once the pool is being destroyed.
+  /// </summary>
+  bool stopping_;
+};
+
+}  // namespace chip8::utils
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// <summary>
+/// Namespace for additional utility components like logger.
+/// </summary>
+namespace chip8::utils {
+
+/// <summary>
+/// Lock-free triple buffer passing the latest value from a single writer to
+/// a single reader. The writer fills the back slot and publishes it, the
+/// reader picks up the newest published slot; neither side ever waits and
+/// intermediate values may be skipped.
+/// </summary>
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer() : slots_(), back_(0), middle_(1), front_(2) {}
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /// <summary>
+  /// Returns the slot owned by the writer.
+  /// </summary>
+  T& GetBack() noexcept { return slots_[back_]; }
+
+  /// <summary>
+  /// Publishes the back slot and takes over the previous middle one.
+  /// Writer only.
+  /// </summary>
+  void Publish() noexcept {
+    back_ = middle_.exchange(static_cast<uint8_t>(back_ | kDirty),
+                             std::memory_order_acq_rel) &
+            kIndexMask;
+  }
+
+  /// <summary>
+  /// Takes over the newest published slot, if there is one. Reader only.
+  /// </summary>
+  /// <returns>True if front slot changed.</returns>
+  bool Update() noexcept {
+    if ((middle_.load(std::memory_order_relaxed) & kDirty) == 0) {
+      return false;
+    }
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+    return true;
+  }
+
+  /// <summary>
+  /// Returns the slot owned by the reader.
+  /// </summary>
+  const T& GetFront() const noexcept { return slots_[front_]; }
+
+ private:
+  /// <summary>
+  /// Set in middle_ when it holds a value not yet seen by the reader.
+  /// </summary>
+  static constexpr uint8_t kDirty{0x4};
+
+  /// <summary>
+  /// Bits of middle_ holding the slot index.
+  /// </summary>
+  static constexpr uint8_t kIndexMask{0x3};
+
+  /// <summary>
+  /// Buffered values.
+  /// </summary>
+  std::array<T, 3> slots_;
+
+  /// <summary>
+  /// Slot owned by the writer.
+  /// </summary>
+  alignas(64) uint8_t back_;
+
+  /// <summary>
+  /// Slot exchanged between writer and reader, with kDirty flag.
+  /// </summary>
+  alignas(64) std::atomic<uint8_t> middle_;
+
+  /// <summary>
+  /// Slot owned by the reader.
+  /// </summary>
+  alignas(64) uint8_t front_;
+};
+
+}  // namespace chip8::utils
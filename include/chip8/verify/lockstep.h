@@ -0,0 +1,162 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Namespace for checking execution engines against the reference
+/// interpreter.
+/// </summary>
+namespace chip8::verify {
+
+/// <summary>
+/// Settings of a lockstep run.
+/// </summary>
+struct LockstepConfig {
+  /// <summary>
+  /// Amount of frames to run.
+  /// </summary>
+  uint64_t frames{600};
+
+  /// <summary>
+  /// Amount of cycles in every frame.
+  /// </summary>
+  size_t cycles_per_frame{10};
+
+  /// <summary>
+  /// Cpus are compared once at least this many instructions were executed
+  /// since the last comparison, and always at the end of a frame. 1 compares
+  /// after every step of the candidate.
+  /// </summary>
+  size_t compare_interval{1};
+
+  /// <summary>
+  /// Amount of reference instructions kept for divergence reports.
+  /// </summary>
+  size_t trace_window{16};
+
+  /// <summary>
+  /// Returns key mask held during given frame, no keys if empty.
+  /// </summary>
+  std::function<uint16_t(uint64_t frame)> keys;
+};
+
+/// <summary>
+/// Instruction executed by the reference cpu.
+/// </summary>
+struct TraceEntry {
+  uint64_t frame;
+
+  /// <summary>
+  /// Index of the instruction since the start of the run.
+  /// </summary>
+  uint64_t instruction;
+
+  uint16_t address;
+  uint16_t opcode;
+};
+
+/// <summary>
+/// First difference found between the cpus.
+/// </summary>
+struct Divergence {
+  uint64_t frame{};
+
+  /// <summary>
+  /// Amount of instructions executed before the comparison.
+  /// </summary>
+  uint64_t instruction{};
+
+  /// <summary>
+  /// Name of the first differing part of the state, e.g. "V3" or "memory".
+  /// </summary>
+  std::string field;
+
+  std::string reference;
+  std::string candidate;
+
+  /// <summary>
+  /// Last reference instructions before the comparison, oldest first.
+  /// </summary>
+  std::vector<TraceEntry> trace;
+
+  /// <summary>
+  /// Returns a multi-line human readable report.
+  /// </summary>
+  std::string Format() const;
+};
+
+/// <summary>
+/// Statistics of a lockstep run.
+/// </summary>
+struct LockstepStats {
+  uint64_t frames{};
+  uint64_t instructions{};
+
+  /// <summary>
+  /// Amount of Cpu::Step() calls of the candidate.
+  /// </summary>
+  uint64_t steps{};
+
+  uint64_t comparisons{};
+};
+
+/// <summary>
+/// Runs a reference interpreter and a candidate engine side by side.
+/// <para>
+/// The candidate advances with Cpu::Step(), so idle skipping, compiled
+/// blocks and superinstructions are used exactly as in RunFrame(). The
+/// reference interprets the same amount of instructions with Cpu::Cycle()
+/// and both cpus are compared: registers, I, PC, stack, timers, keys,
+/// opcode and critical error directly, memory and screen by their hashes.
+/// A frame ends early once the candidate halts on a stack error.
+/// </para>
+/// </summary>
+class LockstepHarness {
+ public:
+  /// <summary>
+  /// Prepares a run. Both cpus must already hold the same ROM and RNG seed;
+  /// fast paths of the reference are disabled.
+  /// </summary>
+  LockstepHarness(core::Cpu& reference, core::Cpu& candidate,
+                  LockstepConfig config);
+
+  /// <summary>
+  /// Runs all frames or until the cpus diverge.
+  /// </summary>
+  /// <returns>First divergence or std::nullopt if cpus stayed equal.</returns>
+  std::optional<Divergence> Run();
+
+  /// <summary>
+  /// Returns statistics of the last run.
+  /// </summary>
+  const LockstepStats& GetStats() const noexcept;
+
+ private:
+  /// <summary>
+  /// Compares both cpus.
+  /// </summary>
+  std::optional<Divergence> Compare(uint64_t frame);
+
+  /// <summary>
+  /// Records the instruction the reference is about to execute.
+  /// </summary>
+  void RecordTrace(uint64_t frame) noexcept;
+
+  core::Cpu& reference_;
+  core::Cpu& candidate_;
+  LockstepConfig config_;
+  LockstepStats stats_;
+
+  /// <summary>
+  /// Ring buffer of the last trace_window reference instructions.
+  /// </summary>
+  std::vector<TraceEntry> trace_;
+};
+
+}  // namespace chip8::verify
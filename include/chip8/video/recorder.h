@@ -0,0 +1,208 @@
+#pragma once
+
+#include <chip8/core/cpu.h>
+#include <chip8/core/framebuffer.h>
+#include <chip8/utils/spsc_queue.h>
+#include <chip8/video/upscaler.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+/// <summary>
+/// Namespace for software rendering of the emulated screen.
+/// </summary>
+namespace chip8::video {
+
+/// <summary>
+/// Layout of a recording. kRaw is a headerless sequence of frames (e.g. for
+/// ffmpeg -f rawvideo), kY4m is a YUV4MPEG2 stream with mono frames.
+/// </summary>
+enum class Container { kRaw, kY4m };
+
+/// <summary>
+/// Settings of a Recorder.
+/// </summary>
+struct RecorderConfig {
+  Container container{Container::kY4m};
+
+  /// <summary>
+  /// Format of recorded pixels, kY4m supports only kY8.
+  /// </summary>
+  PixelFormat pixel_format{PixelFormat::kY8};
+
+  /// <summary>
+  /// Size of an emulated pixel in recorded pixels.
+  /// </summary>
+  size_t scale{core::kPixelSize};
+
+  /// <summary>
+  /// Frame rate written to the Y4M header.
+  /// </summary>
+  uint32_t frame_rate{static_cast<uint32_t>(core::kTimerFrequency)};
+
+  /// <summary>
+  /// Optional text file receiving one line per run of identical frames:
+  /// first frame number, amount of frames and frame hash. Two runs of a ROM
+  /// can be compared by diffing their logs.
+  /// </summary>
+  std::filesystem::path hash_log;
+};
+
+/// <summary>
+/// Recording statistics.
+/// </summary>
+struct RecorderStats {
+  /// <summary>
+  /// Amount of added frames.
+  /// </summary>
+  uint64_t frames{};
+
+  /// <summary>
+  /// Amount of runs of identical frames, i.e. frames which had to be
+  /// scaled.
+  /// </summary>
+  uint64_t runs{};
+
+  /// <summary>
+  /// Amount of times AddFrame() waited for the writer to catch up.
+  /// </summary>
+  uint64_t stalls{};
+};
+
+/// <summary>
+/// Records presented frames without a display.
+/// <para>
+/// The recording thread only compares every frame with the previous one;
+/// identical frames extend the current run and changed ones are packed,
+/// hashed and queued through a lock-free queue. A background writer scales
+/// every run once and writes it as many times as it was presented through a
+/// buffered stream. When the writer falls behind by a whole queue of runs,
+/// AddFrame() waits for it instead of dropping frames.
+/// </para>
+/// </summary>
+class Recorder {
+ public:
+  /// <summary>
+  /// Creates output files and starts the writer.
+  /// </summary>
+  /// <returns>Recorder or nullptr if files cannot be created.</returns>
+  static std::unique_ptr<Recorder> Open(const std::filesystem::path& path,
+                                        const RecorderConfig& config = {});
+
+  Recorder(const Recorder&) = delete;
+  Recorder& operator=(const Recorder&) = delete;
+
+  /// <summary>
+  /// Closes the recording.
+  /// </summary>
+  ~Recorder() noexcept;
+
+  /// <summary>
+  /// Adds the screen of a cpu. Suitable for Cpu::SetFrameCallback(). Must
+  /// be called from a single thread.
+  /// </summary>
+  void AddFrame(const core::Cpu& cpu) noexcept;
+
+  /// <summary>
+  /// Adds a packed frame. Must be called from a single thread and not
+  /// mixed with AddFrame(const Cpu&) in one recording.
+  /// </summary>
+  void AddFrame(const core::Framebuffer& framebuffer) noexcept;
+
+  /// <summary>
+  /// Writes remaining frames, stops the writer and closes files.
+  /// </summary>
+  /// <returns>False if any write failed.</returns>
+  bool Close() noexcept;
+
+  /// <summary>
+  /// Returns statistics of added frames.
+  /// </summary>
+  RecorderStats GetStats() const noexcept;
+
+  /// <summary>
+  /// Returns hash identifying the content of a frame.
+  /// </summary>
+  static uint64_t HashFrame(const core::Framebuffer& framebuffer) noexcept;
+
+ private:
+  /// <summary>
+  /// Frame presented several times in a row.
+  /// </summary>
+  struct Run {
+    core::Framebuffer pixels;
+    uint64_t hash;
+    uint64_t first_frame;
+    uint64_t count;
+  };
+
+  Recorder(const RecorderConfig& config, std::FILE* output,
+           std::FILE* hash_log);
+
+  /// <summary>
+  /// Starts a new run with given frame, queueing the current one.
+  /// </summary>
+  void StartRun(const core::Framebuffer& framebuffer) noexcept;
+
+  /// <summary>
+  /// Queues the current run, waiting for free space if needed.
+  /// </summary>
+  void QueueRun() noexcept;
+
+  /// <summary>
+  /// Body of the writer thread.
+  /// </summary>
+  void WriterLoop() noexcept;
+
+  /// <summary>
+  /// Scales and writes a single run.
+  /// </summary>
+  /// <returns>False if writing failed.</returns>
+  bool WriteRun(const Run& run) noexcept;
+
+  RecorderConfig config_;
+  std::FILE* output_;
+  std::FILE* hash_log_;
+  Upscaler upscaler_;
+
+  /// <summary>
+  /// Scaled frame, owned by the writer.
+  /// </summary>
+  std::vector<uint8_t> image_;
+
+  /// <summary>
+  /// Run being extended by the recording thread.
+  /// </summary>
+  Run current_;
+
+  /// <summary>
+  /// Screen of the last frame added by AddFrame(const Cpu&).
+  /// </summary>
+  std::array<bool, 64 * 32> last_pixels_;
+
+  RecorderStats stats_;
+  utils::SpscQueue<Run, 64> queue_;
+
+  /// <summary>
+  /// Incremented after every queued run and on Close(), waited on by the
+  /// writer when the queue is empty.
+  /// </summary>
+  std::atomic<uint32_t> pushes_;
+
+  /// <summary>
+  /// Incremented after every run taken by the writer, waited on by
+  /// AddFrame() when the queue is full.
+  /// </summary>
+  std::atomic<uint32_t> pops_;
+
+  std::atomic<bool> closing_;
+  std::atomic<bool> failed_;
+  std::thread writer_;
+};
+
+}  // namespace chip8::video
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chip8/core/framebuffer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Namespace for software rendering of the emulated screen.
+/// </summary>
+namespace chip8::video {
+
+/// <summary>
+/// Characters the screen is drawn with.
+/// </summary>
+enum class TerminalCells {
+  /// <summary>
+  /// Half blocks (▀ ▄ █), 1x2 pixels per cell: 64x16 cells.
+  /// </summary>
+  kHalfBlock,
+
+  /// <summary>
+  /// Braille patterns, 2x4 pixels per cell: 32x8 cells.
+  /// </summary>
+  kBraille
+};
+
+/// <summary>
+/// Draws frames on an ANSI terminal as UTF-8 text. Only cells that changed
+/// since the previous frame are written, and the cursor reaches each with
+/// the shortest of an absolute move, a relative move, a line feed or
+/// rewriting the unchanged cells in between. Every frame becomes a single
+/// string, meant to be written with one call.
+/// </summary>
+class TerminalRenderer {
+ public:
+  /// <param name="cells">Characters to draw with.</param>
+  /// <param name="row">Terminal row of the top left cell, from 1.</param>
+  /// <param name="column">Terminal column of the top left cell, from 1.</param>
+  explicit TerminalRenderer(TerminalCells cells = TerminalCells::kHalfBlock,
+                            size_t row = 1, size_t column = 1);
+
+  /// <summary>
+  /// Appends escape sequences and characters which turn the previous frame
+  /// into given one. The first frame, and the first after Invalidate(),
+  /// clears the terminal and draws every lit cell.
+  /// </summary>
+  void Render(const core::Framebuffer& frame, std::string& out);
+
+  /// <summary>
+  /// Forgets what the terminal shows, e.g. after it was resized or written
+  /// to by someone else.
+  /// </summary>
+  void Invalidate() noexcept;
+
+  size_t GetRows() const noexcept;
+  size_t GetColumns() const noexcept;
+
+ private:
+  /// <summary>
+  /// Returns the pixels covered by a cell as bits.
+  /// </summary>
+  uint8_t GetPattern(const core::Framebuffer& frame, size_t row,
+                     size_t column) const noexcept;
+
+  /// <summary>
+  /// Appends UTF-8 character showing given pattern.
+  /// </summary>
+  void AppendCell(uint8_t pattern, std::string& out) const;
+
+  /// <summary>
+  /// Returns length of the character showing given pattern in bytes.
+  /// </summary>
+  size_t GetCellSize(uint8_t pattern) const noexcept;
+
+  /// <summary>
+  /// Appends the cheapest cursor movement to a cell.
+  /// </summary>
+  void MoveTo(size_t row, size_t column, std::string& out);
+
+  TerminalCells cells_;
+  size_t origin_row_;
+  size_t origin_column_;
+  size_t rows_;
+  size_t columns_;
+
+  /// <summary>
+  /// Patterns shown on the terminal, row by row.
+  /// </summary>
+  std::vector<uint8_t> shown_;
+
+  /// <summary>
+  /// False until the terminal was cleared and shown_ matches it.
+  /// </summary>
+  bool valid_;
+
+  /// <summary>
+  /// Cell the cursor is at, if known. Writing the last cell of a row leaves
+  /// it unknown, terminals differ in where it goes.
+  /// </summary>
+  bool cursor_known_;
+  size_t cursor_row_;
+  size_t cursor_column_;
+};
+
+}  // namespace chip8::video
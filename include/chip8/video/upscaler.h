@@ -0,0 +1,148 @@
+#pragma once
+
+#include <chip8/core/constants.h>
+#include <chip8/core/framebuffer.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// Namespace for software rendering of the emulated screen.
+/// </summary>
+namespace chip8::video {
+
+/// <summary>
+/// Output pixel formats. kArgb8888 pixels are native endian uint32 values
+/// (like SDL_PIXELFORMAT_ARGB8888), kRgb24 stores R, G, B bytes and kY8 a
+/// single luma byte.
+/// </summary>
+enum class PixelFormat { kArgb8888, kRgb24, kY8 };
+
+/// <summary>
+/// Implementations of the row scaler.
+/// </summary>
+enum class Kernel { kScalar, kSse2, kAvx2 };
+
+/// <summary>
+/// Colors of lit and unlit pixels as 0xAARRGGBB. Defaults match Screen.
+/// </summary>
+struct Palette {
+  uint32_t on{0xFFFFFFFFu};
+  uint32_t off{0xFF000000u};
+};
+
+/// <summary>
+/// Returns size of a single pixel in bytes.
+/// </summary>
+size_t GetBytesPerPixel(PixelFormat format) noexcept;
+
+/// <summary>
+/// Returns true if the kernel was compiled in and the cpu supports it.
+/// </summary>
+bool IsKernelSupported(Kernel kernel) noexcept;
+
+/// <summary>
+/// Expands a packed Framebuffer into a scaled image, by default
+/// kScreenWidth x kScreenHeight like the SDL renderer.
+/// <para>
+/// Every pair of emulated pixels becomes a span of 2 * scale output pixels.
+/// The scalar kernel copies one of four precomputed spans, SIMD kernels
+/// build the span from the two pixel bits with byte masks.
+/// Only the first line of every scaled row is built this way, the other
+/// scale - 1 lines are copies of it. The fastest supported kernel is
+/// selected at construction; SIMD kernels need spans whose size is a
+/// multiple of the vector width, otherwise the scalar one is used.
+/// </para>
+/// </summary>
+class Upscaler {
+ public:
+  /// <summary>
+  /// Prepares scaling into given format.
+  /// </summary>
+  /// <param name="format">Output pixel format.</param>
+  /// <param name="scale">Size of an emulated pixel in output pixels.</param>
+  /// <param name="palette">Output colors.</param>
+  explicit Upscaler(PixelFormat format, size_t scale = core::kPixelSize,
+                    Palette palette = {});
+
+  /// <summary>
+  /// Selects a kernel.
+  /// </summary>
+  /// <returns>False if kernel cannot be used, selection is unchanged.</returns>
+  bool SetKernel(Kernel kernel) noexcept;
+
+  /// <summary>
+  /// Returns selected kernel.
+  /// </summary>
+  Kernel GetKernel() const noexcept;
+
+  /// <summary>
+  /// Returns output width in pixels.
+  /// </summary>
+  size_t GetWidth() const noexcept;
+
+  /// <summary>
+  /// Returns output height in pixels.
+  /// </summary>
+  size_t GetHeight() const noexcept;
+
+  /// <summary>
+  /// Returns size of an output line in bytes. Lines are tightly packed.
+  /// </summary>
+  size_t GetPitch() const noexcept;
+
+  /// <summary>
+  /// Returns size of the whole output image in bytes.
+  /// </summary>
+  size_t GetFrameSize() const noexcept;
+
+  /// <summary>
+  /// Scales a framebuffer.
+  /// </summary>
+  /// <param name="framebuffer">Packed screen.</param>
+  /// <param name="out">Output image, at least GetFrameSize() bytes.</param>
+  /// <returns>False if output is too small.</returns>
+  bool Scale(const core::Framebuffer& framebuffer,
+             std::span<uint8_t> out) const noexcept;
+
+ private:
+  /// <summary>
+  /// Output format.
+  /// </summary>
+  PixelFormat format_;
+
+  /// <summary>
+  /// Size of an emulated pixel in output pixels.
+  /// </summary>
+  size_t scale_;
+
+  /// <summary>
+  /// Size of an output pixel in bytes.
+  /// </summary>
+  size_t bytes_per_pixel_;
+
+  /// <summary>
+  /// Selected kernel.
+  /// </summary>
+  Kernel kernel_;
+
+  /// <summary>
+  /// Scaled spans of every pixel pair, indexed by two bits of a row.
+  /// </summary>
+  std::array<std::vector<uint8_t>, 4> spans_;
+
+  /// <summary>
+  /// Lit span XORed with unlit span, used by SIMD kernels.
+  /// </summary>
+  std::vector<uint8_t> diff_;
+
+  /// <summary>
+  /// Mask of bytes belonging to the first pixel of a span.
+  /// </summary>
+  std::vector<uint8_t> first_;
+};
+
+}  // namespace chip8::video
@@ -0,0 +1,122 @@
+#include <chip8/analysis/disassembler.h>
+
+#include <cstdio>
+
+namespace chip8::analysis {
+
+std::string Disassemble(uint16_t opcode) {
+  const unsigned x{(opcode & 0x0F00u) >> 8u};
+  const unsigned y{(opcode & 0x00F0u) >> 4u};
+  const unsigned n{opcode & 0x000Fu};
+  const unsigned kk{opcode & 0x00FFu};
+  const unsigned nnn{opcode & 0x0FFFu};
+
+  char buffer[32];
+  auto format{[&buffer](const char* pattern, auto... args) {
+    std::snprintf(buffer, sizeof(buffer), pattern, args...);
+    return std::string(buffer);
+  }};
+
+  switch (opcode & 0xF000u) {
+    case 0x0000:
+      if (opcode == 0x00E0) {
+        return "CLS";
+      }
+      if (opcode == 0x00EE) {
+        return "RET";
+      }
+      break;
+    case 0x1000:
+      return format("JP 0x%03X", nnn);
+    case 0x2000:
+      return format("CALL 0x%03X", nnn);
+    case 0x3000:
+      return format("SE V%X, 0x%02X", x, kk);
+    case 0x4000:
+      return format("SNE V%X, 0x%02X", x, kk);
+    case 0x5000:
+      if (n == 0x0) {
+        return format("SE V%X, V%X", x, y);
+      }
+      break;
+    case 0x6000:
+      return format("LD V%X, 0x%02X", x, kk);
+    case 0x7000:
+      return format("ADD V%X, 0x%02X", x, kk);
+    case 0x8000:
+      switch (n) {
+        case 0x0:
+          return format("LD V%X, V%X", x, y);
+        case 0x1:
+          return format("OR V%X, V%X", x, y);
+        case 0x2:
+          return format("AND V%X, V%X", x, y);
+        case 0x3:
+          return format("XOR V%X, V%X", x, y);
+        case 0x4:
+          return format("ADD V%X, V%X", x, y);
+        case 0x5:
+          return format("SUB V%X, V%X", x, y);
+        case 0x6:
+          return format("SHR V%X {, V%X}", x, y);
+        case 0x7:
+          return format("SUBN V%X, V%X", x, y);
+        case 0xE:
+          return format("SHL V%X {, V%X}", x, y);
+        default:
+          break;
+      }
+      break;
+    case 0x9000:
+      if (n == 0x0) {
+        return format("SNE V%X, V%X", x, y);
+      }
+      break;
+    case 0xA000:
+      return format("LD I, 0x%03X", nnn);
+    case 0xB000:
+      return format("JP V0, 0x%03X", nnn);
+    case 0xC000:
+      return format("RND V%X, 0x%02X", x, kk);
+    case 0xD000:
+      return format("DRW V%X, V%X, %u", x, y, n);
+    case 0xE000:
+      if (kk == 0x9E) {
+        return format("SKP V%X", x);
+      }
+      if (kk == 0xA1) {
+        return format("SKNP V%X", x);
+      }
+      break;
+    case 0xF000:
+      switch (kk) {
+        case 0x07:
+          return format("LD V%X, DT", x);
+        case 0x0A:
+          return format("LD V%X, K", x);
+        case 0x15:
+          return format("LD DT, V%X", x);
+        case 0x18:
+          return format("LD ST, V%X", x);
+        case 0x1E:
+          return format("ADD I, V%X", x);
+        case 0x29:
+          return format("LD F, V%X", x);
+        case 0x33:
+          return format("LD B, V%X", x);
+        case 0x55:
+          return format("LD [I], V%X", x);
+        case 0x65:
+          return format("LD V%X, [I]", x);
+        default:
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+
+  return format("DW 0x%04X", static_cast<unsigned>(opcode));
+}
+
+}  // namespace chip8::analysis
@@ -0,0 +1,422 @@
+#include <chip8/analysis/rom_analyzer.h>
+#include <chip8/utils/logger.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace chip8::analysis {
+
+namespace {
+
+/// <summary>
+/// Checks whether opcode conditionally skips the next instruction.
+/// </summary>
+bool IsSkip(uint16_t opcode) noexcept {
+  switch (opcode & 0xF000u) {
+    case 0x3000:
+    case 0x4000:
+    case 0x5000:
+    case 0x9000:
+      return true;
+    case 0xE000:
+      return (opcode & 0x00FFu) == 0x9Eu || (opcode & 0x00FFu) == 0xA1u;
+    default:
+      return false;
+  }
+}
+
+/// <summary>
+/// Checks whether opcode transfers control somewhere else than to the next
+/// instruction.
+/// </summary>
+bool EndsBlock(uint16_t opcode) noexcept {
+  return opcode == 0x00EEu || (opcode & 0xF000u) == 0x1000u ||
+         (opcode & 0xF000u) == 0x2000u || (opcode & 0xF000u) == 0xB000u ||
+         IsSkip(opcode);
+}
+
+const char* KindName(ByteKind kind) noexcept {
+  switch (kind) {
+    case ByteKind::kCode:
+      return "code";
+    case ByteKind::kSprite:
+      return "sprite";
+    case ByteKind::kData:
+      return "data";
+    default:
+      return "unknown";
+  }
+}
+
+std::optional<ByteKind> KindFromName(const std::string& name) noexcept {
+  if (name == "code") {
+    return ByteKind::kCode;
+  }
+  if (name == "sprite") {
+    return ByteKind::kSprite;
+  }
+  if (name == "data") {
+    return ByteKind::kData;
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+RomAnalyzer::RomAnalyzer(std::span<const uint8_t> rom) noexcept
+    : memory_(), map_(), leaders_(), worklist_(), writes_() {
+  const size_t size{
+      std::min(rom.size(), memory_.size() - core::kRomStartAddress)};
+  std::copy_n(rom.begin(), size, memory_.begin() + core::kRomStartAddress);
+}
+
+CodeMap RomAnalyzer::Analyze() {
+  AddTarget(core::kRomStartAddress);
+  do {
+    Explore();
+    BuildBlocks();
+  } while (PropagateConstants());
+
+  for (const SelfModifyingWrite& write : writes_) {
+    const size_t end{std::min<size_t>(write.address + write.size,
+                                      map_.kinds.size())};
+    for (size_t address{write.address}; address < end; ++address) {
+      if (map_.kinds[address] == ByteKind::kCode) {
+        map_.self_modifying.push_back(write);
+        break;
+      }
+    }
+  }
+
+  LOG_DEBUG("ROM analysis finished: {} blocks, {} self-modifying writes.",
+            map_.blocks.size(), map_.self_modifying.size());
+  return map_;
+}
+
+uint16_t RomAnalyzer::Fetch(size_t address) const noexcept {
+  return static_cast<uint16_t>((memory_[address] << 8u) |
+                               memory_[address + 1]);
+}
+
+void RomAnalyzer::Explore() {
+  while (!worklist_.empty()) {
+    size_t address{worklist_.back()};
+    worklist_.pop_back();
+
+    while (address + 1 < memory_.size() && !map_.instructions[address]) {
+      map_.instructions[address] = true;
+      map_.kinds[address] = ByteKind::kCode;
+      map_.kinds[address + 1] = ByteKind::kCode;
+
+      const uint16_t opcode{Fetch(address)};
+      if ((opcode & 0xF000u) == 0x1000u) {
+        AddTarget(opcode & 0x0FFFu);
+        break;
+      }
+      if ((opcode & 0xF000u) == 0x2000u) {
+        AddTarget(opcode & 0x0FFFu);
+        AddTarget(address + 2);
+        break;
+      }
+      if (IsSkip(opcode)) {
+        AddTarget(address + 2);
+        AddTarget(address + 4);
+        break;
+      }
+      if (EndsBlock(opcode)) {
+        break;
+      }
+      address += 2;
+    }
+  }
+}
+
+void RomAnalyzer::BuildBlocks() {
+  map_.blocks.clear();
+
+  for (size_t start{}; start < memory_.size(); ++start) {
+    if (!leaders_[start] || !map_.instructions[start]) {
+      continue;
+    }
+
+    BasicBlock block{static_cast<uint16_t>(start), 0, {}, false};
+    size_t address{start};
+    while (true) {
+      const uint16_t opcode{Fetch(address)};
+      const size_t next{address + 2};
+      block.end = static_cast<uint16_t>(next);
+
+      if (EndsBlock(opcode)) {
+        if ((opcode & 0xF000u) == 0x1000u) {
+          block.successors.push_back(opcode & 0x0FFFu);
+        } else if ((opcode & 0xF000u) == 0x2000u) {
+          block.successors.push_back(opcode & 0x0FFFu);
+          block.successors.push_back(static_cast<uint16_t>(next));
+        } else if (IsSkip(opcode)) {
+          block.successors.push_back(static_cast<uint16_t>(next));
+          block.successors.push_back(static_cast<uint16_t>(next + 2));
+        } else if ((opcode & 0xF000u) == 0xB000u) {
+          block.computed_jump = true;
+        }
+        break;
+      }
+
+      if (next + 1 >= memory_.size() || !map_.instructions[next] ||
+          leaders_[next]) {
+        if (next + 1 < memory_.size() && map_.instructions[next]) {
+          block.successors.push_back(static_cast<uint16_t>(next));
+        }
+        break;
+      }
+      address = next;
+    }
+
+    map_.blocks.push_back(std::move(block));
+  }
+}
+
+bool RomAnalyzer::PropagateConstants() {
+  bool discovered{false};
+  writes_.clear();
+
+  for (BasicBlock& block : map_.blocks) {
+    std::array<std::optional<uint8_t>, 16> v{};
+    std::optional<uint16_t> i{};
+
+    for (size_t address{block.start}; address < block.end; address += 2) {
+      const uint16_t opcode{Fetch(address)};
+      const uint8_t x{static_cast<uint8_t>((opcode & 0x0F00u) >> 8u)};
+      const uint8_t y{static_cast<uint8_t>((opcode & 0x00F0u) >> 4u)};
+      const uint8_t n{static_cast<uint8_t>(opcode & 0x000Fu)};
+      const uint8_t kk{static_cast<uint8_t>(opcode & 0x00FFu)};
+      const uint16_t nnn{static_cast<uint16_t>(opcode & 0x0FFFu)};
+
+      switch (opcode & 0xF000u) {
+        case 0x6000:
+          v[x] = kk;
+          break;
+        case 0x7000:
+          if (v[x]) {
+            v[x] = static_cast<uint8_t>(*v[x] + kk);
+          }
+          break;
+        case 0x8000:
+          if (n == 0x0) {
+            v[x] = v[y];
+          } else {
+            v[x].reset();
+            v[0xF].reset();
+          }
+          break;
+        case 0xA000:
+          i = nnn;
+          break;
+        case 0xB000:
+          if (v[0]) {
+            const uint16_t target{static_cast<uint16_t>(nnn + *v[0])};
+            block.computed_jump = false;
+            block.successors.assign(1, target);
+            if (target + 1u < memory_.size() && !leaders_[target]) {
+              AddTarget(target);
+              discovered = true;
+            }
+          }
+          break;
+        case 0xC000:
+          v[x].reset();
+          break;
+        case 0xD000:
+          if (i) {
+            MarkData(*i, n, ByteKind::kSprite);
+          }
+          v[0xF].reset();
+          break;
+        case 0xF000:
+          switch (kk) {
+            case 0x07:
+            case 0x0A:
+              v[x].reset();
+              break;
+            case 0x1E:
+              i = (i && v[x]) ? std::optional<uint16_t>(*i + *v[x])
+                              : std::nullopt;
+              v[0xF].reset();
+              break;
+            case 0x29:
+              i = v[x] ? std::optional<uint16_t>(core::kFontsetStartAddress +
+                                                 5 * *v[x])
+                       : std::nullopt;
+              break;
+            case 0x33:
+              if (i) {
+                writes_.push_back({static_cast<uint16_t>(address), *i, 3});
+                MarkData(*i, 3, ByteKind::kData);
+              }
+              break;
+            case 0x55:
+              if (i) {
+                writes_.push_back({static_cast<uint16_t>(address), *i,
+                                   static_cast<uint16_t>(x + 1)});
+                MarkData(*i, x + 1, ByteKind::kData);
+                i = static_cast<uint16_t>(*i + x + 1);
+              }
+              break;
+            case 0x65:
+              if (i) {
+                MarkData(*i, x + 1, ByteKind::kData);
+                i = static_cast<uint16_t>(*i + x + 1);
+              }
+              for (uint8_t reg{}; reg <= x; ++reg) {
+                v[reg].reset();
+              }
+              break;
+            default:
+              break;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  return discovered;
+}
+
+void RomAnalyzer::AddTarget(size_t address) {
+  if (address + 1 >= memory_.size()) {
+    LOG_DEBUG("Ignoring branch target outside of memory: {:#05x}", address);
+    return;
+  }
+  leaders_[address] = true;
+  worklist_.push_back(static_cast<uint16_t>(address));
+}
+
+void RomAnalyzer::MarkData(size_t address, size_t size,
+                           ByteKind kind) noexcept {
+  const size_t end{std::min(address + size, map_.kinds.size())};
+  for (; address < end; ++address) {
+    if (map_.kinds[address] != ByteKind::kCode) {
+      map_.kinds[address] = kind;
+    }
+  }
+}
+
+bool RomAnalyzer::Save(const CodeMap& map, const std::filesystem::path& path) {
+  std::ofstream out_stream(path);
+  if (!out_stream.is_open()) {
+    LOG_ERROR("Failed to open code map for writing ('{}')", path.string());
+    return false;
+  }
+
+  out_stream << "# chip8 code map\n" << std::hex << std::showbase;
+
+  for (size_t start{}; start < map.kinds.size();) {
+    size_t end{start + 1};
+    while (end < map.kinds.size() && map.kinds[end] == map.kinds[start]) {
+      ++end;
+    }
+    if (map.kinds[start] != ByteKind::kUnknown) {
+      out_stream << "kind " << start << ' ' << end << ' '
+                 << KindName(map.kinds[start]) << '\n';
+    }
+    start = end;
+  }
+
+  for (size_t address{}; address < map.instructions.size(); ++address) {
+    if (map.instructions[address]) {
+      out_stream << "insn " << address << '\n';
+    }
+  }
+
+  for (const BasicBlock& block : map.blocks) {
+    out_stream << "block " << block.start << ' ' << block.end << ' '
+               << (block.computed_jump ? 1 : 0);
+    for (uint16_t successor : block.successors) {
+      out_stream << ' ' << successor;
+    }
+    out_stream << '\n';
+  }
+
+  for (const SelfModifyingWrite& write : map.self_modifying) {
+    out_stream << "smc " << write.instruction << ' ' << write.address << ' '
+               << write.size << '\n';
+  }
+
+  return static_cast<bool>(out_stream);
+}
+
+std::optional<CodeMap> RomAnalyzer::Load(const std::filesystem::path& path) {
+  std::ifstream in_stream(path);
+  if (!in_stream.is_open()) {
+    LOG_ERROR("Failed to open code map ('{}')", path.string());
+    return std::nullopt;
+  }
+
+  CodeMap map{};
+  std::string line;
+  size_t line_number{};
+  while (std::getline(in_stream, line)) {
+    ++line_number;
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+
+    std::istringstream fields(line);
+    fields >> std::setbase(0);
+    std::string tag;
+    fields >> tag;
+
+    bool valid{false};
+    if (tag == "kind") {
+      size_t start{}, end{};
+      std::string name;
+      fields >> start >> end >> name;
+      const std::optional<ByteKind> kind{KindFromName(name)};
+      valid = fields && kind && start < end && end <= map.kinds.size();
+      if (valid) {
+        std::fill(map.kinds.begin() + start, map.kinds.begin() + end, *kind);
+      }
+    } else if (tag == "insn") {
+      size_t address{};
+      fields >> address;
+      valid = fields && address < map.instructions.size();
+      if (valid) {
+        map.instructions[address] = true;
+      }
+    } else if (tag == "block") {
+      BasicBlock block{};
+      int computed{};
+      fields >> block.start >> block.end >> computed;
+      valid = static_cast<bool>(fields);
+      block.computed_jump = computed != 0;
+      uint16_t successor{};
+      while (fields >> successor) {
+        block.successors.push_back(successor);
+      }
+      if (valid) {
+        map.blocks.push_back(std::move(block));
+      }
+    } else if (tag == "smc") {
+      SelfModifyingWrite write{};
+      fields >> write.instruction >> write.address >> write.size;
+      valid = static_cast<bool>(fields);
+      if (valid) {
+        map.self_modifying.push_back(write);
+      }
+    }
+
+    if (!valid) {
+      LOG_ERROR("Malformed code map line {} ('{}')", line_number,
+                path.string());
+      return std::nullopt;
+    }
+  }
+
+  return map;
+}
+
+}  // namespace chip8::analysis
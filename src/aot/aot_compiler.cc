@@ -0,0 +1,442 @@
+#include <chip8/analysis/disassembler.h>
+#include <chip8/aot/aot_compiler.h>
+#include <chip8/core/constants.h>
+#include <chip8/utils/logger.h>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace chip8::aot {
+
+namespace {
+
+/// <summary>
+/// Appends printf-style formatted text to a string.
+/// </summary>
+template <typename... Args>
+void Append(std::string& out, const char* pattern, Args... args) {
+  const int size{std::snprintf(nullptr, 0, pattern, args...)};
+  if (size <= 0) {
+    return;
+  }
+  const size_t offset{out.size()};
+  out.resize(offset + static_cast<size_t>(size) + 1);
+  std::snprintf(out.data() + offset, static_cast<size_t>(size) + 1, pattern,
+                args...);
+  out.resize(offset + static_cast<size_t>(size));
+}
+
+/// <summary>
+/// Checks whether generated code of an instruction always leaves the block
+/// (jumps, calls, returns and skips).
+/// </summary>
+bool AlwaysExits(uint16_t opcode) noexcept {
+  switch (opcode & 0xF000u) {
+    case 0x0000:
+      return opcode == 0x00EEu;
+    case 0x1000:
+    case 0x2000:
+    case 0x3000:
+    case 0x4000:
+    case 0x5000:
+    case 0x9000:
+    case 0xB000:
+      return true;
+    case 0xE000:
+      return (opcode & 0x000Fu) == 0xEu || (opcode & 0x000Fu) == 0x1u;
+    default:
+      return false;
+  }
+}
+
+/// <summary>
+/// Code placed before generated blocks. Draw() mirrors core::OpcodeDXYN().
+/// </summary>
+constexpr const char* kPrologue{R"(// Generated by chip8-aot. Do not edit.
+#include <chip8/aot/aot_abi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+using chip8::aot::AotState;
+
+#define CHIP8_EXIT(next_pc, last_opcode, count) \
+  do {                                          \
+    *s->program_counter = (next_pc);            \
+    *s->opcode = (last_opcode);                 \
+    return (count);                             \
+  } while (0)
+
+void Draw(AotState* s, unsigned x, unsigned y, unsigned height) {
+  uint8_t* const v = s->registers;
+  const uint8_t start_x = v[x];
+  const uint8_t start_y = v[y];
+
+  v[0xF] = 0;
+
+  for (uint8_t row_idx = 0; row_idx < height; ++row_idx) {
+    const uint8_t screen_y = (start_y + row_idx) % 32;
+    const uint8_t sprite_byte = s->memory[*s->index_register + row_idx];
+    for (uint8_t pixel_idx = 0; pixel_idx < 8; ++pixel_idx) {
+      const uint8_t screen_x = (start_x + pixel_idx) % 64;
+      if ((sprite_byte & (0x80u >> pixel_idx)) != 0) {
+        const size_t screen_idx = screen_y * 64 + screen_x;
+        if (s->screen[screen_idx]) {
+          v[0xF] = 1;
+        }
+        s->screen[screen_idx] = !s->screen[screen_idx];
+      }
+    }
+  }
+}
+
+)"};
+
+}  // namespace
+
+AotCompiler::AotCompiler(std::span<const uint8_t> rom)
+    : rom_(rom.begin(), rom.end()), memory_(), blocks_() {
+  rom_.resize(std::min(rom_.size(), memory_.size() - core::kRomStartAddress));
+  std::copy(rom_.begin(), rom_.end(),
+            memory_.begin() + core::kRomStartAddress);
+}
+
+std::string AotCompiler::Generate() {
+  const analysis::CodeMap map{analysis::RomAnalyzer(rom_).Analyze()};
+
+  blocks_.clear();
+  const size_t rom_end{core::kRomStartAddress + rom_.size()};
+  for (const analysis::BasicBlock& block : map.blocks) {
+    if (block.start >= core::kRomStartAddress && block.end <= rom_end) {
+      blocks_.push_back(block);
+    }
+  }
+
+  std::string out{kPrologue};
+  for (const analysis::BasicBlock& block : blocks_) {
+    EmitBlock(block, out);
+  }
+
+  out += "const uint8_t kRom[] = {";
+  for (size_t i{}; i < rom_.size(); ++i) {
+    Append(out, "%s0x%02X,", i % 12 == 0 ? "\n    " : " ", rom_[i]);
+  }
+  out += "\n};\n\n";
+
+  if (blocks_.empty()) {
+    out += "const chip8::aot::AotBlock* const kBlocks{nullptr};\n\n";
+  } else {
+    out += "const chip8::aot::AotBlock kBlocks[] = {\n";
+    for (const analysis::BasicBlock& block : blocks_) {
+      uint32_t instructions{};
+      for (size_t address{block.start}; address < block.end; address += 2) {
+        ++instructions;
+        if (AlwaysExits(Fetch(address))) {
+          break;
+        }
+      }
+      Append(out, "    {0x%03X, 0x%03X, %u, &Block_%03X},\n", block.start,
+             block.end, instructions, block.start);
+    }
+    out += "};\n\n";
+  }
+
+  Append(out,
+         "const chip8::aot::AotModule kModule{chip8::aot::kAbiVersion, kRom, "
+         "sizeof(kRom), kBlocks, %zu};\n\n",
+         blocks_.size());
+
+  out += R"(}  // namespace
+
+#if defined(_WIN32)
+#define CHIP8_AOT_EXPORT __declspec(dllexport)
+#else
+#define CHIP8_AOT_EXPORT __attribute__((visibility("default")))
+#endif
+
+extern "C" CHIP8_AOT_EXPORT const chip8::aot::AotModule*
+chip8_aot_get_module() {
+  return &kModule;
+}
+)";
+
+  LOG_DEBUG("Generated {} compiled blocks.", blocks_.size());
+  return out;
+}
+
+size_t AotCompiler::GetBlockCount() const noexcept { return blocks_.size(); }
+
+void AotCompiler::EmitBlock(const analysis::BasicBlock& block,
+                            std::string& out) const {
+  Append(out, "// Block 0x%03X-0x%03X\n", block.start, block.end);
+  Append(out, "uint32_t Block_%03X(AotState* s) {\n", block.start);
+  out +=
+      "  [[maybe_unused]] uint8_t* const v = s->registers;\n"
+      "  [[maybe_unused]] uint8_t* const m = s->memory;\n"
+      "  [[maybe_unused]] uint16_t& i = *s->index_register;\n";
+
+  uint32_t index{};
+  uint16_t previous{};
+  uint16_t address{block.start};
+  for (; address < block.end; address += 2) {
+    const uint16_t opcode{Fetch(address)};
+    Append(out, "\n  // 0x%03X  %04X  %s\n", address, opcode,
+           analysis::Disassemble(opcode).c_str());
+    EmitInstruction(address, index, previous, out);
+    ++index;
+    previous = opcode;
+
+    // Instructions transferring control always leave the block
+    if (AlwaysExits(opcode)) {
+      out += "}\n\n";
+      return;
+    }
+  }
+
+  Append(out, "\n  CHIP8_EXIT(0x%03X, 0x%04X, %u);\n}\n\n", address, previous,
+         index);
+}
+
+void AotCompiler::EmitInstruction(uint16_t address, uint32_t index,
+                                  uint16_t previous, std::string& out) const {
+  const uint16_t opcode{Fetch(address)};
+  const unsigned x{(opcode & 0x0F00u) >> 8u};
+  const unsigned y{(opcode & 0x00F0u) >> 4u};
+  const unsigned n{opcode & 0x000Fu};
+  const unsigned kk{opcode & 0x00FFu};
+  const unsigned nnn{opcode & 0x0FFFu};
+  const unsigned next{address + 2u};
+  const unsigned skip{address + 4u};
+  const unsigned count{index + 1};
+
+  // Leaves the block before this instruction, so that the interpreter
+  // executes it (and reports errors the same way it always does).
+  std::string fallback;
+  if (index == 0) {
+    Append(fallback, "CHIP8_EXIT(0x%03X, *s->opcode, 0);", address);
+  } else {
+    Append(fallback, "CHIP8_EXIT(0x%03X, 0x%04X, %u);", address, previous,
+           index);
+  }
+  const char* exit_to_interpreter{fallback.c_str()};
+
+  auto skip_if{[&](const char* condition) {
+    Append(out, "  CHIP8_EXIT((%s) ? 0x%03X : 0x%03X, 0x%04X, %u);\n",
+           condition, skip, next, opcode, count);
+  }};
+
+  std::string condition;
+  switch (opcode & 0xF000u) {
+    case 0x0000:
+      if (opcode == 0x00E0) {
+        out += "  std::fill_n(s->screen, 64 * 32, false);\n";
+      } else if (opcode == 0x00EE) {
+        Append(out, "  if (*s->stack_pointer == 0) %s\n", exit_to_interpreter);
+        Append(out,
+               "  CHIP8_EXIT(s->stack[--*s->stack_pointer], 0x%04X, %u);\n",
+               opcode, count);
+      } else {
+        // Unknown opcodes are counted by the interpreter
+        Append(out, "  %s\n", exit_to_interpreter);
+      }
+      break;
+    case 0x1000:
+      Append(out, "  CHIP8_EXIT(0x%03X, 0x%04X, %u);\n", nnn, opcode, count);
+      break;
+    case 0x2000:
+      Append(out, "  if (*s->stack_pointer >= 16) %s\n", exit_to_interpreter);
+      Append(out, "  s->stack[(*s->stack_pointer)++] = 0x%03X;\n", next);
+      Append(out, "  CHIP8_EXIT(0x%03X, 0x%04X, %u);\n", nnn, opcode, count);
+      break;
+    case 0x3000:
+      Append(condition, "v[0x%X] == 0x%02X", x, kk);
+      skip_if(condition.c_str());
+      break;
+    case 0x4000:
+      Append(condition, "v[0x%X] != 0x%02X", x, kk);
+      skip_if(condition.c_str());
+      break;
+    case 0x5000:
+      Append(condition, "v[0x%X] == v[0x%X]", x, y);
+      skip_if(condition.c_str());
+      break;
+    case 0x6000:
+      Append(out, "  v[0x%X] = 0x%02X;\n", x, kk);
+      break;
+    case 0x7000:
+      Append(out, "  v[0x%X] = static_cast<uint8_t>(v[0x%X] + 0x%02X);\n", x,
+             x, kk);
+      break;
+    case 0x8000:
+      switch (n) {
+        case 0x0:
+          Append(out, "  v[0x%X] = v[0x%X];\n", x, y);
+          break;
+        case 0x1:
+          Append(out, "  v[0x%X] = v[0x%X] | v[0x%X];\n", x, x, y);
+          break;
+        case 0x2:
+          Append(out, "  v[0x%X] = v[0x%X] & v[0x%X];\n", x, x, y);
+          break;
+        case 0x3:
+          Append(out, "  v[0x%X] = v[0x%X] ^ v[0x%X];\n", x, x, y);
+          break;
+        case 0x4:
+          Append(out,
+                 "  {\n"
+                 "    const uint16_t sum = static_cast<uint16_t>(v[0x%X] + "
+                 "v[0x%X]);\n"
+                 "    v[0xF] = (sum > 0xFFu) ? 1 : 0;\n"
+                 "    v[0x%X] = sum & 0xFFu;\n"
+                 "  }\n",
+                 x, y, x);
+          break;
+        case 0x5:
+          Append(out,
+                 "  v[0xF] = (v[0x%X] > v[0x%X]) ? 1 : 0;\n"
+                 "  v[0x%X] = static_cast<uint8_t>(v[0x%X] - v[0x%X]);\n",
+                 x, y, x, x, y);
+          break;
+        case 0x6:
+          Append(out,
+                 "  v[0xF] = v[0x%X] & 0x1u;\n"
+                 "  v[0x%X] = static_cast<uint8_t>(v[0x%X] >> 1u);\n",
+                 x, x, x);
+          break;
+        case 0x7:
+          Append(out,
+                 "  v[0xF] = (v[0x%X] < v[0x%X]) ? 1 : 0;\n"
+                 "  v[0x%X] = static_cast<uint8_t>(v[0x%X] - v[0x%X]);\n",
+                 x, y, x, y, x);
+          break;
+        case 0xE:
+          Append(out,
+                 "  v[0xF] = (v[0x%X] >> 7u) ? 1 : 0;\n"
+                 "  v[0x%X] = static_cast<uint8_t>(v[0x%X] << 1u);\n",
+                 x, x, x);
+          break;
+        default:
+          // Unknown opcodes are counted by the interpreter
+          Append(out, "  %s\n", exit_to_interpreter);
+      }
+      break;
+    case 0x9000:
+      Append(condition, "v[0x%X] != v[0x%X]", x, y);
+      skip_if(condition.c_str());
+      break;
+    case 0xA000:
+      Append(out, "  i = 0x%03X;\n", nnn);
+      break;
+    case 0xB000:
+      Append(out,
+             "  CHIP8_EXIT(static_cast<uint16_t>(0x%03X + v[0x0]), 0x%04X, "
+             "%u);\n",
+             nnn, opcode, count);
+      break;
+    case 0xC000:
+      Append(out, "  v[0x%X] = s->random(s->cpu) & 0x%02X;\n", x, kk);
+      break;
+    case 0xD000:
+      Append(out, "  if (i + %u > 4096) %s\n", n, exit_to_interpreter);
+      Append(out, "  Draw(s, 0x%X, 0x%X, %u);\n", x, y, n);
+      break;
+    case 0xE000:
+      if (n == 0xE || n == 0x1) {
+        // Like the interpreter, the key numbered by X is checked
+        Append(condition, n == 0xE ? "s->keys[0x%X]" : "!s->keys[0x%X]", x);
+        skip_if(condition.c_str());
+      } else {
+        // Unknown opcodes are counted by the interpreter
+        Append(out, "  %s\n", exit_to_interpreter);
+      }
+      break;
+    case 0xF000:
+      switch (kk) {
+        case 0x07:
+          Append(out, "  v[0x%X] = *s->delay_timer;\n", x);
+          break;
+        case 0x0A:
+          Append(out,
+                 "  {\n"
+                 "    bool pressed = false;\n"
+                 "    for (uint8_t key = 0; key <= 0xFu; ++key) {\n"
+                 "      if (s->keys[key]) {\n"
+                 "        v[0x%X] = key;\n"
+                 "        pressed = true;\n"
+                 "      }\n"
+                 "    }\n"
+                 "    if (!pressed) CHIP8_EXIT(0x%03X, 0x%04X, %u);\n"
+                 "  }\n",
+                 x, address, opcode, count);
+          break;
+        case 0x15:
+          Append(out, "  *s->delay_timer = v[0x%X];\n", x);
+          break;
+        case 0x18:
+          Append(out, "  *s->sound_timer = v[0x%X];\n", x);
+          break;
+        case 0x1E:
+          Append(out,
+                 "  {\n"
+                 "    const uint16_t vx_value = v[0x%X];\n"
+                 "    v[0xF] = (i + vx_value > 0xFFFu) ? 1 : 0;\n"
+                 "    i = static_cast<uint16_t>(i + vx_value);\n"
+                 "  }\n",
+                 x);
+          break;
+        case 0x29:
+          Append(out, "  i = static_cast<uint16_t>(0x%03zX + 5 * v[0x%X]);\n",
+                 core::kFontsetStartAddress, x);
+          break;
+        case 0x33:
+          Append(out, "  if (i + 2 >= 4096) %s\n", exit_to_interpreter);
+          Append(out,
+                 "  {\n"
+                 "    uint8_t num = v[0x%X];\n"
+                 "    m[i + 2] = num %% 10;\n"
+                 "    num /= 10;\n"
+                 "    m[i + 1] = num %% 10;\n"
+                 "    num /= 10;\n"
+                 "    m[i] = num %% 10;\n"
+                 "  }\n"
+                 "  if (s->on_write(s->cpu, i, 3)) CHIP8_EXIT(0x%03X, 0x%04X, "
+                 "%u);\n",
+                 x, next, opcode, count);
+          break;
+        case 0x55:
+          Append(out, "  if (i + %u > 4096) %s\n", x + 1, exit_to_interpreter);
+          Append(out,
+                 "  std::memcpy(m + i, v, %u);\n"
+                 "  {\n"
+                 "    const bool overwritten = s->on_write(s->cpu, i, %u);\n"
+                 "    i = static_cast<uint16_t>(i + %u);\n"
+                 "    if (overwritten) CHIP8_EXIT(0x%03X, 0x%04X, %u);\n"
+                 "  }\n",
+                 x + 1, x + 1, x + 1, next, opcode, count);
+          break;
+        case 0x65:
+          Append(out, "  if (i + %u > 4096) %s\n", x + 1, exit_to_interpreter);
+          Append(out,
+                 "  std::memcpy(v, m + i, %u);\n"
+                 "  i = static_cast<uint16_t>(i + %u);\n",
+                 x + 1, x + 1);
+          break;
+        default:
+          // Unknown opcodes are counted by the interpreter
+          Append(out, "  %s\n", exit_to_interpreter);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+uint16_t AotCompiler::Fetch(size_t address) const noexcept {
+  return static_cast<uint16_t>((memory_[address] << 8u) |
+                               memory_[address + 1]);
+}
+
+}  // namespace chip8::aot
@@ -0,0 +1,82 @@
+#include <chip8/aot/aot_plugin.h>
+#include <chip8/utils/logger.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace chip8::aot {
+
+namespace {
+
+void* OpenLibrary(const std::filesystem::path& path) noexcept {
+#if defined(_WIN32)
+  return reinterpret_cast<void*>(LoadLibraryW(path.c_str()));
+#else
+  return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+}
+
+void* FindSymbol(void* handle, const char* name) noexcept {
+#if defined(_WIN32)
+  return reinterpret_cast<void*>(
+      GetProcAddress(reinterpret_cast<HMODULE>(handle), name));
+#else
+  return dlsym(handle, name);
+#endif
+}
+
+void CloseLibrary(void* handle) noexcept {
+#if defined(_WIN32)
+  FreeLibrary(reinterpret_cast<HMODULE>(handle));
+#else
+  dlclose(handle);
+#endif
+}
+
+}  // namespace
+
+std::unique_ptr<AotPlugin> AotPlugin::Load(const std::filesystem::path& path) {
+  void* handle{OpenLibrary(path)};
+  if (handle == nullptr) {
+#if defined(_WIN32)
+    LOG_ERROR("Failed to load AOT plugin ('{}')", path.string());
+#else
+    LOG_ERROR("Failed to load AOT plugin ('{}'): {}", path.string(),
+              dlerror());
+#endif
+    return nullptr;
+  }
+
+  auto get_module{
+      reinterpret_cast<AotGetModuleFn>(FindSymbol(handle, kEntryPoint))};
+  if (get_module == nullptr) {
+    LOG_ERROR("AOT plugin does not export {} ('{}')", kEntryPoint,
+              path.string());
+    CloseLibrary(handle);
+    return nullptr;
+  }
+
+  const AotModule* module{get_module()};
+  if (module == nullptr || module->abi_version != kAbiVersion) {
+    LOG_ERROR("AOT plugin ABI version mismatch, expected {} ('{}')",
+              kAbiVersion, path.string());
+    CloseLibrary(handle);
+    return nullptr;
+  }
+
+  LOG_INFO("Loaded AOT plugin with {} blocks ('{}')", module->block_count,
+           path.string());
+  return std::unique_ptr<AotPlugin>(new AotPlugin(handle, module));
+}
+
+AotPlugin::AotPlugin(void* handle, const AotModule* module) noexcept
+    : handle_(handle), module_(module) {}
+
+AotPlugin::~AotPlugin() noexcept { CloseLibrary(handle_); }
+
+const AotModule* AotPlugin::GetModule() const noexcept { return module_; }
+
+}  // namespace chip8::aot
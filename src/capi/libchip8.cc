@@ -0,0 +1,157 @@
+#include <chip8/capi/libchip8.h>
+
+#include <chip8/core/cpu.h>
+
+#include <new>
+
+struct chip8_instance {
+  chip8::core::Cpu cpu;
+};
+
+struct chip8_snapshot {
+  chip8::core::CpuSnapshot state;
+};
+
+static_assert(sizeof(bool) == sizeof(uint8_t),
+              "Framebuffer is exposed as bytes");
+static_assert(CHIP8_MEMORY_SIZE == chip8::core::kMemorySize);
+
+extern "C" {
+
+uint32_t chip8_abi_version(void) { return CHIP8_ABI_VERSION; }
+
+chip8_instance* chip8_create(void) {
+  return new (std::nothrow) chip8_instance{};
+}
+
+void chip8_destroy(chip8_instance* instance) { delete instance; }
+
+void chip8_reset(chip8_instance* instance) {
+  if (instance != nullptr) {
+    instance->cpu.Reset();
+  }
+}
+
+void chip8_seed(chip8_instance* instance, uint32_t seed) {
+  if (instance != nullptr) {
+    instance->cpu.SeedRNG(seed);
+  }
+}
+
+chip8_result chip8_load_rom(chip8_instance* instance, const uint8_t* data,
+                            size_t size) {
+  if (instance == nullptr || (data == nullptr && size != 0)) {
+    return CHIP8_ERROR_INVALID_ARGUMENT;
+  }
+
+  try {
+    const std::optional<chip8::core::RomImage> rom{
+        chip8::core::RomImage::FromBytes({data, size})};
+    if (!rom) {
+      return CHIP8_ERROR_INVALID_ROM;
+    }
+    instance->cpu.LoadROM(*rom);
+  } catch (const std::bad_alloc&) {
+    return CHIP8_ERROR_OUT_OF_MEMORY;
+  }
+  return CHIP8_OK;
+}
+
+void chip8_run_cycles(chip8_instance* instance, size_t cycles) {
+  if (instance == nullptr) {
+    return;
+  }
+  chip8::core::Cpu& cpu{instance->cpu};
+  for (size_t i{}; i < cycles &&
+                   cpu.GetCriticalError() == chip8::core::CritErrors::kNone;
+       ++i) {
+    cpu.Cycle();
+  }
+}
+
+size_t chip8_run_frames(chip8_instance* instance, size_t frames,
+                        size_t cycles_per_frame) {
+  if (instance == nullptr) {
+    return 0;
+  }
+  size_t executed{};
+  for (size_t i{}; i < frames; ++i) {
+    executed += instance->cpu.RunFrame(cycles_per_frame);
+  }
+  return executed;
+}
+
+void chip8_set_key(chip8_instance* instance, uint8_t key, int pressed) {
+  if (instance != nullptr) {
+    instance->cpu.SetKey(key, pressed != 0);
+  }
+}
+
+void chip8_set_keys(chip8_instance* instance, uint16_t keys) {
+  if (instance == nullptr) {
+    return;
+  }
+  instance->cpu.SetKeyMask(keys);
+}
+
+const uint8_t* chip8_framebuffer(const chip8_instance* instance) {
+  if (instance == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<const uint8_t*>(instance->cpu.GetPixels().data());
+}
+
+const uint8_t* chip8_memory(const chip8_instance* instance) {
+  return instance != nullptr ? instance->cpu.GetMemory().data() : nullptr;
+}
+
+uint8_t chip8_sound_timer(const chip8_instance* instance) {
+  return instance != nullptr ? instance->cpu.GetSoundTimer() : 0;
+}
+
+uint8_t chip8_delay_timer(const chip8_instance* instance) {
+  return instance != nullptr ? instance->cpu.GetDelayTimer() : 0;
+}
+
+uint16_t chip8_program_counter(const chip8_instance* instance) {
+  return instance != nullptr ? instance->cpu.GetProgramCounter() : 0;
+}
+
+chip8_cpu_error chip8_get_error(const chip8_instance* instance) {
+  if (instance == nullptr) {
+    return CHIP8_CPU_OK;
+  }
+  switch (instance->cpu.GetCriticalError()) {
+    case chip8::core::CritErrors::kStackUnderflow:
+      return CHIP8_CPU_STACK_UNDERFLOW;
+    case chip8::core::CritErrors::kStackOverflow:
+      return CHIP8_CPU_STACK_OVERFLOW;
+    case chip8::core::CritErrors::kNone:
+      break;
+  }
+  return CHIP8_CPU_OK;
+}
+
+chip8_snapshot* chip8_snapshot_create(const chip8_instance* instance) {
+  if (instance == nullptr) {
+    return nullptr;
+  }
+  chip8_snapshot* snapshot{new (std::nothrow) chip8_snapshot{}};
+  if (snapshot != nullptr) {
+    instance->cpu.SaveSnapshot(snapshot->state);
+  }
+  return snapshot;
+}
+
+chip8_result chip8_snapshot_restore(chip8_instance* instance,
+                                    const chip8_snapshot* snapshot) {
+  if (instance == nullptr || snapshot == nullptr) {
+    return CHIP8_ERROR_INVALID_ARGUMENT;
+  }
+  instance->cpu.RestoreSnapshot(snapshot->state);
+  return CHIP8_OK;
+}
+
+void chip8_snapshot_destroy(chip8_snapshot* snapshot) { delete snapshot; }
+
+}  // extern "C"
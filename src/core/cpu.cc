@@ -1,244 +1,338 @@
 #include <chip8/core/cpu.h>
+#include <chip8/utils/hash.h>
+#include <chip8/utils/perf_counters.h>
+#include <chip8/utils/profiler.h>
+
+#include <new>
 
 namespace chip8::core {
+
 Cpu::Cpu() noexcept
-    : registers_(),
-      memory_(),
-      index_register_(),
-      program_counter_(kRomStartAddress),
-      stack_(),
-      stack_pointer_(),
-      delay_timer_(),
-      keys_(),
-      screen_(),
+    : state_(),
       gen_(InitRNG()),
       dist_(0, UINT8_MAX),
-      critical_error_(CritErrors::kNone),
-      opcode_() {
-  LoadFontChars();
-  LOG_INFO("CPU initialized.");
+      idle_skipping_(true),
+      fusion_enabled_(true),
+      fusion_cache_(),
+      fused_instructions_(),
+      aot_module_(nullptr),
+      aot_blocks_(),
+      aot_valid_(),
+      aot_code_(),
+      aot_instructions_(),
+      frame_callback_(),
+      unknown_opcodes_() {
+  LOG_DEBUG("CPU initialized.");
 }
 
-bool Cpu::LoadROM(std::filesystem::path rom_path) noexcept {
-  LOG_TRACE("Opening ROM file ('{}').", rom_path.string());
-
-  std::ifstream in_stream(rom_path, std::ios::binary | std::ios::ate);
-  if (!in_stream.is_open()) {
-    LOG_ERROR("Failed to read ROM ('{}')", rom_path.string());
-    return false;
+void Cpu::Reset() noexcept {
+  state_ = MachineState{};
+  dist_.reset();
+  idle_skipping_ = true;
+  fusion_enabled_ = true;
+  fusion_cache_.fill(Fusion::kUnknown);
+  fused_instructions_ = 0;
+  if (aot_module_ != nullptr) {
+    AttachAotModule(nullptr);
   }
-  LOG_TRACE("ROM file successfully opened ('{}')", rom_path.string());
+  aot_instructions_ = 0;
+  frame_callback_ = nullptr;
+  unknown_opcodes_ = 0;
+}
 
-  std::streamsize rom_size{in_stream.tellg()};
-  LOG_DEBUG("ROM size ('{}'): {} bytes", rom_path.string(), rom_size);
+void Cpu::SeedRNG(unsigned int seed) noexcept {
+  LOG_DEBUG("RNG seed: {}", seed);
+  gen_.seed(seed);
+  dist_.reset();
+}
 
-  if (rom_size <= 0) {
-    LOG_ERROR("ROM file is empty ('{}')", rom_path.string());
-    return false;
-  } else if (kRomStartAddress + rom_size > memory_.size()) {
-    LOG_ERROR("ROM too large to fit in memory ({}/{} bytes) ('{}')", rom_size,
-              memory_.size() - kRomStartAddress, rom_path.string());
+void Cpu::LoadROM(const RomImage& rom) noexcept {
+  CHIP8_ZONE("Cpu::LoadROM");
+  const std::span<const uint8_t> bytes{rom.GetBytes()};
+  LoadRom(state_, bytes);
+  OnMemoryWrite(kRomStartAddress, bytes.size());
+  fused_instructions_ = 0;
+  unknown_opcodes_ = 0;
+}
+
+bool Cpu::LoadROM(std::filesystem::path rom_path) noexcept {
+  std::optional<RomImage> rom;
+  try {
+    rom = RomImage::Load(rom_path);
+  } catch (const std::bad_alloc&) {
+    LOG_ERROR("Out of memory while loading ROM ('{}')", rom_path.string());
+  }
+  if (!rom) {
     return false;
   }
 
-  in_stream.seekg(0, std::ios::beg);
+  LoadROM(*rom);
+  LOG_INFO("Succesfully loaded ROM into memory ('{}')", rom_path.string());
+  return true;
+}
 
-  char* destination_addr{
-      reinterpret_cast<char*>(memory_.data() + kRomStartAddress)};
+void Cpu::TickTimers() noexcept { core::TickTimers(state_); }
 
-  if (!in_stream.read(destination_addr, rom_size)) {
-    LOG_ERROR("Failed to load all bytes into memory ('{}')", rom_path.string());
-    return false;
+size_t Cpu::RunFrame(size_t cycles) {
+  size_t executed{};
+  {
+    CHIP8_ZONE("Cpu::Cycle batch");
+    CHIP8_PERF_SCOPE(kDispatch);
+    while (executed < cycles && state_.critical_error == CritErrors::kNone) {
+      if (idle_skipping_) {
+        const IdleState idle_state{GetIdleState()};
+        if (idle_state != IdleState::kNone) {
+          SkipIdleCycles(idle_state, cycles - executed);
+          break;
+        }
+      }
+      executed += CycleFastest(cycles - executed);
+    }
+    CHIP8_PERF_UNITS(executed);
   }
 
-  LOG_INFO("Succesfully loaded ROM into memory ('{}')", rom_path.string());
-  return true;
+  TickTimers();
+  if (frame_callback_) {
+    CHIP8_ZONE("Cpu::FrameCallback");
+    frame_callback_(*this);
+  }
+  return executed;
 }
 
-const std::array<bool, 64 * 32>& Cpu::GetPixels() const noexcept {
-  return screen_;
+void Cpu::SetFrameCallback(FrameCallback callback) noexcept {
+  frame_callback_ = std::move(callback);
 }
 
-void Cpu::LoadFontChars() noexcept {
-  for (size_t i{}; i < kFontsetCharAmount; ++i) {
-    for (size_t j{}; j < 5; ++j) {
-      memory_.at(kFontsetStartAddress + i * 5 + j) = kFontset.at(i).at(j);
+size_t Cpu::Step(size_t budget) {
+  if (budget == 0 || state_.critical_error != CritErrors::kNone) {
+    return 0;
+  }
+  if (idle_skipping_) {
+    const IdleState idle_state{GetIdleState()};
+    if (idle_state != IdleState::kNone) {
+      SkipIdleCycles(idle_state, budget);
+      return budget;
     }
   }
-  LOG_TRACE("Fontset loaded into memory at: {:#05x}", kFontsetStartAddress);
+  return CycleFastest(budget);
 }
 
-unsigned int Cpu::InitRNG() noexcept {
-  unsigned int seed{std::random_device{}()};
-  LOG_DEBUG("RNG seed: {}", seed);
-  return seed;
+size_t Cpu::CycleFastest(size_t budget) {
+  if (aot_module_ != nullptr) {
+    const size_t compiled{CycleAot(budget)};
+    if (compiled > 0) {
+      return compiled;
+    }
+  }
+  if (fusion_enabled_) {
+    return CycleFused(budget);
+  }
+  Cycle();
+  return 1;
 }
 
-uint8_t Cpu::GenUint8() noexcept { return static_cast<uint8_t>(dist_(gen_)); }
+IdleState Cpu::GetIdleState() const noexcept {
+  if (state_.program_counter + 6u > state_.memory.size()) {
+    return IdleState::kNone;
+  }
+
+  auto fetch{[this](size_t address) -> uint16_t {
+    return ReadWord(state_.memory, address);
+  }};
+
+  const uint16_t first{fetch(state_.program_counter)};
 
-std::optional<uint16_t> Cpu::PopStack() noexcept {
-  if (stack_pointer_ == 0) {
-    LOG_CRITICAL("Stack underflow.");
-    critical_error_ = CritErrors::kStackUnderflow;
-    return std::nullopt;
+  // 1NNN jumping to itself
+  if (first == (0x1000u | state_.program_counter)) {
+    return IdleState::kJumpToSelf;
   }
-  return stack_.at(--stack_pointer_);
-}
 
-void Cpu::PushStack(uint16_t value) noexcept {
-  if (stack_pointer_ >= stack_.size()) {
-    LOG_CRITICAL("Stack overflow.");
-    critical_error_ = CritErrors::kStackOverflow;
-    return;
+  // FX0A while no key is held down
+  if ((first & 0xF0FFu) == 0xF00Au &&
+      std::none_of(state_.keys.begin(), state_.keys.end(),
+                   [](uint8_t key) { return key != 0; })) {
+    return IdleState::kKeyWait;
   }
-  stack_.at(stack_pointer_++) = value;
-}
 
-void Cpu::Cycle() {
+  // FX07, 3XKK/4XKK, 1NNN polling the delay timer. Timer does not change
+  // until the end of the frame, so if the loop does not exit now, it will not
+  // exit until the next tick.
+  if ((first & 0xF0FFu) == 0xF007u) {
+    const uint16_t skip{fetch(state_.program_counter + 2u)};
+    const uint16_t jump{fetch(state_.program_counter + 4u)};
+    const bool same_register{(skip & 0x0F00u) == (first & 0x0F00u)};
 
-  opcode_ =
-      (memory_.at(program_counter_) << 8u) | memory_.at(program_counter_ + 1);
+    if (!same_register || jump != (0x1000u | state_.program_counter)) {
+      return IdleState::kNone;
+    }
+    if ((skip & 0xF000u) == 0x3000u && state_.delay_timer != (skip & 0x00FFu)) {
+      return IdleState::kTimerWait;
+    }
+    if ((skip & 0xF000u) == 0x4000u && state_.delay_timer == (skip & 0x00FFu)) {
+      return IdleState::kTimerWait;
+    }
+  }
 
-  program_counter_ += 2;
+  return IdleState::kNone;
+}
 
-  switch (opcode_ & 0xF000) {
-    case 0x0000:
-      switch (opcode_) {
-        case 0x00E0:
-          Opcode00E0();
-          break;
-        case 0x00EE:
-          Opcode00EE();
-          break;
-        default:
-          LOG_WARN("Opcode unknown: {:#x}", opcode_);
-      }
-      break;
-    case 0x1000:
-      Opcode1NNN();
-      break;
-    case 0x2000:
-      Opcode2NNN();
-      break;
-    case 0x3000:
-      Opcode3XKK();
-      break;
-    case 0x4000:
-      Opcode4XKK();
-      break;
-    case 0x5000:
-      Opcode5XY0();
-      break;
-    case 0x6000:
-      Opcode6XKK();
-      break;
-    case 0x7000:
-      Opcode7XKK();
-      break;
-    case 0x8000:
-      switch (opcode_ & 0x000F) {
-        case 0x0000:
-          Opcode8XY0();
-          break;
-        case 0x0001:
-          Opcode8XY1();
-          break;
-        case 0x0002:
-          Opcode8XY2();
-          break;
-        case 0x0003:
-          Opcode8XY3();
-          break;
-        case 0x0004:
-          Opcode8XY4();
-          break;
-        case 0x0005:
-          Opcode8XY5();
-          break;
-        case 0x0006:
-          Opcode8XY6();
-          break;
-        case 0x0007:
-          Opcode8XY7();
-          break;
-        case 0x000E:
-          Opcode8XYE();
-          break;
-        default:
-          LOG_WARN("Opcode unknown: {:#x}", opcode_);
-      }
-      break;
-    case 0x9000:
-      Opcode9XY0();
-      break;
-    case 0xA000:
-      OpcodeANNN();
-      break;
-    case 0xB000:
-      OpcodeBNNN();
-      break;
-    case 0xC000:
-      OpcodeCXKK();
-      break;
-    case 0xD000:
-      OpcodeDXYN();
+void Cpu::SkipIdleCycles(IdleState state, size_t cycles) noexcept {
+  if (cycles == 0) {
+    return;
+  }
+
+  switch (state) {
+    case IdleState::kJumpToSelf:
+    case IdleState::kKeyWait:
+      // Every iteration refetches the same opcode and ends at the same PC
+      state_.opcode = ReadWord(state_.memory, state_.program_counter);
       break;
-    case 0xE000:
-      switch (opcode_ & 0x000F) {
-        case 0x000E:
-          OpcodeEX9E();
-          break;
-        case 0x0001:
-          OpcodeEXA1();
-          break;
-        default:
-          LOG_WARN("Opcode unknown: {:#x}", opcode_);
-      }
+    case IdleState::kTimerWait: {
+      const uint16_t loop_start{state_.program_counter};
+      const size_t phase{cycles % 3};
+      const size_t last_address{loop_start + (phase == 0 ? 4u : phase * 2 - 2)};
+
+      state_.registers[state_.memory[loop_start] & 0x0Fu] = state_.delay_timer;
+      state_.opcode = ReadWord(state_.memory, last_address);
+      state_.program_counter = static_cast<uint16_t>(loop_start + phase * 2);
       break;
-    case 0xF000:
-      switch (opcode_ & 0x00FF) {
-        case 0x0007:
-          OpcodeFX07();
-          break;
-        case 0x000A:
-          OpcodeFX0A();
-          break;
-        case 0x0015:
-          OpcodeFX15();
-          break;
-        case 0x0018:
-          OpcodeFX18();
-          break;
-        case 0x001E:
-          OpcodeFX1E();
-          break;
-        case 0x0029:
-          OpcodeFX29();
-          break;
-        case 0x0033:
-          OpcodeFX33();
-          break;
-        case 0x0055:
-          OpcodeFX55();
-          break;
-        case 0x0065:
-          OpcodeFX65();
-          break;
-        default:
-          LOG_WARN("Opcode unknown: {:#x}", opcode_);
-      }
+    }
+    case IdleState::kNone:
       break;
-    default:
-      LOG_WARN("Opcode unknown: {:#x}", opcode_);
   }
 
-  if (delay_timer_ > 0) {
-    --delay_timer_;
+  LOG_TRACE("Skipped {} idle cycles at {:#05x}.", cycles,
+            state_.program_counter);
+}
+
+void Cpu::SetIdleSkipping(bool enabled) noexcept { idle_skipping_ = enabled; }
+
+void Cpu::SetFusion(bool enabled) noexcept { fusion_enabled_ = enabled; }
+
+uint64_t Cpu::GetFusedInstructionCount() const noexcept {
+  return fused_instructions_;
+}
+
+void Cpu::SetKey(uint8_t key, bool pressed) noexcept {
+  state_.keys[key & 0x0Fu] = pressed ? 1 : 0;
+}
+
+void Cpu::SetKeyMask(uint16_t mask) noexcept {
+  for (uint8_t key{}; key < state_.keys.size(); ++key) {
+    state_.keys[key] = (mask >> key) & 1u;
+  }
+}
+
+uint16_t Cpu::GetKeyMask() const noexcept {
+  uint16_t mask{};
+  for (uint8_t key{}; key < state_.keys.size(); ++key) {
+    mask |= static_cast<uint16_t>((state_.keys[key] != 0 ? 1u : 0u) << key);
   }
+  return mask;
+}
+
+const std::array<bool, 64 * 32>& Cpu::GetPixels() const noexcept {
+  return state_.screen;
+}
+
+const std::array<uint8_t, 16>& Cpu::GetRegisters() const noexcept {
+  return state_.registers;
+}
+
+const std::array<uint8_t, 4096>& Cpu::GetMemory() const noexcept {
+  return state_.memory;
+}
 
-  if (sound_timer_ > 0) {
-    --sound_timer_;
+const std::array<uint16_t, 16>& Cpu::GetStack() const noexcept {
+  return state_.stack;
+}
+
+uint16_t Cpu::GetIndexRegister() const noexcept {
+  return state_.index_register;
+}
+
+uint16_t Cpu::GetProgramCounter() const noexcept {
+  return state_.program_counter;
+}
+
+uint8_t Cpu::GetStackPointer() const noexcept { return state_.stack_pointer; }
+
+uint8_t Cpu::GetDelayTimer() const noexcept { return state_.delay_timer; }
+
+uint8_t Cpu::GetSoundTimer() const noexcept { return state_.sound_timer; }
+
+uint16_t Cpu::GetOpcode() const noexcept { return state_.opcode; }
+
+CritErrors Cpu::GetCriticalError() const noexcept {
+  return state_.critical_error;
+}
+
+uint64_t Cpu::GetUnknownOpcodeCount() const noexcept {
+  return unknown_opcodes_;
+}
+
+const MachineState& Cpu::GetState() const noexcept { return state_; }
+
+void Cpu::SetState(const MachineState& state) noexcept {
+  state_ = state;
+  OnMemoryWrite(0, state_.memory.size());
+}
+
+void Cpu::SaveSnapshot(CpuSnapshot& snapshot) const noexcept {
+  snapshot.state = state_;
+  snapshot.generator = gen_;
+  snapshot.distribution = dist_;
+}
+
+void Cpu::RestoreSnapshot(const CpuSnapshot& snapshot) noexcept {
+  gen_ = snapshot.generator;
+  dist_ = snapshot.distribution;
+  SetState(snapshot.state);
+}
+
+uint64_t Cpu::GetStateHash() const noexcept {
+  uint64_t hash{utils::kFnv1aOffset};
+  auto add{[&hash](const auto& value) {
+    hash = utils::Fnv1a(
+        {reinterpret_cast<const uint8_t*>(&value), sizeof(value)}, hash);
+  }};
+
+  add(state_.registers);
+  add(state_.memory);
+  add(state_.index_register);
+  add(state_.program_counter);
+  add(state_.stack);
+  add(state_.stack_pointer);
+  add(state_.delay_timer);
+  add(state_.sound_timer);
+  add(state_.keys);
+  add(state_.screen);
+  add(state_.opcode);
+  return hash;
+}
+
+unsigned int Cpu::InitRNG() noexcept {
+  unsigned int seed{std::random_device{}()};
+  LOG_DEBUG("RNG seed: {}", seed);
+  return seed;
+}
+
+uint8_t Cpu::GenUint8() noexcept { return static_cast<uint8_t>(dist_(gen_)); }
+
+void Cpu::Cycle() {
+  state_.opcode = ReadWord(state_.memory, state_.program_counter);
+  state_.program_counter += 2;
+  if ((state_.opcode & 0xF000u) == 0xD000u) {
+    Draw();
+    return;
   }
+  Policy policy{*this};
+  ExecuteOpcode(state_, policy);
+}
+
+void Cpu::Draw() noexcept {
+  CHIP8_PERF_SCOPE(kDraw);
+  OpcodeDXYN(state_);
 }
 
 }  // namespace chip8::core
\ No newline at end of file
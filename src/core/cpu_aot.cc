@@ -0,0 +1,122 @@
+#include <chip8/core/cpu.h>
+
+namespace chip8::core {
+
+void Cpu::AttachAotModule(const aot::AotModule* module) noexcept {
+  aot_module_ = module;
+  aot_blocks_.fill(0);
+  aot_code_.reset();
+  aot_valid_.clear();
+
+  if (module == nullptr) {
+    LOG_DEBUG("AOT module detached.");
+    return;
+  }
+
+  const size_t rom_end{std::min<size_t>(kRomStartAddress + module->rom_size,
+                                        state_.memory.size())};
+  aot_valid_.resize(module->block_count, false);
+  for (uint32_t i{}; i < module->block_count; ++i) {
+    const aot::AotBlock& block{module->blocks[i]};
+    if (block.start < kRomStartAddress || block.start >= block.end ||
+        block.end > rom_end || block.function == nullptr) {
+      LOG_WARN("Ignoring malformed AOT block at {:#05x}", block.start);
+      continue;
+    }
+    aot_blocks_[block.start] = static_cast<uint16_t>(i + 1);
+    for (size_t address{block.start}; address < block.end; ++address) {
+      aot_code_[address] = true;
+    }
+  }
+
+  ValidateAotBlocks(kRomStartAddress, rom_end - kRomStartAddress);
+  LOG_INFO("AOT module attached: {}/{} blocks match memory.",
+           std::count(aot_valid_.begin(), aot_valid_.end(), true),
+           module->block_count);
+}
+
+uint64_t Cpu::GetAotInstructionCount() const noexcept {
+  return aot_instructions_;
+}
+
+size_t Cpu::CycleAot(size_t budget) {
+  if (state_.program_counter >= aot_blocks_.size()) {
+    return 0;
+  }
+
+  const uint16_t index{aot_blocks_[state_.program_counter]};
+  if (index == 0 || !aot_valid_[index - 1]) {
+    return 0;
+  }
+
+  const aot::AotBlock& block{aot_module_->blocks[index - 1]};
+  if (block.instructions > budget) {
+    return 0;
+  }
+
+  aot::AotState state{state_.registers.data(),  state_.memory.data(),
+                      &state_.index_register,   &state_.program_counter,
+                      state_.stack.data(),      &state_.stack_pointer,
+                      &state_.delay_timer,      &state_.sound_timer,
+                      state_.keys.data(),       state_.screen.data(),
+                      &state_.opcode,           this,
+                      &Cpu::AotRandom,          &Cpu::AotOnWrite};
+
+  const uint32_t executed{block.function(&state)};
+  aot_instructions_ += executed;
+  return executed;
+}
+
+bool Cpu::ValidateAotBlocks(size_t address, size_t size) noexcept {
+  if (aot_module_ == nullptr) {
+    return false;
+  }
+
+  const size_t end{std::min(address + size, state_.memory.size())};
+  bool overlaps{false};
+  for (size_t i{address}; i < end && !overlaps; ++i) {
+    overlaps = aot_code_[i];
+  }
+  if (!overlaps) {
+    return false;
+  }
+
+  for (uint32_t i{}; i < aot_module_->block_count; ++i) {
+    const aot::AotBlock& block{aot_module_->blocks[i]};
+    if (aot_blocks_[block.start] != i + 1 || block.end <= address ||
+        block.start >= end) {
+      continue;
+    }
+
+    const bool valid{std::equal(
+        state_.memory.begin() + block.start, state_.memory.begin() + block.end,
+        aot_module_->rom + (block.start - kRomStartAddress))};
+    if (aot_valid_[i] && !valid) {
+      LOG_DEBUG("AOT block at {:#05x} was overwritten.", block.start);
+    }
+    aot_valid_[i] = valid;
+  }
+  return true;
+}
+
+bool Cpu::OnMemoryWrite(size_t address, size_t size) noexcept {
+  address = WrapAddress(address);
+  const size_t head{std::min(size, state_.memory.size() - address)};
+  InvalidateFusion(address, head);
+  bool overwritten{ValidateAotBlocks(address, head)};
+  if (size > head) {
+    InvalidateFusion(0, size - head);
+    overwritten |= ValidateAotBlocks(0, size - head);
+  }
+  return overwritten;
+}
+
+uint8_t Cpu::AotRandom(void* cpu) noexcept {
+  return static_cast<Cpu*>(cpu)->GenUint8();
+}
+
+bool Cpu::AotOnWrite(void* cpu, uint16_t address, uint16_t size) noexcept {
+  return static_cast<Cpu*>(cpu)->OnMemoryWrite(address, size);
+}
+
+}  // namespace chip8::core
@@ -0,0 +1,147 @@
+#include <chip8/core/cpu.h>
+
+namespace chip8::core {
+
+size_t Cpu::CycleFused(size_t budget) {
+  if (budget < 2 || state_.program_counter + 4u > state_.memory.size()) {
+    Cycle();
+    return 1;
+  }
+
+  const uint16_t address{state_.program_counter};
+  Fusion& fusion{fusion_cache_[address]};
+  if (fusion == Fusion::kUnknown) {
+    fusion = DecodeFusion(address);
+  }
+  if (fusion == Fusion::kNone) {
+    Cycle();
+    return 1;
+  }
+
+  state_.opcode = ReadWord(state_.memory, address);
+  state_.program_counter += 2;
+
+  switch (fusion) {
+    case Fusion::kSkipEqualJump:
+      Opcode3XKK(state_);
+      break;
+    case Fusion::kSkipNotEqualJump:
+      Opcode4XKK(state_);
+      break;
+    case Fusion::kIndexDraw:
+    case Fusion::kIndexLoad:
+      OpcodeANNN(state_);
+      break;
+    case Fusion::kAddSkipEqual:
+    case Fusion::kAddSkipNotEqual:
+      Opcode7XKK(state_);
+      break;
+    default:
+      break;
+  }
+
+  // Skip was taken, so the jump is not executed at all
+  if (state_.program_counter != address + 2) {
+    ++fused_instructions_;
+    return 1;
+  }
+
+  state_.opcode = ReadWord(state_.memory, address + 2);
+  state_.program_counter += 2;
+
+  switch (fusion) {
+    case Fusion::kSkipEqualJump:
+    case Fusion::kSkipNotEqualJump:
+      Opcode1NNN(state_);
+      break;
+    case Fusion::kIndexDraw:
+      Draw();
+      break;
+    case Fusion::kIndexLoad:
+      OpcodeFX65(state_);
+      break;
+    case Fusion::kAddSkipEqual:
+      Opcode3XKK(state_);
+      break;
+    case Fusion::kAddSkipNotEqual:
+      Opcode4XKK(state_);
+      break;
+    default:
+      break;
+  }
+
+  fused_instructions_ += 2;
+  return 2;
+}
+
+Fusion Cpu::DecodeFusion(uint16_t address) const noexcept {
+  if (address + 4u > state_.memory.size()) {
+    return Fusion::kNone;
+  }
+
+  const uint16_t first{ReadWord(state_.memory, address)};
+  const uint16_t second{ReadWord(state_.memory, address + 2)};
+  const bool same_register{(first & 0x0F00u) == (second & 0x0F00u)};
+
+  switch (first & 0xF000u) {
+    case 0x3000:
+      if ((second & 0xF000u) == 0x1000u) {
+        return Fusion::kSkipEqualJump;
+      }
+      break;
+    case 0x4000:
+      if ((second & 0xF000u) == 0x1000u) {
+        return Fusion::kSkipNotEqualJump;
+      }
+      break;
+    case 0xA000:
+      if ((second & 0xF000u) == 0xD000u) {
+        return Fusion::kIndexDraw;
+      }
+      if ((second & 0xF0FFu) == 0xF065u) {
+        return Fusion::kIndexLoad;
+      }
+      break;
+    case 0x7000:
+      if (same_register && (second & 0xF000u) == 0x3000u) {
+        return Fusion::kAddSkipEqual;
+      }
+      if (same_register && (second & 0xF000u) == 0x4000u) {
+        return Fusion::kAddSkipNotEqual;
+      }
+      break;
+    default:
+      break;
+  }
+
+  return Fusion::kNone;
+}
+
+void Cpu::PrewarmDecodeCache(const analysis::CodeMap& code_map) noexcept {
+  size_t decoded{};
+  for (size_t address{}; address < fusion_cache_.size(); ++address) {
+    if (code_map.instructions[address]) {
+      fusion_cache_[address] = DecodeFusion(static_cast<uint16_t>(address));
+      ++decoded;
+    }
+  }
+  LOG_DEBUG("Decode cache prewarmed with {} instructions.", decoded);
+
+  for (const analysis::SelfModifyingWrite& write : code_map.self_modifying) {
+    LOG_WARN("Self-modifying code: instruction at {:#05x} writes {} bytes at "
+             "{:#05x}",
+             write.instruction, write.size, write.address);
+  }
+}
+
+void Cpu::InvalidateFusion(size_t address, size_t size) noexcept {
+  // A pair starting up to 3 bytes before the write covers written bytes
+  const size_t begin{address > 3 ? address - 3 : 0};
+  const size_t end{std::min(address + size, fusion_cache_.size())};
+  if (begin < end) {
+    std::fill(fusion_cache_.begin() + begin, fusion_cache_.begin() + end,
+              Fusion::kUnknown);
+  }
+}
+
+}  // namespace chip8::core
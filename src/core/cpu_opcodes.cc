@@ -1,308 +0,0 @@
-#include <chip8/core/cpu.h>
-
-namespace chip8::core {
-
-void Cpu::Opcode00E0() noexcept {
-  LOG_TRACE("CLS - Clears the display.");
-  screen_.fill(false);
-}
-
-void Cpu::Opcode00EE() noexcept {
-  LOG_TRACE("RET - Returns from a subroutine.");
-  program_counter_ = PopStack().value_or(0);
-}
-
-void Cpu::Opcode1NNN() noexcept {
-  LOG_TRACE("JP addr - Jump to location nnn.");
-  program_counter_ = opcode_ & 0x0FFFu;
-}
-
-void Cpu::Opcode2NNN() noexcept {
-  LOG_TRACE("CALL addr - Call subroutine at nnn.");
-  PushStack(program_counter_);
-  program_counter_ = opcode_ & 0x0FFFu;
-}
-
-void Cpu::Opcode3XKK() noexcept {
-  LOG_TRACE("SE Vx, byte - Skip next instruction if Vx = kk.");
-  if (registers_.at((opcode_ & 0x0F00u) >> 8u) == (opcode_ & 0x00FFu)) {
-    program_counter_ += 2;
-  }
-}
-
-void Cpu::Opcode4XKK() noexcept {
-  LOG_TRACE("SNE Vx, byte - Skip next instruction if Vx != kk.");
-  if (registers_.at((opcode_ & 0x0F00u) >> 8u) != (opcode_ & 0x00FFu)) {
-    program_counter_ += 2;
-  }
-}
-
-void Cpu::Opcode5XY0() noexcept {
-  LOG_TRACE("SE Vx, Vy - Skip next instruction if Vx = Vy.");
-  if (registers_.at((opcode_ & 0x0F00u) >> 8u) ==
-      registers_.at((opcode_ & 0x00F0u) >> 4u)) {
-    program_counter_ += 2;
-  }
-}
-
-void Cpu::Opcode6XKK() noexcept {
-  LOG_TRACE("LD Vx, byte - Set Vx = kk.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) = opcode_ & 0x00FF;
-}
-
-void Cpu::Opcode7XKK() noexcept {
-  LOG_TRACE("ADD Vx, byte - Set Vx = Vx + kk.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) += (opcode_ & 0x00FFu);
-}
-
-void Cpu::Opcode8XY0() noexcept {
-  LOG_TRACE("LD Vx, Vy - Set Vx = Vy.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) =
-      registers_.at((opcode_ & 0x00F0u) >> 4u);
-}
-
-void Cpu::Opcode8XY1() noexcept {
-  LOG_TRACE("OR Vx, Vy - Set Vx = Vx OR Vy.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) =
-      registers_.at((opcode_ & 0x0F00u) >> 8u) |
-      registers_.at((opcode_ & 0x00F0u) >> 4u);
-}
-
-void Cpu::Opcode8XY2() noexcept {
-  LOG_TRACE("AND Vx, Vy - Set Vx = Vx AND Vy.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) =
-      registers_.at((opcode_ & 0x0F00u) >> 8u) &
-      registers_.at((opcode_ & 0x00F0u) >> 4u);
-}
-
-void Cpu::Opcode8XY3() noexcept {
-  LOG_TRACE("XOR Vx, Vy - Set Vx = Vx XOR Vy.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) =
-      registers_.at((opcode_ & 0x0F00u) >> 8u) ^
-      registers_.at((opcode_ & 0x00F0u) >> 4u);
-}
-
-void Cpu::Opcode8XY4() noexcept {
-  LOG_TRACE("ADD Vx, Vy - Set Vx = Vx + Vy, set VF = carry.");
-
-  uint16_t sum{static_cast<uint16_t>(registers_.at((opcode_ & 0x0F00u) >> 8u) +
-                                     registers_.at((opcode_ & 0x00F0u) >> 4u))};
-
-  registers_.at(0xFu) = (sum > 0xFFu) ? 1 : 0;
-
-  registers_.at((opcode_ & 0x0F00u) >> 8u) = sum & 0xFFu;
-}
-
-void Cpu::Opcode8XY5() noexcept {
-  LOG_TRACE("SUB Vx, Vy - Set Vx = Vx - Vy, set VF = NOT borrow.");
-  registers_.at(0xFu) = (registers_.at((opcode_ & 0x0F00u) >> 8u) >
-                         registers_.at((opcode_ & 0x00F0u) >> 4u))
-                            ? 1
-                            : 0;
-
-  registers_.at((opcode_ & 0x0F00u) >> 8u) -=
-      registers_.at((opcode_ & 0x00F0u) >> 4u);
-}
-
-void Cpu::Opcode8XY6() noexcept {
-  LOG_TRACE("SHR Vx {, Vy} - Set Vx = Vx SHR 1.");
-  registers_.at(0xFu) = registers_.at((opcode_ & 0x0F00u) >> 8u) & 0x1u;
-  registers_.at((opcode_ & 0x0F00u) >> 8u) >>= 1u;
-}
-
-void Cpu::Opcode8XY7() noexcept {
-  LOG_TRACE("SUBN Vx, Vy - Set Vx = Vy - Vx, set VF = NOT borrow.");
-  registers_.at(0xFu) = (registers_.at((opcode_ & 0x0F00u) >> 8u) <
-                         registers_.at((opcode_ & 0x00F0u) >> 4u))
-                            ? 1
-                            : 0;
-
-  registers_.at((opcode_ & 0x0F00u) >> 8u) =
-      registers_.at((opcode_ & 0x00F0u) >> 4u) -
-      registers_.at((opcode_ & 0x0F00u) >> 8u);
-}
-
-void Cpu::Opcode8XYE() noexcept {
-  LOG_TRACE("SHL Vx {, Vy} - Set Vx = Vx SHL 1.");
-  LOG_WARN(
-      "This instruction might cause some issues due to inaccurate "
-      "documentation about what it should do");
-
-  // todo DECIDE WHICH IMPLEMENTATION TO USE
-
-  if (registers_.at((opcode_ & 0x0F00u) >> 8u) >> 7u) {
-    registers_.at(0xFu) = 1;
-  } else {
-    registers_.at(0xFu) = 0;
-  }
-  registers_.at((opcode_ & 0x0F00u) >> 8u) <<= 1u;
-}
-
-void Cpu::Opcode9XY0() noexcept {
-  if (registers_.at((opcode_ & 0x0F00u) >> 8u) !=
-      registers_.at((opcode_ & 0x00F0u) >> 4u)) {
-    program_counter_ += 2;
-  }
-}
-
-void Cpu::OpcodeANNN() noexcept {
-  LOG_TRACE("LD I, addr - Set I = nnn.");
-  index_register_ = opcode_ & 0x0FFFu;
-}
-
-void Cpu::OpcodeBNNN() noexcept {
-  LOG_TRACE("JP V0, addr - Jump to location nnn + V0.");
-  program_counter_ = (opcode_ & 0x0FFFu) + registers_.at(0);
-}
-
-void Cpu::OpcodeCXKK() noexcept {
-  LOG_TRACE("RND Vx, byte - Set Vx = random byte AND kk.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) = GenUint8() & (opcode_ & 0x00FFu);
-}
-
-void Cpu::OpcodeDXYN() noexcept {
-  LOG_TRACE(
-      "DRW Vx, Vy, nibble - Display n-byte sprite starting at memory location "
-      "I at (Vx, Vy), set VF = collision.");
-
-  const uint8_t vx_index = (opcode_ & 0x0F00u) >> 8u;
-  const uint8_t vy_index = (opcode_ & 0x00F0u) >> 4u;
-  const uint8_t start_x = registers_.at(vx_index);
-  const uint8_t start_y = registers_.at(vy_index);
-  const uint8_t height = opcode_ & 0x000Fu;
-
-  registers_.at(0xF) = 0;
-
-
-  for (uint8_t row_idx = 0; row_idx < height; ++row_idx) {
-    
-    const uint8_t screen_y = (start_y + row_idx) % 32;
-
-    const uint8_t sprite_byte = memory_.at(index_register_ + row_idx);
-
-    for (uint8_t pixel_idx = 0; pixel_idx < 8; ++pixel_idx) {
-
-      const uint8_t screen_x = (start_x + pixel_idx) % 64;
-
-      if ((sprite_byte & (0x80u >> pixel_idx)) != 0) {
-        
-        const size_t screen_idx = screen_y * 64 + screen_x;
-
-        if (screen_.at(screen_idx) == 1) {
-          registers_.at(0xF) = 1;
-        }
-
-        screen_.at(screen_idx) ^= 1;
-      }
-    }
-  }
-}
-
-void Cpu::OpcodeEX9E() noexcept {
-  LOG_TRACE(
-      "Ex9E - SKP Vx - Skip next instruction if key with the value of Vx is "
-      "pressed.");
-  if (keys_.at((opcode_ & 0x0F00u) >> 8u)) {
-    program_counter_ += 2;
-  }
-}
-
-void Cpu::OpcodeEXA1() noexcept {
-  LOG_TRACE(
-      "ExA1 - SKNP Vx - Skip next instruction if key with the value of Vx is "
-      "not pressed. ");
-
-  if (!keys_.at((opcode_ & 0x0F00u) >> 8u)) {
-    program_counter_ += 2;
-  }
-}
-
-void Cpu::OpcodeFX07() noexcept {
-  LOG_TRACE("Fx07 - LD Vx, DT - Set Vx = delay timer value.");
-  registers_.at((opcode_ & 0x0F00u) >> 8u) = delay_timer_;
-}
-
-void Cpu::OpcodeFX0A() noexcept {
-  LOG_TRACE(
-      "Fx0A - LD Vx, K - Wait for a key press, store the value of the key in "
-      "Vx.");
-
-  bool pressed{false};
-
-  for (uint8_t i{}; i <= 0xFu; ++i) {
-    if (keys_.at(i)) {
-      registers_.at((opcode_ & 0x0F00u) >> 8u) = i;
-      pressed = true;
-    }
-  }
-
-  if (!pressed) {
-    program_counter_ -= 2;
-  }
-}
-
-void Cpu::OpcodeFX15() noexcept {
-  LOG_TRACE("Fx15 - LD DT, Vx - Set delay timer = Vx.");
-  delay_timer_ = registers_.at((opcode_ & 0x0F00u) >> 8u);
-}
-
-void Cpu::OpcodeFX18() noexcept {
-  LOG_TRACE("Fx18 - LD ST, Vx - Set sound timer = Vx.");
-  sound_timer_ = registers_.at((opcode_ & 0x0F00u) >> 8u);
-}
-
-void Cpu::OpcodeFX1E() noexcept {
-  LOG_TRACE("Fx1E - ADD I, Vx - Set I = I + Vx.");
-  const uint8_t vx_index = (opcode_ & 0x0F00u) >> 8u;
-  const uint16_t vx_value = registers_.at(vx_index);
-
-  if (index_register_ + vx_value > 0xFFFu) {
-    registers_.at(0xF) = 1;
-  } else {
-    registers_.at(0xF) = 0;
-  }
-
-  index_register_ += vx_value;
-}
-
-void Cpu::OpcodeFX29() noexcept {
-  LOG_TRACE("Fx29 - LD F, Vx - Set I = location of sprite for digit Vx.");
-  index_register_ =
-      kFontsetStartAddress + 5 * registers_.at((opcode_ & 0x0F00u) >> 8u);
-}
-
-void Cpu::OpcodeFX33() noexcept {
-  LOG_TRACE(
-      "Fx33 - LD B, Vx - Store BCD representation of Vx in memory locations I, "
-      "I+1, and I+2.");
-  uint8_t num{registers_.at((opcode_ & 0x0F00u) >> 8u)};
-  memory_.at(index_register_ + 2) = num % 10;
-  num /= 10;
-  memory_.at(index_register_ + 1) = num % 10;
-  num /= 10;
-  memory_.at(index_register_) = num % 10;
-}
-
-void Cpu::OpcodeFX55() noexcept {
-  LOG_TRACE(
-      "Fx55 - LD [I], Vx - Store registers V0 through Vx in memory starting at "
-      "location I. ");
-  const uint8_t vx_index = (opcode_ & 0x0F00u) >> 8u;
-  std::copy_n(registers_.begin(), vx_index + 1,
-              memory_.begin() + index_register_);
-  index_register_ += vx_index + 1;
-}
-
-void Cpu::OpcodeFX65() noexcept {
-  LOG_TRACE(
-      "Fx65 - LD Vx, [I] - Read registers V0 through Vx from memory starting "
-      "at location I. ");
-  const uint8_t vx_index = (opcode_ & 0x0F00u) >> 8u;
-
-  std::copy_n(memory_.begin() + index_register_, vx_index + 1,
-              registers_.begin());
-
-  index_register_ += vx_index + 1;
-}
-
-}  // namespace chip8::core
\ No newline at end of file
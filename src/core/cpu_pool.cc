@@ -0,0 +1,49 @@
+#include <chip8/core/cpu_pool.h>
+
+namespace chip8::core {
+
+void CpuPool::Releaser::operator()(Cpu* cpu) const noexcept {
+  pool->Release(cpu);
+}
+
+CpuPool::CpuPool(size_t initial_size)
+    : mutex_(), idle_(), created_(initial_size) {
+  idle_.reserve(initial_size);
+  for (size_t i{}; i < initial_size; ++i) {
+    idle_.push_back(std::make_unique<Cpu>());
+  }
+}
+
+CpuPool::Handle CpuPool::Acquire() {
+  {
+    std::lock_guard lock(mutex_);
+    if (!idle_.empty()) {
+      Cpu* cpu{idle_.back().release()};
+      idle_.pop_back();
+      return Handle(cpu, Releaser{this});
+    }
+    // Room for releasing the new cpu is made now, while throwing is allowed
+    idle_.reserve(created_ + 1);
+    ++created_;
+  }
+  return Handle(new Cpu(), Releaser{this});
+}
+
+size_t CpuPool::GetIdleCount() const noexcept {
+  std::lock_guard lock(mutex_);
+  return idle_.size();
+}
+
+void CpuPool::Release(Cpu* cpu) noexcept {
+  if (cpu == nullptr) {
+    return;
+  }
+
+  std::unique_ptr<Cpu> owned{cpu};
+  owned->Reset();
+
+  std::lock_guard lock(mutex_);
+  idle_.push_back(std::move(owned));
+}
+
+}  // namespace chip8::core
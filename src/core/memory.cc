@@ -0,0 +1,12 @@
+#include <chip8/core/memory.h>
+
+#include <chip8/utils/logger.h>
+
+namespace chip8::core {
+
+void ReportWrappedAccess(size_t address, size_t size) noexcept {
+  LOG_WARN("Memory access at {:#05x} ({} bytes) wrapped around to {:#05x}",
+           address, size, WrapAddress(address + size - 1));
+}
+
+}  // namespace chip8::core
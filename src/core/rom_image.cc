@@ -0,0 +1,73 @@
+#include <chip8/core/rom_image.h>
+
+#include <chip8/core/constants.h>
+#include <chip8/utils/hash.h>
+#include <chip8/utils/logger.h>
+#include <chip8/utils/profiler.h>
+
+#include <fstream>
+#include <system_error>
+
+namespace chip8::core {
+
+RomImage::RomImage(std::vector<uint8_t> bytes) noexcept
+    : bytes_(std::move(bytes)) {}
+
+std::optional<RomImage> RomImage::Load(const std::filesystem::path& rom_path) {
+  CHIP8_ZONE("RomImage::Load");
+  LOG_TRACE("Opening ROM file ('{}').", rom_path.string());
+
+  std::error_code error;
+  const uintmax_t size{std::filesystem::file_size(rom_path, error)};
+  if (error) {
+    LOG_ERROR("Failed to read ROM ('{}'): {}", rom_path.string(),
+              error.message());
+    return std::nullopt;
+  }
+  LOG_DEBUG("ROM size ('{}'): {} bytes", rom_path.string(), size);
+  if (size > kMemorySize - kRomStartAddress) {
+    LOG_ERROR("ROM too large to fit in memory ({}/{} bytes) ('{}')", size,
+              kMemorySize - kRomStartAddress, rom_path.string());
+    return std::nullopt;
+  }
+
+  std::ifstream in_stream(rom_path, std::ios::binary);
+  if (!in_stream.is_open()) {
+    LOG_ERROR("Failed to read ROM ('{}')", rom_path.string());
+    return std::nullopt;
+  }
+
+  std::vector<uint8_t> bytes(static_cast<size_t>(size));
+  in_stream.read(reinterpret_cast<char*>(bytes.data()),
+                 static_cast<std::streamsize>(bytes.size()));
+  if (in_stream.gcount() != static_cast<std::streamsize>(bytes.size())) {
+    LOG_ERROR("Failed to load all bytes into memory ('{}')", rom_path.string());
+    return std::nullopt;
+  }
+
+  std::optional<RomImage> image{FromBytes(bytes)};
+  if (!image) {
+    LOG_ERROR("Invalid ROM ('{}')", rom_path.string());
+  }
+  return image;
+}
+
+std::optional<RomImage> RomImage::FromBytes(std::span<const uint8_t> bytes) {
+  if (bytes.empty()) {
+    LOG_ERROR("ROM is empty.");
+    return std::nullopt;
+  } else if (kRomStartAddress + bytes.size() > kMemorySize) {
+    LOG_ERROR("ROM too large to fit in memory ({}/{} bytes)", bytes.size(),
+              kMemorySize - kRomStartAddress);
+    return std::nullopt;
+  }
+  return RomImage(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+}
+
+std::span<const uint8_t> RomImage::GetBytes() const noexcept {
+  return bytes_;
+}
+
+uint64_t RomImage::GetHash() const noexcept { return utils::Fnv1a(bytes_); }
+
+}  // namespace chip8::core
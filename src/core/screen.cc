@@ -1,4 +1,7 @@
 #include <chip8/core/screen.h>
+#include <chip8/utils/histogram.h>
+#include <chip8/utils/perf_counters.h>
+#include <chip8/utils/profiler.h>
 
 namespace chip8::core {
 
@@ -8,7 +11,10 @@ Screen::Screen(Cpu& cpu) noexcept
       dev_(),
       have_(),
       want_(),
-      renderer_(nullptr) {
+      renderer_(nullptr),
+      keys_(),
+      metrics_(nullptr),
+      netplay_(nullptr) {
   if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS)) {
     LOG_ERROR("Error during SDL initialization: \"{}\"", SDL_GetError());
     SDL_Quit();
@@ -76,33 +82,90 @@ Screen::Screen(Cpu& cpu) noexcept
   GenerateBeep();
 }
 
+void Screen::SetMetrics(runtime::EmulatorMetrics* metrics) noexcept {
+  metrics_ = metrics;
+}
+
+void Screen::SetNetplay(runtime::Netplay* netplay) noexcept {
+  netplay_ = netplay;
+}
+
 void Screen::RenderLoop() noexcept {
-  auto last_cycle_time{std::chrono::high_resolution_clock::now()};
+  using Clock = std::chrono::steady_clock;
+  CHIP8_THREAD_NAME("Render");
+
+  const auto frame_duration{std::chrono::duration_cast<Clock::duration>(
+      std::chrono::seconds(1)) /
+                            kTimerFrequency};
+  const CycleRate cycle_rate{GetCycleRate()};
+  LOG_DEBUG("Cycles: {} every {} frames", cycle_rate.cycles,
+            cycle_rate.frames);
+
+  // Every published frame wakes this thread up through the event queue, so
+  // it can simply block on events.
+  runtime::EmulationThread emulation(cpu_, cycle_rate, frame_duration,
+                                     [] {
+                                       SDL_Event event;
+                                       SDL_zero(event);
+                                       event.type = SDL_USEREVENT;
+                                       SDL_PushEvent(&event);
+                                     });
+  emulation.SetMetrics(metrics_);
+  emulation.SetNetplay(netplay_);
+  utils::Histogram present_times;
+  uint64_t presented_number{};
+  emulation.Start();
 
   SDL_Event e;
   bool quit = false;
   while (!quit) {
-    while (SDL_PollEvent(&e)) {
-      if (e.type == SDL_QUIT) {
-        quit = true;
-      }
+    CHIP8_ZONE("Screen::RenderLoop");
+    int waited;
+    {
+      CHIP8_ZONE("SDL_WaitEvent");
+      waited = SDL_WaitEvent(&e);
+    }
+    if (waited) {
+      do {
+        if (e.type == SDL_QUIT) {
+          quit = true;
+        }
+      } while (SDL_PollEvent(&e));
     }
 
-    auto current_time{std::chrono::high_resolution_clock::now()};
-    float dt{std::chrono::duration<float, std::chrono::milliseconds::period>(
-                 current_time - last_cycle_time)
-                 .count()};
-
-    if (dt > kCycleDelay) {
-      last_cycle_time = current_time;
-      cpu_.Cycle();
-      UpdateDisplay();
-      if (cpu_.sound_timer_ == 0) {
+    UpdateKeysState(emulation);
+    if (emulation.Update()) {
+      const auto start{Clock::now()};
+      UpdateDisplay(emulation.GetFrame().pixels);
+      present_times.Record(Clock::now() - start);
+      if (emulation.GetFrame().sound_timer == 0) {
         PlayBeep();
       }
-      UpdateKeysState();
+      if (metrics_ != nullptr) {
+        const uint64_t number{emulation.GetFrame().number};
+        metrics_->frames_presented.Add();
+        metrics_->frames_skipped.Add(number - presented_number - 1);
+        metrics_->audio_queue_bytes.Set(SDL_GetQueuedAudioSize(dev_));
+      }
+      presented_number = emulation.GetFrame().number;
     }
   }
+
+  emulation.Stop();
+  LOG_INFO("Emulation frame times: {}",
+           emulation.GetFrameTimes().Summarize());
+  LOG_INFO("Presentation times: {}", present_times.Summarize());
+  if (emulation.GetDroppedKeyCount() != 0) {
+    LOG_WARN("Dropped key events: {}", emulation.GetDroppedKeyCount());
+  }
+}
+
+CycleRate Screen::GetCycleRate() noexcept {
+  if (kCyclesPerFrame != 0) {
+    return CycleRate{kCyclesPerFrame, 1};
+  }
+  return CycleRate::FromCycleDelay(kCycleDelay,
+                                   static_cast<uint32_t>(kTimerFrequency));
 }
 
 Screen::~Screen() noexcept {
@@ -122,50 +185,51 @@ void Screen::GenerateBeep() noexcept {
 }
 
 void Screen::PlayBeep() noexcept {
+  CHIP8_ZONE("Screen::PlayBeep");
+  CHIP8_PERF_SCOPE(kAudio);
   SDL_QueueAudio(dev_, audio_buffer_.data(),
                  static_cast<Uint32>(audio_buffer_.size()) * sizeof(Sint16));
   SDL_PauseAudioDevice(dev_, 0);
 }
 
-void Screen::UpdateDisplay() noexcept {
-  const std::array<bool, 64 * 32>& pixels{cpu_.GetPixels()};
-  int width{}, height{};
-  SDL_GetWindowSize(window_, &width, &height);
-  for (size_t i{}; i < 64 * 32; ++i) {
-    size_t x{i % 64}, y{i / 64};
-    if (pixels.at(i)) {
-      SDL_Rect rectangle{
-          static_cast<int>(x * kPixelSize), static_cast<int>(y * kPixelSize),
-          static_cast<int>(kPixelSize), static_cast<int>(kPixelSize)};
-      SDL_SetRenderDrawColor(renderer_, 255u, 255u, 255u, 255u);
-      SDL_RenderDrawRect(renderer_, &rectangle);
-      SDL_RenderFillRect(renderer_, &rectangle);
+void Screen::UpdateDisplay(const Framebuffer& pixels) noexcept {
+  CHIP8_ZONE("Screen::UpdateDisplay");
+  CHIP8_PERF_SCOPE(kRender);
+  SDL_SetRenderDrawColor(renderer_, 255u, 255u, 255u, 255u);
+  for (size_t y{}; y < pixels.size(); ++y) {
+    for (size_t x{}; x < 64; ++x) {
+      if ((pixels[y] >> x) & 1u) {
+        SDL_Rect rectangle{
+            static_cast<int>(x * kPixelSize), static_cast<int>(y * kPixelSize),
+            static_cast<int>(kPixelSize), static_cast<int>(kPixelSize)};
+        SDL_RenderFillRect(renderer_, &rectangle);
+      }
     }
   }
-  SDL_RenderPresent(renderer_);
+  {
+    CHIP8_ZONE("SDL_RenderPresent");
+    SDL_RenderPresent(renderer_);
+  }
   SDL_SetRenderDrawColor(renderer_, 0u, 0u, 0u, 255u);
   SDL_RenderClear(renderer_);
 }
 
-void Screen::UpdateKeysState() noexcept {
-  const Uint8* sdl_state{SDL_GetKeyboardState(NULL)};
+void Screen::UpdateKeysState(runtime::EmulationThread& emulation) noexcept {
+  CHIP8_ZONE("Screen::UpdateKeysState");
+  static constexpr std::array<SDL_Scancode, 16> kKeyMap{
+      SDL_SCANCODE_X, SDL_SCANCODE_1, SDL_SCANCODE_2, SDL_SCANCODE_3,
+      SDL_SCANCODE_Q, SDL_SCANCODE_W, SDL_SCANCODE_E, SDL_SCANCODE_A,
+      SDL_SCANCODE_S, SDL_SCANCODE_D, SDL_SCANCODE_Z, SDL_SCANCODE_C,
+      SDL_SCANCODE_4, SDL_SCANCODE_R, SDL_SCANCODE_F, SDL_SCANCODE_V};
 
-  cpu_.keys_.at(0x0u) = sdl_state[SDL_SCANCODE_X];
-  cpu_.keys_.at(0x1u) = sdl_state[SDL_SCANCODE_1];
-  cpu_.keys_.at(0x2u) = sdl_state[SDL_SCANCODE_2];
-  cpu_.keys_.at(0x3u) = sdl_state[SDL_SCANCODE_3];
-  cpu_.keys_.at(0x4u) = sdl_state[SDL_SCANCODE_Q];
-  cpu_.keys_.at(0x5u) = sdl_state[SDL_SCANCODE_W];
-  cpu_.keys_.at(0x6u) = sdl_state[SDL_SCANCODE_E];
-  cpu_.keys_.at(0x7u) = sdl_state[SDL_SCANCODE_A];
-  cpu_.keys_.at(0x8u) = sdl_state[SDL_SCANCODE_S];
-  cpu_.keys_.at(0x9u) = sdl_state[SDL_SCANCODE_D];
-  cpu_.keys_.at(0xAu) = sdl_state[SDL_SCANCODE_Z];
-  cpu_.keys_.at(0xBu) = sdl_state[SDL_SCANCODE_C];
-  cpu_.keys_.at(0xCu) = sdl_state[SDL_SCANCODE_4];
-  cpu_.keys_.at(0xDu) = sdl_state[SDL_SCANCODE_R];
-  cpu_.keys_.at(0xEu) = sdl_state[SDL_SCANCODE_F];
-  cpu_.keys_.at(0xFu) = sdl_state[SDL_SCANCODE_V];
+  const Uint8* sdl_state{SDL_GetKeyboardState(NULL)};
+  for (uint8_t key{}; key < kKeyMap.size(); ++key) {
+    const bool pressed{sdl_state[kKeyMap[key]] != 0};
+    // A dropped event is retried on the next call.
+    if (pressed != keys_[key] && emulation.PushKey(key, pressed)) {
+      keys_[key] = pressed;
+    }
+  }
 }
 
 }  // namespace chip8::core
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include <chip8/core/terminal_screen.h>
+#include <chip8/utils/histogram.h>
+#include <chip8/utils/logger.h>
+#include <chip8/utils/perf_counters.h>
+#include <chip8/utils/profiler.h>
+
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(_WIN32)
+#include <conio.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace chip8::core {
+
+namespace {
+
+/// <summary>
+/// Longest wait for input. Frames are picked up between waits, so this
+/// bounds the presentation latency.
+/// </summary>
+constexpr std::chrono::milliseconds kInputTimeout{5};
+
+constexpr char kCtrlC{'\x03'};
+constexpr char kEscape{'\x1b'};
+
+/// <summary>
+/// Same layout as the SDL screen: 1234/QWER/ASDF/ZXCV.
+/// </summary>
+constexpr std::string_view kKeyMap{"x123qweasdzc4rfv"};
+
+/// <summary>
+/// Puts the terminal in raw mode (no echo, no line buffering, no signals)
+/// and restores it when destroyed.
+/// </summary>
+class RawTerminal {
+ public:
+  RawTerminal() noexcept : active_(false) {
+#if defined(_WIN32)
+    input_ = GetStdHandle(STD_INPUT_HANDLE);
+    output_ = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (GetConsoleMode(input_, &input_mode_) &&
+        GetConsoleMode(output_, &output_mode_)) {
+      SetConsoleMode(input_, input_mode_ & ~(ENABLE_PROCESSED_INPUT |
+                                             ENABLE_LINE_INPUT |
+                                             ENABLE_ECHO_INPUT));
+      SetConsoleMode(output_,
+                     output_mode_ | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+      active_ = true;
+    }
+#else
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &saved_) == 0) {
+      termios raw{saved_};
+      raw.c_iflag &= ~(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
+      raw.c_lflag &= ~(ECHO | ICANON | IEXTEN | ISIG);
+      raw.c_cc[VMIN] = 0;
+      raw.c_cc[VTIME] = 0;
+      active_ = tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) == 0;
+    }
+#endif
+    if (!active_) {
+      LOG_WARN("Standard input is not a terminal, keys are not read");
+    }
+  }
+
+  RawTerminal(const RawTerminal&) = delete;
+  RawTerminal& operator=(const RawTerminal&) = delete;
+
+  ~RawTerminal() noexcept {
+    if (!active_) {
+      return;
+    }
+#if defined(_WIN32)
+    SetConsoleMode(input_, input_mode_);
+    SetConsoleMode(output_, output_mode_);
+#else
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_);
+#endif
+  }
+
+  bool IsActive() const noexcept { return active_; }
+
+ private:
+  bool active_;
+#if defined(_WIN32)
+  HANDLE input_;
+  HANDLE output_;
+  DWORD input_mode_;
+  DWORD output_mode_;
+#else
+  termios saved_;
+#endif
+};
+
+/// <summary>
+/// Waits up to kInputTimeout for bytes on stdin.
+/// </summary>
+std::string ReadBytes() {
+  std::string bytes;
+#if defined(_WIN32)
+  if (!_kbhit()) {
+    Sleep(static_cast<DWORD>(kInputTimeout.count()));
+  }
+  while (_kbhit()) {
+    bytes += static_cast<char>(_getch());
+  }
+#else
+  pollfd descriptor{STDIN_FILENO, POLLIN, 0};
+  if (poll(&descriptor, 1, static_cast<int>(kInputTimeout.count())) > 0) {
+    char buffer[64];
+    const ssize_t size{read(STDIN_FILENO, buffer, sizeof(buffer))};
+    if (size > 0) {
+      bytes.assign(buffer, static_cast<size_t>(size));
+    }
+  }
+#endif
+  return bytes;
+}
+
+/// <summary>
+/// Writes all of given bytes to stdout, in a single call unless the
+/// terminal accepts less.
+/// </summary>
+void Write(std::string_view bytes) noexcept {
+  CHIP8_ZONE("TerminalScreen::Write");
+  while (!bytes.empty()) {
+#if defined(_WIN32)
+    DWORD written{};
+    if (!WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), bytes.data(),
+                   static_cast<DWORD>(bytes.size()), &written, nullptr)) {
+      return;
+    }
+#else
+    const ssize_t written{write(STDOUT_FILENO, bytes.data(), bytes.size())};
+    if (written < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        continue;
+      }
+      return;
+    }
+#endif
+    bytes.remove_prefix(static_cast<size_t>(written));
+  }
+}
+
+}  // namespace
+
+TerminalScreen::TerminalScreen(Cpu& cpu, CycleRate cycle_rate,
+                               video::TerminalCells cells) noexcept
+    : cpu_(cpu),
+      cycle_rate_(cycle_rate),
+      cells_(cells),
+      pressed_at_(),
+      keys_(),
+      metrics_(nullptr),
+      netplay_(nullptr) {}
+
+void TerminalScreen::SetMetrics(runtime::EmulatorMetrics* metrics) noexcept {
+  metrics_ = metrics;
+}
+
+void TerminalScreen::SetNetplay(runtime::Netplay* netplay) noexcept {
+  netplay_ = netplay;
+}
+
+void TerminalScreen::RenderLoop() noexcept {
+  CHIP8_THREAD_NAME("Render");
+  LOG_INFO("Drawing on the terminal, press Escape or Ctrl-C to quit.");
+  LOG_DEBUG("Cycles: {} every {} frames", cycle_rate_.cycles,
+            cycle_rate_.frames);
+
+  const RawTerminal terminal;
+  utils::Logger::SetConsoleEnabled(false);
+
+  // There is nothing to wake up, input is polled with a short timeout.
+  runtime::EmulationThread emulation(cpu_, cycle_rate_);
+  emulation.SetMetrics(metrics_);
+  emulation.SetNetplay(netplay_);
+  video::TerminalRenderer renderer(cells_);
+  utils::Histogram present_times;
+  uint64_t presented_number{};
+  uint64_t written_bytes{};
+  uint8_t sound_timer{};
+  std::string output{"\x1b[?25l"};
+  emulation.Start();
+
+  bool quit{false};
+  while (!quit) {
+    CHIP8_ZONE("TerminalScreen::RenderLoop");
+    if (terminal.IsActive()) {
+      quit = !ReadInput();
+    } else {
+      std::this_thread::sleep_for(kInputTimeout);
+    }
+
+    UpdateKeysState(emulation);
+    if (emulation.Update()) {
+      CHIP8_PERF_SCOPE(kRender);
+      const auto start{Clock::now()};
+      const runtime::PresentedFrame& frame{emulation.GetFrame()};
+      renderer.Render(frame.pixels, output);
+      if (frame.sound_timer != 0 && sound_timer == 0 && kVolume > 0.0f) {
+        output += '\a';
+      }
+      sound_timer = frame.sound_timer;
+      Write(output);
+      written_bytes += output.size();
+      output.clear();
+      present_times.Record(Clock::now() - start);
+      if (metrics_ != nullptr) {
+        metrics_->frames_presented.Add();
+        metrics_->frames_skipped.Add(frame.number - presented_number - 1);
+      }
+      presented_number = frame.number;
+    }
+  }
+
+  emulation.Stop();
+  Write("\x1b[0m\x1b[?25h\x1b[" + std::to_string(renderer.GetRows() + 1) +
+        ";1H\r\n");
+  utils::Logger::SetConsoleEnabled(true);
+  LOG_INFO("Emulation frame times: {}",
+           emulation.GetFrameTimes().Summarize());
+  LOG_INFO("Presentation times: {}", present_times.Summarize());
+  LOG_INFO("Terminal output: {} bytes in {} frames", written_bytes,
+           present_times.GetCount());
+  if (emulation.GetDroppedKeyCount() != 0) {
+    LOG_WARN("Dropped key events: {}", emulation.GetDroppedKeyCount());
+  }
+}
+
+bool TerminalScreen::ReadInput() noexcept {
+  const std::string bytes{ReadBytes()};
+  const auto now{Clock::now()};
+  for (size_t i{}; i < bytes.size(); ++i) {
+    const char byte{bytes[i]};
+    if (byte == kCtrlC) {
+      return false;
+    }
+    if (byte == kEscape) {
+      // A lone Escape quits, longer sequences come from arrows and function
+      // keys and are skipped.
+      if (i + 1 == bytes.size()) {
+        return false;
+      }
+      if (bytes[i + 1] == '[' || bytes[i + 1] == 'O') {
+        i += 2;
+        while (i < bytes.size() && (bytes[i] < 0x40 || bytes[i] > 0x7E)) {
+          ++i;
+        }
+      }
+      continue;
+    }
+    const size_t key{kKeyMap.find(static_cast<char>(
+        std::tolower(static_cast<unsigned char>(byte))))};
+    if (key != std::string_view::npos) {
+      pressed_at_[key] = now;
+    }
+  }
+  return true;
+}
+
+void TerminalScreen::UpdateKeysState(
+    runtime::EmulationThread& emulation) noexcept {
+  CHIP8_ZONE("TerminalScreen::UpdateKeysState");
+  const auto now{Clock::now()};
+  for (uint8_t key{}; key < keys_.size(); ++key) {
+    const bool pressed{pressed_at_[key] != Clock::time_point{} &&
+                       now - pressed_at_[key] < kKeyHoldTime};
+    // A dropped event is retried on the next call.
+    if (pressed != keys_[key] && emulation.PushKey(key, pressed)) {
+      keys_[key] = pressed;
+    }
+  }
+}
+
+}  // namespace chip8::core
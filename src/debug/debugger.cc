@@ -0,0 +1,303 @@
+#include <chip8/analysis/disassembler.h>
+#include <chip8/core/memory.h>
+#include <chip8/debug/debugger.h>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace chip8::debug {
+
+bool BreakCondition::Matches(const core::Cpu& cpu) const noexcept {
+  const uint8_t actual{cpu.GetRegisters()[register_index & 0xFu]};
+  switch (comparison) {
+    case Comparison::kEqual:
+      return actual == value;
+    case Comparison::kNotEqual:
+      return actual != value;
+    case Comparison::kLess:
+      return actual < value;
+    case Comparison::kLessEqual:
+      return actual <= value;
+    case Comparison::kGreater:
+      return actual > value;
+    case Comparison::kGreaterEqual:
+      return actual >= value;
+  }
+  return false;
+}
+
+Debugger::Debugger(core::Cpu& cpu, size_t cycles_per_frame) noexcept
+    : cpu_(cpu),
+      cycles_per_frame_(std::max<size_t>(cycles_per_frame, 1)),
+      frame_cycle_(0),
+      frames_(0),
+      breakpoints_(),
+      unconditional_(),
+      conditions_(),
+      watch_reads_(),
+      watch_writes_(),
+      stopped_at_() {}
+
+void Debugger::AddBreakpoint(uint16_t address) noexcept {
+  const size_t wrapped{core::WrapAddress(address)};
+  breakpoints_.set(wrapped);
+  unconditional_.set(wrapped);
+}
+
+void Debugger::AddBreakpoint(uint16_t address, BreakCondition condition) {
+  const auto wrapped{static_cast<uint16_t>(core::WrapAddress(address))};
+  breakpoints_.set(wrapped);
+  conditions_.emplace_back(wrapped, condition);
+}
+
+void Debugger::RemoveBreakpoint(uint16_t address) noexcept {
+  const auto wrapped{static_cast<uint16_t>(core::WrapAddress(address))};
+  breakpoints_.reset(wrapped);
+  unconditional_.reset(wrapped);
+  std::erase_if(conditions_,
+                [wrapped](const auto& entry) { return entry.first == wrapped; });
+}
+
+void Debugger::AddWatchpoint(uint16_t address, uint16_t size,
+                             WatchKind kind) noexcept {
+  for (size_t offset{}; offset < size; ++offset) {
+    const size_t wrapped{core::WrapAddress(address + offset)};
+    if ((static_cast<uint8_t>(kind) & static_cast<uint8_t>(WatchKind::kRead)) !=
+        0) {
+      watch_reads_.set(wrapped);
+    }
+    if ((static_cast<uint8_t>(kind) &
+         static_cast<uint8_t>(WatchKind::kWrite)) != 0) {
+      watch_writes_.set(wrapped);
+    }
+  }
+}
+
+void Debugger::RemoveWatchpoint(uint16_t address, uint16_t size,
+                                WatchKind kind) noexcept {
+  for (size_t offset{}; offset < size; ++offset) {
+    const size_t wrapped{core::WrapAddress(address + offset)};
+    if ((static_cast<uint8_t>(kind) & static_cast<uint8_t>(WatchKind::kRead)) !=
+        0) {
+      watch_reads_.reset(wrapped);
+    }
+    if ((static_cast<uint8_t>(kind) &
+         static_cast<uint8_t>(WatchKind::kWrite)) != 0) {
+      watch_writes_.reset(wrapped);
+    }
+  }
+}
+
+void Debugger::Clear() noexcept {
+  breakpoints_.reset();
+  unconditional_.reset();
+  conditions_.clear();
+  watch_reads_.reset();
+  watch_writes_.reset();
+}
+
+bool Debugger::IsArmed() const noexcept {
+  return breakpoints_.any() || watch_reads_.any() || watch_writes_.any();
+}
+
+Stop Debugger::RunFrames(uint64_t frames) {
+  const uint64_t target{frames_ + frames};
+  while (frames_ < target) {
+    if (cpu_.GetCriticalError() != core::CritErrors::kNone) {
+      return Stop{StopReason::kHalted, cpu_.GetProgramCounter()};
+    }
+    // Nothing to check, so whole frames run on the fast paths.
+    if (frame_cycle_ == 0 && !IsArmed()) {
+      cpu_.RunFrame(cycles_per_frame_);
+      ++frames_;
+      stopped_at_.reset();
+      continue;
+    }
+    const Stop stop{
+        ExecuteChecked(cycles_per_frame_ - frame_cycle_, std::nullopt)};
+    if (stop.reason != StopReason::kDone) {
+      return stop;
+    }
+  }
+  return Stop{StopReason::kDone, cpu_.GetProgramCounter()};
+}
+
+Stop Debugger::StepInstruction() {
+  stopped_at_ = cpu_.GetProgramCounter();
+  return ExecuteChecked(1, std::nullopt);
+}
+
+Stop Debugger::StepOver(uint64_t max_instructions) {
+  const uint16_t opcode{
+      core::ReadWord(cpu_.GetMemory(), cpu_.GetProgramCounter())};
+  if ((opcode & 0xF000u) != 0x2000u) {
+    return StepInstruction();
+  }
+  // The call pushes one entry, its RET pops it.
+  stopped_at_ = cpu_.GetProgramCounter();
+  return ExecuteChecked(max_instructions,
+                        static_cast<uint8_t>(cpu_.GetStackPointer() + 1));
+}
+
+Stop Debugger::StepOut(uint64_t max_instructions) {
+  if (cpu_.GetStackPointer() == 0) {
+    return StepInstruction();
+  }
+  stopped_at_ = cpu_.GetProgramCounter();
+  return ExecuteChecked(max_instructions, cpu_.GetStackPointer());
+}
+
+uint64_t Debugger::GetFrameCount() const noexcept { return frames_; }
+
+std::string Debugger::FormatRegisters() const {
+  char buffer[96];
+  std::snprintf(buffer, sizeof(buffer),
+                "PC %04X  I %04X  SP %u  DT %02X  ST %02X  frame %llu\n",
+                cpu_.GetProgramCounter(), cpu_.GetIndexRegister(),
+                cpu_.GetStackPointer(), cpu_.GetDelayTimer(),
+                cpu_.GetSoundTimer(), static_cast<unsigned long long>(frames_));
+  std::string out{buffer};
+
+  for (size_t i{}; i < cpu_.GetRegisters().size(); ++i) {
+    std::snprintf(buffer, sizeof(buffer), "%sV%zX %02X", i == 0 ? "" : "  ", i,
+                  cpu_.GetRegisters()[i]);
+    out += buffer;
+  }
+  out += "\nStack:";
+  for (size_t i{}; i < std::min<size_t>(cpu_.GetStackPointer(),
+                                         cpu_.GetStack().size());
+       ++i) {
+    std::snprintf(buffer, sizeof(buffer), " %04X", cpu_.GetStack()[i]);
+    out += buffer;
+  }
+
+  const uint16_t opcode{
+      core::ReadWord(cpu_.GetMemory(), cpu_.GetProgramCounter())};
+  std::snprintf(buffer, sizeof(buffer), "\nNext: %04X  %04X  ",
+                cpu_.GetProgramCounter(), opcode);
+  out += buffer;
+  out += analysis::Disassemble(opcode);
+  out += '\n';
+  return out;
+}
+
+std::string Debugger::FormatMemory(uint16_t address, uint16_t size) const {
+  std::string out;
+  char buffer[16];
+  for (size_t offset{}; offset < size; ++offset) {
+    const size_t wrapped{core::WrapAddress(address + offset)};
+    if (offset % 16 == 0) {
+      std::snprintf(buffer, sizeof(buffer), "%s%04zX:", offset == 0 ? "" : "\n",
+                    wrapped);
+      out += buffer;
+    }
+    std::snprintf(buffer, sizeof(buffer), " %02X",
+                  core::ReadByte(cpu_.GetMemory(), wrapped));
+    out += buffer;
+  }
+  if (size != 0) {
+    out += '\n';
+  }
+  return out;
+}
+
+Stop Debugger::ExecuteChecked(uint64_t max_instructions,
+                              std::optional<uint8_t> return_depth) {
+  if (watch_reads_.any() || watch_writes_.any()) {
+    return Execute<true>(max_instructions, return_depth);
+  }
+  return Execute<false>(max_instructions, return_depth);
+}
+
+template <bool kWatchpoints>
+Stop Debugger::Execute(uint64_t max_instructions,
+                       std::optional<uint8_t> return_depth) {
+  for (uint64_t executed{}; executed < max_instructions; ++executed) {
+    const uint16_t program_counter{cpu_.GetProgramCounter()};
+    // The instruction the last stop happened at runs without being checked,
+    // otherwise execution could never resume from a breakpoint.
+    if (executed != 0 || stopped_at_ != program_counter) {
+      if (const std::optional<Stop> stop{Check<kWatchpoints>()}) {
+        stopped_at_ = program_counter;
+        return *stop;
+      }
+    }
+    stopped_at_.reset();
+
+    if (!ExecuteOne()) {
+      return Stop{StopReason::kHalted, program_counter};
+    }
+    if (return_depth && cpu_.GetStackPointer() < *return_depth) {
+      break;
+    }
+  }
+  return Stop{StopReason::kDone, cpu_.GetProgramCounter()};
+}
+
+template <bool kWatchpoints>
+std::optional<Stop> Debugger::Check() const noexcept {
+  const uint16_t program_counter{cpu_.GetProgramCounter()};
+  const size_t wrapped{core::WrapAddress(program_counter)};
+  if (breakpoints_[wrapped]) {
+    const bool hit{unconditional_[wrapped] ||
+                   std::any_of(conditions_.begin(), conditions_.end(),
+                               [this, wrapped](const auto& entry) {
+                                 return entry.first == wrapped &&
+                                        entry.second.Matches(cpu_);
+                               })};
+    if (hit) {
+      return Stop{StopReason::kBreakpoint, program_counter};
+    }
+  }
+  if constexpr (kWatchpoints) {
+    return CheckWatchpoints();
+  }
+  return std::nullopt;
+}
+
+std::optional<Stop> Debugger::CheckWatchpoints() const noexcept {
+  const uint16_t opcode{
+      core::ReadWord(cpu_.GetMemory(), cpu_.GetProgramCounter())};
+  const size_t x{(opcode & 0x0F00u) >> 8u};
+
+  // Only these instructions access memory through I.
+  size_t size{};
+  bool write{};
+  if ((opcode & 0xF000u) == 0xD000u) {
+    size = opcode & 0x000Fu;
+  } else if ((opcode & 0xF0FFu) == 0xF033u) {
+    size = 3;
+    write = true;
+  } else if ((opcode & 0xF0FFu) == 0xF055u) {
+    size = x + 1;
+    write = true;
+  } else if ((opcode & 0xF0FFu) == 0xF065u) {
+    size = x + 1;
+  }
+
+  const std::bitset<4096>& watched{write ? watch_writes_ : watch_reads_};
+  for (size_t offset{}; offset < size; ++offset) {
+    const size_t address{
+        core::WrapAddress(cpu_.GetIndexRegister() + offset)};
+    if (watched[address]) {
+      return Stop{write ? StopReason::kWatchWrite : StopReason::kWatchRead,
+                  static_cast<uint16_t>(address)};
+    }
+  }
+  return std::nullopt;
+}
+
+bool Debugger::ExecuteOne() {
+  if (cpu_.Step(1) == 0) {
+    return false;
+  }
+  // Ends the frame the way RunFrame() does: timers, then frame callback.
+  if (++frame_cycle_ == cycles_per_frame_) {
+    cpu_.RunFrame(0);
+    frame_cycle_ = 0;
+    ++frames_;
+  }
+  return true;
+}
+
+}  // namespace chip8::debug
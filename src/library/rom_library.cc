@@ -0,0 +1,415 @@
+#include <chip8/library/rom_library.h>
+
+#include <chip8/analysis/rom_analyzer.h>
+#include <chip8/core/constants.h>
+#include <chip8/utils/hash.h>
+#include <chip8/utils/logger.h>
+#include <chip8/utils/mapped_file.h>
+#include <chip8/utils/profiler.h>
+#include <chip8/utils/thread_pool.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <string_view>
+#include <unordered_set>
+
+namespace chip8::library {
+
+namespace {
+
+constexpr std::array<char, 4> kMagic{'C', '8', 'L', 1};
+constexpr size_t kHeaderSize{16};
+constexpr size_t kRecordSize{32};
+
+/// <summary>
+/// XO-CHIP has 64 KiB of memory, the other platforms 4 KiB.
+/// </summary>
+constexpr size_t kMaxRomSize{0x10000 - core::kRomStartAddress};
+
+constexpr std::array<std::string_view, 4> kExtensions{".ch8", ".c8", ".sc8",
+                                                      ".xo8"};
+
+bool IsSuperChip(uint16_t opcode) noexcept {
+  switch (opcode & 0xF000u) {
+    case 0x0000u:
+      // 00CN scrolls down, 00FB-00FF scroll, exit and switch resolution.
+      return ((opcode & 0xFFF0u) == 0x00C0u && (opcode & 0x000Fu) != 0) ||
+             (opcode >= 0x00FBu && opcode <= 0x00FFu);
+    case 0xD000u:
+      // DXY0 draws a 16x16 sprite.
+      return (opcode & 0x000Fu) == 0;
+    case 0xF000u:
+      // Large font, RPL user flags.
+      return (opcode & 0x00FFu) == 0x30u || (opcode & 0x00FFu) == 0x75u ||
+             (opcode & 0x00FFu) == 0x85u;
+    default:
+      return false;
+  }
+}
+
+bool IsXoChip(uint16_t opcode) noexcept {
+  switch (opcode & 0xF000u) {
+    case 0x0000u:
+      // 00DN scrolls up.
+      return (opcode & 0xFFF0u) == 0x00D0u && (opcode & 0x000Fu) != 0;
+    case 0x5000u:
+      // Save and load register ranges.
+      return (opcode & 0x000Fu) == 0x2u || (opcode & 0x000Fu) == 0x3u;
+    case 0xF000u:
+      // Long I, plane selection, audio pattern and pitch.
+      return opcode == 0xF000u || (opcode & 0x00FFu) == 0x01u ||
+             opcode == 0xF002u || (opcode & 0x00FFu) == 0x3Au;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+void AppendLittleEndian(std::string& out, T value) {
+  for (size_t i{}; i < sizeof(T); ++i) {
+    out += static_cast<char>((value >> (8 * i)) & 0xFFu);
+  }
+}
+
+template <typename T>
+T ReadLittleEndian(std::span<const uint8_t> bytes, size_t offset) noexcept {
+  T value{};
+  for (size_t i{}; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<T>(bytes[offset + i]) << (8 * i));
+  }
+  return value;
+}
+
+/// <summary>
+/// Returns the amount of records if the index has a valid header and room
+/// for all of them.
+/// </summary>
+std::optional<size_t> ReadHeader(std::span<const uint8_t> index) noexcept {
+  if (index.size() < kHeaderSize ||
+      !std::equal(kMagic.begin(), kMagic.end(), index.begin())) {
+    return std::nullopt;
+  }
+  const size_t count{ReadLittleEndian<uint32_t>(index, kMagic.size())};
+  if ((index.size() - kHeaderSize) / kRecordSize < count) {
+    return std::nullopt;
+  }
+  return count;
+}
+
+/// <summary>
+/// Decodes record number i of a validated index.
+/// </summary>
+std::optional<RomProfile> ReadRecord(std::span<const uint8_t> index,
+                                     size_t count, size_t i) {
+  const size_t offset{kHeaderSize + i * kRecordSize};
+  RomProfile profile;
+  profile.hash = ReadLittleEndian<uint64_t>(index, offset);
+  profile.size = ReadLittleEndian<uint32_t>(index, offset + 8);
+  profile.cycles_per_frame = ReadLittleEndian<uint32_t>(index, offset + 12);
+  profile.quirks = ReadLittleEndian<uint32_t>(index, offset + 16);
+  const size_t strings{kHeaderSize + count * kRecordSize +
+                       ReadLittleEndian<uint32_t>(index, offset + 20)};
+  const size_t title_size{ReadLittleEndian<uint16_t>(index, offset + 24)};
+  const size_t path_size{ReadLittleEndian<uint16_t>(index, offset + 26)};
+  const uint8_t platform{index[offset + 28]};
+  if (platform > static_cast<uint8_t>(Platform::kXoChip) ||
+      strings + title_size + path_size > index.size()) {
+    return std::nullopt;
+  }
+  profile.platform = static_cast<Platform>(platform);
+  const auto* text{reinterpret_cast<const char*>(index.data()) + strings};
+  profile.title.assign(text, title_size);
+  profile.path = std::filesystem::path(
+      std::u8string(reinterpret_cast<const char8_t*>(text) + title_size,
+                    path_size));
+  return profile;
+}
+
+bool IsRomFile(const std::filesystem::path& path) {
+  std::string extension{path.extension().string()};
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return std::find(kExtensions.begin(), kExtensions.end(), extension) !=
+         kExtensions.end();
+}
+
+}  // namespace
+
+const char* GetPlatformName(Platform platform) noexcept {
+  switch (platform) {
+    case Platform::kSuperChip:
+      return "SCHIP";
+    case Platform::kXoChip:
+      return "XO-CHIP";
+    default:
+      return "CHIP-8";
+  }
+}
+
+Platform DetectPlatform(std::span<const uint8_t> rom) {
+  if (core::kRomStartAddress + rom.size() > core::kMemorySize) {
+    return Platform::kXoChip;
+  }
+  const analysis::CodeMap map{analysis::RomAnalyzer(rom).Analyze()};
+  Platform platform{Platform::kChip8};
+  for (size_t address{core::kRomStartAddress};
+       address + 1 < core::kRomStartAddress + rom.size(); ++address) {
+    if (!map.instructions[address]) {
+      continue;
+    }
+    const size_t offset{address - core::kRomStartAddress};
+    const auto opcode{
+        static_cast<uint16_t>((rom[offset] << 8u) | rom[offset + 1])};
+    if (IsXoChip(opcode)) {
+      return Platform::kXoChip;
+    }
+    if (IsSuperChip(opcode)) {
+      platform = Platform::kSuperChip;
+    }
+  }
+  return platform;
+}
+
+uint32_t GetDefaultQuirks(Platform platform) noexcept {
+  switch (platform) {
+    case Platform::kSuperChip:
+      return kMemoryKeepsIndex | kJumpWithVx | kClipSprites;
+    case Platform::kXoChip:
+      return kShiftUsesVy;
+    default:
+      return 0;
+  }
+}
+
+uint32_t GetDefaultCyclesPerFrame(Platform platform) noexcept {
+  switch (platform) {
+    case Platform::kSuperChip:
+      return 30;
+    case Platform::kXoChip:
+      return 1000;
+    default:
+      return 10;
+  }
+}
+
+std::optional<RomProfile> RomLibrary::Inspect(
+    const std::filesystem::path& path) {
+  CHIP8_ZONE("RomLibrary::Inspect");
+  const std::unique_ptr<utils::MappedFile> file{utils::MappedFile::Open(path)};
+  if (!file) {
+    return std::nullopt;
+  }
+  const std::span<const uint8_t> bytes{file->GetBytes()};
+  if (bytes.empty() || bytes.size() > kMaxRomSize) {
+    LOG_ERROR("Not a ROM, {} bytes ('{}')", bytes.size(), path.string());
+    return std::nullopt;
+  }
+
+  RomProfile profile;
+  profile.hash = utils::Fnv1a(bytes);
+  profile.size = static_cast<uint32_t>(bytes.size());
+  profile.platform = DetectPlatform(bytes);
+  profile.quirks = GetDefaultQuirks(profile.platform);
+  profile.cycles_per_frame = GetDefaultCyclesPerFrame(profile.platform);
+  profile.title = path.stem().string();
+  profile.path = std::filesystem::absolute(path);
+  return profile;
+}
+
+std::optional<RomProfile> RomLibrary::Lookup(
+    const std::filesystem::path& index_path, uint64_t hash) {
+  CHIP8_ZONE("RomLibrary::Lookup");
+  const std::unique_ptr<utils::MappedFile> file{
+      utils::MappedFile::Open(index_path)};
+  if (!file) {
+    return std::nullopt;
+  }
+  const std::span<const uint8_t> index{file->GetBytes()};
+  const std::optional<size_t> count{ReadHeader(index)};
+  if (!count) {
+    LOG_ERROR("Not a ROM library index ('{}')", index_path.string());
+    return std::nullopt;
+  }
+
+  size_t low{};
+  size_t high{*count};
+  while (low < high) {
+    const size_t middle{low + (high - low) / 2};
+    if (ReadLittleEndian<uint64_t>(index, kHeaderSize + middle * kRecordSize) <
+        hash) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == *count ||
+      ReadLittleEndian<uint64_t>(index, kHeaderSize + low * kRecordSize) !=
+          hash) {
+    return std::nullopt;
+  }
+  return ReadRecord(index, *count, low);
+}
+
+std::optional<RomLibrary> RomLibrary::Load(const std::filesystem::path& path) {
+  const std::unique_ptr<utils::MappedFile> file{utils::MappedFile::Open(path)};
+  if (!file) {
+    return std::nullopt;
+  }
+  const std::span<const uint8_t> index{file->GetBytes()};
+  const std::optional<size_t> count{ReadHeader(index)};
+  if (!count) {
+    LOG_ERROR("Not a ROM library index ('{}')", path.string());
+    return std::nullopt;
+  }
+
+  RomLibrary library;
+  library.profiles_.reserve(*count);
+  for (size_t i{}; i < *count; ++i) {
+    std::optional<RomProfile> profile{ReadRecord(index, *count, i)};
+    if (!profile || (!library.profiles_.empty() &&
+                     library.profiles_.back().hash >= profile->hash)) {
+      LOG_ERROR("Malformed ROM library index ('{}')", path.string());
+      return std::nullopt;
+    }
+    library.profiles_.push_back(std::move(*profile));
+  }
+  return library;
+}
+
+bool RomLibrary::Save(const std::filesystem::path& path) const {
+  std::string records;
+  std::string strings;
+  records.reserve(profiles_.size() * kRecordSize);
+  for (const RomProfile& profile : profiles_) {
+    const std::string title{profile.title.substr(0, UINT16_MAX)};
+    const std::u8string location{profile.path.generic_u8string()};
+    if (location.size() > UINT16_MAX) {
+      LOG_ERROR("ROM path too long ('{}')", profile.path.string());
+      return false;
+    }
+    AppendLittleEndian(records, profile.hash);
+    AppendLittleEndian(records, profile.size);
+    AppendLittleEndian(records, profile.cycles_per_frame);
+    AppendLittleEndian(records, profile.quirks);
+    AppendLittleEndian(records, static_cast<uint32_t>(strings.size()));
+    AppendLittleEndian(records, static_cast<uint16_t>(title.size()));
+    AppendLittleEndian(records, static_cast<uint16_t>(location.size()));
+    AppendLittleEndian(records, static_cast<uint8_t>(profile.platform));
+    records.append(3, '\0');
+    strings += title;
+    strings.append(reinterpret_cast<const char*>(location.data()),
+                   location.size());
+  }
+
+  // Written next to the index and renamed, so a concurrent Lookup() never
+  // sees a partial file.
+  std::filesystem::path temporary{path};
+  temporary += ".tmp";
+  {
+    std::ofstream out_stream(temporary, std::ios::binary | std::ios::trunc);
+    if (!out_stream.is_open()) {
+      LOG_ERROR("Failed to write ROM library index ('{}')", path.string());
+      return false;
+    }
+    std::string header(kMagic.begin(), kMagic.end());
+    AppendLittleEndian(header, static_cast<uint32_t>(profiles_.size()));
+    header.resize(kHeaderSize, '\0');
+    out_stream << header << records << strings;
+    out_stream.close();
+    if (out_stream.fail()) {
+      LOG_ERROR("Failed to write ROM library index ('{}')", path.string());
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    LOG_ERROR("Failed to replace ROM library index ('{}'): {}", path.string(),
+              error.message());
+    return false;
+  }
+  return true;
+}
+
+ScanStats RomLibrary::Scan(const std::filesystem::path& directory,
+                           size_t threads) {
+  CHIP8_ZONE("RomLibrary::Scan");
+  ScanStats stats;
+  std::vector<std::filesystem::path> paths;
+  std::error_code error;
+  for (std::filesystem::recursive_directory_iterator it(
+           directory,
+           std::filesystem::directory_options::skip_permission_denied, error),
+       end;
+       !error && it != end; it.increment(error)) {
+    if (it->is_regular_file(error) && IsRomFile(it->path())) {
+      paths.push_back(it->path());
+    }
+  }
+  if (error) {
+    LOG_ERROR("Failed to scan '{}': {}", directory.string(), error.message());
+  }
+  // Sorted so duplicates resolve the same way on every scan.
+  std::sort(paths.begin(), paths.end());
+  stats.files = paths.size();
+
+  std::vector<std::optional<RomProfile>> inspected(paths.size());
+  utils::ThreadPool pool(std::max<size_t>(threads, 1));
+  pool.ParallelFor(paths.size(),
+                   [&](size_t i) { inspected[i] = Inspect(paths[i]); });
+
+  std::unordered_set<uint64_t> seen;
+  for (std::optional<RomProfile>& profile : inspected) {
+    if (!profile) {
+      ++stats.failed;
+      continue;
+    }
+    if (!seen.insert(profile->hash).second) {
+      ++stats.duplicates;
+      continue;
+    }
+    const auto it{std::lower_bound(
+        profiles_.begin(), profiles_.end(), profile->hash,
+        [](const RomProfile& known, uint64_t hash) {
+          return known.hash < hash;
+        })};
+    if (it != profiles_.end() && it->hash == profile->hash) {
+      // Keeps tuned values, the ROM may have been moved.
+      if (!std::filesystem::exists(it->path, error)) {
+        it->path = std::move(profile->path);
+      }
+      continue;
+    }
+    profiles_.insert(it, std::move(*profile));
+    ++stats.added;
+  }
+  return stats;
+}
+
+void RomLibrary::Add(RomProfile profile) {
+  const auto it{std::lower_bound(
+      profiles_.begin(), profiles_.end(), profile.hash,
+      [](const RomProfile& known, uint64_t hash) { return known.hash < hash; })};
+  if (it != profiles_.end() && it->hash == profile.hash) {
+    *it = std::move(profile);
+  } else {
+    profiles_.insert(it, std::move(profile));
+  }
+}
+
+const RomProfile* RomLibrary::Find(uint64_t hash) const noexcept {
+  const auto it{std::lower_bound(
+      profiles_.begin(), profiles_.end(), hash,
+      [](const RomProfile& known, uint64_t value) {
+        return known.hash < value;
+      })};
+  return it != profiles_.end() && it->hash == hash ? &*it : nullptr;
+}
+
+const std::vector<RomProfile>& RomLibrary::GetProfiles() const noexcept {
+  return profiles_;
+}
+
+}  // namespace chip8::library
@@ -1,31 +1,331 @@
 #include <chip8/chip8.h>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
 // ! Links to articles i used:
 // ! https://austinmorlan.com/posts/chip8_emulator/
 // ! http://devernay.free.fr/hacks/chip8/C8TECH10.HTM#00E0
 
+namespace {
+
+/// <summary>
+/// Optional start parameters, passed as --name=value after the required ones.
+/// Empty values are not set.
+/// </summary>
+struct Options {
+  std::string code_map;
+  std::string aot_plugin;
+  std::string recording;
+  std::string metrics_port;
+  std::string metrics_json;
+  std::string netplay;
+  std::string renderer{"sdl"};
+  std::string export_name;
+  std::string library;
+};
+
+/// <summary>
+/// Parses named options, logging the first unknown one.
+/// </summary>
+std::optional<Options> ParseOptions(int argc, char* argv[], int first) {
+  constexpr std::array<std::pair<std::string_view, std::string Options::*>, 9>
+      kOptions{{{"--code-map=", &Options::code_map},
+                {"--aot=", &Options::aot_plugin},
+                {"--record=", &Options::recording},
+                {"--metrics-port=", &Options::metrics_port},
+                {"--metrics-json=", &Options::metrics_json},
+                {"--netplay=", &Options::netplay},
+                {"--renderer=", &Options::renderer},
+                {"--export=", &Options::export_name},
+                {"--library=", &Options::library}}};
+
+  Options options;
+  for (int i{first}; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    const auto option{std::find_if(
+        kOptions.begin(), kOptions.end(),
+        [arg](const auto& entry) { return arg.starts_with(entry.first); })};
+    if (option == kOptions.end()) {
+      LOG_ERROR("Unknown start parameter: {}", arg);
+      return std::nullopt;
+    }
+    options.*option->second = arg.substr(option->first.size());
+  }
+  return options;
+}
+
+/// <summary>
+/// Parses a port number, std::nullopt unless it is within 1-65535.
+/// </summary>
+std::optional<uint16_t> ParsePort(std::string_view text) noexcept {
+  unsigned long port{};
+  const auto [end, error]{
+      std::from_chars(text.data(), text.data() + text.size(), port)};
+  if (error != std::errc{} || end != text.data() + text.size() || port == 0 ||
+      port > UINT16_MAX) {
+    return std::nullopt;
+  }
+  return static_cast<uint16_t>(port);
+}
+
+}  // namespace
+
 int main(int argc, char* argv[]) {
   chip8::utils::Logger::Init();
 
-  if (argc != 4) {
-    LOG_ERROR("Incorrect amount of start parameters: {}", argc - 1);
-    LOG_ERROR("Correct usage: ./{} [rom_path] [volume] [cycle_delay]", argv[0]);
+  const std::optional<Options> options{
+      argc < 4 ? std::nullopt : ParseOptions(argc, argv, 4)};
+  if (!options) {
+    LOG_ERROR(
+        "Correct usage: ./{} <rom_path> <volume> <cycle_delay> "
+        "[--code-map=<path>] [--aot=<plugin>] [--record=<path>] "
+        "[--metrics-port=<port>] [--metrics-json=<path>] "
+        "[--netplay=host:<port>|join:<host>:<port>] "
+        "[--renderer=sdl|terminal|braille] [--export=<name>] "
+        "[--library=<index>]",
+        argv[0]);
     return 1;
   }
 
   chip8::core::kVolume = std::stof(argv[2]);
-  chip8::core::kCycleDelay = std::stoul(argv[3]);
+  const bool auto_speed{std::string_view{argv[3]} == "-"};
+  if (!auto_speed) {
+    chip8::core::kCycleDelay = std::stoul(argv[3]);
+  }
 
   for (size_t i{1}; i < static_cast<size_t>(argc); ++i) {
     LOG_INFO("Arg #{}: {}", i, argv[i]);
   }
 
+  // Without cycle_delay the ROM runs at the speed stored in the library.
+  std::optional<chip8::library::RomProfile> profile;
+  if (!options->library.empty()) {
+    const std::optional<chip8::core::RomImage> rom{
+        chip8::core::RomImage::Load(argv[1])};
+    if (rom) {
+      profile = chip8::library::RomLibrary::Lookup(options->library,
+                                                    rom->GetHash());
+    }
+    if (profile) {
+      LOG_INFO("{} ({}, {} cycles per frame)", profile->title,
+               chip8::library::GetPlatformName(profile->platform),
+               profile->cycles_per_frame);
+      if (profile->platform != chip8::library::Platform::kChip8 ||
+          profile->quirks != 0) {
+        LOG_WARN("ROM expects {} with quirks {:#x}, only CHIP-8 with quirks "
+                 "0 is implemented",
+                 chip8::library::GetPlatformName(profile->platform),
+                 profile->quirks);
+      }
+    } else {
+      LOG_WARN("ROM is not in the library, add it with chip8-library");
+    }
+  }
+  if (auto_speed) {
+    chip8::core::kCyclesPerFrame =
+        profile ? profile->cycles_per_frame
+                : chip8::library::GetDefaultCyclesPerFrame(
+                      chip8::library::Platform::kChip8);
+  }
+  const chip8::core::CycleRate cycle_rate{
+      chip8::core::Screen::GetCycleRate()};
+
   chip8::core::Cpu cpu;
   cpu.LoadROM(argv[1]);
 
-  chip8::core::Screen screen(cpu);
-  screen.RenderLoop();
+  if (!options->code_map.empty()) {
+    const std::optional<chip8::analysis::CodeMap> code_map{
+        chip8::analysis::RomAnalyzer::Load(options->code_map)};
+    if (code_map) {
+      cpu.PrewarmDecodeCache(*code_map);
+    }
+  }
+
+  std::unique_ptr<chip8::aot::AotPlugin> plugin;
+  if (!options->aot_plugin.empty()) {
+    plugin = chip8::aot::AotPlugin::Load(options->aot_plugin);
+    if (plugin) {
+      cpu.AttachAotModule(plugin->GetModule());
+    }
+  }
+
+  std::unique_ptr<chip8::video::Recorder> recorder;
+  std::unique_ptr<chip8::runtime::MovieWriter> movie;
+  chip8::core::Cpu::FrameCallback on_frame;
+  const std::string_view recording{options->recording};
+  const bool record{!recording.empty()};
+  if (record && recording.ends_with(".c8m")) {
+    const std::optional<chip8::core::RomImage> rom{
+        chip8::core::RomImage::Load(argv[1])};
+    chip8::runtime::MovieHeader header;
+    header.rom_hash = rom ? rom->GetHash() : 0;
+    header.seed = std::random_device{}();
+    // Movies replay the same amount of cycles in every frame
+    header.cycles_per_frame =
+        static_cast<uint32_t>(cycle_rate.GetRoundedCycles());
+    cpu.SeedRNG(header.seed);
+    movie = chip8::runtime::MovieWriter::Open(options->recording, header);
+    if (movie) {
+      on_frame = [&movie](const chip8::core::Cpu& frame) {
+        movie->AddFrame(frame.GetKeyMask());
+      };
+    }
+  } else if (record) {
+    chip8::video::RecorderConfig config;
+    config.container = recording.ends_with(".y4m")
+                           ? chip8::video::Container::kY4m
+                           : chip8::video::Container::kRaw;
+    recorder = chip8::video::Recorder::Open(options->recording, config);
+    if (recorder) {
+      on_frame = [&recorder](const chip8::core::Cpu& frame) {
+        recorder->AddFrame(frame);
+      };
+    }
+  }
+
+  chip8::utils::MetricsRegistry registry;
+  chip8::runtime::EmulatorMetrics metrics(registry);
+  chip8::runtime::MetricsExporterConfig exporter_config;
+  if (!options->metrics_port.empty()) {
+    const std::optional<uint16_t> port{ParsePort(options->metrics_port)};
+    if (!port) {
+      LOG_ERROR("Metrics port must be between 1 and 65535");
+      return 1;
+    }
+    exporter_config.http_port = *port;
+  }
+  exporter_config.json_path = options->metrics_json;
+  std::unique_ptr<chip8::runtime::MetricsExporter> exporter;
+  if (exporter_config.http_port || !exporter_config.json_path.empty()) {
+    exporter = chip8::runtime::MetricsExporter::Start(registry,
+                                                      exporter_config);
+  }
+
+  // host:<port> plays keys 0-B, join:<host>:<port> plays keys C-F.
+  std::unique_ptr<chip8::runtime::Netplay> netplay;
+  if (!options->netplay.empty()) {
+    const std::string_view spec{options->netplay};
+    chip8::runtime::NetplayConfig netplay_config;
+    netplay_config.rollback.cycles_per_frame = cycle_rate.GetRoundedCycles();
+    std::optional<uint16_t> port;
+    if (spec.starts_with("host:")) {
+      port = ParsePort(spec.substr(5));
+      netplay_config.local_port = port.value_or(0);
+    } else if (spec.starts_with("join:") && spec.rfind(':') > 4) {
+      const size_t colon{spec.rfind(':')};
+      port = ParsePort(spec.substr(colon + 1));
+      netplay_config.remote_host = spec.substr(5, colon - 5);
+      netplay_config.remote_port = port.value_or(0);
+      netplay_config.rollback.local_keys = 0xF000;
+    }
+    if (!port) {
+      LOG_ERROR("Netplay must be host:<port> or join:<host>:<port>, with a "
+                "port between 1 and 65535");
+      return 1;
+    }
+    if (movie || recorder) {
+      LOG_ERROR("Recording is not supported during netplay");
+      return 1;
+    }
+
+    // Both players must produce the same random numbers, and peers with
+    // another ROM or speed are rejected.
+    const std::optional<chip8::core::RomImage> rom{
+        chip8::core::RomImage::Load(argv[1])};
+    netplay_config.rom_hash = rom ? rom->GetHash() : 0;
+    cpu.SeedRNG(static_cast<unsigned int>(netplay_config.rom_hash));
+    netplay = chip8::runtime::Netplay::Open(cpu, netplay_config);
+    if (!netplay) {
+      return 1;
+    }
+  }
+
+  // Published from the emulation thread at the end of every frame.
+  std::unique_ptr<chip8::runtime::SharedStateWriter> shared_state;
+  if (!options->export_name.empty()) {
+    // Rollbacks re-simulate frames, readers would see mispredicted ones.
+    if (netplay) {
+      LOG_ERROR("Shared memory export is not supported during netplay");
+      return 1;
+    }
+    shared_state = chip8::runtime::SharedStateWriter::Create(
+        options->export_name);
+    if (!shared_state) {
+      return 1;
+    }
+    on_frame = [&shared_state, record = std::move(on_frame)](
+                   const chip8::core::Cpu& frame) {
+      if (record) {
+        record(frame);
+      }
+      shared_state->Publish(frame);
+    };
+  }
+  cpu.SetFrameCallback(std::move(on_frame));
 
+  const std::string_view renderer{options->renderer};
+  if (renderer != "sdl" && renderer != "terminal" && renderer != "braille") {
+    LOG_ERROR("Renderer must be sdl, terminal or braille");
+    return 1;
+  }
+  const auto run{[&](auto& screen) {
+    if (exporter) {
+      screen.SetMetrics(&metrics);
+    }
+    screen.SetNetplay(netplay.get());
+    screen.RenderLoop();
+  }};
+  if (renderer == "terminal" || renderer == "braille") {
+    chip8::core::TerminalScreen screen(
+        cpu, cycle_rate,
+        renderer == "braille" ? chip8::video::TerminalCells::kBraille
+                              : chip8::video::TerminalCells::kHalfBlock);
+    run(screen);
+  } else {
+    chip8::core::Screen screen(cpu);
+    run(screen);
+  }
+  if (exporter) {
+    exporter->Stop();
+  }
+  cpu.SetFrameCallback(nullptr);
+  if (recorder) {
+    recorder->Close();
+  }
+  if (movie) {
+    movie->Close(cpu.GetStateHash());
+  }
+  if (netplay) {
+    const chip8::runtime::RollbackStats& stats{
+        netplay->GetSession().GetStats()};
+    LOG_INFO("Netplay: {} frames, {} rollbacks ({} frames re-simulated, "
+             "deepest {}), {} stalls",
+             stats.frames, stats.rollbacks, stats.resimulated_frames,
+             stats.max_depth, stats.stalls);
+    LOG_INFO("Re-simulation time: {}",
+             stats.resimulation_times.Summarize());
+  }
+  LOG_INFO("Instructions executed as superinstructions: {}",
+           cpu.GetFusedInstructionCount());
+  LOG_INFO("Instructions executed by compiled blocks: {}",
+           cpu.GetAotInstructionCount());
+  cpu.AttachAotModule(nullptr);
+#ifdef CHIP8_PERF_COUNTERS
+  LOG_INFO("Hardware counters:\n{}", chip8::utils::PerfCounters::Report());
+#endif
+#ifdef CHIP8_PROFILE
+  if (chip8::utils::Profiler::WriteChromeTrace("chip8_trace.json")) {
+    LOG_INFO("Instrumentation zones written to chip8_trace.json");
+  }
+#endif
 
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include <chip8/runtime/emulation_thread.h>
+#include <chip8/utils/profiler.h>
+
+namespace chip8::runtime {
+
+EmulationThread::EmulationThread(core::Cpu& cpu, core::CycleRate cycle_rate,
+                                 Clock::duration frame_duration,
+                                 std::function<void()> on_publish)
+    : cpu_(cpu),
+      cycle_rate_(cycle_rate),
+      frame_duration_(frame_duration),
+      on_publish_(std::move(on_publish)),
+      frames_(),
+      keys_(),
+      wakeups_(0),
+      running_(false),
+      dropped_keys_(0),
+      frame_times_(),
+      metrics_(nullptr),
+      netplay_(nullptr),
+      local_keys_(0),
+      reported_unknown_opcodes_(0),
+      reported_halt_(false),
+      rate_start_(),
+      rate_instructions_(0) {}
+
+EmulationThread::~EmulationThread() noexcept { Stop(); }
+
+void EmulationThread::SetMetrics(EmulatorMetrics* metrics) noexcept {
+  metrics_ = metrics;
+}
+
+void EmulationThread::SetNetplay(Netplay* netplay) noexcept {
+  netplay_ = netplay;
+}
+
+void EmulationThread::Start() {
+  if (thread_.joinable()) {
+    return;
+  }
+  running_.store(true, std::memory_order_relaxed);
+  thread_ = std::thread(&EmulationThread::Run, this);
+}
+
+void EmulationThread::Stop() noexcept {
+  if (!thread_.joinable()) {
+    return;
+  }
+  running_.store(false, std::memory_order_relaxed);
+  wakeups_.fetch_add(1, std::memory_order_release);
+  wakeups_.notify_one();
+  thread_.join();
+}
+
+bool EmulationThread::PushKey(uint8_t key, bool pressed) noexcept {
+  if (!keys_.TryPush(KeyEvent{key, pressed})) {
+    ++dropped_keys_;
+    return false;
+  }
+  wakeups_.fetch_add(1, std::memory_order_release);
+  wakeups_.notify_one();
+  return true;
+}
+
+bool EmulationThread::Update() noexcept { return frames_.Update(); }
+
+const PresentedFrame& EmulationThread::GetFrame() const noexcept {
+  return frames_.GetFront();
+}
+
+const utils::Histogram& EmulationThread::GetFrameTimes() const noexcept {
+  return frame_times_;
+}
+
+uint64_t EmulationThread::GetDroppedKeyCount() const noexcept {
+  return dropped_keys_;
+}
+
+void EmulationThread::Run() noexcept {
+  CHIP8_THREAD_NAME("Emulation");
+  uint64_t frame_number{};
+  auto next_frame_time{Clock::now()};
+  rate_start_ = next_frame_time;
+  rate_instructions_ = 0;
+  reported_unknown_opcodes_ = cpu_.GetUnknownOpcodeCount();
+  reported_halt_ = cpu_.GetCriticalError() != core::CritErrors::kNone;
+
+  while (running_.load(std::memory_order_relaxed)) {
+    // Read the counter before draining the queue, so an event pushed in
+    // between is never slept through.
+    const uint32_t wakeups{wakeups_.load(std::memory_order_acquire)};
+    ApplyKeys();
+
+    const auto start{Clock::now()};
+    // A netplay frame waiting for the other player executes nothing.
+    const size_t executed{netplay_ != nullptr
+                              ? netplay_->RunFrame(local_keys_).value_or(0)
+                              : cpu_.RunFrame(cycle_rate_.GetCycles(frame_number))};
+
+    {
+      CHIP8_ZONE("EmulationThread::Publish");
+      PresentedFrame& frame{frames_.GetBack()};
+      core::PackFramebuffer(cpu_.GetPixels(), frame.pixels);
+      frame.sound_timer = cpu_.GetSoundTimer();
+      frame.number = ++frame_number;
+      frames_.Publish();
+    }
+    const auto frame_time{Clock::now() - start};
+    frame_times_.Record(frame_time);
+    if (metrics_ != nullptr) {
+      UpdateMetrics(executed, frame_time);
+    }
+
+    if (on_publish_) {
+      CHIP8_ZONE("EmulationThread::OnPublish");
+      on_publish_();
+    }
+
+    // Nothing can change until a key event arrives, so block instead of
+    // emulating identical frames.
+    if (IsStalled()) {
+      if (metrics_ != nullptr) {
+        metrics_->instructions_per_second.Set(0);
+      }
+      wakeups_.wait(wakeups, std::memory_order_acquire);
+      next_frame_time = Clock::now();
+      rate_start_ = next_frame_time;
+      rate_instructions_ = 0;
+      continue;
+    }
+
+    next_frame_time += frame_duration_;
+    const auto now{Clock::now()};
+    if (next_frame_time > now) {
+      std::this_thread::sleep_until(next_frame_time);
+    } else {
+      next_frame_time = now;
+    }
+  }
+}
+
+void EmulationThread::ApplyKeys() noexcept {
+  CHIP8_ZONE("EmulationThread::ApplyKeys");
+  while (const auto event{keys_.TryPop()}) {
+    if (netplay_ == nullptr) {
+      cpu_.SetKey(event->key, event->pressed);
+    } else if (event->pressed) {
+      local_keys_ |= static_cast<uint16_t>(1u << event->key);
+    } else {
+      local_keys_ &= static_cast<uint16_t>(~(1u << event->key));
+    }
+  }
+}
+
+void EmulationThread::UpdateMetrics(size_t executed,
+                                    Clock::duration frame_time) noexcept {
+  metrics_->instructions.Add(executed);
+  metrics_->frames_emulated.Add();
+  metrics_->frame_time.Record(frame_time);
+
+  // The cpu counts since its last ROM load, report only what is new.
+  const uint64_t unknown_opcodes{cpu_.GetUnknownOpcodeCount()};
+  if (unknown_opcodes > reported_unknown_opcodes_) {
+    metrics_->unknown_opcodes.Add(unknown_opcodes - reported_unknown_opcodes_);
+  }
+  reported_unknown_opcodes_ = unknown_opcodes;
+
+  const bool halted{cpu_.GetCriticalError() != core::CritErrors::kNone};
+  if (halted && !reported_halt_) {
+    metrics_->critical_errors.Add();
+  }
+  reported_halt_ = halted;
+
+  rate_instructions_ += executed;
+  const auto now{Clock::now()};
+  const std::chrono::duration<double> elapsed{now - rate_start_};
+  if (elapsed >= std::chrono::seconds{1}) {
+    metrics_->instructions_per_second.Set(
+        static_cast<double>(rate_instructions_) / elapsed.count());
+    rate_start_ = now;
+    rate_instructions_ = 0;
+  }
+}
+
+bool EmulationThread::IsStalled() const noexcept {
+  // Input of the other player arrives without key events.
+  if (netplay_ != nullptr) {
+    return false;
+  }
+  if (cpu_.GetCriticalError() != core::CritErrors::kNone) {
+    return true;
+  }
+  const core::IdleState idle_state{cpu_.GetIdleState()};
+  return (idle_state == core::IdleState::kKeyWait ||
+          idle_state == core::IdleState::kJumpToSelf) &&
+         cpu_.GetDelayTimer() == 0 && cpu_.GetSoundTimer() == 0;
+}
+
+}  // namespace chip8::runtime
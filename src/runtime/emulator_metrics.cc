@@ -0,0 +1,44 @@
+#include <chip8/runtime/emulator_metrics.h>
+
+namespace chip8::runtime {
+
+namespace {
+
+/// <summary>
+/// Frame time buckets, from far below a frame to several frames late.
+/// </summary>
+std::vector<std::chrono::nanoseconds> GetFrameTimeBounds() {
+  using std::chrono::microseconds;
+  return {microseconds{50},   microseconds{100},   microseconds{250},
+          microseconds{500},  microseconds{1000},  microseconds{2500},
+          microseconds{5000}, microseconds{10000}, microseconds{16667},
+          microseconds{25000}, microseconds{50000}, microseconds{100000}};
+}
+
+}  // namespace
+
+EmulatorMetrics::EmulatorMetrics(utils::MetricsRegistry& registry)
+    : instructions(registry.AddCounter("chip8_instructions_total",
+                                       "Instructions executed by the cpu.")),
+      instructions_per_second(registry.AddGauge(
+          "chip8_instructions_per_second",
+          "Instructions executed during the last second of emulation.")),
+      frames_emulated(registry.AddCounter("chip8_frames_emulated_total",
+                                          "Frames emulated and published.")),
+      frames_presented(registry.AddCounter("chip8_frames_presented_total",
+                                           "Frames shown on screen.")),
+      frames_skipped(registry.AddCounter(
+          "chip8_frames_skipped_total",
+          "Published frames replaced before they were shown.")),
+      frame_time(registry.AddHistogram("chip8_frame_time_seconds",
+                                       "Time spent emulating a frame.",
+                                       GetFrameTimeBounds())),
+      audio_queue_bytes(registry.AddGauge("chip8_audio_queue_bytes",
+                                          "Audio queued for playback.")),
+      unknown_opcodes(registry.AddCounter("chip8_unknown_opcodes_total",
+                                          "Unknown opcodes executed.")),
+      critical_errors(registry.AddCounter(
+          "chip8_critical_errors_total",
+          "Stack overflows and underflows which halted the cpu.")) {}
+
+}  // namespace chip8::runtime
@@ -0,0 +1,72 @@
+#include <chip8/runtime/environment.h>
+
+namespace chip8::runtime {
+
+Environment::Environment(std::shared_ptr<const core::RomImage> rom,
+                         EnvironmentConfig config, Framebuffer* observation)
+    : rom_(std::move(rom)),
+      config_(std::move(config)),
+      cpu_(),
+      own_observation_(),
+      observation_(observation != nullptr ? observation : &own_observation_),
+      before_(config_.watched_addresses.size()),
+      after_(config_.watched_addresses.size()),
+      episode_frames_() {}
+
+const Framebuffer& Environment::Reset(unsigned int seed) noexcept {
+  cpu_.Reset();
+  cpu_.SeedRNG(seed);
+  cpu_.LoadROM(*rom_);
+  episode_frames_ = 0;
+
+  ReadWatched(after_);
+  core::PackFramebuffer(cpu_.GetPixels(), *observation_);
+  return *observation_;
+}
+
+StepResult Environment::Step(uint16_t action) {
+  cpu_.SetKeyMask(action);
+
+  before_.swap(after_);
+  for (size_t frame{}; frame < config_.frame_skip; ++frame) {
+    cpu_.RunFrame(config_.cycles_per_frame);
+  }
+  episode_frames_ += config_.frame_skip;
+
+  ReadWatched(after_);
+  core::PackFramebuffer(cpu_.GetPixels(), *observation_);
+
+  StepResult result{};
+  if (config_.reward) {
+    result.reward = config_.reward(before_, after_);
+  }
+  if (config_.terminal) {
+    result.terminated = config_.terminal(after_);
+  }
+  // A halted cpu never runs again, whatever the hook says
+  if (cpu_.GetCriticalError() != core::CritErrors::kNone) {
+    result.terminated = true;
+  }
+  result.truncated = config_.max_episode_frames != 0 &&
+                     episode_frames_ >= config_.max_episode_frames;
+  return result;
+}
+
+const Framebuffer& Environment::GetObservation() const noexcept {
+  return *observation_;
+}
+
+uint64_t Environment::GetEpisodeFrames() const noexcept {
+  return episode_frames_;
+}
+
+const core::Cpu& Environment::GetCpu() const noexcept { return cpu_; }
+
+void Environment::ReadWatched(std::vector<uint8_t>& out) const noexcept {
+  const std::array<uint8_t, 4096>& memory{cpu_.GetMemory()};
+  for (size_t i{}; i < out.size(); ++i) {
+    out[i] = core::ReadByte(memory, config_.watched_addresses[i]);
+  }
+}
+
+}  // namespace chip8::runtime
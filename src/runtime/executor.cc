@@ -0,0 +1,178 @@
+#include <chip8/runtime/executor.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace chip8::runtime {
+
+Executor::Executor(bool real_time, Clock::duration frame_duration)
+    : real_time_(real_time),
+      frame_duration_(frame_duration),
+      simulated_now_(),
+      sequence_(),
+      active_(),
+      sessions_(),
+      queue_() {}
+
+size_t Executor::Spawn(core::Cpu& cpu, SessionConfig config) {
+  const size_t id{sessions_.size()};
+  sessions_.push_back(std::make_unique<Session>(
+      Session{id, &cpu, std::move(config), SessionStats{}, SessionTask{}, Now(),
+              false, false, false}));
+
+  Session& session{*sessions_.back()};
+  session.task = RunSession(session);
+  ++active_;
+  Schedule(session);
+
+  LOG_DEBUG("Session #{} spawned ({} cycles per frame).", id,
+            session.config.cycles_per_frame);
+  return id;
+}
+
+void Executor::SetKey(size_t session, uint8_t key, bool pressed) {
+  Session& state{*sessions_.at(session)};
+  state.cpu->SetKey(key, pressed);
+
+  if (pressed && state.waiting_for_key && !state.finished) {
+    state.waiting_for_key = false;
+    state.deadline = Now();
+    Schedule(state);
+  }
+}
+
+void Executor::Stop(size_t session) {
+  Session& state{*sessions_.at(session)};
+  state.stop_requested = true;
+
+  if (state.waiting_for_key && !state.finished) {
+    state.waiting_for_key = false;
+    state.deadline = Now();
+    Schedule(state);
+  }
+}
+
+void Executor::Run() { RunUntil(Clock::time_point::max()); }
+
+void Executor::RunUntil(Clock::time_point end) {
+  while (!queue_.empty() && queue_.top().deadline <= end) {
+    const Clock::time_point deadline{queue_.top().deadline};
+    if (real_time_) {
+      std::this_thread::sleep_until(deadline);
+    } else if (simulated_now_ < deadline) {
+      simulated_now_ = deadline;
+    }
+
+    const Clock::time_point woken{Clock::now()};
+    const Scheduled next{queue_.top()};
+    queue_.pop();
+
+    Session& session{*sessions_[next.session]};
+    if (session.finished) {
+      continue;
+    }
+
+    const Clock::time_point now{Now()};
+    const auto lateness{
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - deadline)};
+    session.stats.max_lateness = std::max(session.stats.max_lateness, lateness);
+    if (now - deadline >= frame_duration_) {
+      ++session.stats.deadline_misses;
+      session.deadline = now;
+      LOG_DEBUG("Session #{} missed its deadline by {} ns.", next.session,
+                lateness.count());
+    }
+
+    session.stats.scheduling_overhead += Clock::now() - woken;
+    session.task.Resume();
+
+    if (session.task.IsDone()) {
+      session.finished = true;
+      --active_;
+      LOG_DEBUG("Session #{} finished after {} frames.", next.session,
+                session.stats.frames);
+    }
+  }
+
+  if (!real_time_ && end != Clock::time_point::max() && simulated_now_ < end) {
+    simulated_now_ = end;
+  }
+}
+
+Executor::Clock::time_point Executor::Now() const noexcept {
+  return real_time_ ? Clock::now() : simulated_now_;
+}
+
+bool Executor::IsFinished(size_t session) const noexcept {
+  return sessions_[session]->finished;
+}
+
+bool Executor::IsWaitingForKey(size_t session) const noexcept {
+  return sessions_[session]->waiting_for_key;
+}
+
+const SessionStats& Executor::GetStats(size_t session) const noexcept {
+  return sessions_[session]->stats;
+}
+
+size_t Executor::GetActiveCount() const noexcept { return active_; }
+
+void Executor::FrameAwaiter::await_suspend(std::coroutine_handle<>) const {
+  session->deadline += executor->frame_duration_;
+  executor->Schedule(*session);
+}
+
+bool Executor::KeyAwaiter::await_ready() const noexcept {
+  return session->stop_requested;
+}
+
+void Executor::KeyAwaiter::await_suspend(
+    std::coroutine_handle<>) const noexcept {
+  session->waiting_for_key = true;
+}
+
+SessionTask Executor::RunSession(Session& session) {
+  core::Cpu& cpu{*session.cpu};
+  SessionStats& stats{session.stats};
+
+  while (!session.stop_requested &&
+         (session.config.max_frames == 0 ||
+          stats.frames < session.config.max_frames)) {
+    const Clock::time_point start{Clock::now()};
+    const size_t executed{cpu.RunFrame(session.config.cycles_per_frame)};
+    ++stats.frames;
+    if (executed < session.config.cycles_per_frame) {
+      ++stats.idle_frames;
+    }
+    if (session.config.on_frame) {
+      session.config.on_frame(cpu);
+    }
+    stats.emulation_time += Clock::now() - start;
+
+    // A halted cpu never runs again, rescheduling it would spin forever
+    if (cpu.GetCriticalError() != core::CritErrors::kNone) {
+      stats.error = cpu.GetCriticalError();
+      LOG_WARN("Session #{} halted after {} frames.", session.id,
+               stats.frames);
+      co_return;
+    }
+
+    if (IsBlockedOnKey(cpu)) {
+      ++stats.key_waits;
+      co_await KeyAwaiter{&session};
+    } else {
+      co_await FrameAwaiter{this, &session};
+    }
+  }
+}
+
+void Executor::Schedule(Session& session) {
+  queue_.push(Scheduled{session.deadline, sequence_++, session.id});
+}
+
+bool Executor::IsBlockedOnKey(const core::Cpu& cpu) noexcept {
+  return cpu.GetIdleState() == core::IdleState::kKeyWait &&
+         cpu.GetDelayTimer() == 0 && cpu.GetSoundTimer() == 0;
+}
+
+}  // namespace chip8::runtime
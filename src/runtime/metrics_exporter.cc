@@ -0,0 +1,265 @@
+#include <chip8/runtime/metrics_exporter.h>
+#include <chip8/utils/logger.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace chip8::runtime {
+
+namespace {
+
+/// <summary>
+/// Longest time the exporter thread sleeps before checking for Stop().
+/// </summary>
+constexpr int kPollTimeoutMs{100};
+
+constexpr intptr_t kNoSocket{-1};
+
+void CloseSocket(intptr_t socket) noexcept {
+#if defined(_WIN32)
+  closesocket(static_cast<SOCKET>(socket));
+#else
+  close(static_cast<int>(socket));
+#endif
+}
+
+/// <summary>
+/// Waits until the socket has a pending connection or data.
+/// </summary>
+bool WaitReadable(intptr_t socket, int timeout_ms) noexcept {
+#if defined(_WIN32)
+  WSAPOLLFD descriptor{static_cast<SOCKET>(socket), POLLRDNORM, 0};
+  return WSAPoll(&descriptor, 1, timeout_ms) > 0;
+#else
+  pollfd descriptor{static_cast<int>(socket), POLLIN, 0};
+  return poll(&descriptor, 1, timeout_ms) > 0;
+#endif
+}
+
+void SendAll(intptr_t socket, std::string_view data) noexcept {
+  while (!data.empty()) {
+#if defined(_WIN32)
+    const int sent{send(static_cast<SOCKET>(socket), data.data(),
+                        static_cast<int>(data.size()), 0)};
+#else
+    const ssize_t sent{
+        send(static_cast<int>(socket), data.data(), data.size(), MSG_NOSIGNAL)};
+#endif
+    if (sent <= 0) {
+      return;
+    }
+    data.remove_prefix(static_cast<size_t>(sent));
+  }
+}
+
+std::string MakeResponse(std::string_view status, std::string_view type,
+                         const std::string& body) {
+  char header[192];
+  std::snprintf(header, sizeof(header),
+                "HTTP/1.1 %.*s\r\nContent-Type: %.*s\r\n"
+                "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+                static_cast<int>(status.size()), status.data(),
+                static_cast<int>(type.size()), type.data(), body.size());
+  return header + body;
+}
+
+/// <summary>
+/// Opens a listening socket on 127.0.0.1.
+/// </summary>
+/// <param name="port">Requested port, receives the bound one.</param>
+intptr_t Listen(uint16_t& port) noexcept {
+#if defined(_WIN32)
+  WSADATA wsa_data;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+    return kNoSocket;
+  }
+  const SOCKET native{socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)};
+  if (native == INVALID_SOCKET) {
+    return kNoSocket;
+  }
+  const intptr_t listener{static_cast<intptr_t>(native)};
+#else
+  const int native{socket(AF_INET, SOCK_STREAM, 0)};
+  if (native < 0) {
+    return kNoSocket;
+  }
+  const intptr_t listener{native};
+  const int reuse{1};
+  setsockopt(native, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  socklen_t length{sizeof(address)};
+  if (bind(native, reinterpret_cast<const sockaddr*>(&address), length) != 0 ||
+      listen(native, 8) != 0 ||
+      getsockname(native, reinterpret_cast<sockaddr*>(&address), &length) !=
+          0) {
+    CloseSocket(listener);
+    return kNoSocket;
+  }
+  port = ntohs(address.sin_port);
+  return listener;
+}
+
+}  // namespace
+
+std::unique_ptr<MetricsExporter> MetricsExporter::Start(
+    const utils::MetricsRegistry& registry, MetricsExporterConfig config) {
+  Socket listener{kNoSocket};
+  uint16_t port{};
+  if (config.http_port) {
+    port = *config.http_port;
+    listener = Listen(port);
+    if (listener == kNoSocket) {
+      LOG_ERROR("Failed to open metrics endpoint on port {}",
+                *config.http_port);
+      return nullptr;
+    }
+    LOG_INFO("Serving metrics on http://127.0.0.1:{}/metrics", port);
+  }
+
+  std::unique_ptr<MetricsExporter> exporter(
+      new MetricsExporter(registry, std::move(config), listener, port));
+  exporter->thread_ = std::thread(&MetricsExporter::Run, exporter.get());
+  return exporter;
+}
+
+MetricsExporter::MetricsExporter(const utils::MetricsRegistry& registry,
+                                 MetricsExporterConfig config, Socket listener,
+                                 uint16_t port) noexcept
+    : registry_(registry),
+      config_(std::move(config)),
+      listener_(listener),
+      port_(port),
+      running_(true),
+      thread_() {}
+
+MetricsExporter::~MetricsExporter() noexcept { Stop(); }
+
+void MetricsExporter::Stop() noexcept {
+  if (!thread_.joinable()) {
+    return;
+  }
+  running_.store(false, std::memory_order_relaxed);
+  thread_.join();
+  if (listener_ != kNoSocket) {
+    CloseSocket(listener_);
+    listener_ = kNoSocket;
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+  }
+  DumpJson();
+}
+
+uint16_t MetricsExporter::GetPort() const noexcept { return port_; }
+
+void MetricsExporter::Run() noexcept {
+  using Clock = std::chrono::steady_clock;
+  auto next_dump{Clock::now() + config_.json_interval};
+
+  while (running_.load(std::memory_order_relaxed)) {
+    if (listener_ == kNoSocket) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{kPollTimeoutMs});
+    } else if (WaitReadable(listener_, kPollTimeoutMs)) {
+#if defined(_WIN32)
+      const SOCKET native{accept(static_cast<SOCKET>(listener_), nullptr,
+                                 nullptr)};
+      if (native != INVALID_SOCKET) {
+        Serve(static_cast<Socket>(native));
+      }
+#else
+      const int native{accept(static_cast<int>(listener_), nullptr, nullptr)};
+      if (native >= 0) {
+        Serve(native);
+      }
+#endif
+    }
+
+    if (!config_.json_path.empty() && Clock::now() >= next_dump) {
+      DumpJson();
+      next_dump += config_.json_interval;
+    }
+  }
+}
+
+void MetricsExporter::Serve(Socket client) const noexcept {
+  // A client which never sends its request must not stall the thread.
+  std::string request;
+  char buffer[1024];
+  while (request.find("\r\n") == std::string::npos && request.size() < 4096 &&
+         WaitReadable(client, 1000)) {
+#if defined(_WIN32)
+    const int received{recv(static_cast<SOCKET>(client), buffer,
+                            static_cast<int>(sizeof(buffer)), 0)};
+#else
+    const ssize_t received{
+        recv(static_cast<int>(client), buffer, sizeof(buffer), 0)};
+#endif
+    if (received <= 0) {
+      break;
+    }
+    request.append(buffer, static_cast<size_t>(received));
+  }
+
+  try {
+    const std::string_view line{std::string_view{request}.substr(
+        0, request.find("\r\n"))};
+    std::string response;
+    if (line.starts_with("GET /metrics ")) {
+      response = MakeResponse("200 OK", "text/plain; version=0.0.4",
+                              registry_.FormatPrometheus());
+    } else if (line.starts_with("GET /metrics.json ")) {
+      response =
+          MakeResponse("200 OK", "application/json", registry_.FormatJson());
+    } else {
+      response = MakeResponse("404 Not Found", "text/plain", "Not found\n");
+    }
+    SendAll(client, response);
+  } catch (const std::exception& error) {
+    LOG_ERROR("Failed to serve metrics: {}", error.what());
+  }
+  CloseSocket(client);
+}
+
+void MetricsExporter::DumpJson() const noexcept {
+  if (config_.json_path.empty()) {
+    return;
+  }
+
+  try {
+    std::filesystem::path temporary{config_.json_path};
+    temporary += ".tmp";
+    {
+      std::ofstream out_stream(temporary, std::ios::trunc);
+      if (!out_stream.is_open()) {
+        LOG_ERROR("Failed to write metrics ('{}')", temporary.string());
+        return;
+      }
+      out_stream << registry_.FormatJson() << '\n';
+    }
+    std::filesystem::rename(temporary, config_.json_path);
+  } catch (const std::exception& error) {
+    LOG_ERROR("Failed to write metrics ('{}'): {}", config_.json_path.string(),
+              error.what());
+  }
+}
+
+}  // namespace chip8::runtime
@@ -0,0 +1,222 @@
+#include <chip8/runtime/movie.h>
+
+#include <array>
+
+namespace chip8::runtime {
+
+namespace {
+
+/// <summary>
+/// First bytes of every movie: "C8M" and format version.
+/// </summary>
+constexpr std::array<char, 4> kMagic{'C', '8', 'M', 1};
+
+template <typename T>
+void WriteLittleEndian(std::ostream& out_stream, T value) {
+  for (size_t i{}; i < sizeof(T); ++i) {
+    out_stream.put(static_cast<char>((value >> (8 * i)) & 0xFFu));
+  }
+}
+
+template <typename T>
+bool ReadLittleEndian(std::istream& in_stream, T& value) {
+  value = 0;
+  for (size_t i{}; i < sizeof(T); ++i) {
+    const int byte{in_stream.get()};
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<T>(static_cast<T>(byte) << (8 * i));
+  }
+  return true;
+}
+
+void WriteVarint(std::ostream& out_stream, uint64_t value) {
+  while (value >= 0x80u) {
+    out_stream.put(static_cast<char>((value & 0x7Fu) | 0x80u));
+    value >>= 7;
+  }
+  out_stream.put(static_cast<char>(value));
+}
+
+bool ReadVarint(std::istream& in_stream, uint64_t& value) {
+  value = 0;
+  for (size_t shift{}; shift < 64; shift += 7) {
+    const int byte{in_stream.get()};
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+std::unique_ptr<MovieWriter> MovieWriter::Open(
+    const std::filesystem::path& path, const MovieHeader& header) {
+  std::ofstream out_stream(path, std::ios::binary | std::ios::trunc);
+  if (!out_stream.is_open()) {
+    LOG_ERROR("Failed to open movie for writing ('{}')", path.string());
+    return nullptr;
+  }
+
+  out_stream.write(kMagic.data(), kMagic.size());
+  WriteLittleEndian(out_stream, header.rom_hash);
+  WriteLittleEndian(out_stream, header.seed);
+  WriteLittleEndian(out_stream, header.cycles_per_frame);
+  WriteLittleEndian(out_stream, header.quirks);
+  LOG_INFO("Recording movie to {} (RNG seed {})", path.string(), header.seed);
+  return std::unique_ptr<MovieWriter>(new MovieWriter(std::move(out_stream)));
+}
+
+MovieWriter::MovieWriter(std::ofstream out_stream)
+    : out_stream_(std::move(out_stream)), keys_(0), held_(0), frames_(0) {}
+
+MovieWriter::~MovieWriter() noexcept { Close(); }
+
+void MovieWriter::AddFrame(uint16_t keys) noexcept {
+  if (keys != keys_) {
+    WriteRecord(held_, static_cast<uint16_t>(keys ^ keys_));
+    keys_ = keys;
+    held_ = 0;
+  }
+  ++held_;
+  ++frames_;
+}
+
+bool MovieWriter::Close(uint64_t state_hash) noexcept {
+  if (!out_stream_.is_open()) {
+    return true;
+  }
+
+  WriteRecord(held_, 0);
+  WriteVarint(out_stream_, frames_);
+  WriteLittleEndian(out_stream_, state_hash);
+  out_stream_.close();
+  if (out_stream_.fail()) {
+    LOG_ERROR("Failed to write movie");
+    return false;
+  }
+  LOG_INFO("Recorded movie of {} frames", frames_);
+  return true;
+}
+
+uint64_t MovieWriter::GetFrameCount() const noexcept { return frames_; }
+
+void MovieWriter::WriteRecord(uint64_t frames, uint16_t delta) noexcept {
+  WriteVarint(out_stream_, frames);
+  WriteLittleEndian(out_stream_, delta);
+}
+
+std::unique_ptr<MovieReader> MovieReader::Open(
+    const std::filesystem::path& path) {
+  std::ifstream in_stream(path, std::ios::binary);
+  if (!in_stream.is_open()) {
+    LOG_ERROR("Failed to open movie ('{}')", path.string());
+    return nullptr;
+  }
+
+  std::array<char, kMagic.size()> magic{};
+  MovieHeader header;
+  if (!in_stream.read(magic.data(), magic.size()) || magic != kMagic ||
+      !ReadLittleEndian(in_stream, header.rom_hash) ||
+      !ReadLittleEndian(in_stream, header.seed) ||
+      !ReadLittleEndian(in_stream, header.cycles_per_frame) ||
+      !ReadLittleEndian(in_stream, header.quirks)) {
+    LOG_ERROR("Not a supported movie ('{}')", path.string());
+    return nullptr;
+  }
+  return std::unique_ptr<MovieReader>(
+      new MovieReader(std::move(in_stream), header));
+}
+
+MovieReader::MovieReader(std::ifstream in_stream, const MovieHeader& header)
+    : in_stream_(std::move(in_stream)),
+      header_(header),
+      keys_(0),
+      next_delta_(0),
+      remaining_(0),
+      frames_(0),
+      last_record_(false),
+      complete_(false),
+      state_hash_(0) {}
+
+const MovieHeader& MovieReader::GetHeader() const noexcept { return header_; }
+
+std::optional<uint16_t> MovieReader::NextFrame() noexcept {
+  while (remaining_ == 0) {
+    if (last_record_ || !ReadRecord()) {
+      return std::nullopt;
+    }
+  }
+  --remaining_;
+  ++frames_;
+  return keys_;
+}
+
+uint64_t MovieReader::GetFrameCount() const noexcept { return frames_; }
+
+bool MovieReader::IsComplete() const noexcept {
+  return complete_ && remaining_ == 0;
+}
+
+uint64_t MovieReader::GetStateHash() const noexcept { return state_hash_; }
+
+bool MovieReader::ReadRecord() noexcept {
+  keys_ ^= next_delta_;
+  if (!ReadVarint(in_stream_, remaining_) ||
+      !ReadLittleEndian(in_stream_, next_delta_)) {
+    LOG_WARN("Movie ends after {} frames without a proper end", frames_);
+    remaining_ = 0;
+    last_record_ = true;
+    return false;
+  }
+
+  if (next_delta_ == 0) {
+    last_record_ = true;
+    uint64_t frames{};
+    complete_ = ReadVarint(in_stream_, frames) &&
+                ReadLittleEndian(in_stream_, state_hash_) &&
+                frames == frames_ + remaining_;
+    if (!complete_) {
+      LOG_WARN("Movie has a malformed end");
+    }
+  }
+  return true;
+}
+
+std::optional<ReplayResult> Replay(const core::RomImage& rom,
+                                   MovieReader& movie, core::Cpu& cpu,
+                                   core::Cpu::FrameCallback on_frame) {
+  const MovieHeader& header{movie.GetHeader()};
+  if (header.rom_hash != rom.GetHash()) {
+    LOG_ERROR("Movie was recorded with another ROM");
+    return std::nullopt;
+  } else if (header.quirks != 0) {
+    LOG_ERROR("Movie uses unsupported quirk profile {}", header.quirks);
+    return std::nullopt;
+  }
+
+  cpu.Reset();
+  cpu.SeedRNG(header.seed);
+  cpu.LoadROM(rom);
+  cpu.SetFrameCallback(std::move(on_frame));
+  while (const std::optional<uint16_t> keys{movie.NextFrame()}) {
+    cpu.SetKeyMask(*keys);
+    cpu.RunFrame(header.cycles_per_frame);
+  }
+
+  ReplayResult result;
+  result.frames = movie.GetFrameCount();
+  result.state_hash = cpu.GetStateHash();
+  result.complete = movie.IsComplete();
+  result.matched = result.complete && movie.GetStateHash() != 0 &&
+                   movie.GetStateHash() == result.state_hash;
+  return result;
+}
+
+}  // namespace chip8::runtime
@@ -0,0 +1,299 @@
+#include <chip8/runtime/netplay.h>
+#include <chip8/utils/logger.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace chip8::runtime {
+
+namespace {
+
+constexpr intptr_t kNoSocket{-1};
+
+constexpr std::array<uint8_t, 4> kMagic{'C', '8', 'N', 2};
+
+constexpr size_t kRomHashOffset{kMagic.size()};
+constexpr size_t kCyclesOffset{kRomHashOffset + 8};
+constexpr size_t kFirstFrameOffset{kCyclesOffset + 4};
+
+/// <summary>
+/// Magic, ROM hash, cycles per frame, first frame and amount of inputs.
+/// </summary>
+constexpr size_t kHeaderSize{kFirstFrameOffset + 8 + 1};
+
+constexpr size_t kMaxInputs{255};
+
+template <typename T>
+void StoreLittleEndian(uint8_t* out, T value) noexcept {
+  for (size_t i{}; i < sizeof(T); ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+template <typename T>
+T LoadLittleEndian(const uint8_t* in) noexcept {
+  T value{};
+  for (size_t i{}; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<T>(in[i]) << (8 * i));
+  }
+  return value;
+}
+
+void CloseSocket(intptr_t socket) noexcept {
+#if defined(_WIN32)
+  closesocket(static_cast<SOCKET>(socket));
+  WSACleanup();
+#else
+  close(static_cast<int>(socket));
+#endif
+}
+
+/// <summary>
+/// Opens a non-blocking UDP socket on all interfaces.
+/// </summary>
+/// <param name="port">Requested port, receives the bound one.</param>
+intptr_t Bind(uint16_t& port) noexcept {
+#if defined(_WIN32)
+  WSADATA wsa_data;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+    return kNoSocket;
+  }
+  const SOCKET native{socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)};
+  if (native == INVALID_SOCKET) {
+    WSACleanup();
+    return kNoSocket;
+  }
+  u_long non_blocking{1};
+  ioctlsocket(native, FIONBIO, &non_blocking);
+  const intptr_t bound{static_cast<intptr_t>(native)};
+#else
+  const int native{socket(AF_INET, SOCK_DGRAM, 0)};
+  if (native < 0) {
+    return kNoSocket;
+  }
+  fcntl(native, F_SETFL, fcntl(native, F_GETFL, 0) | O_NONBLOCK);
+  const intptr_t bound{native};
+#endif
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  socklen_t length{sizeof(address)};
+  if (bind(native, reinterpret_cast<const sockaddr*>(&address), length) != 0 ||
+      getsockname(native, reinterpret_cast<sockaddr*>(&address), &length) !=
+          0) {
+    CloseSocket(bound);
+    return kNoSocket;
+  }
+  port = ntohs(address.sin_port);
+  return bound;
+}
+
+/// <summary>
+/// Resolves an IPv4 host name or address.
+/// </summary>
+/// <returns>Address in host byte order, 0 on failure.</returns>
+uint32_t Resolve(const std::string& host) noexcept {
+  addrinfo hints{};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_DGRAM;
+  addrinfo* result{};
+  if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 ||
+      result == nullptr) {
+    return 0;
+  }
+  const uint32_t ip{ntohl(
+      reinterpret_cast<const sockaddr_in*>(result->ai_addr)->sin_addr.s_addr)};
+  freeaddrinfo(result);
+  return ip;
+}
+
+}  // namespace
+
+std::unique_ptr<Netplay> Netplay::Open(core::Cpu& cpu, NetplayConfig config) {
+  uint16_t port{config.local_port};
+  const Socket socket{Bind(port)};
+  if (socket == kNoSocket) {
+    LOG_ERROR("Failed to open netplay socket on port {}", config.local_port);
+    return nullptr;
+  }
+
+  uint32_t remote_ip{};
+  if (!config.remote_host.empty()) {
+    remote_ip = Resolve(config.remote_host);
+    if (remote_ip == 0 || config.remote_port == 0) {
+      LOG_ERROR("Failed to resolve netplay peer {}:{}", config.remote_host,
+                config.remote_port);
+      CloseSocket(socket);
+      return nullptr;
+    }
+    LOG_INFO("Netplay on port {}, sending to {}:{}", port, config.remote_host,
+             config.remote_port);
+  } else {
+    LOG_INFO("Netplay on port {}, waiting for the other player", port);
+  }
+
+  return std::unique_ptr<Netplay>(
+      new Netplay(cpu, config, socket, port, remote_ip));
+}
+
+Netplay::Netplay(core::Cpu& cpu, const NetplayConfig& config, Socket socket,
+                 uint16_t port, uint32_t remote_ip)
+    : session_(cpu, config.rollback),
+      socket_(socket),
+      port_(port),
+      remote_ip_(remote_ip),
+      remote_port_(config.remote_port),
+      rom_hash_(config.rom_hash),
+      cycles_per_frame_(
+          static_cast<uint32_t>(config.rollback.cycles_per_frame)),
+      connected_(false),
+      mismatched_(false) {}
+
+Netplay::~Netplay() noexcept { CloseSocket(socket_); }
+
+std::optional<size_t> Netplay::RunFrame(uint16_t local_keys) {
+  Receive();
+  const std::optional<size_t> executed{session_.AdvanceFrame(local_keys)};
+  Send();
+  return executed;
+}
+
+void Netplay::Poll() {
+  Receive();
+  session_.Synchronize();
+  Send();
+}
+
+uint16_t Netplay::GetPort() const noexcept { return port_; }
+
+bool Netplay::IsConnected() const noexcept { return connected_; }
+
+bool Netplay::IsMismatched() const noexcept { return mismatched_; }
+
+const RollbackSession& Netplay::GetSession() const noexcept {
+  return session_;
+}
+
+void Netplay::Receive() noexcept {
+  std::array<uint8_t, kHeaderSize + kMaxInputs * 2> buffer;
+  while (true) {
+    sockaddr_in sender{};
+    socklen_t length{sizeof(sender)};
+#if defined(_WIN32)
+    const int received{recvfrom(static_cast<SOCKET>(socket_),
+                                reinterpret_cast<char*>(buffer.data()),
+                                static_cast<int>(buffer.size()), 0,
+                                reinterpret_cast<sockaddr*>(&sender), &length)};
+#else
+    const ssize_t received{recvfrom(static_cast<int>(socket_), buffer.data(),
+                                    buffer.size(), 0,
+                                    reinterpret_cast<sockaddr*>(&sender),
+                                    &length)};
+#endif
+    if (received < 0) {
+      return;
+    }
+    const auto size{static_cast<size_t>(received)};
+    if (size < kHeaderSize ||
+        !std::equal(kMagic.begin(), kMagic.end(), buffer.begin()) ||
+        size != kHeaderSize + buffer[kHeaderSize - 1] * 2u) {
+      continue;
+    }
+
+    const uint64_t rom_hash{
+        LoadLittleEndian<uint64_t>(buffer.data() + kRomHashOffset)};
+    const uint32_t cycles_per_frame{
+        LoadLittleEndian<uint32_t>(buffer.data() + kCyclesOffset)};
+    const uint32_t sender_ip{ntohl(sender.sin_addr.s_addr)};
+    const uint16_t sender_port{ntohs(sender.sin_port)};
+    if (rom_hash != rom_hash_ || cycles_per_frame != cycles_per_frame_) {
+      if (!mismatched_) {
+        LOG_ERROR("Netplay peer runs ROM {:016x} at {} cycles per frame, "
+                  "expected ROM {:016x} at {}; its input is ignored",
+                  rom_hash, cycles_per_frame, rom_hash_, cycles_per_frame_);
+        mismatched_ = true;
+      }
+      // An empty reply lets the peer report the mismatch too. Empty
+      // datagrams are never answered, so two peers cannot ping-pong.
+      if (buffer[kHeaderSize - 1] != 0) {
+        SendTo(sender_ip, sender_port, 0, 0);
+      }
+      continue;
+    }
+
+    if (remote_ip_ == 0) {
+      remote_ip_ = sender_ip;
+      remote_port_ = sender_port;
+    } else if (sender_ip != remote_ip_ || sender_port != remote_port_) {
+      continue;
+    }
+    if (!connected_) {
+      LOG_INFO("Netplay connected to the other player");
+      connected_ = true;
+    }
+
+    const uint64_t first_frame{
+        LoadLittleEndian<uint64_t>(buffer.data() + kFirstFrameOffset)};
+    for (size_t i{}; i < buffer[kHeaderSize - 1]; ++i) {
+      const size_t offset{kHeaderSize + i * 2};
+      session_.AddRemoteInput(
+          first_frame + i, LoadLittleEndian<uint16_t>(buffer.data() + offset));
+    }
+  }
+}
+
+void Netplay::Send() noexcept {
+  const uint64_t frame{session_.GetFrame()};
+  if (remote_ip_ == 0 || frame == 0) {
+    return;
+  }
+  const size_t count{static_cast<size_t>(std::min<uint64_t>(
+      frame, std::min(session_.GetHistorySize(), kMaxInputs)))};
+  // A lost datagram is resent as a part of the next ones.
+  SendTo(remote_ip_, remote_port_, frame - count, count);
+}
+
+void Netplay::SendTo(uint32_t ip, uint16_t port, uint64_t first_frame,
+                     size_t count) noexcept {
+  std::array<uint8_t, kHeaderSize + kMaxInputs * 2> buffer;
+  std::copy(kMagic.begin(), kMagic.end(), buffer.begin());
+  StoreLittleEndian(buffer.data() + kRomHashOffset, rom_hash_);
+  StoreLittleEndian(buffer.data() + kCyclesOffset, cycles_per_frame_);
+  StoreLittleEndian(buffer.data() + kFirstFrameOffset, first_frame);
+  buffer[kHeaderSize - 1] = static_cast<uint8_t>(count);
+  for (size_t i{}; i < count; ++i) {
+    StoreLittleEndian(buffer.data() + kHeaderSize + i * 2,
+                      session_.GetLocalInput(first_frame + i));
+  }
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(ip);
+  address.sin_port = htons(port);
+  const size_t size{kHeaderSize + count * 2};
+#if defined(_WIN32)
+  sendto(static_cast<SOCKET>(socket_),
+         reinterpret_cast<const char*>(buffer.data()), static_cast<int>(size),
+         0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+#else
+  sendto(static_cast<int>(socket_), buffer.data(), size, 0,
+         reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+#endif
+}
+
+}  // namespace chip8::runtime
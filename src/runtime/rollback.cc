@@ -0,0 +1,130 @@
+#include <chip8/runtime/rollback.h>
+#include <chip8/utils/profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace chip8::runtime {
+
+namespace {
+
+constexpr uint64_t kNoFrame{std::numeric_limits<uint64_t>::max()};
+
+}  // namespace
+
+RollbackSession::RollbackSession(core::Cpu& cpu, RollbackConfig config)
+    : cpu_(cpu),
+      config_(config),
+      slots_(),
+      remote_(),
+      frame_(0),
+      confirmed_(0),
+      predicted_keys_(0),
+      rollback_from_(),
+      stats_() {
+  config_.max_rollback = std::max<size_t>(config_.max_rollback, 1);
+  // Snapshots reach back max_rollback frames. Remote input may run as far
+  // ahead, and local input is resent for twice the window, see Netplay.
+  const size_t ring{2 * config_.max_rollback + 2};
+  slots_.assign(ring, Slot{kNoFrame, {}, 0, 0});
+  remote_.assign(ring, RemoteInput{kNoFrame, 0});
+}
+
+std::optional<size_t> RollbackSession::AdvanceFrame(uint16_t local_keys) {
+  if (frame_ >= confirmed_ + config_.max_rollback) {
+    ++stats_.stalls;
+    return std::nullopt;
+  }
+  Synchronize();
+  const size_t executed{RunFrame(frame_, local_keys)};
+  ++frame_;
+  ++stats_.frames;
+  return executed;
+}
+
+void RollbackSession::AddRemoteInput(uint64_t frame, uint16_t keys) noexcept {
+  if (frame < confirmed_ || frame >= confirmed_ + remote_.size()) {
+    return;
+  }
+  // Keys of the local player never come from the remote one, differences
+  // there are no misprediction.
+  keys &= static_cast<uint16_t>(~config_.local_keys);
+  RemoteInput& input{remote_[frame % remote_.size()]};
+  if (input.frame == frame) {
+    return;
+  }
+  input = RemoteInput{frame, keys};
+
+  // Frames before frame_ were already run, with a prediction if the input
+  // was missing.
+  const Slot& slot{slots_[frame % slots_.size()]};
+  if (frame < frame_ && slot.remote_keys != keys) {
+    rollback_from_ = std::min(rollback_from_.value_or(frame), frame);
+  }
+  while (remote_[confirmed_ % remote_.size()].frame == confirmed_) {
+    predicted_keys_ = remote_[confirmed_ % remote_.size()].keys;
+    ++confirmed_;
+  }
+}
+
+void RollbackSession::Synchronize() {
+  if (!rollback_from_) {
+    return;
+  }
+  CHIP8_ZONE("RollbackSession::Rollback");
+  const auto start{std::chrono::steady_clock::now()};
+  const uint64_t from{*rollback_from_};
+  rollback_from_.reset();
+
+  cpu_.RestoreSnapshot(slots_[from % slots_.size()].state);
+  for (uint64_t frame{from}; frame < frame_; ++frame) {
+    RunFrame(frame, slots_[frame % slots_.size()].local_keys);
+  }
+
+  const size_t depth{static_cast<size_t>(frame_ - from)};
+  ++stats_.rollbacks;
+  stats_.resimulated_frames += depth;
+  stats_.last_depth = depth;
+  stats_.max_depth = std::max(stats_.max_depth, depth);
+  stats_.resimulation_times.Record(std::chrono::steady_clock::now() - start);
+}
+
+uint64_t RollbackSession::GetFrame() const noexcept { return frame_; }
+
+uint64_t RollbackSession::GetConfirmedFrame() const noexcept {
+  return confirmed_;
+}
+
+uint16_t RollbackSession::GetLocalInput(uint64_t frame) const noexcept {
+  const Slot& slot{slots_[frame % slots_.size()]};
+  return slot.frame == frame ? slot.local_keys : 0;
+}
+
+size_t RollbackSession::GetHistorySize() const noexcept {
+  return slots_.size();
+}
+
+const RollbackStats& RollbackSession::GetStats() const noexcept {
+  return stats_;
+}
+
+uint16_t RollbackSession::GetRemoteKeys(uint64_t frame) const noexcept {
+  const RemoteInput& input{remote_[frame % remote_.size()]};
+  return input.frame == frame ? input.keys : predicted_keys_;
+}
+
+size_t RollbackSession::RunFrame(uint64_t frame, uint16_t local_keys) {
+  Slot& slot{slots_[frame % slots_.size()]};
+  slot.frame = frame;
+  cpu_.SaveSnapshot(slot.state);
+  slot.local_keys = local_keys;
+  slot.remote_keys = GetRemoteKeys(frame);
+
+  cpu_.SetKeyMask(
+      static_cast<uint16_t>((local_keys & config_.local_keys) |
+                            slot.remote_keys));
+  return cpu_.RunFrame(config_.cycles_per_frame);
+}
+
+}  // namespace chip8::runtime
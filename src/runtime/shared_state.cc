@@ -0,0 +1,329 @@
+#include <chip8/core/framebuffer.h>
+#include <chip8/runtime/shared_state.h>
+#include <chip8/utils/logger.h>
+#include <chip8/utils/profiler.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace chip8::runtime {
+
+namespace {
+
+constexpr uint32_t kMagic{0x4D533843};  // "C8SM"
+constexpr uint32_t kVersion{1};
+constexpr size_t kFrameWords{sizeof(SharedFrame) / sizeof(uint64_t)};
+
+/// <summary>
+/// Layout of the shared memory segment, see SharedStateWriter.
+/// </summary>
+struct Segment {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t frame_size;
+  uint32_t closed;
+
+  /// <summary>
+  /// Own cache line, so polling readers don't share it with the header.
+  /// </summary>
+  alignas(64) uint64_t sequence;
+
+  /// <summary>
+  /// SharedFrame, copied word by word with relaxed atomic accesses so
+  /// concurrent reads are never undefined, only discarded.
+  /// </summary>
+  alignas(64) uint64_t words[kFrameWords];
+};
+
+static_assert(offsetof(Segment, sequence) == 64);
+static_assert(offsetof(Segment, words) == 128);
+static_assert(std::atomic_ref<uint64_t>::is_always_lock_free,
+              "Readers in other processes need lock-free atomics");
+
+/// <summary>
+/// Named shared memory mapped into this process.
+/// </summary>
+class SharedMemory {
+ public:
+  SharedMemory() noexcept : segment_(nullptr), owner_(false) {}
+
+  SharedMemory(const SharedMemory&) = delete;
+  SharedMemory& operator=(const SharedMemory&) = delete;
+
+  ~SharedMemory() noexcept {
+    if (segment_ == nullptr) {
+      return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(segment_);
+    CloseHandle(handle_);
+#else
+    munmap(segment_, sizeof(Segment));
+    if (owner_) {
+      shm_unlink(name_.c_str());
+    }
+#endif
+  }
+
+  /// <summary>
+  /// Creates and maps a zeroed segment for writing.
+  /// </summary>
+  bool Create(const std::string& name) noexcept {
+    name_ = Normalize(name);
+#if defined(_WIN32)
+    handle_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                 0, static_cast<DWORD>(sizeof(Segment)),
+                                 name_.c_str());
+    if (handle_ == nullptr) {
+      return false;
+    }
+    segment_ = static_cast<Segment*>(
+        MapViewOfFile(handle_, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Segment)));
+    if (segment_ == nullptr) {
+      CloseHandle(handle_);
+      return false;
+    }
+    std::memset(segment_, 0, sizeof(Segment));
+#else
+    // A segment left behind by a crashed writer would keep its old header.
+    shm_unlink(name_.c_str());
+    const int descriptor{
+        shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644)};
+    if (descriptor < 0) {
+      return false;
+    }
+    void* address{MAP_FAILED};
+    if (ftruncate(descriptor, sizeof(Segment)) == 0) {
+      address = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (address == MAP_FAILED) {
+      shm_unlink(name_.c_str());
+      return false;
+    }
+    segment_ = static_cast<Segment*>(address);
+    owner_ = true;
+#endif
+    return true;
+  }
+
+  /// <summary>
+  /// Maps an existing segment for reading.
+  /// </summary>
+  bool Open(const std::string& name) noexcept {
+    name_ = Normalize(name);
+#if defined(_WIN32)
+    handle_ = OpenFileMappingA(FILE_MAP_READ, FALSE, name_.c_str());
+    if (handle_ == nullptr) {
+      return false;
+    }
+    segment_ = static_cast<Segment*>(
+        MapViewOfFile(handle_, FILE_MAP_READ, 0, 0, sizeof(Segment)));
+    if (segment_ == nullptr) {
+      CloseHandle(handle_);
+      return false;
+    }
+#else
+    const int descriptor{shm_open(name_.c_str(), O_RDONLY, 0)};
+    if (descriptor < 0) {
+      return false;
+    }
+    struct stat status {};
+    void* address{MAP_FAILED};
+    if (fstat(descriptor, &status) == 0 &&
+        static_cast<size_t>(status.st_size) >= sizeof(Segment)) {
+      address = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED,
+                     descriptor, 0);
+    }
+    close(descriptor);
+    if (address == MAP_FAILED) {
+      return false;
+    }
+    segment_ = static_cast<Segment*>(address);
+#endif
+    return true;
+  }
+
+  Segment& Get() const noexcept { return *segment_; }
+
+ private:
+  /// <summary>
+  /// POSIX names start with a slash, Windows names must not contain one.
+  /// </summary>
+  static std::string Normalize(const std::string& name) {
+#if defined(_WIN32)
+    return name.starts_with('/') ? name.substr(1) : name;
+#else
+    return name.starts_with('/') ? name : '/' + name;
+#endif
+  }
+
+  Segment* segment_;
+  std::string name_;
+  bool owner_;
+#if defined(_WIN32)
+  HANDLE handle_;
+#endif
+};
+
+}  // namespace
+
+struct SharedStateWriter::Mapping {
+  SharedMemory memory;
+};
+
+struct SharedStateReader::Mapping {
+  SharedMemory memory;
+};
+
+std::unique_ptr<SharedStateWriter> SharedStateWriter::Create(
+    const std::string& name) {
+  auto mapping{std::make_unique<Mapping>()};
+  if (!mapping->memory.Create(name)) {
+    LOG_ERROR("Failed to create shared memory segment \"{}\"", name);
+    return nullptr;
+  }
+  Segment& segment{mapping->memory.Get()};
+  segment.version = kVersion;
+  segment.frame_size = sizeof(SharedFrame);
+  // Readers check the magic first, it is stored once the rest is complete.
+  std::atomic_ref<uint32_t>{segment.magic}.store(kMagic,
+                                                 std::memory_order_release);
+  LOG_INFO("Exporting emulator state to shared memory \"{}\"", name);
+  return std::unique_ptr<SharedStateWriter>(
+      new SharedStateWriter(std::move(mapping)));
+}
+
+SharedStateWriter::SharedStateWriter(std::unique_ptr<Mapping> mapping) noexcept
+    : mapping_(std::move(mapping)), published_(0) {}
+
+SharedStateWriter::~SharedStateWriter() noexcept {
+  std::atomic_ref<uint32_t>{mapping_->memory.Get().closed}.store(
+      1, std::memory_order_release);
+}
+
+void SharedStateWriter::Publish(const core::Cpu& cpu) noexcept {
+  SharedFrame frame{};
+  frame.number = published_ + 1;
+  core::Framebuffer pixels;
+  core::PackFramebuffer(cpu.GetPixels(), pixels);
+  std::copy(pixels.begin(), pixels.end(), frame.pixels);
+  std::copy(cpu.GetMemory().begin(), cpu.GetMemory().end(), frame.memory);
+  std::copy(cpu.GetStack().begin(), cpu.GetStack().end(), frame.stack);
+  frame.index_register = cpu.GetIndexRegister();
+  frame.program_counter = cpu.GetProgramCounter();
+  frame.keys = cpu.GetKeyMask();
+  std::copy(cpu.GetRegisters().begin(), cpu.GetRegisters().end(),
+            frame.registers);
+  frame.stack_pointer = cpu.GetStackPointer();
+  frame.delay_timer = cpu.GetDelayTimer();
+  frame.sound_timer = cpu.GetSoundTimer();
+  frame.halted = cpu.GetCriticalError() != core::CritErrors::kNone;
+  Publish(frame);
+}
+
+void SharedStateWriter::Publish(const SharedFrame& frame) noexcept {
+  CHIP8_ZONE("SharedStateWriter::Publish");
+  std::array<uint64_t, kFrameWords> words;
+  std::memcpy(words.data(), &frame, sizeof(frame));
+
+  Segment& segment{mapping_->memory.Get()};
+  std::atomic_ref<uint64_t> sequence{segment.sequence};
+  const uint64_t start{sequence.load(std::memory_order_relaxed)};
+  sequence.store(start + 1, std::memory_order_relaxed);
+  // Keeps the stores below after the odd sequence.
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i{}; i < words.size(); ++i) {
+    std::atomic_ref<uint64_t>{segment.words[i]}.store(
+        words[i], std::memory_order_relaxed);
+  }
+  sequence.store(start + 2, std::memory_order_release);
+  ++published_;
+}
+
+uint64_t SharedStateWriter::GetPublishedCount() const noexcept {
+  return published_;
+}
+
+std::unique_ptr<SharedStateReader> SharedStateReader::Open(
+    const std::string& name) {
+  auto mapping{std::make_unique<Mapping>()};
+  if (!mapping->memory.Open(name)) {
+    LOG_ERROR("Failed to open shared memory segment \"{}\"", name);
+    return nullptr;
+  }
+  Segment& segment{mapping->memory.Get()};
+  if (std::atomic_ref<uint32_t>{segment.magic}.load(
+          std::memory_order_acquire) != kMagic ||
+      segment.version != kVersion ||
+      segment.frame_size != sizeof(SharedFrame)) {
+    LOG_ERROR("Shared memory segment \"{}\" has an unknown format", name);
+    return nullptr;
+  }
+  return std::unique_ptr<SharedStateReader>(
+      new SharedStateReader(std::move(mapping)));
+}
+
+SharedStateReader::SharedStateReader(std::unique_ptr<Mapping> mapping) noexcept
+    : mapping_(std::move(mapping)), retries_(0) {}
+
+SharedStateReader::~SharedStateReader() noexcept = default;
+
+uint64_t SharedStateReader::GetSequence() const noexcept {
+  return std::atomic_ref<uint64_t>{mapping_->memory.Get().sequence}.load(
+      std::memory_order_acquire);
+}
+
+std::optional<SharedFrame> SharedStateReader::Read(
+    size_t max_attempts) noexcept {
+  Segment& segment{mapping_->memory.Get()};
+  std::atomic_ref<uint64_t> sequence{segment.sequence};
+  std::array<uint64_t, kFrameWords> words;
+  for (size_t attempt{}; attempt < max_attempts; ++attempt) {
+    const uint64_t before{sequence.load(std::memory_order_acquire)};
+    if (before == 0) {
+      return std::nullopt;
+    }
+    if (before % 2 == 0) {
+      for (size_t i{}; i < words.size(); ++i) {
+        words[i] = std::atomic_ref<uint64_t>{segment.words[i]}.load(
+            std::memory_order_relaxed);
+      }
+      // Keeps the loads above before the second sequence load.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        SharedFrame frame;
+        std::memcpy(&frame, words.data(), sizeof(frame));
+        return frame;
+      }
+    }
+    ++retries_;
+    std::this_thread::yield();
+  }
+  return std::nullopt;
+}
+
+bool SharedStateReader::IsClosed() const noexcept {
+  return std::atomic_ref<uint32_t>{mapping_->memory.Get().closed}.load(
+             std::memory_order_acquire) != 0;
+}
+
+uint64_t SharedStateReader::GetRetryCount() const noexcept {
+  return retries_;
+}
+
+}  // namespace chip8::runtime
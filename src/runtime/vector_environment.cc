@@ -0,0 +1,68 @@
+#include <chip8/runtime/vector_environment.h>
+
+namespace chip8::runtime {
+
+VectorEnvironment::VectorEnvironment(
+    std::shared_ptr<const core::RomImage> rom, const EnvironmentConfig& config,
+    size_t count, size_t threads)
+    : observations_(count),
+      environments_(),
+      results_(count),
+      seeds_(count),
+      pool_(threads) {
+  environments_.reserve(count);
+  for (size_t i{}; i < count; ++i) {
+    environments_.push_back(
+        std::make_unique<Environment>(rom, config, &observations_[i]));
+  }
+  LOG_DEBUG("Vector environment created ({} environments, {} threads).",
+            count, pool_.GetThreadCount());
+}
+
+std::span<const Framebuffer> VectorEnvironment::Reset(unsigned int seed) {
+  const size_t count{environments_.size()};
+  for (size_t i{}; i < count; ++i) {
+    seeds_[i] = seed + static_cast<unsigned int>(i);
+    results_[i] = StepResult{};
+  }
+
+  pool_.ParallelFor(count, [this, count](size_t i) {
+    environments_[i]->Reset(seeds_[i]);
+    seeds_[i] += static_cast<unsigned int>(count);
+  });
+  return observations_;
+}
+
+std::span<const StepResult> VectorEnvironment::Step(
+    std::span<const uint16_t> actions) {
+  if (actions.size() != environments_.size()) {
+    LOG_ERROR("Got {} actions for {} environments, nothing was stepped",
+              actions.size(), environments_.size());
+    return {};
+  }
+  pool_.ParallelFor(actions.size(), [this, actions](size_t i) {
+    Environment& environment{*environments_[i]};
+    if (results_[i].terminated || results_[i].truncated) {
+      environment.Reset(seeds_[i]);
+      seeds_[i] += static_cast<unsigned int>(environments_.size());
+    }
+    results_[i] = environment.Step(actions[i]);
+  });
+  return results_;
+}
+
+std::span<const Framebuffer> VectorEnvironment::GetObservations()
+    const noexcept {
+  return observations_;
+}
+
+const Environment& VectorEnvironment::GetEnvironment(
+    size_t index) const noexcept {
+  return *environments_[index];
+}
+
+size_t VectorEnvironment::GetSize() const noexcept {
+  return environments_.size();
+}
+
+}  // namespace chip8::runtime
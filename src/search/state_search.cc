@@ -0,0 +1,245 @@
+#include <chip8/search/state_search.h>
+
+#include <chip8/utils/hash.h>
+#include <chip8/utils/profiler.h>
+#include <chip8/utils/thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace chip8::search {
+
+namespace {
+
+constexpr size_t kNoParent{std::numeric_limits<size_t>::max()};
+
+/// <summary>
+/// Edge of the search tree: the state reached by holding input in parent.
+/// </summary>
+struct Node {
+  size_t parent;
+  uint16_t input;
+};
+
+/// <summary>
+/// Frontier state forked with one of the inputs.
+/// </summary>
+struct Child {
+  uint64_t hash;
+  uint64_t cell;
+  double score;
+  bool goal;
+  bool halted;
+
+  /// <summary>
+  /// True if the state reached a new cell or improved the best score of a
+  /// known one. Always false unless the strategy is kNovelty.
+  /// </summary>
+  bool novel;
+
+  /// <summary>
+  /// Index in the search tree, set once the state is known to be new.
+  /// </summary>
+  size_t node;
+};
+
+std::vector<uint16_t> DefaultInputs() {
+  std::vector<uint16_t> inputs{0};
+  for (uint8_t key{}; key <= 0xFu; ++key) {
+    inputs.push_back(static_cast<uint16_t>(1u << key));
+  }
+  return inputs;
+}
+
+uint64_t HashCell(const core::Cpu& cpu,
+                  const std::vector<uint16_t>& addresses) noexcept {
+  uint64_t hash{utils::kFnv1aOffset};
+  for (const uint16_t address : addresses) {
+    const uint8_t value{core::ReadByte(cpu.GetMemory(), address)};
+    hash = utils::Fnv1a({&value, 1}, hash);
+  }
+  return hash;
+}
+
+std::vector<uint16_t> CollectInputs(const std::vector<Node>& nodes,
+                                    size_t node) {
+  std::vector<uint16_t> inputs;
+  for (; nodes[node].parent != kNoParent; node = nodes[node].parent) {
+    inputs.push_back(nodes[node].input);
+  }
+  std::reverse(inputs.begin(), inputs.end());
+  return inputs;
+}
+
+}  // namespace
+
+ScoreFunction ScoreMemory(std::vector<MemoryWeight> weights) {
+  return [weights = std::move(weights)](const core::Cpu& cpu) {
+    double score{};
+    for (const MemoryWeight& entry : weights) {
+      score += entry.weight * core::ReadByte(cpu.GetMemory(), entry.address);
+    }
+    return score;
+  };
+}
+
+uint64_t HashState(const core::Cpu& cpu) noexcept {
+  uint64_t hash{utils::kFnv1aOffset};
+  auto add{[&hash](const auto& value) {
+    hash = utils::Fnv1a(
+        {reinterpret_cast<const uint8_t*>(&value), sizeof(value)}, hash);
+  }};
+
+  add(cpu.GetMemory());
+  add(cpu.GetRegisters());
+  add(cpu.GetPixels());
+  add(cpu.GetStack());
+  add(cpu.GetIndexRegister());
+  add(cpu.GetProgramCounter());
+  add(cpu.GetStackPointer());
+  add(cpu.GetDelayTimer());
+  add(cpu.GetSoundTimer());
+  return hash;
+}
+
+SearchResult Search(const core::Cpu& start, const SearchConfig& config) {
+  const auto start_time{std::chrono::steady_clock::now()};
+  const std::vector<uint16_t> inputs{config.inputs.empty() ? DefaultInputs()
+                                                           : config.inputs};
+  const bool novelty{config.strategy == Strategy::kNovelty};
+  auto rate{[&config](const core::Cpu& cpu) {
+    return config.score ? config.score(cpu) : 0.0;
+  }};
+  auto cell_of{[&config](const core::Cpu& cpu) {
+    return config.novelty_addresses.empty()
+               ? HashState(cpu)
+               : HashCell(cpu, config.novelty_addresses);
+  }};
+  auto advance{[&config](core::Cpu& cpu, uint16_t keys) {
+    cpu.SetKeyMask(keys);
+    for (size_t frame{}; frame < config.frames_per_decision; ++frame) {
+      cpu.RunFrame(config.cycles_per_frame);
+    }
+  }};
+
+  utils::ThreadPool pool(std::max<size_t>(config.threads, 1));
+  SearchResult result;
+  std::vector<Node> nodes{Node{kNoParent, 0}};
+  size_t best_node{};
+  result.best_score = rate(start);
+
+  std::unordered_set<uint64_t> visited{HashState(start)};
+  // Best score reached in every cell of the novelty archive.
+  std::unordered_map<uint64_t, double> archive;
+  if (novelty) {
+    archive.emplace(cell_of(start), result.best_score);
+  }
+
+  std::vector<core::Cpu> frontier{start};
+  std::vector<size_t> frontier_nodes{0};
+  if (config.goal && config.goal(start)) {
+    result.found = true;
+    frontier.clear();
+  }
+
+  std::vector<Child> children;
+  std::vector<size_t> candidates;
+  while (!frontier.empty() && result.depth < config.max_depth) {
+    children.resize(frontier.size() * inputs.size());
+    pool.ParallelFor(children.size(), [&](size_t index) {
+      CHIP8_ZONE("Search::Expand");
+      core::Cpu cpu{frontier[index / inputs.size()]};
+      advance(cpu, inputs[index % inputs.size()]);
+      children[index] = Child{
+          HashState(cpu),
+          novelty ? cell_of(cpu) : 0,
+          rate(cpu),
+          config.goal && config.goal(cpu),
+          cpu.GetCriticalError() != core::CritErrors::kNone,
+          false,
+          0};
+    });
+    result.states_explored += children.size();
+    ++result.depth;
+
+    // Deduplication and bookkeeping stay serial, in input order, so results
+    // do not depend on the amount of threads.
+    candidates.clear();
+    for (size_t index{}; index < children.size(); ++index) {
+      Child& child{children[index]};
+      if (!visited.insert(child.hash).second) {
+        ++result.duplicates;
+        continue;
+      }
+      child.node = nodes.size();
+      nodes.push_back(Node{frontier_nodes[index / inputs.size()],
+                           inputs[index % inputs.size()]});
+      if (child.goal) {
+        result.found = true;
+        result.best_score = child.score;
+        best_node = child.node;
+        break;
+      }
+      if (child.score > result.best_score) {
+        result.best_score = child.score;
+        best_node = child.node;
+      }
+      if (child.halted) {
+        continue;
+      }
+      if (novelty) {
+        const auto [cell, inserted]{archive.emplace(child.cell, child.score)};
+        child.novel = inserted || child.score > cell->second;
+        cell->second = std::max(cell->second, child.score);
+      }
+      candidates.push_back(index);
+    }
+    if (result.found) {
+      break;
+    }
+
+    if (config.strategy != Strategy::kBreadthFirst) {
+      std::stable_sort(candidates.begin(), candidates.end(),
+                       [&children](size_t lhs, size_t rhs) {
+                         if (children[lhs].novel != children[rhs].novel) {
+                           return children[lhs].novel;
+                         }
+                         return children[lhs].score > children[rhs].score;
+                       });
+    }
+    candidates.resize(std::min(candidates.size(), config.frontier_size));
+
+    // Only kept states are forked again, the rest were emulated in
+    // temporaries. Emulation is deterministic, so redoing it is cheaper than
+    // keeping a copy of every child.
+    std::vector<core::Cpu> next;
+    next.reserve(candidates.size());
+    std::vector<size_t> next_nodes;
+    for (const size_t index : candidates) {
+      next.push_back(frontier[index / inputs.size()]);
+      next_nodes.push_back(children[index].node);
+    }
+    pool.ParallelFor(next.size(), [&](size_t slot) {
+      advance(next[slot], inputs[candidates[slot] % inputs.size()]);
+    });
+    frontier = std::move(next);
+    frontier_nodes = std::move(next_nodes);
+
+    LOG_DEBUG("Search depth {}: {} states explored, {} kept.", result.depth,
+              result.states_explored, frontier.size());
+  }
+
+  result.inputs = CollectInputs(nodes, best_node);
+  result.cells = archive.size();
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start_time)
+                       .count();
+  result.states_per_second =
+      result.seconds > 0 ? result.states_explored / result.seconds : 0;
+  return result;
+}
+
+}  // namespace chip8::search
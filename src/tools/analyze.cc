@@ -0,0 +1,76 @@
+#include <chip8/analysis/disassembler.h>
+#include <chip8/analysis/rom_analyzer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Usage: ./chip8-analyze <rom_path> [code_map_path]
+// Prints basic blocks with disassembly and optionally saves the code map
+// which can be passed to chip8-bin.
+
+int main(int argc, char* argv[]) {
+  if (argc != 2 && argc != 3) {
+    std::fprintf(stderr, "Correct usage: %s [rom_path] [code_map_path]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  std::ifstream in_stream(argv[1], std::ios::binary);
+  if (!in_stream.is_open()) {
+    std::fprintf(stderr, "Failed to read ROM ('%s')\n", argv[1]);
+    return 1;
+  }
+  const std::vector<uint8_t> rom{std::istreambuf_iterator<char>(in_stream),
+                                 std::istreambuf_iterator<char>()};
+
+  chip8::analysis::RomAnalyzer analyzer(rom);
+  const chip8::analysis::CodeMap map{analyzer.Analyze()};
+
+  std::array<uint8_t, 4096> memory{};
+  std::copy_n(rom.begin(),
+              std::min(rom.size(),
+                       memory.size() - chip8::core::kRomStartAddress),
+              memory.begin() + chip8::core::kRomStartAddress);
+  for (const chip8::analysis::BasicBlock& block : map.blocks) {
+    std::printf("block %#05x-%#05x ->", block.start, block.end);
+    for (uint16_t successor : block.successors) {
+      std::printf(" %#05x", successor);
+    }
+    std::printf("%s\n", block.computed_jump ? " (computed)" : "");
+
+    for (size_t address{block.start}; address < block.end; address += 2) {
+      const uint16_t opcode{static_cast<uint16_t>(
+          (memory.at(address) << 8u) | memory.at(address + 1))};
+      std::printf("  %#05zx  %04X  %s\n", address, opcode,
+                  chip8::analysis::Disassemble(opcode).c_str());
+    }
+  }
+
+  size_t counts[4]{};
+  for (size_t address{chip8::core::kRomStartAddress};
+       address < chip8::core::kRomStartAddress + rom.size() &&
+       address < memory.size();
+       ++address) {
+    ++counts[static_cast<size_t>(map.kinds[address])];
+  }
+  std::printf(
+      "\n%zu blocks, %zu code bytes, %zu sprite bytes, %zu data bytes, %zu "
+      "unknown bytes\n",
+      map.blocks.size(), counts[1], counts[2], counts[3], counts[0]);
+
+  for (const chip8::analysis::SelfModifyingWrite& write : map.self_modifying) {
+    std::printf("self-modifying: %#05x writes %u bytes at %#05x\n",
+                write.instruction, write.size, write.address);
+  }
+
+  if (argc == 3 && !chip8::analysis::RomAnalyzer::Save(map, argv[2])) {
+    std::fprintf(stderr, "Failed to save code map ('%s')\n", argv[2]);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <chip8/aot/aot_compiler.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Usage: ./chip8-aot <rom_path> <output_path>
+// Translates a ROM into C++ source of a plugin. Compile it as a shared
+// library (see chip8_add_aot_plugin in CMakeLists.txt) and pass it to
+// chip8-bin.
+
+int main(int argc, char* argv[]) {
+  if (argc != 3) {
+    std::fprintf(stderr, "Correct usage: %s [rom_path] [output_path]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  std::ifstream in_stream(argv[1], std::ios::binary);
+  if (!in_stream.is_open()) {
+    std::fprintf(stderr, "Failed to read ROM ('%s')\n", argv[1]);
+    return 1;
+  }
+  const std::vector<uint8_t> rom{std::istreambuf_iterator<char>(in_stream),
+                                 std::istreambuf_iterator<char>()};
+  if (rom.empty()) {
+    std::fprintf(stderr, "ROM is empty ('%s')\n", argv[1]);
+    return 1;
+  }
+
+  chip8::aot::AotCompiler compiler(rom);
+  const std::string source{compiler.Generate()};
+
+  std::ofstream out_stream(argv[2], std::ios::binary);
+  out_stream << source;
+  if (!out_stream) {
+    std::fprintf(stderr, "Failed to write '%s'\n", argv[2]);
+    return 1;
+  }
+
+  std::printf("Compiled %zu blocks into %s\n", compiler.GetBlockCount(),
+              argv[2]);
+  return 0;
+}
@@ -0,0 +1,201 @@
+#include <chip8/core/cpu.h>
+#include <chip8/core/rom_image.h>
+#include <chip8/debug/debugger.h>
+#include <chip8/utils/logger.h>
+
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+
+// Usage: ./chip8-debug <rom_path> [cycles_per_frame]
+// Interactive debugger reading commands from stdin:
+//   break <addr> [V<x> <op> <value>]   op: == != < <= > >=
+//   delete <addr>                      remove breakpoints at address
+//   watch <addr> [size] [r|w|rw]       stop on memory access through I
+//   unwatch <addr> [size]
+//   continue [frames]   step   next   finish
+//   regs   mem <addr> [size]   key <key> <0|1>   screen   quit
+// Numbers are hexadecimal.
+
+namespace {
+
+using chip8::debug::BreakCondition;
+using chip8::debug::Comparison;
+using chip8::debug::Debugger;
+using chip8::debug::Stop;
+using chip8::debug::StopReason;
+using chip8::debug::WatchKind;
+
+uint16_t ParseHex(const std::string& text) {
+  return static_cast<uint16_t>(std::stoul(text, nullptr, 16));
+}
+
+std::optional<Comparison> ParseComparison(const std::string& text) {
+  if (text == "==") {
+    return Comparison::kEqual;
+  }
+  if (text == "!=") {
+    return Comparison::kNotEqual;
+  }
+  if (text == "<") {
+    return Comparison::kLess;
+  }
+  if (text == "<=") {
+    return Comparison::kLessEqual;
+  }
+  if (text == ">") {
+    return Comparison::kGreater;
+  }
+  if (text == ">=") {
+    return Comparison::kGreaterEqual;
+  }
+  return std::nullopt;
+}
+
+void PrintStop(const Stop& stop, const Debugger& debugger) {
+  switch (stop.reason) {
+    case StopReason::kDone:
+      break;
+    case StopReason::kBreakpoint:
+      std::printf("Breakpoint at %04X\n", stop.address);
+      break;
+    case StopReason::kWatchRead:
+      std::printf("Read of watched %04X\n", stop.address);
+      break;
+    case StopReason::kWatchWrite:
+      std::printf("Write to watched %04X\n", stop.address);
+      break;
+    case StopReason::kHalted:
+      std::printf("Cpu halted by a stack error at %04X\n", stop.address);
+      break;
+  }
+  std::printf("%s", debugger.FormatRegisters().c_str());
+}
+
+void PrintScreen(const chip8::core::Cpu& cpu) {
+  const auto& pixels{cpu.GetPixels()};
+  for (size_t y{}; y < 32; ++y) {
+    std::string line(64, ' ');
+    for (size_t x{}; x < 64; ++x) {
+      if (pixels[y * 64 + x]) {
+        line[x] = '#';
+      }
+    }
+    std::printf("%s\n", line.c_str());
+  }
+}
+
+/// <summary>
+/// Executes a single command line.
+/// </summary>
+/// <returns>False if the session should end.</returns>
+bool RunCommand(const std::string& line, Debugger& debugger,
+                chip8::core::Cpu& cpu) {
+  std::istringstream in_stream(line);
+  std::string command;
+  if (!(in_stream >> command)) {
+    return true;
+  }
+
+  if (command == "quit" || command == "q") {
+    return false;
+  }
+  if (command == "break" || command == "b") {
+    std::string address, reg, op, value;
+    in_stream >> address >> reg >> op >> value;
+    if (reg.empty()) {
+      debugger.AddBreakpoint(ParseHex(address));
+      return true;
+    }
+    const std::optional<Comparison> comparison{ParseComparison(op)};
+    if (reg.size() != 2 || (reg[0] != 'V' && reg[0] != 'v') || !comparison ||
+        value.empty()) {
+      std::printf("Condition must look like V3 == 10\n");
+      return true;
+    }
+    debugger.AddBreakpoint(
+        ParseHex(address),
+        BreakCondition{static_cast<uint8_t>(ParseHex(reg.substr(1))),
+                       *comparison, static_cast<uint8_t>(ParseHex(value))});
+  } else if (command == "delete" || command == "d") {
+    std::string address;
+    in_stream >> address;
+    debugger.RemoveBreakpoint(ParseHex(address));
+  } else if (command == "watch" || command == "w") {
+    std::string address, size{"1"}, kind{"rw"};
+    in_stream >> address >> size >> kind;
+    debugger.AddWatchpoint(ParseHex(address), ParseHex(size),
+                           kind == "r"   ? WatchKind::kRead
+                           : kind == "w" ? WatchKind::kWrite
+                                         : WatchKind::kReadWrite);
+  } else if (command == "unwatch") {
+    std::string address, size{"1"};
+    in_stream >> address >> size;
+    debugger.RemoveWatchpoint(ParseHex(address), ParseHex(size));
+  } else if (command == "continue" || command == "c") {
+    std::string frames{"FFFFFFFF"};
+    in_stream >> frames;
+    PrintStop(debugger.RunFrames(std::stoull(frames, nullptr, 16)), debugger);
+  } else if (command == "step" || command == "s") {
+    PrintStop(debugger.StepInstruction(), debugger);
+  } else if (command == "next" || command == "n") {
+    PrintStop(debugger.StepOver(), debugger);
+  } else if (command == "finish") {
+    PrintStop(debugger.StepOut(), debugger);
+  } else if (command == "regs" || command == "r") {
+    std::printf("%s", debugger.FormatRegisters().c_str());
+  } else if (command == "mem" || command == "x") {
+    std::string address, size{"40"};
+    in_stream >> address >> size;
+    std::printf("%s",
+                debugger.FormatMemory(ParseHex(address), ParseHex(size)).c_str());
+  } else if (command == "key") {
+    std::string key, pressed;
+    in_stream >> key >> pressed;
+    cpu.SetKey(static_cast<uint8_t>(ParseHex(key)), pressed == "1");
+  } else if (command == "screen") {
+    PrintScreen(cpu);
+  } else {
+    std::printf("Unknown command: %s\n", command.c_str());
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  chip8::utils::Logger::Init();
+
+  if (argc != 2 && argc != 3) {
+    std::fprintf(stderr, "Correct usage: %s [rom_path] [cycles_per_frame]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  const std::optional<chip8::core::RomImage> rom{
+      chip8::core::RomImage::Load(argv[1])};
+  if (!rom) {
+    return 1;
+  }
+
+  chip8::core::Cpu cpu;
+  cpu.LoadROM(*rom);
+  Debugger debugger(cpu, argc == 3 ? std::stoul(argv[2]) : 10);
+  std::printf("%s", debugger.FormatRegisters().c_str());
+
+  std::string line;
+  while (std::printf("(chip8) "), std::fflush(stdout),
+         std::getline(std::cin, line)) {
+    try {
+      if (!RunCommand(line, debugger, cpu)) {
+        break;
+      }
+    } catch (const std::exception&) {
+      std::printf("Invalid number in: %s\n", line.c_str());
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,135 @@
+#include <chip8/library/rom_library.h>
+#include <chip8/utils/logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Usage: ./chip8-library <index> scan <directory>...
+//        ./chip8-library <index> list
+//        ./chip8-library <index> find <rom_path>
+//        ./chip8-library <index> set <rom_path> <cycles_per_frame> [quirks]
+//                                    [title]
+// Maintains the ROM library index passed to chip8-bin. Scanning adds new
+// ROMs below the directories with detected platform and default profile,
+// set tunes the profile of a single ROM, adding it if needed.
+
+namespace {
+
+using chip8::library::RomLibrary;
+using chip8::library::RomProfile;
+
+void Print(const RomProfile& profile) {
+  std::printf("%016llx %-7s %5u B %4u cpf quirks %#04x  %s  (%s)\n",
+              static_cast<unsigned long long>(profile.hash),
+              chip8::library::GetPlatformName(profile.platform), profile.size,
+              profile.cycles_per_frame, profile.quirks, profile.title.c_str(),
+              profile.path.string().c_str());
+}
+
+/// <summary>
+/// Loads the index, or starts an empty library if there is none yet.
+/// </summary>
+std::optional<RomLibrary> LoadOrCreate(const std::filesystem::path& path) {
+  if (!std::filesystem::exists(path)) {
+    return RomLibrary{};
+  }
+  return RomLibrary::Load(path);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  chip8::utils::Logger::Init();
+
+  const std::string_view command{argc >= 3 ? argv[2] : ""};
+  if (!((command == "scan" && argc >= 4) || (command == "list" && argc == 3) ||
+        (command == "find" && argc == 4) ||
+        (command == "set" && argc >= 5 && argc <= 7))) {
+    std::fprintf(stderr,
+                 "Correct usage: %s [index] scan [directory]...\n"
+                 "               %s [index] list\n"
+                 "               %s [index] find [rom_path]\n"
+                 "               %s [index] set [rom_path] "
+                 "[cycles_per_frame] [quirks] [title]\n",
+                 argv[0], argv[0], argv[0], argv[0]);
+    return 1;
+  }
+  const std::filesystem::path index_path{argv[1]};
+
+  if (command == "find") {
+    const std::optional<RomProfile> inspected{RomLibrary::Inspect(argv[3])};
+    if (!inspected) {
+      return 1;
+    }
+    const auto start{std::chrono::steady_clock::now()};
+    const std::optional<RomProfile> profile{
+        RomLibrary::Lookup(index_path, inspected->hash)};
+    const std::chrono::duration<double, std::micro> elapsed{
+        std::chrono::steady_clock::now() - start};
+    if (!profile) {
+      std::printf("Not in the library, detected:\n");
+      Print(*inspected);
+      return 2;
+    }
+    Print(*profile);
+    std::printf("Lookup took %.1f us\n", elapsed.count());
+    return 0;
+  }
+
+  std::optional<RomLibrary> library{LoadOrCreate(index_path)};
+  if (!library) {
+    return 1;
+  }
+
+  if (command == "list") {
+    for (const RomProfile& profile : library->GetProfiles()) {
+      Print(profile);
+    }
+    std::printf("%zu ROMs\n", library->GetProfiles().size());
+    return 0;
+  }
+
+  if (command == "scan") {
+    const size_t threads{std::max(1u, std::thread::hardware_concurrency())};
+    for (int i{3}; i < argc; ++i) {
+      const auto start{std::chrono::steady_clock::now()};
+      const chip8::library::ScanStats stats{library->Scan(argv[i], threads)};
+      const std::chrono::duration<double> elapsed{
+          std::chrono::steady_clock::now() - start};
+      std::printf(
+          "%s: %zu files, %zu added, %zu duplicates, %zu failed in %.3f s\n",
+          argv[i], stats.files, stats.added, stats.duplicates, stats.failed,
+          elapsed.count());
+    }
+  } else {
+    std::optional<RomProfile> profile{RomLibrary::Inspect(argv[3])};
+    if (!profile) {
+      return 1;
+    }
+    if (const RomProfile* known{library->Find(profile->hash)}) {
+      profile->title = known->title;
+      profile->platform = known->platform;
+      profile->quirks = known->quirks;
+    }
+    profile->cycles_per_frame = static_cast<uint32_t>(std::stoul(argv[4]));
+    if (argc >= 6) {
+      profile->quirks = static_cast<uint32_t>(std::stoul(argv[5], nullptr, 0));
+    }
+    if (argc == 7) {
+      profile->title = argv[6];
+    }
+    Print(*profile);
+    library->Add(std::move(*profile));
+  }
+
+  if (!library->Save(index_path)) {
+    return 1;
+  }
+  std::printf("%zu ROMs in %s\n", library->GetProfiles().size(),
+              index_path.string().c_str());
+  return 0;
+}
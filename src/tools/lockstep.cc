@@ -0,0 +1,86 @@
+#include <chip8/analysis/rom_analyzer.h>
+#include <chip8/aot/aot_plugin.h>
+#include <chip8/core/cpu.h>
+#include <chip8/core/rom_image.h>
+#include <chip8/verify/lockstep.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+// Usage: ./chip8-lockstep <rom_path> [frames] [compare_interval]
+//                         [aot_plugin]
+// Runs the ROM on the plain interpreter and on the emulator's fast paths
+// (idle skipping, superinstructions prewarmed from static analysis and
+// optionally compiled blocks) side by side, with pseudo-random keys, and
+// reports the first divergence. Exits with 1 if the cpus diverged.
+
+int main(int argc, char* argv[]) {
+  chip8::utils::Logger::Init();
+
+  if (argc < 2 || argc > 5) {
+    std::fprintf(stderr,
+                 "Correct usage: %s [rom_path] [frames] [compare_interval] "
+                 "[aot_plugin]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  const std::optional<chip8::core::RomImage> rom{
+      chip8::core::RomImage::Load(argv[1])};
+  if (!rom) {
+    return 1;
+  }
+
+  chip8::verify::LockstepConfig config;
+  if (argc > 2) {
+    config.frames = std::stoull(argv[2]);
+  }
+  if (argc > 3) {
+    config.compare_interval = std::stoul(argv[3]);
+  }
+  // Keys change every 16 frames, so both pressed and released paths run.
+  config.keys = [](uint64_t frame) {
+    std::mt19937 gen(static_cast<unsigned int>(frame / 16));
+    return static_cast<uint16_t>(gen() & gen());
+  };
+
+  chip8::core::Cpu reference;
+  reference.SeedRNG(0);
+  reference.LoadROM(*rom);
+
+  chip8::core::Cpu candidate;
+  candidate.SeedRNG(0);
+  candidate.LoadROM(*rom);
+  chip8::analysis::RomAnalyzer analyzer(rom->GetBytes());
+  candidate.PrewarmDecodeCache(analyzer.Analyze());
+
+  std::unique_ptr<chip8::aot::AotPlugin> plugin;
+  if (argc > 4) {
+    plugin = chip8::aot::AotPlugin::Load(argv[4]);
+    if (!plugin) {
+      return 1;
+    }
+    candidate.AttachAotModule(plugin->GetModule());
+  }
+
+  chip8::verify::LockstepHarness harness(reference, candidate, config);
+  const std::optional<chip8::verify::Divergence> divergence{harness.Run()};
+  const chip8::verify::LockstepStats& stats{harness.GetStats()};
+  candidate.AttachAotModule(nullptr);
+
+  if (divergence) {
+    std::fputs(divergence->Format().c_str(), stdout);
+    return 1;
+  }
+  std::printf(
+      "%llu frames, %llu instructions in %llu steps, %llu comparisons: no "
+      "divergence (%llu fused, %llu compiled)\n",
+      static_cast<unsigned long long>(stats.frames),
+      static_cast<unsigned long long>(stats.instructions),
+      static_cast<unsigned long long>(stats.steps),
+      static_cast<unsigned long long>(stats.comparisons),
+      static_cast<unsigned long long>(candidate.GetFusedInstructionCount()),
+      static_cast<unsigned long long>(candidate.GetAotInstructionCount()));
+  return 0;
+}
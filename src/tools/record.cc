@@ -0,0 +1,94 @@
+#include <chip8/core/cpu.h>
+#include <chip8/core/rom_image.h>
+#include <chip8/video/recorder.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// Usage: ./chip8-record <rom_path> <output> [frames] [cycles_per_frame]
+//                       [scale] [hash_log]
+// Runs a ROM headless as fast as possible and records every frame. Outputs
+// ending with .y4m are written as Y4M, anything else as raw Y8 frames. The
+// same run is timed without recording first to report the overhead.
+
+namespace {
+
+template <typename Function>
+double MeasureFramesPerSecond(size_t frames, Function&& function) {
+  const auto start{std::chrono::steady_clock::now()};
+  for (size_t i{}; i < frames; ++i) {
+    function();
+  }
+  const std::chrono::duration<double> elapsed{
+      std::chrono::steady_clock::now() - start};
+  return static_cast<double>(frames) / elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  chip8::utils::Logger::Init();
+
+  if (argc < 3 || argc > 7) {
+    std::fprintf(stderr,
+                 "Correct usage: %s [rom_path] [output] [frames] "
+                 "[cycles_per_frame] [scale] [hash_log]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  const std::optional<chip8::core::RomImage> rom{
+      chip8::core::RomImage::Load(argv[1])};
+  if (!rom) {
+    return 1;
+  }
+  const std::string output{argv[2]};
+  const size_t frames{argc > 3 ? std::stoul(argv[3]) : 600};
+  const size_t cycles_per_frame{argc > 4 ? std::stoul(argv[4]) : 10};
+
+  chip8::video::RecorderConfig config;
+  config.container =
+      output.ends_with(".y4m") ? chip8::video::Container::kY4m
+                               : chip8::video::Container::kRaw;
+  if (argc > 5) {
+    config.scale = std::stoul(argv[5]);
+  }
+  if (argc > 6) {
+    config.hash_log = argv[6];
+  }
+
+  chip8::core::Cpu cpu;
+  cpu.SeedRNG(0);
+  cpu.LoadROM(*rom);
+
+  chip8::core::Cpu baseline{cpu};
+  const double baseline_fps{MeasureFramesPerSecond(
+      frames, [&baseline, cycles_per_frame] {
+        baseline.RunFrame(cycles_per_frame);
+      })};
+
+  std::unique_ptr<chip8::video::Recorder> recorder{
+      chip8::video::Recorder::Open(output, config)};
+  if (!recorder) {
+    return 1;
+  }
+  cpu.SetFrameCallback(
+      [&recorder](const chip8::core::Cpu& frame) { recorder->AddFrame(frame); });
+  const double recording_fps{MeasureFramesPerSecond(
+      frames, [&cpu, cycles_per_frame] { cpu.RunFrame(cycles_per_frame); })};
+  cpu.SetFrameCallback(nullptr);
+
+  const chip8::video::RecorderStats stats{recorder->GetStats()};
+  if (!recorder->Close()) {
+    return 1;
+  }
+
+  std::printf("frames:    %zu (%llu unique runs, %llu writer stalls)\n",
+              frames, static_cast<unsigned long long>(stats.runs),
+              static_cast<unsigned long long>(stats.stalls));
+  std::printf("baseline:  %10.0f frames/s\n", baseline_fps);
+  std::printf("recording: %10.0f frames/s (%.1f%% slower)\n", recording_fps,
+              100.0 * (1.0 - recording_fps / baseline_fps));
+  return 0;
+}
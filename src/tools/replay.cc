@@ -0,0 +1,81 @@
+#include <chip8/core/cpu.h>
+#include <chip8/core/rom_image.h>
+#include <chip8/runtime/movie.h>
+#include <chip8/utils/perf_counters.h>
+#include <chip8/video/recorder.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+
+// Usage: ./chip8-replay <rom_path> <movie.c8m> [recording]
+// Replays a movie recorded by chip8-bin as fast as possible and checks that
+// the run ends in the recorded state. Optionally records video of the
+// replay (see chip8-record). Exits with 2 if the replay diverged. Built
+// with CHIP8_PERF_COUNTERS, also prints hardware counters per emulated
+// instruction, a repeatable benchmark for interpreter changes.
+
+int main(int argc, char* argv[]) {
+  chip8::utils::Logger::Init();
+
+  if (argc != 3 && argc != 4) {
+    std::fprintf(stderr,
+                 "Correct usage: %s [rom_path] [movie.c8m] [recording]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  const std::optional<chip8::core::RomImage> rom{
+      chip8::core::RomImage::Load(argv[1])};
+  std::unique_ptr<chip8::runtime::MovieReader> movie{
+      chip8::runtime::MovieReader::Open(argv[2])};
+  if (!rom || !movie) {
+    return 1;
+  }
+
+  std::unique_ptr<chip8::video::Recorder> recorder;
+  chip8::core::Cpu::FrameCallback on_frame;
+  if (argc == 4) {
+    chip8::video::RecorderConfig config;
+    config.container = std::string_view{argv[3]}.ends_with(".y4m")
+                           ? chip8::video::Container::kY4m
+                           : chip8::video::Container::kRaw;
+    recorder = chip8::video::Recorder::Open(argv[3], config);
+    if (!recorder) {
+      return 1;
+    }
+    on_frame = [&recorder](const chip8::core::Cpu& frame) {
+      recorder->AddFrame(frame);
+    };
+  }
+
+  chip8::core::Cpu cpu;
+  const auto start{std::chrono::steady_clock::now()};
+  const std::optional<chip8::runtime::ReplayResult> result{
+      chip8::runtime::Replay(*rom, *movie, cpu, std::move(on_frame))};
+  const std::chrono::duration<double> elapsed{
+      std::chrono::steady_clock::now() - start};
+  cpu.SetFrameCallback(nullptr);
+  if (recorder && !recorder->Close()) {
+    return 1;
+  }
+  if (!result) {
+    return 1;
+  }
+
+  std::printf("frames:     %llu (%.0f frames/s)\n",
+              static_cast<unsigned long long>(result->frames),
+              static_cast<double>(result->frames) / elapsed.count());
+  std::printf("state hash: %016llx\n",
+              static_cast<unsigned long long>(result->state_hash));
+#ifdef CHIP8_PERF_COUNTERS
+  std::printf("%s", chip8::utils::PerfCounters::Report().c_str());
+#endif
+  if (!result->complete || movie->GetStateHash() == 0) {
+    std::printf("movie has no final state, it was not checked\n");
+    return 0;
+  }
+  std::printf("%s\n", result->matched ? "replay matches the recording"
+                                      : "replay diverged from the recording");
+  return result->matched ? 0 : 2;
+}
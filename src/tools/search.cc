@@ -0,0 +1,136 @@
+#include <chip8/core/cpu.h>
+#include <chip8/core/rom_image.h>
+#include <chip8/runtime/movie.h>
+#include <chip8/search/state_search.h>
+#include <chip8/utils/logger.h>
+
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Usage: ./chip8-search <rom_path> <bfs|beam|novelty> <addresses> [depth]
+//                       [movie.c8m]
+// Searches key presses maximising the weighted sum of memory bytes given as
+// comma separated hex addresses with optional decimal weights, e.g.
+// "1F0:100,1F1". With novelty, the same bytes also form the cells of the
+// archive. Prints the search rate and optionally saves the best path as a
+// movie for chip8-replay.
+
+namespace {
+
+using chip8::search::MemoryWeight;
+
+std::optional<std::vector<MemoryWeight>> ParseWeights(const std::string& text) {
+  std::vector<MemoryWeight> weights;
+  std::istringstream in_stream(text);
+  std::string entry;
+  while (std::getline(in_stream, entry, ',')) {
+    MemoryWeight weight;
+    const size_t colon{entry.find(':')};
+    try {
+      weight.address =
+          static_cast<uint16_t>(std::stoul(entry.substr(0, colon), nullptr, 16));
+      if (colon != std::string::npos) {
+        weight.weight = std::stod(entry.substr(colon + 1));
+      }
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+    weights.push_back(weight);
+  }
+  return weights;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  chip8::utils::Logger::Init();
+
+  if (argc < 4 || argc > 6) {
+    std::fprintf(stderr,
+                 "Correct usage: %s [rom_path] [bfs|beam|novelty] [addresses] "
+                 "[depth] [movie.c8m]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  const std::optional<chip8::core::RomImage> rom{
+      chip8::core::RomImage::Load(argv[1])};
+  if (!rom) {
+    return 1;
+  }
+
+  chip8::search::SearchConfig config;
+  const std::string_view strategy{argv[2]};
+  if (strategy == "bfs") {
+    config.strategy = chip8::search::Strategy::kBreadthFirst;
+  } else if (strategy == "beam") {
+    config.strategy = chip8::search::Strategy::kBeam;
+  } else if (strategy == "novelty") {
+    config.strategy = chip8::search::Strategy::kNovelty;
+  } else {
+    std::fprintf(stderr, "Unknown strategy: %s\n", argv[2]);
+    return 1;
+  }
+  const std::optional<std::vector<MemoryWeight>> weights{
+      ParseWeights(argv[3])};
+  if (!weights || weights->empty()) {
+    std::fprintf(stderr, "Invalid addresses: %s\n", argv[3]);
+    return 1;
+  }
+  for (const MemoryWeight& weight : *weights) {
+    config.novelty_addresses.push_back(weight.address);
+  }
+  config.score = chip8::search::ScoreMemory(*weights);
+  if (argc > 4) {
+    config.max_depth = std::stoul(argv[4]);
+  }
+
+  chip8::core::Cpu start;
+  start.SeedRNG(0);
+  start.LoadROM(*rom);
+  const chip8::search::SearchResult result{
+      chip8::search::Search(start, config)};
+
+  std::printf("depth:      %zu\n", result.depth);
+  std::printf("states:     %llu (%.0f states/s, %llu duplicates)\n",
+              static_cast<unsigned long long>(result.states_explored),
+              result.states_per_second,
+              static_cast<unsigned long long>(result.duplicates));
+  if (config.strategy == chip8::search::Strategy::kNovelty) {
+    std::printf("cells:      %zu\n", result.cells);
+  }
+  std::printf("best score: %g after %zu inputs\n", result.best_score,
+              result.inputs.size());
+
+  if (argc > 5) {
+    chip8::runtime::MovieHeader header;
+    header.rom_hash = rom->GetHash();
+    header.cycles_per_frame = static_cast<uint32_t>(config.cycles_per_frame);
+    std::unique_ptr<chip8::runtime::MovieWriter> movie{
+        chip8::runtime::MovieWriter::Open(argv[5], header)};
+    if (!movie) {
+      return 1;
+    }
+    // Replays the path once more for the final state checked by replays.
+    chip8::core::Cpu cpu;
+    cpu.SeedRNG(header.seed);
+    cpu.LoadROM(*rom);
+    for (const uint16_t keys : result.inputs) {
+      cpu.SetKeyMask(keys);
+      for (size_t frame{}; frame < config.frames_per_decision; ++frame) {
+        movie->AddFrame(keys);
+        cpu.RunFrame(config.cycles_per_frame);
+      }
+    }
+    if (!movie->Close(cpu.GetStateHash())) {
+      return 1;
+    }
+  }
+  return 0;
+}
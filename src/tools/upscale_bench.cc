@@ -0,0 +1,98 @@
+#include <chip8/video/upscaler.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Usage: ./chip8-upscale-bench [frames]
+// Compares every supported upscaler kernel with a naive per output pixel
+// loop, for all pixel formats at the default scale. SIMD kernels are also
+// compared with the scalar one, which copies precomputed spans with memcpy.
+
+namespace {
+
+using chip8::core::Framebuffer;
+using chip8::video::Kernel;
+using chip8::video::PixelFormat;
+
+void ScaleNaive(const Framebuffer& framebuffer, PixelFormat format,
+                uint8_t* out) {
+  const size_t scale{chip8::core::kPixelSize};
+  const size_t bytes_per_pixel{chip8::video::GetBytesPerPixel(format)};
+  for (size_t y{}; y < 32 * scale; ++y) {
+    for (size_t x{}; x < 64 * scale; ++x) {
+      const bool lit{((framebuffer[y / scale] >> (x / scale)) & 1u) != 0};
+      const uint32_t argb{lit ? 0xFFFFFFFFu : 0xFF000000u};
+      if (format == PixelFormat::kArgb8888) {
+        std::memcpy(out, &argb, sizeof(argb));
+      } else {
+        std::memset(out, lit ? 0xFF : 0x00, bytes_per_pixel);
+      }
+      out += bytes_per_pixel;
+    }
+  }
+}
+
+template <typename Function>
+double MeasureFramesPerSecond(size_t frames, Function&& function) {
+  const auto start{std::chrono::steady_clock::now()};
+  for (size_t i{}; i < frames; ++i) {
+    function();
+  }
+  const std::chrono::duration<double> elapsed{
+      std::chrono::steady_clock::now() - start};
+  return static_cast<double>(frames) / elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t frames{argc > 1 ? std::stoul(argv[1]) : 2000};
+
+  std::mt19937_64 gen(1);
+  Framebuffer framebuffer{};
+  for (uint64_t& row : framebuffer) {
+    row = gen();
+  }
+
+  const struct {
+    PixelFormat format;
+    const char* name;
+  } formats[]{{PixelFormat::kArgb8888, "ARGB8888"},
+              {PixelFormat::kRgb24, "RGB24"},
+              {PixelFormat::kY8, "Y8"}};
+  const struct {
+    Kernel kernel;
+    const char* name;
+  } kernels[]{{Kernel::kSse2, "sse2"}, {Kernel::kAvx2, "avx2"}};
+
+  for (const auto& format : formats) {
+    chip8::video::Upscaler upscaler(format.format);
+    std::vector<uint8_t> image(upscaler.GetFrameSize());
+
+    const double naive{MeasureFramesPerSecond(frames, [&] {
+      ScaleNaive(framebuffer, format.format, image.data());
+    })};
+    std::printf("%-9s %-7s %10.0f frames/s\n", format.name, "naive", naive);
+
+    upscaler.SetKernel(Kernel::kScalar);
+    const double copy{MeasureFramesPerSecond(
+        frames, [&] { upscaler.Scale(framebuffer, image); })};
+    std::printf("%-9s %-7s %10.0f frames/s (%.1fx naive)\n", format.name,
+                "memcpy", copy, copy / naive);
+
+    for (const auto& kernel : kernels) {
+      if (!upscaler.SetKernel(kernel.kernel)) {
+        continue;
+      }
+      const double fps{MeasureFramesPerSecond(
+          frames, [&] { upscaler.Scale(framebuffer, image); })};
+      std::printf("%-9s %-7s %10.0f frames/s (%.1fx naive, %.2fx memcpy)\n",
+                  format.name, kernel.name, fps, fps / naive, fps / copy);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include <chip8/core/framebuffer.h>
+#include <chip8/runtime/shared_state.h>
+#include <chip8/utils/logger.h>
+#include <chip8/video/terminal_renderer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+// Usage: ./chip8-watch <segment> [frames]
+// Example consumer of the shared memory export (chip8-bin [export]): maps
+// the segment read-only, draws every new frame on the terminal with a
+// status line, and exits when the emulator quits or after [frames] frames.
+
+int main(int argc, char* argv[]) {
+  chip8::utils::Logger::Init();
+
+  if (argc != 2 && argc != 3) {
+    std::fprintf(stderr, "Correct usage: %s [segment] [frames]\n", argv[0]);
+    return 1;
+  }
+  const uint64_t limit{argc == 3 ? std::stoull(argv[2]) : 0};
+
+  const std::unique_ptr<chip8::runtime::SharedStateReader> reader{
+      chip8::runtime::SharedStateReader::Open(argv[1])};
+  if (!reader) {
+    return 1;
+  }
+
+  chip8::video::TerminalRenderer renderer;
+  std::string output;
+  uint64_t sequence{};
+  uint64_t frames{};
+  uint64_t skipped{};
+  uint64_t last_number{};
+  while (!reader->IsClosed() && (limit == 0 || frames < limit)) {
+    // Polling the sequence touches a single cache line of the segment.
+    const uint64_t current{reader->GetSequence()};
+    if (current == sequence) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      continue;
+    }
+    const std::optional<chip8::runtime::SharedFrame> frame{reader->Read()};
+    if (!frame) {
+      continue;
+    }
+    sequence = current;
+    ++frames;
+    skipped += last_number != 0 ? frame->number - last_number - 1 : 0;
+    last_number = frame->number;
+
+    chip8::core::Framebuffer pixels;
+    std::copy(std::begin(frame->pixels), std::end(frame->pixels),
+              pixels.begin());
+    renderer.Render(pixels, output);
+
+    // The status line is written with the cursor saved and restored, so the
+    // renderer keeps track of it.
+    char status[128];
+    std::snprintf(status, sizeof(status),
+                  "\x1b" "7\x1b[%zu;1H\x1b[2Kframe %llu  pc %03X  i %03X  "
+                  "skipped %llu  retries %llu\x1b" "8",
+                  renderer.GetRows() + 1,
+                  static_cast<unsigned long long>(frame->number),
+                  frame->program_counter, frame->index_register,
+                  static_cast<unsigned long long>(skipped),
+                  static_cast<unsigned long long>(reader->GetRetryCount()));
+    output += status;
+    std::fwrite(output.data(), 1, output.size(), stdout);
+    std::fflush(stdout);
+    output.clear();
+  }
+
+  std::printf("\x1b[%zu;1H\n", renderer.GetRows() + 2);
+  std::printf("%llu frames read, %llu skipped, %llu retries\n",
+              static_cast<unsigned long long>(frames),
+              static_cast<unsigned long long>(skipped),
+              static_cast<unsigned long long>(reader->GetRetryCount()));
+  return 0;
+}
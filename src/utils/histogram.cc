@@ -0,0 +1,82 @@
+#include <chip8/utils/histogram.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+
+namespace chip8::utils {
+
+Histogram::Histogram() noexcept : buckets_(), count_(), sum_(), max_() {}
+
+void Histogram::Record(std::chrono::nanoseconds duration) noexcept {
+  const uint64_t value{
+      static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0))};
+  ++buckets_[GetBucket(value)];
+  ++count_;
+  sum_ += value;
+  max_ = std::max(max_, value);
+}
+
+uint64_t Histogram::GetCount() const noexcept { return count_; }
+
+std::chrono::nanoseconds Histogram::GetMax() const noexcept {
+  return std::chrono::nanoseconds{max_};
+}
+
+std::chrono::nanoseconds Histogram::GetMean() const noexcept {
+  return std::chrono::nanoseconds{count_ == 0 ? 0 : sum_ / count_};
+}
+
+std::chrono::nanoseconds Histogram::GetPercentile(
+    double percentile) const noexcept {
+  if (count_ == 0) {
+    return std::chrono::nanoseconds{0};
+  }
+
+  const uint64_t rank{std::max<uint64_t>(
+      1, static_cast<uint64_t>(
+             std::ceil(percentile / 100.0 * static_cast<double>(count_))))};
+  uint64_t seen{};
+  for (size_t bucket{}; bucket < buckets_.size(); ++bucket) {
+    seen += buckets_[bucket];
+    if (seen >= rank) {
+      return std::chrono::nanoseconds{GetBucketStart(bucket)};
+    }
+  }
+  return GetMax();
+}
+
+std::string Histogram::Summarize() const {
+  auto to_us{[](std::chrono::nanoseconds value) {
+    return static_cast<double>(value.count()) / 1000.0;
+  }};
+
+  char buffer[160];
+  std::snprintf(buffer, sizeof(buffer),
+                "count %llu, mean %.1f us, p50 %.1f us, p90 %.1f us, "
+                "p99 %.1f us, max %.1f us",
+                static_cast<unsigned long long>(count_), to_us(GetMean()),
+                to_us(GetPercentile(50)), to_us(GetPercentile(90)),
+                to_us(GetPercentile(99)), to_us(GetMax()));
+  return buffer;
+}
+
+size_t Histogram::GetBucket(uint64_t value) noexcept {
+  if (value < 8) {
+    return static_cast<size_t>(value);
+  }
+  const size_t exponent{static_cast<size_t>(std::bit_width(value)) - 1};
+  const size_t sub_bucket{static_cast<size_t>((value >> (exponent - 3)) & 7u)};
+  return (exponent - 2) * 8 + sub_bucket;
+}
+
+uint64_t Histogram::GetBucketStart(size_t bucket) noexcept {
+  if (bucket < 8) {
+    return bucket;
+  }
+  const size_t exponent{bucket / 8 + 2};
+  return (uint64_t{8} | (bucket % 8)) << (exponent - 3);
+}
+
+}  // namespace chip8::utils
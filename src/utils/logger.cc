@@ -2,7 +2,21 @@
 
 namespace chip8::utils {
 
-std::shared_ptr<spdlog::logger> Logger::logger_;
+namespace {
+
+/// <summary>
+/// Creates a logger without sinks, so that core components can be used before
+/// (or without) calling Logger::Init().
+/// </summary>
+std::shared_ptr<spdlog::logger> MakeSilentLogger() {
+  auto logger{std::make_shared<spdlog::logger>("Silent")};
+  logger->set_level(spdlog::level::off);
+  return logger;
+}
+
+}  // namespace
+
+std::shared_ptr<spdlog::logger> Logger::logger_{MakeSilentLogger()};
 std::shared_ptr<spdlog::sinks::rotating_file_sink_mt> Logger::file_sink_;
 std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> Logger::console_sink_;
 
@@ -24,4 +38,11 @@ void Logger::Init() noexcept {
   LOG_INFO("Logger initialized.");
 }
 
+void Logger::SetConsoleEnabled(bool enabled) noexcept {
+  if (console_sink_) {
+    console_sink_->set_level(enabled ? spdlog::level::trace
+                                     : spdlog::level::off);
+  }
+}
+
 }  // namespace chip8::utils
\ No newline at end of file
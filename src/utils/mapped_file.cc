@@ -0,0 +1,98 @@
+#include <chip8/utils/mapped_file.h>
+#include <chip8/utils/logger.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace chip8::utils {
+
+std::unique_ptr<MappedFile> MappedFile::Open(
+    const std::filesystem::path& path) {
+#if defined(_WIN32)
+  const HANDLE file{CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    LOG_ERROR("Failed to open file ('{}')", path.string());
+    return nullptr;
+  }
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    LOG_ERROR("Failed to open file ('{}')", path.string());
+    return nullptr;
+  }
+  if (size.QuadPart == 0) {
+    CloseHandle(file);
+    return std::unique_ptr<MappedFile>(new MappedFile(nullptr, 0));
+  }
+  // The view keeps the mapping alive, both handles can be closed.
+  const HANDLE mapping{
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    LOG_ERROR("Failed to map file ('{}')", path.string());
+    return nullptr;
+  }
+  const void* data{MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+  CloseHandle(mapping);
+  if (data == nullptr) {
+    LOG_ERROR("Failed to map file ('{}')", path.string());
+    return nullptr;
+  }
+  return std::unique_ptr<MappedFile>(
+      new MappedFile(static_cast<const uint8_t*>(data),
+                     static_cast<size_t>(size.QuadPart)));
+#else
+  const int descriptor{open(path.c_str(), O_RDONLY)};
+  if (descriptor < 0) {
+    LOG_ERROR("Failed to open file ('{}')", path.string());
+    return nullptr;
+  }
+  struct stat status {};
+  if (fstat(descriptor, &status) != 0) {
+    close(descriptor);
+    LOG_ERROR("Failed to open file ('{}')", path.string());
+    return nullptr;
+  }
+  const auto size{static_cast<size_t>(status.st_size)};
+  if (size == 0) {
+    close(descriptor);
+    return std::unique_ptr<MappedFile>(new MappedFile(nullptr, 0));
+  }
+  void* data{mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+  close(descriptor);
+  if (data == MAP_FAILED) {
+    LOG_ERROR("Failed to map file ('{}')", path.string());
+    return nullptr;
+  }
+  return std::unique_ptr<MappedFile>(
+      new MappedFile(static_cast<const uint8_t*>(data), size));
+#endif
+}
+
+MappedFile::MappedFile(const uint8_t* data, size_t size) noexcept
+    : data_(data), size_(size) {}
+
+MappedFile::~MappedFile() noexcept {
+  if (data_ == nullptr) {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(data_);
+#else
+  munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+}
+
+std::span<const uint8_t> MappedFile::GetBytes() const noexcept {
+  return {data_, size_};
+}
+
+}  // namespace chip8::utils
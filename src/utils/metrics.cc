@@ -0,0 +1,173 @@
+#include <chip8/utils/metrics.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+namespace chip8::utils {
+
+namespace {
+
+double ToSeconds(std::chrono::nanoseconds duration) noexcept {
+  return std::chrono::duration<double>(duration).count();
+}
+
+/// <summary>
+/// Formats a number the way both Prometheus and JSON accept it.
+/// </summary>
+std::string FormatNumber(double value) {
+  if (!std::isfinite(value)) {
+    return "0";
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+  return buffer;
+}
+
+std::string FormatNumber(uint64_t value) {
+  char buffer[24];
+  std::snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+  return buffer;
+}
+
+}  // namespace
+
+MetricHistogram::MetricHistogram(std::vector<std::chrono::nanoseconds> bounds)
+    : bounds_(std::move(bounds)),
+      buckets_(std::make_unique<std::atomic<uint64_t>[]>(bounds_.size() + 1)),
+      sum_(0) {
+  std::sort(bounds_.begin(), bounds_.end());
+}
+
+void MetricHistogram::Record(std::chrono::nanoseconds duration) noexcept {
+  const size_t bucket{static_cast<size_t>(
+      std::lower_bound(bounds_.begin(), bounds_.end(), duration) -
+      bounds_.begin())};
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0)),
+                 std::memory_order_relaxed);
+}
+
+const std::vector<std::chrono::nanoseconds>& MetricHistogram::GetBounds()
+    const noexcept {
+  return bounds_;
+}
+
+std::vector<uint64_t> MetricHistogram::GetBuckets() const {
+  std::vector<uint64_t> buckets(bounds_.size() + 1);
+  for (size_t bucket{}; bucket < buckets.size(); ++bucket) {
+    buckets[bucket] = buckets_[bucket].load(std::memory_order_relaxed);
+  }
+  return buckets;
+}
+
+std::chrono::nanoseconds MetricHistogram::GetSum() const noexcept {
+  return std::chrono::nanoseconds{sum_.load(std::memory_order_relaxed)};
+}
+
+Counter& MetricsRegistry::AddCounter(std::string name, std::string help) {
+  auto counter{std::make_unique<Counter>()};
+  Counter& result{*counter};
+  const std::lock_guard lock(mutex_);
+  entries_.push_back(Entry{std::move(name), std::move(help), std::move(counter)});
+  return result;
+}
+
+Gauge& MetricsRegistry::AddGauge(std::string name, std::string help) {
+  auto gauge{std::make_unique<Gauge>()};
+  Gauge& result{*gauge};
+  const std::lock_guard lock(mutex_);
+  entries_.push_back(Entry{std::move(name), std::move(help), std::move(gauge)});
+  return result;
+}
+
+MetricHistogram& MetricsRegistry::AddHistogram(
+    std::string name, std::string help,
+    std::vector<std::chrono::nanoseconds> bounds) {
+  auto histogram{std::make_unique<MetricHistogram>(std::move(bounds))};
+  MetricHistogram& result{*histogram};
+  const std::lock_guard lock(mutex_);
+  entries_.push_back(
+      Entry{std::move(name), std::move(help), std::move(histogram)});
+  return result;
+}
+
+std::string MetricsRegistry::FormatPrometheus() const {
+  const std::lock_guard lock(mutex_);
+  std::string out;
+  for (const Entry& entry : entries_) {
+    out += "# HELP " + entry.name + ' ' + entry.help + '\n';
+    if (const auto* counter{
+            std::get_if<std::unique_ptr<Counter>>(&entry.metric)}) {
+      out += "# TYPE " + entry.name + " counter\n";
+      out += entry.name + ' ' + FormatNumber((*counter)->Get()) + '\n';
+    } else if (const auto* gauge{
+                   std::get_if<std::unique_ptr<Gauge>>(&entry.metric)}) {
+      out += "# TYPE " + entry.name + " gauge\n";
+      out += entry.name + ' ' + FormatNumber((*gauge)->Get()) + '\n';
+    } else {
+      const MetricHistogram& histogram{
+          *std::get<std::unique_ptr<MetricHistogram>>(entry.metric)};
+      const std::vector<uint64_t> buckets{histogram.GetBuckets()};
+      out += "# TYPE " + entry.name + " histogram\n";
+      // Buckets are cumulative and the count is taken from the same
+      // snapshot, so +Inf always equals _count.
+      uint64_t count{};
+      for (size_t bucket{}; bucket < buckets.size(); ++bucket) {
+        count += buckets[bucket];
+        const std::string bound{
+            bucket < histogram.GetBounds().size()
+                ? FormatNumber(ToSeconds(histogram.GetBounds()[bucket]))
+                : "+Inf"};
+        out += entry.name + "_bucket{le=\"" + bound + "\"} " +
+               FormatNumber(count) + '\n';
+      }
+      out += entry.name + "_sum " +
+             FormatNumber(ToSeconds(histogram.GetSum())) + '\n';
+      out += entry.name + "_count " + FormatNumber(count) + '\n';
+    }
+  }
+  return out;
+}
+
+std::string MetricsRegistry::FormatJson() const {
+  const std::lock_guard lock(mutex_);
+  std::string out{"{"};
+  for (const Entry& entry : entries_) {
+    if (out.size() > 1) {
+      out += ',';
+    }
+    out += '"' + entry.name + "\":";
+    if (const auto* counter{
+            std::get_if<std::unique_ptr<Counter>>(&entry.metric)}) {
+      out += FormatNumber((*counter)->Get());
+    } else if (const auto* gauge{
+                   std::get_if<std::unique_ptr<Gauge>>(&entry.metric)}) {
+      out += FormatNumber((*gauge)->Get());
+    } else {
+      const MetricHistogram& histogram{
+          *std::get<std::unique_ptr<MetricHistogram>>(entry.metric)};
+      const std::vector<uint64_t> buckets{histogram.GetBuckets()};
+      std::string cumulative;
+      uint64_t count{};
+      for (size_t bucket{}; bucket < histogram.GetBounds().size(); ++bucket) {
+        count += buckets[bucket];
+        if (!cumulative.empty()) {
+          cumulative += ',';
+        }
+        cumulative += "[" +
+                      FormatNumber(ToSeconds(histogram.GetBounds()[bucket])) +
+                      ',' + FormatNumber(count) + ']';
+      }
+      count += buckets.back();
+      out += "{\"count\":" + FormatNumber(count) +
+             ",\"sum\":" + FormatNumber(ToSeconds(histogram.GetSum())) +
+             ",\"buckets\":[" + cumulative + "]}";
+    }
+  }
+  out += '}';
+  return out;
+}
+
+}  // namespace chip8::utils
@@ -0,0 +1,289 @@
+#include <chip8/utils/logger.h>
+#include <chip8/utils/perf_counters.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace chip8::utils {
+
+namespace {
+
+constexpr size_t kPhaseCount{static_cast<size_t>(PerfPhase::kCount)};
+
+/// <summary>
+/// Deepest supported nesting of scopes.
+/// </summary>
+constexpr size_t kMaxDepth{8};
+
+constexpr std::array<const char*, kPhaseCount> kPhaseNames{
+    "dispatch", "draw", "render", "audio"};
+
+/// <summary>
+/// Counters and totals of a single thread. Only the owning thread writes
+/// them.
+/// </summary>
+struct ThreadCounters {
+  bool opened{};
+  bool available{};
+
+#if defined(__linux__)
+  /// <summary>
+  /// Event descriptors, the first one leads the group.
+  /// </summary>
+  std::array<int, 5> fds{-1, -1, -1, -1, -1};
+
+  /// <summary>
+  /// Pages used to read counters with rdpmc, nullptr if not mapped.
+  /// </summary>
+  std::array<perf_event_mmap_page*, 5> pages{};
+#endif
+
+  std::array<PerfPhaseTotals, kPhaseCount> totals{};
+  std::array<PerfPhase, kMaxDepth> stack{};
+  size_t depth{};
+
+  /// <summary>
+  /// Counter values when the innermost scope last started or resumed.
+  /// </summary>
+  PerfSample last{};
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadCounters>> threads;
+};
+
+/// <summary>
+/// Returns counters of every thread. Never destroyed, so threads may end
+/// scopes during static destruction.
+/// </summary>
+Registry& GetRegistry() noexcept {
+  static Registry* registry{new Registry()};
+  return *registry;
+}
+
+#if defined(__linux__)
+
+int OpenEvent(uint32_t type, uint64_t config, int group) noexcept {
+  perf_event_attr attributes{};
+  attributes.size = sizeof(attributes);
+  attributes.type = type;
+  attributes.config = config;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.disabled = group == -1 ? 1 : 0;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attributes, 0, -1, group, 0));
+}
+
+bool Open(ThreadCounters& counters) noexcept {
+  const std::array<std::pair<uint32_t, uint64_t>, 5> events{{
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                               (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+  }};
+
+  const long page_size{sysconf(_SC_PAGESIZE)};
+  for (size_t i{}; i < events.size(); ++i) {
+    counters.fds[i] =
+        OpenEvent(events[i].first, events[i].second, counters.fds[0]);
+    if (counters.fds[i] < 0) {
+      for (size_t j{}; j < i; ++j) {
+        if (counters.pages[j] != nullptr) {
+          munmap(counters.pages[j], static_cast<size_t>(page_size));
+        }
+        close(counters.fds[j]);
+      }
+      return false;
+    }
+    void* page{mmap(nullptr, static_cast<size_t>(page_size), PROT_READ,
+                    MAP_SHARED, counters.fds[i], 0)};
+    counters.pages[i] =
+        page == MAP_FAILED ? nullptr : static_cast<perf_event_mmap_page*>(page);
+  }
+  ioctl(counters.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return true;
+}
+
+uint64_t ReadCounter(const ThreadCounters& counters, size_t i) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  // Lock-free protocol of perf_event_mmap_page: retry while the kernel
+  // updates the page.
+  if (const perf_event_mmap_page* page{counters.pages[i]};
+      page != nullptr && page->cap_user_rdpmc) {
+    uint32_t sequence;
+    uint64_t count;
+    do {
+      sequence = page->lock;
+      asm volatile("" ::: "memory");
+      const uint32_t index{page->index};
+      count = static_cast<uint64_t>(page->offset);
+      if (index != 0) {
+        const int shift{64 - page->pmc_width};
+        const int64_t value{static_cast<int64_t>(
+                                __builtin_ia32_rdpmc(static_cast<int>(index - 1))
+                                << shift) >>
+                            shift};
+        count += static_cast<uint64_t>(value);
+      }
+      asm volatile("" ::: "memory");
+    } while (page->lock != sequence);
+    return count;
+  }
+#endif
+  uint64_t count{};
+  if (read(counters.fds[i], &count, sizeof(count)) != sizeof(count)) {
+    return 0;
+  }
+  return count;
+}
+
+PerfSample Read(const ThreadCounters& counters) noexcept {
+  return PerfSample{ReadCounter(counters, 0), ReadCounter(counters, 1),
+                    ReadCounter(counters, 2), ReadCounter(counters, 3),
+                    ReadCounter(counters, 4)};
+}
+
+#else
+
+bool Open(ThreadCounters&) noexcept { return false; }
+
+PerfSample Read(const ThreadCounters&) noexcept { return PerfSample{}; }
+
+#endif
+
+ThreadCounters& GetThreadCounters() noexcept {
+  thread_local ThreadCounters* counters{nullptr};
+  if (counters == nullptr) {
+    Registry& registry{GetRegistry()};
+    const std::lock_guard lock(registry.mutex);
+    registry.threads.push_back(std::make_unique<ThreadCounters>());
+    counters = registry.threads.back().get();
+  }
+  if (!counters->opened) {
+    counters->opened = true;
+    counters->available = Open(*counters);
+    if (!counters->available) {
+      LOG_WARN("Hardware performance counters are not available");
+    }
+  }
+  return *counters;
+}
+
+double Divide(uint64_t dividend, uint64_t divisor) noexcept {
+  return divisor == 0
+             ? 0.0
+             : static_cast<double>(dividend) / static_cast<double>(divisor);
+}
+
+}  // namespace
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) noexcept {
+  cycles += other.cycles;
+  instructions += other.instructions;
+  branches += other.branches;
+  branch_misses += other.branch_misses;
+  l1d_misses += other.l1d_misses;
+  return *this;
+}
+
+PerfSample PerfSample::operator-(const PerfSample& other) const noexcept {
+  return PerfSample{cycles - other.cycles, instructions - other.instructions,
+                    branches - other.branches,
+                    branch_misses - other.branch_misses,
+                    l1d_misses - other.l1d_misses};
+}
+
+bool PerfCounters::IsAvailable() noexcept {
+  return GetThreadCounters().available;
+}
+
+void PerfCounters::Begin(PerfPhase phase) noexcept {
+  ThreadCounters& counters{GetThreadCounters()};
+  if (!counters.available || counters.depth == kMaxDepth) {
+    return;
+  }
+  const PerfSample now{Read(counters)};
+  // The enclosing phase pauses until this one ends.
+  if (counters.depth != 0) {
+    const auto outer{static_cast<size_t>(counters.stack[counters.depth - 1])};
+    counters.totals[outer].counters += now - counters.last;
+  }
+  counters.stack[counters.depth++] = phase;
+  counters.last = now;
+}
+
+void PerfCounters::End(PerfPhase phase, uint64_t units) noexcept {
+  ThreadCounters& counters{GetThreadCounters()};
+  if (!counters.available || counters.depth == 0 ||
+      counters.stack[counters.depth - 1] != phase) {
+    return;
+  }
+  const PerfSample now{Read(counters)};
+  PerfPhaseTotals& totals{counters.totals[static_cast<size_t>(phase)]};
+  totals.counters += now - counters.last;
+  totals.units += units;
+  --counters.depth;
+  counters.last = now;
+}
+
+std::array<PerfPhaseTotals, kPhaseCount> PerfCounters::GetTotals() {
+  std::array<PerfPhaseTotals, kPhaseCount> totals{};
+  Registry& registry{GetRegistry()};
+  const std::lock_guard lock(registry.mutex);
+  for (const auto& thread : registry.threads) {
+    for (size_t phase{}; phase < kPhaseCount; ++phase) {
+      totals[phase].counters += thread->totals[phase].counters;
+      totals[phase].units += thread->totals[phase].units;
+    }
+  }
+  return totals;
+}
+
+std::string PerfCounters::Report() {
+  std::string out{
+      "phase          units   cycles/unit    instr/unit    IPC  "
+      "br-miss/unit  br-miss %  L1d-miss/unit\n"};
+  char line[160];
+  const std::array<PerfPhaseTotals, kPhaseCount> all_totals{GetTotals()};
+  for (size_t phase{}; phase < kPhaseCount; ++phase) {
+    const PerfPhaseTotals& totals{all_totals[phase]};
+    const PerfSample& counters{totals.counters};
+    std::snprintf(line, sizeof(line),
+                  "%-8s %12" PRIu64 " %13.1f %13.1f %6.2f %13.3f %10.2f %14.3f\n",
+                  kPhaseNames[phase], totals.units,
+                  Divide(counters.cycles, totals.units),
+                  Divide(counters.instructions, totals.units),
+                  Divide(counters.instructions, counters.cycles),
+                  Divide(counters.branch_misses, totals.units),
+                  100.0 * Divide(counters.branch_misses, counters.branches),
+                  Divide(counters.l1d_misses, totals.units));
+    out += line;
+  }
+  return out;
+}
+
+void PerfCounters::Clear() noexcept {
+  Registry& registry{GetRegistry()};
+  const std::lock_guard lock(registry.mutex);
+  for (const auto& thread : registry.threads) {
+    thread->totals = {};
+  }
+}
+
+}  // namespace chip8::utils
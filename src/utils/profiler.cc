@@ -0,0 +1,171 @@
+#include <chip8/utils/logger.h>
+#include <chip8/utils/profiler.h>
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chip8::utils {
+
+namespace {
+
+struct ZoneEvent {
+  const char* name;
+  int64_t start;
+  int64_t end;
+};
+
+/// <summary>
+/// Zones of a single thread. Only the owning thread writes events, readers
+/// see the first count of them.
+/// </summary>
+struct ThreadBuffer {
+  explicit ThreadBuffer(uint32_t thread_id)
+      : id(thread_id),
+        name(nullptr),
+        count(0),
+        events(std::make_unique<ZoneEvent[]>(Profiler::kThreadCapacity)) {}
+
+  uint32_t id;
+  std::atomic<const char*> name;
+  std::atomic<size_t> count;
+  std::unique_ptr<ZoneEvent[]> events;
+};
+
+struct Buffers {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> threads;
+  std::atomic<uint64_t> dropped{};
+};
+
+/// <summary>
+/// Returns buffers of every thread. Never destroyed, so threads may record
+/// zones during static destruction.
+/// </summary>
+Buffers& GetBuffers() noexcept {
+  static Buffers* buffers{new Buffers()};
+  return *buffers;
+}
+
+ThreadBuffer& GetThreadBuffer() noexcept {
+  thread_local ThreadBuffer* buffer{nullptr};
+  if (buffer == nullptr) {
+    Buffers& buffers{GetBuffers()};
+    const std::lock_guard lock(buffers.mutex);
+    buffers.threads.push_back(std::make_unique<ThreadBuffer>(
+        static_cast<uint32_t>(buffers.threads.size() + 1)));
+    buffer = buffers.threads.back().get();
+  }
+  return *buffer;
+}
+
+/// <summary>
+/// Appends a JSON string literal.
+/// </summary>
+void AppendString(std::string& out, const char* text) {
+  out += '"';
+  for (; *text != '\0'; ++text) {
+    if (*text == '"' || *text == '\\') {
+      out += '\\';
+    }
+    out += *text;
+  }
+  out += '"';
+}
+
+}  // namespace
+
+int64_t Profiler::Now() noexcept {
+  using Clock = std::chrono::steady_clock;
+  static const Clock::time_point epoch{Clock::now()};
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                              epoch)
+      .count();
+}
+
+void Profiler::Record(const char* name, int64_t start, int64_t end) noexcept {
+  ThreadBuffer& buffer{GetThreadBuffer()};
+  const size_t count{buffer.count.load(std::memory_order_relaxed)};
+  if (count >= kThreadCapacity) {
+    GetBuffers().dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events[count] = ZoneEvent{name, start, end};
+  buffer.count.store(count + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char* name) noexcept {
+  GetThreadBuffer().name.store(name, std::memory_order_release);
+}
+
+std::string Profiler::FormatChromeTrace() {
+  Buffers& buffers{GetBuffers()};
+  const std::lock_guard lock(buffers.mutex);
+
+  std::string out{"{\"displayTimeUnit\":\"ms\",\"traceEvents\":["};
+  bool first{true};
+  char numbers[96];
+  for (const auto& thread : buffers.threads) {
+    if (const char* name{thread->name.load(std::memory_order_acquire)}) {
+      std::snprintf(numbers, sizeof(numbers),
+                    "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                    "\"tid\":%" PRIu32 ",\"args\":{\"name\":",
+                    first ? "" : ",", thread->id);
+      out += numbers;
+      AppendString(out, name);
+      out += "}}";
+      first = false;
+    }
+
+    const size_t count{thread->count.load(std::memory_order_acquire)};
+    for (size_t i{}; i < count; ++i) {
+      const ZoneEvent& event{thread->events[i]};
+      out += first ? "{\"name\":" : ",\n{\"name\":";
+      AppendString(out, event.name);
+      // Chrome expects microseconds.
+      std::snprintf(numbers, sizeof(numbers),
+                    ",\"ph\":\"X\",\"pid\":1,\"tid\":%" PRIu32
+                    ",\"ts\":%.3f,\"dur\":%.3f}",
+                    thread->id, static_cast<double>(event.start) / 1000.0,
+                    static_cast<double>(event.end - event.start) / 1000.0);
+      out += numbers;
+      first = false;
+    }
+  }
+  out += "]}\n";
+  return out;
+}
+
+bool Profiler::WriteChromeTrace(const std::filesystem::path& path) {
+  std::ofstream out_stream(path, std::ios::trunc);
+  if (!out_stream.is_open()) {
+    LOG_ERROR("Failed to write trace ('{}')", path.string());
+    return false;
+  }
+  out_stream << FormatChromeTrace();
+  if (GetDroppedCount() != 0) {
+    LOG_WARN("Trace is missing {} zones recorded after buffers filled up",
+             GetDroppedCount());
+  }
+  return out_stream.good();
+}
+
+uint64_t Profiler::GetDroppedCount() noexcept {
+  return GetBuffers().dropped.load(std::memory_order_relaxed);
+}
+
+void Profiler::Clear() noexcept {
+  Buffers& buffers{GetBuffers()};
+  const std::lock_guard lock(buffers.mutex);
+  for (const auto& thread : buffers.threads) {
+    thread->count.store(0, std::memory_order_relaxed);
+  }
+  buffers.dropped.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace chip8::utils
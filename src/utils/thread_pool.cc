@@ -0,0 +1,102 @@
+#include <chip8/utils/thread_pool.h>
+
+#include <algorithm>
+
+namespace chip8::utils {
+
+ThreadPool::ThreadPool(size_t threads)
+    : workers_(),
+      mutex_(),
+      start_cv_(),
+      done_cv_(),
+      body_(nullptr),
+      count_(),
+      next_(),
+      generation_(),
+      busy_(),
+      stopping_(false) {
+  const size_t workers{std::max<size_t>(threads, 1) - 1};
+  workers_.reserve(workers);
+  for (size_t i{}; i < workers; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() noexcept {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  start_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)>& body) {
+  if (count == 0) {
+    return;
+  }
+
+  if (workers_.empty() || count == 1) {
+    for (size_t i{}; i < count; ++i) {
+      body(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard lock(mutex_);
+    body_ = &body;
+    count_ = count;
+    next_.store(0, std::memory_order_relaxed);
+    busy_ = workers_.size();
+    ++generation_;
+  }
+  start_cv_.notify_all();
+
+  Drain();
+
+  std::unique_lock lock(mutex_);
+  done_cv_.wait(lock, [this] { return busy_ == 0; });
+  body_ = nullptr;
+}
+
+size_t ThreadPool::GetThreadCount() const noexcept {
+  return workers_.size() + 1;
+}
+
+void ThreadPool::WorkerLoop() {
+  size_t seen_generation{};
+  while (true) {
+    {
+      std::unique_lock lock(mutex_);
+      start_cv_.wait(lock, [this, seen_generation] {
+        return stopping_ || generation_ != seen_generation;
+      });
+      if (stopping_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+
+    Drain();
+
+    {
+      std::lock_guard lock(mutex_);
+      --busy_;
+    }
+    done_cv_.notify_one();
+  }
+}
+
+void ThreadPool::Drain() noexcept {
+  size_t index{next_.fetch_add(1, std::memory_order_relaxed)};
+  while (index < count_) {
+    (*body_)(index);
+    index = next_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace chip8::utils
@@ -0,0 +1,227 @@
+#include <chip8/verify/lockstep.h>
+
+#include <chip8/analysis/disassembler.h>
+#include <chip8/utils/hash.h>
+
+#include <cstdio>
+
+namespace chip8::verify {
+
+namespace {
+
+std::string FormatHex(uint64_t value) {
+  char buffer[24];
+  std::snprintf(buffer, sizeof(buffer), "%#llx",
+                static_cast<unsigned long long>(value));
+  return buffer;
+}
+
+template <typename T, size_t N>
+uint64_t HashArray(const std::array<T, N>& array) noexcept {
+  return utils::Fnv1a(
+      {reinterpret_cast<const uint8_t*>(array.data()), sizeof(array)});
+}
+
+/// <summary>
+/// Returns index of the first element differing between arrays.
+/// </summary>
+template <typename T, size_t N>
+size_t FindMismatch(const std::array<T, N>& lhs,
+                    const std::array<T, N>& rhs) noexcept {
+  size_t index{};
+  while (index < N && lhs[index] == rhs[index]) {
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace
+
+std::string Divergence::Format() const {
+  char line[160];
+  std::snprintf(line, sizeof(line),
+                "divergence in frame %llu after %llu instructions: %s is %s "
+                "in reference, %s in candidate\n",
+                static_cast<unsigned long long>(frame),
+                static_cast<unsigned long long>(instruction), field.c_str(),
+                reference.c_str(), candidate.c_str());
+  std::string result{line};
+  for (const TraceEntry& entry : trace) {
+    std::snprintf(line, sizeof(line),
+                  "  frame %6llu  #%-10llu %#05x  %04x  %s\n",
+                  static_cast<unsigned long long>(entry.frame),
+                  static_cast<unsigned long long>(entry.instruction),
+                  entry.address, entry.opcode,
+                  analysis::Disassemble(entry.opcode).c_str());
+    result += line;
+  }
+  return result;
+}
+
+LockstepHarness::LockstepHarness(core::Cpu& reference, core::Cpu& candidate,
+                                 LockstepConfig config)
+    : reference_(reference),
+      candidate_(candidate),
+      config_(std::move(config)),
+      stats_(),
+      trace_() {
+  reference_.SetIdleSkipping(false);
+  reference_.SetFusion(false);
+  reference_.AttachAotModule(nullptr);
+  config_.compare_interval = std::max<size_t>(config_.compare_interval, 1);
+  trace_.reserve(config_.trace_window);
+}
+
+std::optional<Divergence> LockstepHarness::Run() {
+  stats_ = {};
+  trace_.clear();
+
+  for (uint64_t frame{}; frame < config_.frames; ++frame) {
+    const uint16_t keys{config_.keys ? config_.keys(frame) : uint16_t{0}};
+    reference_.SetKeyMask(keys);
+    candidate_.SetKeyMask(keys);
+
+    size_t executed{};
+    size_t since_comparison{};
+    while (executed < config_.cycles_per_frame) {
+      const size_t consumed{
+          candidate_.Step(config_.cycles_per_frame - executed)};
+      if (consumed == 0) {
+        // Halted by a stack error, the reference stops at the same point.
+        break;
+      }
+      for (size_t i{}; i < consumed; ++i) {
+        RecordTrace(frame);
+        reference_.Cycle();
+        ++stats_.instructions;
+      }
+      executed += consumed;
+      since_comparison += consumed;
+      ++stats_.steps;
+
+      if (since_comparison >= config_.compare_interval) {
+        since_comparison = 0;
+        if (std::optional<Divergence> divergence{Compare(frame)}) {
+          return divergence;
+        }
+      }
+    }
+
+    reference_.TickTimers();
+    candidate_.TickTimers();
+    ++stats_.frames;
+    if (std::optional<Divergence> divergence{Compare(frame)}) {
+      return divergence;
+    }
+  }
+  return std::nullopt;
+}
+
+const LockstepStats& LockstepHarness::GetStats() const noexcept {
+  return stats_;
+}
+
+std::optional<Divergence> LockstepHarness::Compare(uint64_t frame) {
+  ++stats_.comparisons;
+
+  Divergence divergence;
+  auto differs{[&divergence](const std::string& field, uint64_t reference,
+                             uint64_t candidate) {
+    if (reference == candidate) {
+      return false;
+    }
+    divergence.field = field;
+    divergence.reference = FormatHex(reference);
+    divergence.candidate = FormatHex(candidate);
+    return true;
+  }};
+
+  bool diverged{
+      differs("PC", reference_.GetProgramCounter(),
+              candidate_.GetProgramCounter()) ||
+      differs("I", reference_.GetIndexRegister(),
+              candidate_.GetIndexRegister()) ||
+      differs("opcode", reference_.GetOpcode(), candidate_.GetOpcode()) ||
+      differs("SP", reference_.GetStackPointer(),
+              candidate_.GetStackPointer()) ||
+      differs("DT", reference_.GetDelayTimer(), candidate_.GetDelayTimer()) ||
+      differs("ST", reference_.GetSoundTimer(), candidate_.GetSoundTimer()) ||
+      differs("keys", reference_.GetKeyMask(), candidate_.GetKeyMask()) ||
+      differs("unknown opcodes", reference_.GetUnknownOpcodeCount(),
+              candidate_.GetUnknownOpcodeCount()) ||
+      differs("error",
+              static_cast<uint64_t>(reference_.GetCriticalError()),
+              static_cast<uint64_t>(candidate_.GetCriticalError()))};
+
+  const std::array<uint8_t, 16>& registers{reference_.GetRegisters()};
+  const size_t register_index{
+      FindMismatch(registers, candidate_.GetRegisters())};
+  if (!diverged && register_index < registers.size()) {
+    char field[4];
+    std::snprintf(field, sizeof(field), "V%zX", register_index);
+    diverged = differs(field, registers[register_index],
+                       candidate_.GetRegisters()[register_index]);
+  }
+
+  const std::array<uint16_t, 16>& stack{reference_.GetStack()};
+  const size_t stack_index{FindMismatch(stack, candidate_.GetStack())};
+  if (!diverged && stack_index < stack.size()) {
+    diverged = differs("stack[" + std::to_string(stack_index) + "]",
+                       stack[stack_index], candidate_.GetStack()[stack_index]);
+  }
+
+  // Memory and screen are compared by hash; the first differing byte is
+  // only looked up for the report.
+  if (!diverged && HashArray(reference_.GetMemory()) !=
+                       HashArray(candidate_.GetMemory())) {
+    const size_t address{
+        FindMismatch(reference_.GetMemory(), candidate_.GetMemory())};
+    diverged = differs("memory[" + FormatHex(address) + "]",
+                       reference_.GetMemory()[address],
+                       candidate_.GetMemory()[address]);
+  }
+  if (!diverged && HashArray(reference_.GetPixels()) !=
+                       HashArray(candidate_.GetPixels())) {
+    const size_t pixel{
+        FindMismatch(reference_.GetPixels(), candidate_.GetPixels())};
+    diverged = differs("pixel(" + std::to_string(pixel % 64) + "," +
+                           std::to_string(pixel / 64) + ")",
+                       reference_.GetPixels()[pixel],
+                       candidate_.GetPixels()[pixel]);
+  }
+
+  if (!diverged) {
+    return std::nullopt;
+  }
+
+  divergence.frame = frame;
+  divergence.instruction = stats_.instructions;
+  const size_t oldest{trace_.size() < config_.trace_window
+                          ? 0
+                          : stats_.instructions % config_.trace_window};
+  for (size_t i{}; i < trace_.size(); ++i) {
+    divergence.trace.push_back(trace_[(oldest + i) % trace_.size()]);
+  }
+  return divergence;
+}
+
+void LockstepHarness::RecordTrace(uint64_t frame) noexcept {
+  if (config_.trace_window == 0) {
+    return;
+  }
+
+  const std::array<uint8_t, 4096>& memory{reference_.GetMemory()};
+  const uint16_t address{reference_.GetProgramCounter()};
+  const TraceEntry entry{
+      frame, stats_.instructions, address,
+      static_cast<uint16_t>(
+          (memory[address & core::kAddressMask] << 8u) |
+          memory[(address + 1u) & core::kAddressMask])};
+  if (trace_.size() < config_.trace_window) {
+    trace_.push_back(entry);
+  } else {
+    trace_[stats_.instructions % config_.trace_window] = entry;
+  }
+}
+
+}  // namespace chip8::verify
@@ -0,0 +1,210 @@
+#include <chip8/video/recorder.h>
+
+#include <cstring>
+
+namespace chip8::video {
+
+namespace {
+
+/// <summary>
+/// Size of stdio buffers of output files.
+/// </summary>
+constexpr size_t kWriteBufferSize{1 << 20};
+
+}  // namespace
+
+std::unique_ptr<Recorder> Recorder::Open(const std::filesystem::path& path,
+                                         const RecorderConfig& config) {
+  if (config.container == Container::kY4m &&
+      config.pixel_format != PixelFormat::kY8) {
+    LOG_ERROR("Y4M recordings support only Y8 pixels");
+    return nullptr;
+  }
+
+  std::FILE* output{std::fopen(path.string().c_str(), "wb")};
+  if (output == nullptr) {
+    LOG_ERROR("Failed to create recording: {}", path.string());
+    return nullptr;
+  }
+  std::setvbuf(output, nullptr, _IOFBF, kWriteBufferSize);
+
+  std::FILE* hash_log{};
+  if (!config.hash_log.empty()) {
+    hash_log = std::fopen(config.hash_log.string().c_str(), "w");
+    if (hash_log == nullptr) {
+      LOG_ERROR("Failed to create frame hash log: {}",
+                config.hash_log.string());
+      std::fclose(output);
+      return nullptr;
+    }
+  }
+
+  std::unique_ptr<Recorder> recorder{new Recorder(config, output, hash_log)};
+  if (config.container == Container::kY4m) {
+    std::fprintf(output, "YUV4MPEG2 W%zu H%zu F%u:1 Ip A1:1 Cmono\n",
+                 recorder->upscaler_.GetWidth(),
+                 recorder->upscaler_.GetHeight(), config.frame_rate);
+  }
+  recorder->writer_ = std::thread(&Recorder::WriterLoop, recorder.get());
+  LOG_INFO("Recording {}x{} frames to {}", recorder->upscaler_.GetWidth(),
+           recorder->upscaler_.GetHeight(), path.string());
+  return recorder;
+}
+
+Recorder::Recorder(const RecorderConfig& config, std::FILE* output,
+                   std::FILE* hash_log)
+    : config_(config),
+      output_(output),
+      hash_log_(hash_log),
+      upscaler_(config.pixel_format, config.scale),
+      image_(upscaler_.GetFrameSize()),
+      current_(),
+      last_pixels_(),
+      stats_(),
+      queue_(),
+      pushes_(0),
+      pops_(0),
+      closing_(false),
+      failed_(false) {}
+
+Recorder::~Recorder() noexcept { Close(); }
+
+void Recorder::AddFrame(const core::Cpu& cpu) noexcept {
+  const std::array<bool, 64 * 32>& pixels{cpu.GetPixels()};
+  if (stats_.frames != 0 && pixels == last_pixels_) {
+    ++stats_.frames;
+    ++current_.count;
+    return;
+  }
+
+  last_pixels_ = pixels;
+  core::Framebuffer framebuffer;
+  core::PackFramebuffer(pixels, framebuffer);
+  StartRun(framebuffer);
+}
+
+void Recorder::AddFrame(const core::Framebuffer& framebuffer) noexcept {
+  if (stats_.frames != 0 && framebuffer == current_.pixels) {
+    ++stats_.frames;
+    ++current_.count;
+    return;
+  }
+  StartRun(framebuffer);
+}
+
+bool Recorder::Close() noexcept {
+  if (!writer_.joinable()) {
+    return !failed_.load(std::memory_order_relaxed);
+  }
+
+  if (current_.count != 0) {
+    QueueRun();
+  }
+  closing_.store(true, std::memory_order_release);
+  pushes_.fetch_add(1, std::memory_order_release);
+  pushes_.notify_one();
+  writer_.join();
+
+  if (std::fclose(output_) != 0) {
+    failed_.store(true, std::memory_order_relaxed);
+  }
+  if (hash_log_ != nullptr && std::fclose(hash_log_) != 0) {
+    failed_.store(true, std::memory_order_relaxed);
+  }
+  output_ = nullptr;
+  hash_log_ = nullptr;
+
+  LOG_INFO("Recorded {} frames in {} runs, writer stalls: {}", stats_.frames,
+           stats_.runs, stats_.stalls);
+  if (failed_.load(std::memory_order_relaxed)) {
+    LOG_ERROR("Recording is incomplete, writing failed");
+    return false;
+  }
+  return true;
+}
+
+RecorderStats Recorder::GetStats() const noexcept { return stats_; }
+
+uint64_t Recorder::HashFrame(const core::Framebuffer& framebuffer) noexcept {
+  uint64_t hash{0xCBF29CE484222325u};
+  for (const uint64_t row : framebuffer) {
+    hash = (hash ^ row) * 0x100000001B3u;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+void Recorder::StartRun(const core::Framebuffer& framebuffer) noexcept {
+  if (current_.count != 0) {
+    QueueRun();
+  }
+  current_.pixels = framebuffer;
+  current_.hash = HashFrame(framebuffer);
+  current_.first_frame = stats_.frames;
+  current_.count = 1;
+  ++stats_.frames;
+  ++stats_.runs;
+}
+
+void Recorder::QueueRun() noexcept {
+  for (;;) {
+    // Read the counter before trying, so a pop in between is never slept
+    // through.
+    const uint32_t pops{pops_.load(std::memory_order_acquire)};
+    if (queue_.TryPush(current_)) {
+      break;
+    }
+    ++stats_.stalls;
+    pops_.wait(pops, std::memory_order_acquire);
+  }
+  pushes_.fetch_add(1, std::memory_order_release);
+  pushes_.notify_one();
+}
+
+void Recorder::WriterLoop() noexcept {
+  for (;;) {
+    // Runs queued before Close() are visible once closing_ is, so an empty
+    // queue seen afterwards means everything was written.
+    const bool closing{closing_.load(std::memory_order_acquire)};
+    const uint32_t pushes{pushes_.load(std::memory_order_acquire)};
+    if (const std::optional<Run> run{queue_.TryPop()}) {
+      pops_.fetch_add(1, std::memory_order_release);
+      pops_.notify_one();
+      if (!failed_.load(std::memory_order_relaxed) && !WriteRun(*run)) {
+        LOG_ERROR("Failed to write recorded frames");
+        failed_.store(true, std::memory_order_relaxed);
+      }
+      continue;
+    }
+    if (closing) {
+      return;
+    }
+    pushes_.wait(pushes, std::memory_order_acquire);
+  }
+}
+
+bool Recorder::WriteRun(const Run& run) noexcept {
+  if (hash_log_ != nullptr) {
+    std::fprintf(hash_log_, "%llu %llu %016llx\n",
+                 static_cast<unsigned long long>(run.first_frame),
+                 static_cast<unsigned long long>(run.count),
+                 static_cast<unsigned long long>(run.hash));
+  }
+
+  upscaler_.Scale(run.pixels, image_);
+  static constexpr char kFrameHeader[]{"FRAME\n"};
+  for (uint64_t i{}; i < run.count; ++i) {
+    if (config_.container == Container::kY4m &&
+        std::fwrite(kFrameHeader, 1, sizeof(kFrameHeader) - 1, output_) !=
+            sizeof(kFrameHeader) - 1) {
+      return false;
+    }
+    if (std::fwrite(image_.data(), 1, image_.size(), output_) !=
+        image_.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace chip8::video
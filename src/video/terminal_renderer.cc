@@ -0,0 +1,198 @@
+#include <chip8/video/terminal_renderer.h>
+#include <chip8/utils/profiler.h>
+
+#include <algorithm>
+#include <array>
+
+namespace chip8::video {
+
+namespace {
+
+constexpr size_t kWidth{64};
+constexpr size_t kHeight{32};
+
+/// <summary>
+/// Half block characters by pattern: bit 0 is the upper pixel, bit 1 the
+/// lower one.
+/// </summary>
+constexpr std::array<const char*, 4> kHalfBlocks{" ", "\xE2\x96\x80",
+                                                 "\xE2\x96\x84",
+                                                 "\xE2\x96\x88"};
+
+/// <summary>
+/// Bits of braille dots by pixel inside a 2x4 cell, [y][x]. Dots 1-3 and 4-6
+/// fill the top three rows, dots 7 and 8 were added below them.
+/// </summary>
+constexpr std::array<std::array<uint8_t, 2>, 4> kBrailleDots{{
+    {0x01, 0x08},
+    {0x02, 0x10},
+    {0x04, 0x20},
+    {0x40, 0x80},
+}};
+
+size_t CountDigits(size_t value) noexcept {
+  size_t digits{1};
+  while (value >= 10) {
+    value /= 10;
+    ++digits;
+  }
+  return digits;
+}
+
+}  // namespace
+
+TerminalRenderer::TerminalRenderer(TerminalCells cells, size_t row,
+                                   size_t column)
+    : cells_(cells),
+      origin_row_(std::max<size_t>(row, 1)),
+      origin_column_(std::max<size_t>(column, 1)),
+      rows_(cells == TerminalCells::kHalfBlock ? kHeight / 2 : kHeight / 4),
+      columns_(cells == TerminalCells::kHalfBlock ? kWidth : kWidth / 2),
+      shown_(rows_ * columns_),
+      valid_(false),
+      cursor_known_(false),
+      cursor_row_(0),
+      cursor_column_(0) {}
+
+void TerminalRenderer::Render(const core::Framebuffer& frame,
+                              std::string& out) {
+  CHIP8_ZONE("TerminalRenderer::Render");
+  if (!valid_) {
+    out += "\x1b[2J";
+    std::fill(shown_.begin(), shown_.end(), uint8_t{0});
+    valid_ = true;
+  }
+
+  for (size_t row{}; row < rows_; ++row) {
+    for (size_t column{}; column < columns_; ++column) {
+      const uint8_t pattern{GetPattern(frame, row, column)};
+      uint8_t& shown{shown_[row * columns_ + column]};
+      if (pattern == shown) {
+        continue;
+      }
+      MoveTo(row, column, out);
+      AppendCell(pattern, out);
+      shown = pattern;
+      cursor_known_ = column + 1 < columns_;
+      cursor_row_ = row;
+      cursor_column_ = column + 1;
+    }
+  }
+}
+
+void TerminalRenderer::Invalidate() noexcept {
+  valid_ = false;
+  cursor_known_ = false;
+}
+
+size_t TerminalRenderer::GetRows() const noexcept { return rows_; }
+
+size_t TerminalRenderer::GetColumns() const noexcept { return columns_; }
+
+uint8_t TerminalRenderer::GetPattern(const core::Framebuffer& frame,
+                                     size_t row,
+                                     size_t column) const noexcept {
+  if (cells_ == TerminalCells::kHalfBlock) {
+    return static_cast<uint8_t>(((frame[row * 2] >> column) & 1u) |
+                                (((frame[row * 2 + 1] >> column) & 1u) << 1));
+  }
+  uint8_t pattern{};
+  for (size_t y{}; y < kBrailleDots.size(); ++y) {
+    const uint64_t pixels{frame[row * 4 + y] >> (column * 2)};
+    if (pixels & 1u) {
+      pattern |= kBrailleDots[y][0];
+    }
+    if (pixels & 2u) {
+      pattern |= kBrailleDots[y][1];
+    }
+  }
+  return pattern;
+}
+
+void TerminalRenderer::AppendCell(uint8_t pattern, std::string& out) const {
+  if (cells_ == TerminalCells::kHalfBlock) {
+    out += kHalfBlocks[pattern & 3u];
+  } else if (pattern == 0) {
+    // A blank braille pattern is wider than a space in some fonts.
+    out += ' ';
+  } else {
+    // U+2800 + pattern, always three bytes in UTF-8.
+    out += '\xE2';
+    out += static_cast<char>(0xA0 | (pattern >> 6));
+    out += static_cast<char>(0x80 | (pattern & 0x3F));
+  }
+}
+
+size_t TerminalRenderer::GetCellSize(uint8_t pattern) const noexcept {
+  return pattern == 0 ? 1 : 3;
+}
+
+void TerminalRenderer::MoveTo(size_t row, size_t column, std::string& out) {
+  if (cursor_known_ && cursor_row_ == row && cursor_column_ == column) {
+    return;
+  }
+
+  // Absolute position works from anywhere: ESC [ row ; column H.
+  const size_t absolute_row{origin_row_ + row};
+  const size_t absolute_column{origin_column_ + column};
+  size_t best_size{4 + CountDigits(absolute_row) +
+                   CountDigits(absolute_column)};
+  enum class Move { kAbsolute, kForward, kRewrite, kNextLine } best{
+      Move::kAbsolute};
+
+  if (cursor_known_ && cursor_row_ == row && cursor_column_ < column) {
+    // ESC [ n C, or the unchanged cells in between written again.
+    const size_t gap{column - cursor_column_};
+    const size_t forward_size{3 + CountDigits(gap)};
+    size_t rewrite_size{};
+    for (size_t i{cursor_column_}; i < column; ++i) {
+      rewrite_size += GetCellSize(shown_[row * columns_ + i]);
+    }
+    if (forward_size < best_size) {
+      best = Move::kForward;
+      best_size = forward_size;
+    }
+    if (rewrite_size < best_size) {
+      best = Move::kRewrite;
+      best_size = rewrite_size;
+    }
+  } else if (cursor_known_ && cursor_row_ + 1 == row) {
+    // CR LF, then forward to the column.
+    const size_t offset{absolute_column - 1};
+    const size_t next_line_size{2 + (offset == 0 ? 0 : 3 + CountDigits(offset))};
+    if (next_line_size < best_size) {
+      best = Move::kNextLine;
+      best_size = next_line_size;
+    }
+  }
+
+  switch (best) {
+    case Move::kAbsolute:
+      out += "\x1b[";
+      out += std::to_string(absolute_row);
+      out += ';';
+      out += std::to_string(absolute_column);
+      out += 'H';
+      break;
+    case Move::kForward:
+      out += "\x1b[";
+      out += std::to_string(column - cursor_column_);
+      out += 'C';
+      break;
+    case Move::kRewrite:
+      for (size_t i{cursor_column_}; i < column; ++i) {
+        AppendCell(shown_[row * columns_ + i], out);
+      }
+      break;
+    case Move::kNextLine:
+      out += "\r\n";
+      if (absolute_column > 1) {
+        out += "\x1b[";
+        out += std::to_string(absolute_column - 1);
+        out += 'C';
+      }
+      break;
+  }
+}
+
+}  // namespace chip8::video
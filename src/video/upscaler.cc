@@ -0,0 +1,297 @@
+#include <chip8/video/upscaler.h>
+
+#include <chip8/utils/logger.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define CHIP8_VIDEO_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(CHIP8_VIDEO_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CHIP8_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CHIP8_TARGET_AVX2
+#endif
+
+namespace chip8::video {
+namespace {
+
+/// <summary>
+/// Precomputed patterns of a pixel pair, span_size bytes each.
+/// </summary>
+struct RowSpans {
+  /// <summary>
+  /// Scaled pairs: pairs[i] has its first pixel lit if bit 0 of i is set and
+  /// its second pixel lit if bit 1 is set.
+  /// </summary>
+  const uint8_t* const* pairs;
+
+  /// <summary>
+  /// Bytes of lit pixels XORed with bytes of unlit ones.
+  /// </summary>
+  const uint8_t* diff;
+
+  /// <summary>
+  /// 0xFF over bytes of the first pixel of a pair, 0 over the second one.
+  /// </summary>
+  const uint8_t* first;
+
+  size_t span_size;
+};
+
+/// <summary>
+/// Writes one output line of a scaled row, a pair of pixels at a time.
+/// </summary>
+using RowKernel = void (*)(uint64_t row, const RowSpans& spans,
+                           uint8_t* out) noexcept;
+
+void ScaleRowScalar(uint64_t row, const RowSpans& spans,
+                    uint8_t* out) noexcept {
+  for (size_t x{}; x < 64; x += 2) {
+    std::memcpy(out, spans.pairs[(row >> x) & 3u], spans.span_size);
+    out += spans.span_size;
+  }
+}
+
+#ifdef CHIP8_VIDEO_X86
+
+// SIMD kernels build every span from the row bits instead of copying one:
+// both bits of a pair are broadcast into byte masks, the first pixel mask
+// selects which of them covers each byte, and lit bytes are flipped from the
+// unlit pattern with diff, unlit ^ (diff & lit).
+
+void ScaleRowSse2(uint64_t row, const RowSpans& spans,
+                  uint8_t* out) noexcept {
+  const __m128i* unlit{reinterpret_cast<const __m128i*>(spans.pairs[0])};
+  const __m128i* diff{reinterpret_cast<const __m128i*>(spans.diff)};
+  const __m128i* first{reinterpret_cast<const __m128i*>(spans.first)};
+  const size_t vectors{spans.span_size / sizeof(__m128i)};
+  for (size_t x{}; x < 64; x += 2) {
+    const __m128i lit_first{
+        _mm_set1_epi8(static_cast<char>(0 - ((row >> x) & 1u)))};
+    const __m128i lit_second{
+        _mm_set1_epi8(static_cast<char>(0 - ((row >> (x + 1)) & 1u)))};
+    __m128i* line{reinterpret_cast<__m128i*>(out)};
+    for (size_t i{}; i < vectors; ++i) {
+      const __m128i mask{_mm_loadu_si128(first + i)};
+      const __m128i lit{_mm_or_si128(_mm_and_si128(mask, lit_first),
+                                     _mm_andnot_si128(mask, lit_second))};
+      _mm_storeu_si128(
+          line + i,
+          _mm_xor_si128(_mm_loadu_si128(unlit + i),
+                        _mm_and_si128(_mm_loadu_si128(diff + i), lit)));
+    }
+    out += spans.span_size;
+  }
+}
+
+CHIP8_TARGET_AVX2 void ScaleRowAvx2(uint64_t row, const RowSpans& spans,
+                                    uint8_t* out) noexcept {
+  const __m256i* unlit{reinterpret_cast<const __m256i*>(spans.pairs[0])};
+  const __m256i* diff{reinterpret_cast<const __m256i*>(spans.diff)};
+  const __m256i* first{reinterpret_cast<const __m256i*>(spans.first)};
+  const size_t vectors{spans.span_size / sizeof(__m256i)};
+  for (size_t x{}; x < 64; x += 2) {
+    const __m256i lit_first{
+        _mm256_set1_epi8(static_cast<char>(0 - ((row >> x) & 1u)))};
+    const __m256i lit_second{
+        _mm256_set1_epi8(static_cast<char>(0 - ((row >> (x + 1)) & 1u)))};
+    __m256i* line{reinterpret_cast<__m256i*>(out)};
+    for (size_t i{}; i < vectors; ++i) {
+      const __m256i lit{_mm256_blendv_epi8(
+          lit_second, lit_first, _mm256_loadu_si256(first + i))};
+      _mm256_storeu_si256(
+          line + i,
+          _mm256_xor_si256(
+              _mm256_loadu_si256(unlit + i),
+              _mm256_and_si256(_mm256_loadu_si256(diff + i), lit)));
+    }
+    out += spans.span_size;
+  }
+}
+
+bool CpuSupportsAvx2() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+  int info[4]{};
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+  __cpuid(info, 1);
+  const bool os_saves_avx{(info[2] & (1 << 27)) != 0 &&
+                          (info[2] & (1 << 28)) != 0 &&
+                          (_xgetbv(0) & 0x6u) == 0x6u};
+  __cpuidex(info, 7, 0);
+  return os_saves_avx && (info[1] & (1 << 5)) != 0;
+#else
+  return false;
+#endif
+}
+
+#endif
+
+/// <summary>
+/// Returns vector width required by a kernel.
+/// </summary>
+size_t GetVectorSize(Kernel kernel) noexcept {
+  switch (kernel) {
+    case Kernel::kSse2:
+      return 16;
+    case Kernel::kAvx2:
+      return 32;
+    case Kernel::kScalar:
+      break;
+  }
+  return 1;
+}
+
+/// <summary>
+/// Writes a single pixel of given color.
+/// </summary>
+void WritePixel(PixelFormat format, uint32_t argb, uint8_t* out) noexcept {
+  const uint8_t red{static_cast<uint8_t>(argb >> 16u)};
+  const uint8_t green{static_cast<uint8_t>(argb >> 8u)};
+  const uint8_t blue{static_cast<uint8_t>(argb)};
+  switch (format) {
+    case PixelFormat::kArgb8888:
+      std::memcpy(out, &argb, sizeof(argb));
+      break;
+    case PixelFormat::kRgb24:
+      out[0] = red;
+      out[1] = green;
+      out[2] = blue;
+      break;
+    case PixelFormat::kY8:
+      // ITU-R BT.601 luma
+      out[0] = static_cast<uint8_t>((299u * red + 587u * green + 114u * blue +
+                                     500u) /
+                                    1000u);
+      break;
+  }
+}
+
+}  // namespace
+
+size_t GetBytesPerPixel(PixelFormat format) noexcept {
+  switch (format) {
+    case PixelFormat::kArgb8888:
+      return 4;
+    case PixelFormat::kRgb24:
+      return 3;
+    case PixelFormat::kY8:
+      break;
+  }
+  return 1;
+}
+
+bool IsKernelSupported(Kernel kernel) noexcept {
+  switch (kernel) {
+    case Kernel::kScalar:
+      return true;
+#ifdef CHIP8_VIDEO_X86
+    case Kernel::kSse2:
+      return true;
+    case Kernel::kAvx2:
+      return CpuSupportsAvx2();
+#endif
+    default:
+      return false;
+  }
+}
+
+Upscaler::Upscaler(PixelFormat format, size_t scale, Palette palette)
+    : format_(format),
+      scale_(std::max<size_t>(scale, 1)),
+      bytes_per_pixel_(GetBytesPerPixel(format)),
+      kernel_(Kernel::kScalar),
+      spans_(),
+      diff_(),
+      first_() {
+  const size_t span_size{2 * scale_ * bytes_per_pixel_};
+  const uint32_t colors[2]{palette.off, palette.on};
+  for (size_t pair{}; pair < spans_.size(); ++pair) {
+    spans_[pair].resize(span_size);
+    for (size_t i{}; i < 2 * scale_; ++i) {
+      WritePixel(format_, colors[(pair >> (i / scale_)) & 1u],
+                 spans_[pair].data() + i * bytes_per_pixel_);
+    }
+  }
+  diff_.resize(span_size);
+  first_.resize(span_size);
+  for (size_t i{}; i < span_size; ++i) {
+    diff_[i] = spans_[0][i] ^ spans_[3][i];
+    first_[i] = i < span_size / 2 ? 0xFF : 0x00;
+  }
+
+  if (!SetKernel(Kernel::kAvx2)) {
+    SetKernel(Kernel::kSse2);
+  }
+  LOG_DEBUG("Upscaler created ({}x{}, kernel {}).", GetWidth(), GetHeight(),
+            static_cast<int>(kernel_));
+}
+
+bool Upscaler::SetKernel(Kernel kernel) noexcept {
+  if (!IsKernelSupported(kernel) ||
+      spans_[0].size() % GetVectorSize(kernel) != 0) {
+    return false;
+  }
+  kernel_ = kernel;
+  return true;
+}
+
+Kernel Upscaler::GetKernel() const noexcept { return kernel_; }
+
+size_t Upscaler::GetWidth() const noexcept { return 64 * scale_; }
+
+size_t Upscaler::GetHeight() const noexcept { return 32 * scale_; }
+
+size_t Upscaler::GetPitch() const noexcept {
+  return GetWidth() * bytes_per_pixel_;
+}
+
+size_t Upscaler::GetFrameSize() const noexcept {
+  return GetPitch() * GetHeight();
+}
+
+bool Upscaler::Scale(const core::Framebuffer& framebuffer,
+                     std::span<uint8_t> out) const noexcept {
+  if (out.size() < GetFrameSize()) {
+    LOG_ERROR("Upscaler output too small ({}/{} bytes)", out.size(),
+              GetFrameSize());
+    return false;
+  }
+
+  RowKernel scale_row{&ScaleRowScalar};
+#ifdef CHIP8_VIDEO_X86
+  if (kernel_ == Kernel::kSse2) {
+    scale_row = &ScaleRowSse2;
+  } else if (kernel_ == Kernel::kAvx2) {
+    scale_row = &ScaleRowAvx2;
+  }
+#endif
+
+  const uint8_t* const pairs[4]{spans_[0].data(), spans_[1].data(),
+                                 spans_[2].data(), spans_[3].data()};
+  const RowSpans spans{pairs, diff_.data(), first_.data(), spans_[0].size()};
+  const size_t pitch{GetPitch()};
+  uint8_t* line{out.data()};
+  for (uint64_t row : framebuffer) {
+    scale_row(row, spans, line);
+    for (size_t copy{1}; copy < scale_; ++copy) {
+      std::memcpy(line + copy * pitch, line, pitch);
+    }
+    line += pitch * scale_;
+  }
+  return true;
+}
+
+}  // namespace chip8::video
@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/capi/libchip8.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Draws random font digits and counts frames in V5.
+const std::vector<uint8_t> kDrawProgram{
+    0xC0, 0x3F,  // 0x200: RND V0, 0x3F
+    0xC1, 0x1F,  // 0x202: RND V1, 0x1F
+    0xC2, 0x0F,  // 0x204: RND V2, 0x0F
+    0xF2, 0x29,  // 0x206: LD F, V2
+    0xD0, 0x15,  // 0x208: DRW V0, V1, 5
+    0x75, 0x01,  // 0x20A: ADD V5, 1
+    0x12, 0x00,  // 0x20C: JP 0x200
+};
+
+}  // namespace
+
+TEST_CASE("C interface runs ROMs from memory", "[capi]") {
+  REQUIRE(chip8_abi_version() == CHIP8_ABI_VERSION);
+
+  chip8_instance* instance{chip8_create()};
+  REQUIRE(instance != nullptr);
+  chip8_seed(instance, 5);
+  REQUIRE(chip8_load_rom(instance, kDrawProgram.data(), kDrawProgram.size()) ==
+          CHIP8_OK);
+  REQUIRE(std::equal(kDrawProgram.begin(), kDrawProgram.end(),
+                     chip8_memory(instance) + 0x200));
+
+  const uint8_t* framebuffer{chip8_framebuffer(instance)};
+  REQUIRE(framebuffer != nullptr);
+  REQUIRE(std::all_of(framebuffer,
+                      framebuffer + CHIP8_FRAMEBUFFER_WIDTH *
+                                        CHIP8_FRAMEBUFFER_HEIGHT,
+                      [](uint8_t pixel) { return pixel == 0; }));
+
+  REQUIRE(chip8_run_frames(instance, 10, 14) == 140);
+  REQUIRE(chip8_framebuffer(instance) == framebuffer);
+  REQUIRE(std::any_of(framebuffer,
+                      framebuffer + CHIP8_FRAMEBUFFER_WIDTH *
+                                        CHIP8_FRAMEBUFFER_HEIGHT,
+                      [](uint8_t pixel) { return pixel == 1; }));
+
+  chip8_run_cycles(instance, 7);
+  REQUIRE(chip8_program_counter(instance) == 0x200);
+
+  chip8_reset(instance);
+  REQUIRE(chip8_framebuffer(instance) == framebuffer);
+  REQUIRE(framebuffer[0] == 0);
+  REQUIRE(chip8_program_counter(instance) == 0x200);
+
+  chip8_destroy(instance);
+}
+
+TEST_CASE("C interface snapshots restore state", "[capi]") {
+  chip8_instance* instance{chip8_create()};
+  REQUIRE(chip8_load_rom(instance, kDrawProgram.data(), kDrawProgram.size()) ==
+          CHIP8_OK);
+  chip8_set_keys(instance, 0x0102);
+  chip8_run_frames(instance, 5, 9);
+
+  chip8_snapshot* snapshot{chip8_snapshot_create(instance)};
+  REQUIRE(snapshot != nullptr);
+
+  const uint8_t* framebuffer{chip8_framebuffer(instance)};
+  chip8_run_frames(instance, 20, 9);
+  std::vector<uint8_t> expected(framebuffer,
+                                framebuffer + CHIP8_FRAMEBUFFER_WIDTH *
+                                                  CHIP8_FRAMEBUFFER_HEIGHT);
+  const std::vector<uint8_t> expected_memory(
+      chip8_memory(instance), chip8_memory(instance) + CHIP8_MEMORY_SIZE);
+
+  REQUIRE(chip8_snapshot_restore(instance, snapshot) == CHIP8_OK);
+  REQUIRE(chip8_framebuffer(instance) == framebuffer);
+  chip8_run_frames(instance, 20, 9);
+  REQUIRE(std::equal(expected.begin(), expected.end(), framebuffer));
+  REQUIRE(std::equal(expected_memory.begin(), expected_memory.end(),
+                     chip8_memory(instance)));
+
+  chip8_snapshot_destroy(snapshot);
+  chip8_destroy(instance);
+}
+
+TEST_CASE("C interface stops a halted cpu until reset", "[capi]") {
+  // Returns with an empty stack, then would run font data from 0x000.
+  const std::vector<uint8_t> program{
+      0x70, 0x01,  // 0x200: ADD V0, 1
+      0x00, 0xEE,  // 0x202: RET
+  };
+  chip8_instance* instance{chip8_create()};
+  REQUIRE(chip8_load_rom(instance, program.data(), program.size()) ==
+          CHIP8_OK);
+  REQUIRE(chip8_get_error(instance) == CHIP8_CPU_OK);
+
+  chip8_run_cycles(instance, 10);
+  REQUIRE(chip8_get_error(instance) == CHIP8_CPU_STACK_UNDERFLOW);
+  REQUIRE(chip8_program_counter(instance) == 0x000);
+  chip8_run_cycles(instance, 10);
+  REQUIRE(chip8_program_counter(instance) == 0x000);
+  REQUIRE(chip8_run_frames(instance, 5, 10) == 0);
+  REQUIRE(chip8_program_counter(instance) == 0x000);
+
+  chip8_reset(instance);
+  REQUIRE(chip8_get_error(instance) == CHIP8_CPU_OK);
+  REQUIRE(chip8_load_rom(instance, program.data(), program.size()) ==
+          CHIP8_OK);
+  chip8_run_cycles(instance, 1);
+  REQUIRE(chip8_program_counter(instance) == 0x202);
+  chip8_destroy(instance);
+}
+
+TEST_CASE("C interface rejects invalid arguments", "[capi]") {
+  REQUIRE(chip8_get_error(nullptr) == CHIP8_CPU_OK);
+  REQUIRE(chip8_load_rom(nullptr, kDrawProgram.data(), kDrawProgram.size()) ==
+          CHIP8_ERROR_INVALID_ARGUMENT);
+  REQUIRE(chip8_framebuffer(nullptr) == nullptr);
+  REQUIRE(chip8_snapshot_create(nullptr) == nullptr);
+  REQUIRE(chip8_run_frames(nullptr, 1, 1) == 0);
+
+  chip8_instance* instance{chip8_create()};
+  REQUIRE(chip8_load_rom(instance, nullptr, 4) == CHIP8_ERROR_INVALID_ARGUMENT);
+  REQUIRE(chip8_load_rom(instance, kDrawProgram.data(), 0) ==
+          CHIP8_ERROR_INVALID_ROM);
+  const std::vector<uint8_t> too_large(CHIP8_MEMORY_SIZE);
+  REQUIRE(chip8_load_rom(instance, too_large.data(), too_large.size()) ==
+          CHIP8_ERROR_INVALID_ROM);
+  REQUIRE(chip8_snapshot_restore(instance, nullptr) ==
+          CHIP8_ERROR_INVALID_ARGUMENT);
+  chip8_destroy(instance);
+}
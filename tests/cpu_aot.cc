@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/aot/aot_compiler.h>
+#include <chip8/aot/aot_plugin.h>
+
+#include <test_utils.h>
+
+#include <fstream>
+#include <iterator>
+
+using chip8::aot::AotCompiler;
+using chip8::core::Cpu;
+
+TEST_CASE("AOT compiler emits a function per block", "[aot]") {
+  const std::vector<uint8_t> program{
+      0x60, 0x00,  // 0x200: LD V0, 0
+      0x70, 0x01,  // 0x202: ADD V0, 1
+      0x30, 0x10,  // 0x204: SE V0, 0x10
+      0x12, 0x02,  // 0x206: JP 0x202
+      0x12, 0x08,  // 0x208: JP 0x208
+  };
+
+  AotCompiler compiler(program);
+  const std::string source{compiler.Generate()};
+
+  REQUIRE(compiler.GetBlockCount() == 4);
+  REQUIRE(source.find("Block_200") != std::string::npos);
+  REQUIRE(source.find("Block_202") != std::string::npos);
+  REQUIRE(source.find("Block_206") != std::string::npos);
+  REQUIRE(source.find("Block_208") != std::string::npos);
+  REQUIRE(source.find(chip8::aot::kEntryPoint) != std::string::npos);
+}
+
+TEST_CASE("Compiled blocks leave unknown opcodes to the interpreter",
+          "[aot]") {
+  const std::vector<uint8_t> program{
+      0x60, 0x01,  // 0x200: LD V0, 1
+      0x81, 0x28,  // 0x202: DW 0x8128
+      0x12, 0x00,  // 0x204: JP 0x200
+  };
+
+  AotCompiler compiler(program);
+  const std::string source{compiler.Generate()};
+
+  // Exits before the unknown opcode, counting only LD V0, 1
+  REQUIRE(source.find("  CHIP8_EXIT(0x202, 0x6001, 1);") != std::string::npos);
+}
+
+#ifdef CHIP8_TEST_AOT_PLUGIN
+
+TEST_CASE("Compiled blocks match the interpreter", "[aot]") {
+  const std::unique_ptr<chip8::aot::AotPlugin> plugin{
+      chip8::aot::AotPlugin::Load(CHIP8_TEST_AOT_PLUGIN)};
+  REQUIRE(plugin != nullptr);
+
+  std::ifstream in_stream(CHIP8_TEST_AOT_ROM, std::ios::binary);
+  const std::vector<uint8_t> rom{std::istreambuf_iterator<char>(in_stream),
+                                 std::istreambuf_iterator<char>()};
+  REQUIRE(!rom.empty());
+
+  for (size_t cycles_per_frame : {1, 3, 7, 16}) {
+    Cpu reference;
+    reference.SetFusion(false);
+    reference.SetIdleSkipping(false);
+    REQUIRE(chip8::tests::LoadProgram(reference, rom));
+
+    Cpu compiled;
+    REQUIRE(chip8::tests::LoadProgram(compiled, rom));
+    compiled.AttachAotModule(plugin->GetModule());
+
+    for (size_t frame{}; frame < 150; ++frame) {
+      reference.RunFrame(cycles_per_frame);
+      compiled.RunFrame(cycles_per_frame);
+      chip8::tests::RequireSameState(reference, compiled);
+    }
+    REQUIRE(compiled.GetAotInstructionCount() > 0);
+    compiled.AttachAotModule(nullptr);
+  }
+}
+
+TEST_CASE("Compiled blocks are skipped for a different ROM", "[aot]") {
+  const std::unique_ptr<chip8::aot::AotPlugin> plugin{
+      chip8::aot::AotPlugin::Load(CHIP8_TEST_AOT_PLUGIN)};
+  REQUIRE(plugin != nullptr);
+
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {0x70, 0x01, 0x12, 0x00}));
+  cpu.AttachAotModule(plugin->GetModule());
+  for (size_t frame{}; frame < 10; ++frame) {
+    cpu.RunFrame(10);
+  }
+  cpu.AttachAotModule(nullptr);
+
+  REQUIRE(cpu.GetAotInstructionCount() == 0);
+  REQUIRE(cpu.GetRegisters()[0] == 50);
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <test_utils.h>
+
+using chip8::core::Cpu;
+
+namespace {
+
+// Draws a sprite in a loop, then loads registers from memory and halts.
+const std::vector<uint8_t> kDrawLoopProgram{
+    0x60, 0x00,  // 0x200: LD V0, 0
+    0x61, 0x01,  // 0x202: LD V1, 1
+    0xA2, 0x20,  // 0x204: LD I, 0x220
+    0xD0, 0x15,  // 0x206: DRW V0, V1, 5
+    0x70, 0x08,  // 0x208: ADD V0, 8
+    0x30, 0x40,  // 0x20A: SE V0, 0x40
+    0x12, 0x04,  // 0x20C: JP 0x204
+    0xA2, 0x30,  // 0x20E: LD I, 0x230
+    0xF2, 0x65,  // 0x210: LD V2, [I]
+    0x32, 0x03,  // 0x212: SE V2, 3
+    0x12, 0x14,  // 0x214: JP 0x214
+    0x12, 0x16,  // 0x216: JP 0x216
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x218
+    0xF0, 0x90, 0xF0, 0x90, 0xF0, 0x00, 0x00, 0x00,  // 0x220: sprite
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x228
+    0x01, 0x02, 0x03,                                // 0x230: data
+};
+
+// Overwrites the second half of an already executed ANNN + FX65 pair with
+// LD VA, 0x55 and runs it again.
+const std::vector<uint8_t> kSelfModifyingProgram{
+    0xA2, 0x30,  // 0x200: LD I, 0x230
+    0xF1, 0x65,  // 0x202: LD V1, [I]
+    0x3B, 0x01,  // 0x204: SE VB, 1
+    0x12, 0x0A,  // 0x206: JP 0x20A
+    0x12, 0x08,  // 0x208: JP 0x208
+    0x6B, 0x01,  // 0x20A: LD VB, 1
+    0xA2, 0x02,  // 0x20C: LD I, 0x202
+    0xF1, 0x55,  // 0x20E: LD [I], V1
+    0x12, 0x00,  // 0x210: JP 0x200
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x212
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x21A
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x222
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,              // 0x22A
+    0x6A, 0x55,                                      // 0x230: data
+};
+
+// Jumps into the middle of an ANNN + DXYN pair before executing it whole.
+const std::vector<uint8_t> kMiddleJumpProgram{
+    0x12, 0x04,  // 0x200: JP 0x204
+    0xA0, 0x55,  // 0x202: LD I, 0x055
+    0xD0, 0x05,  // 0x204: DRW V0, V0, 5
+    0x3E, 0x01,  // 0x206: SE VE, 1
+    0x12, 0x0C,  // 0x208: JP 0x20C
+    0x12, 0x0A,  // 0x20A: JP 0x20A
+    0x6E, 0x01,  // 0x20C: LD VE, 1
+    0x12, 0x02,  // 0x20E: JP 0x202
+};
+
+/// <summary>
+/// Runs program with and without superinstructions and compares the state
+/// after every frame. Returns amount of fused instructions.
+/// </summary>
+uint64_t RunAgainstReference(const std::vector<uint8_t>& program,
+                             size_t cycles_per_frame) {
+  Cpu reference;
+  Cpu fused;
+  reference.SetFusion(false);
+  reference.SetIdleSkipping(false);
+  fused.SetIdleSkipping(false);
+  REQUIRE(chip8::tests::LoadProgram(reference, program));
+  REQUIRE(chip8::tests::LoadProgram(fused, program));
+
+  for (size_t frame{}; frame < 20; ++frame) {
+    reference.RunFrame(cycles_per_frame);
+    fused.RunFrame(cycles_per_frame);
+    chip8::tests::RequireSameState(reference, fused);
+  }
+  return fused.GetFusedInstructionCount();
+}
+
+}  // namespace
+
+TEST_CASE("Superinstructions give the same state as interpreting",
+          "[cpu][fusion]") {
+  for (size_t cycles_per_frame{1}; cycles_per_frame <= 12; ++cycles_per_frame) {
+    const uint64_t fused{RunAgainstReference(kDrawLoopProgram, cycles_per_frame)};
+    if (cycles_per_frame > 1) {
+      REQUIRE(fused > 0);
+    } else {
+      REQUIRE(fused == 0);
+    }
+  }
+}
+
+TEST_CASE("Overwritten superinstruction is decoded again", "[cpu][fusion]") {
+  for (size_t cycles_per_frame{1}; cycles_per_frame <= 12; ++cycles_per_frame) {
+    RunAgainstReference(kSelfModifyingProgram, cycles_per_frame);
+  }
+
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kSelfModifyingProgram));
+  cpu.RunFrame(50);
+  REQUIRE(cpu.GetRegisters().at(0xA) == 0x55);
+  REQUIRE(cpu.GetProgramCounter() == 0x208);
+}
+
+TEST_CASE("Jump into the middle of a superinstruction", "[cpu][fusion]") {
+  for (size_t cycles_per_frame{1}; cycles_per_frame <= 12; ++cycles_per_frame) {
+    RunAgainstReference(kMiddleJumpProgram, cycles_per_frame);
+  }
+}
+
+TEST_CASE("Fused instruction count is reset by loading a ROM",
+          "[cpu][fusion]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kDrawLoopProgram));
+  cpu.RunFrame(100);
+  REQUIRE(cpu.GetFusedInstructionCount() > 0);
+
+  REQUIRE(chip8::tests::LoadProgram(cpu, kDrawLoopProgram));
+  REQUIRE(cpu.GetFusedInstructionCount() == 0);
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <test_utils.h>
+
+using chip8::core::Cpu;
+using chip8::core::IdleState;
+
+namespace {
+
+// V0 = 5, DT = V0, then poll DT until it reaches zero and halt.
+const std::vector<uint8_t> kTimerWaitProgram{
+    0x60, 0x05,  // 0x200: LD V0, 5
+    0xF0, 0x15,  // 0x202: LD DT, V0
+    0xF1, 0x07,  // 0x204: LD V1, DT
+    0x31, 0x00,  // 0x206: SE V1, 0
+    0x12, 0x04,  // 0x208: JP 0x204
+    0x72, 0x01,  // 0x20A: ADD V2, 1
+    0x12, 0x0C,  // 0x20C: JP 0x20C
+};
+
+}  // namespace
+
+TEST_CASE("Jump to self is detected and skipped", "[cpu][idle]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {0x12, 0x00}));
+
+  REQUIRE(cpu.GetIdleState() == IdleState::kJumpToSelf);
+  REQUIRE(cpu.RunFrame(100) == 0);
+  REQUIRE(cpu.GetProgramCounter() == 0x200);
+  REQUIRE(cpu.GetOpcode() == 0x1200);
+}
+
+TEST_CASE("Key wait is skipped until a key is pressed", "[cpu][idle]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {0xF3, 0x0A, 0x12, 0x02}));
+
+  REQUIRE(cpu.GetIdleState() == IdleState::kKeyWait);
+  REQUIRE(cpu.RunFrame(10) == 0);
+  REQUIRE(cpu.GetProgramCounter() == 0x200);
+
+  cpu.SetKey(0xB, true);
+  REQUIRE(cpu.GetIdleState() == IdleState::kNone);
+  cpu.RunFrame(1);
+  REQUIRE(cpu.GetRegisters().at(3) == 0xB);
+  REQUIRE(cpu.GetProgramCounter() == 0x202);
+}
+
+TEST_CASE("Delay timer polling loop is detected", "[cpu][idle]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kTimerWaitProgram));
+
+  cpu.RunFrame(2);
+  REQUIRE(cpu.GetDelayTimer() == 4);
+  REQUIRE(cpu.GetProgramCounter() == 0x204);
+  REQUIRE(cpu.GetIdleState() == IdleState::kTimerWait);
+}
+
+TEST_CASE("Idle skipping gives the same state as interpreting",
+          "[cpu][idle]") {
+  for (size_t cycles_per_frame{1}; cycles_per_frame <= 20; ++cycles_per_frame) {
+    Cpu reference;
+    Cpu skipping;
+    reference.SetIdleSkipping(false);
+    REQUIRE(chip8::tests::LoadProgram(reference, kTimerWaitProgram));
+    REQUIRE(chip8::tests::LoadProgram(skipping, kTimerWaitProgram));
+
+    size_t interpreted{};
+    for (size_t frame{}; frame < 30; ++frame) {
+      REQUIRE(reference.RunFrame(cycles_per_frame) == cycles_per_frame);
+      interpreted += skipping.RunFrame(cycles_per_frame);
+      chip8::tests::RequireSameState(reference, skipping);
+    }
+
+    REQUIRE(skipping.GetRegisters().at(2) == 1);
+    if (cycles_per_frame > 6) {
+      REQUIRE(interpreted < cycles_per_frame * 30);
+    }
+  }
+}
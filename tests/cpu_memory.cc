@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <test_utils.h>
+
+using chip8::core::Cpu;
+
+namespace {
+
+/// <summary>
+/// Executes given amount of single cycles.
+/// </summary>
+void RunCycles(Cpu& cpu, size_t cycles) {
+  for (size_t i{}; i < cycles; ++i) {
+    cpu.Cycle();
+  }
+}
+
+}  // namespace
+
+TEST_CASE("FX55 and FX65 wrap around the end of memory", "[memory]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {
+                                             0xAF, 0xFE,  // LD I, 0xFFE
+                                             0x60, 0x11,  // LD V0, 0x11
+                                             0x61, 0x22,  // LD V1, 0x22
+                                             0x62, 0x33,  // LD V2, 0x33
+                                             0xF2, 0x55,  // LD [I], V2
+                                             0x60, 0x00,  // LD V0, 0
+                                             0x61, 0x00,  // LD V1, 0
+                                             0x62, 0x00,  // LD V2, 0
+                                             0xAF, 0xFE,  // LD I, 0xFFE
+                                             0xF2, 0x65,  // LD V2, [I]
+                                         }));
+
+  RunCycles(cpu, 5);
+  REQUIRE(cpu.GetMemory()[0xFFE] == 0x11);
+  REQUIRE(cpu.GetMemory()[0xFFF] == 0x22);
+  REQUIRE(cpu.GetMemory()[0x000] == 0x33);
+  REQUIRE(cpu.GetIndexRegister() == 0x1001);
+
+  RunCycles(cpu, 5);
+  REQUIRE(cpu.GetRegisters()[0] == 0x11);
+  REQUIRE(cpu.GetRegisters()[1] == 0x22);
+  REQUIRE(cpu.GetRegisters()[2] == 0x33);
+}
+
+TEST_CASE("FX33 wraps around the end of memory", "[memory]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {
+                                             0xAF, 0xFF,  // LD I, 0xFFF
+                                             0x60, 0x7B,  // LD V0, 123
+                                             0xF0, 0x33,  // LD B, V0
+                                         }));
+
+  RunCycles(cpu, 3);
+  REQUIRE(cpu.GetMemory()[0xFFF] == 1);
+  REQUIRE(cpu.GetMemory()[0x000] == 2);
+  REQUIRE(cpu.GetMemory()[0x001] == 3);
+}
+
+TEST_CASE("DXYN reads sprites across the end of memory", "[memory]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {
+                                             0xAF, 0xFF,  // LD I, 0xFFF
+                                             0x60, 0xAA,  // LD V0, 0xAA
+                                             0x61, 0xF0,  // LD V1, 0xF0
+                                             0xF1, 0x55,  // LD [I], V1
+                                             0xAF, 0xFF,  // LD I, 0xFFF
+                                             0x60, 0x00,  // LD V0, 0
+                                             0xD0, 0x02,  // DRW V0, V0, 2
+                                         }));
+
+  RunCycles(cpu, 7);
+
+  const auto& pixels{cpu.GetPixels()};
+  for (size_t x{}; x < 8; ++x) {
+    REQUIRE(pixels[x] == (x % 2 == 0));
+    REQUIRE(pixels[64 + x] == (x < 4));
+  }
+}
+
+TEST_CASE("Instruction fetch wraps around the end of memory", "[memory]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {
+                                             0xA0, 0x00,  // LD I, 0x000
+                                             0x60, 0x6A,  // LD V0, 0x6A
+                                             0x61, 0x42,  // LD V1, 0x42
+                                             0xF1, 0x55,  // LD [I], V1
+                                             0x1F, 0xFE,  // JP 0xFFE
+                                         }));
+
+  // 0xFFE holds 0x0000, then LD VA, 0x42 is fetched from 0x000.
+  RunCycles(cpu, 7);
+  REQUIRE(cpu.GetOpcode() == 0x6A42);
+  REQUIRE(cpu.GetRegisters()[0xA] == 0x42);
+  REQUIRE(cpu.GetProgramCounter() == 0x1002);
+}
@@ -2,4 +2,211 @@
 
 #include <catch2/catch_test_macros.hpp>
 
-TEST_CASE("Opcode 00E0: CLS", "[opcodes]") { REQUIRE(1L == 1L); }
\ No newline at end of file
+#include <chip8/core/machine.h>
+#include <test_utils.h>
+
+#include <array>
+#include <vector>
+
+using chip8::core::CritErrors;
+using chip8::core::MachineState;
+
+namespace {
+
+/// <summary>
+/// Executes a single opcode as if it was fetched from program counter.
+/// </summary>
+constexpr MachineState Execute(MachineState state, uint16_t opcode) {
+  chip8::core::StaticPolicy policy;
+  state.opcode = opcode;
+  state.program_counter += 2;
+  chip8::core::ExecuteOpcode(state, policy);
+  return state;
+}
+
+/// <summary>
+/// Returns power-on state with given registers set.
+/// </summary>
+constexpr MachineState WithRegisters(uint8_t vx, uint8_t vy = 0,
+                                     uint8_t v0 = 0) {
+  MachineState state;
+  state.registers[0] = v0;
+  state.registers[1] = vx;
+  state.registers[2] = vy;
+  return state;
+}
+
+// Counts V0 up to 10, draws the sprite of its last digit and halts.
+constexpr std::array<uint8_t, 14> kBootRom{
+    0x60, 0x00,  // 0x200: LD V0, 0
+    0x70, 0x01,  // 0x202: ADD V0, 1
+    0x30, 0x0A,  // 0x204: SE V0, 10
+    0x12, 0x02,  // 0x206: JP 0x202
+    0xF0, 0x29,  // 0x208: LD F, V0
+    0xD1, 0x25,  // 0x20A: DRW V1, V2, 5
+    0x12, 0x0C,  // 0x20C: JP 0x20C
+};
+
+constexpr MachineState kBooted{chip8::core::Boot(kBootRom, 2, 50)};
+
+}  // namespace
+
+// Opcodes are checked at compile time, a failure stops the build.
+static_assert(Execute(MachineState{}, 0x1345).program_counter == 0x345);
+static_assert(Execute(WithRegisters(7), 0x3107).program_counter == 0x204);
+static_assert(Execute(WithRegisters(7), 0x3108).program_counter == 0x202);
+static_assert(Execute(WithRegisters(7), 0x4108).program_counter == 0x204);
+static_assert(Execute(WithRegisters(7, 7), 0x5120).program_counter == 0x204);
+static_assert(Execute(WithRegisters(7, 8), 0x9120).program_counter == 0x204);
+static_assert(Execute(MachineState{}, 0x61AB).registers[1] == 0xAB);
+static_assert(Execute(WithRegisters(0xFF), 0x7102).registers[1] == 0x01);
+static_assert(Execute(WithRegisters(0xFF), 0x7102).registers[0xF] == 0);
+static_assert(Execute(WithRegisters(0x0F, 0xF0), 0x8121).registers[1] == 0xFF);
+static_assert(Execute(WithRegisters(0x0F, 0xF0), 0x8121).registers[0xF] == 0);
+static_assert(Execute(WithRegisters(0x3C, 0x0F), 0x8122).registers[1] == 0x0C);
+static_assert(Execute(WithRegisters(0x3C, 0x0F), 0x8123).registers[1] == 0x33);
+static_assert(Execute(WithRegisters(0xF0, 0x20), 0x8124).registers[1] == 0x10);
+static_assert(Execute(WithRegisters(0xF0, 0x20), 0x8124).registers[0xF] == 1);
+static_assert(Execute(WithRegisters(0x20, 0x30), 0x8125).registers[1] == 0xF0);
+static_assert(Execute(WithRegisters(0x20, 0x30), 0x8125).registers[0xF] == 0);
+static_assert(Execute(WithRegisters(0x20, 0x30), 0x8127).registers[1] == 0x10);
+static_assert(Execute(WithRegisters(0x20, 0x30), 0x8127).registers[0xF] == 1);
+static_assert(Execute(WithRegisters(0x81, 0x02), 0x8126).registers[1] == 0x40);
+static_assert(Execute(WithRegisters(0x81, 0x02), 0x8126).registers[0xF] == 1);
+static_assert(Execute(WithRegisters(0x81, 0x02), 0x812E).registers[1] == 0x02);
+static_assert(Execute(WithRegisters(0x81, 0x02), 0x812E).registers[0xF] == 1);
+static_assert(Execute(MachineState{}, 0xA123).index_register == 0x123);
+static_assert(Execute(WithRegisters(0, 0, 4), 0xB300).program_counter == 0x304);
+static_assert(Execute(WithRegisters(0xB), 0xF129).index_register == 0x50 + 55);
+
+TEST_CASE("Opcode 00E0: CLS", "[opcodes]") { REQUIRE(1L == 1L); }
+
+TEST_CASE("Stack opcodes nest calls and halt on errors", "[opcodes]") {
+  constexpr MachineState kCalled{Execute(MachineState{}, 0x2400)};
+  static_assert(kCalled.program_counter == 0x400);
+  static_assert(kCalled.stack_pointer == 1 && kCalled.stack[0] == 0x202);
+  static_assert(Execute(kCalled, 0x00EE).program_counter == 0x202);
+  static_assert(Execute(kCalled, 0x00EE).stack_pointer == 0);
+
+  constexpr MachineState kUnderflow{Execute(MachineState{}, 0x00EE)};
+  static_assert(kUnderflow.critical_error == CritErrors::kStackUnderflow);
+  static_assert(kUnderflow.program_counter == 0);
+
+  constexpr MachineState kOverflow{[] {
+    MachineState state;
+    for (size_t i{}; i <= state.stack.size(); ++i) {
+      state = Execute(state, 0x2200);
+    }
+    return state;
+  }()};
+  static_assert(kOverflow.critical_error == CritErrors::kStackOverflow);
+  static_assert(kOverflow.stack_pointer == 16);
+}
+
+TEST_CASE("Memory opcodes store, load and advance I", "[opcodes]") {
+  constexpr MachineState kBcd{[] {
+    MachineState state{WithRegisters(254)};
+    state.index_register = 0x300;
+    return Execute(state, 0xF133);
+  }()};
+  static_assert(kBcd.memory[0x300] == 2 && kBcd.memory[0x301] == 5 &&
+                kBcd.memory[0x302] == 4);
+  static_assert(kBcd.index_register == 0x300);
+
+  constexpr MachineState kStored{[] {
+    MachineState state{WithRegisters(0x11, 0x22, 0x33)};
+    state.index_register = 0x300;
+    return Execute(state, 0xF255);
+  }()};
+  static_assert(kStored.memory[0x300] == 0x33);
+  static_assert(kStored.memory[0x301] == 0x11);
+  static_assert(kStored.memory[0x302] == 0x22);
+  static_assert(kStored.index_register == 0x303);
+
+  constexpr MachineState kLoaded{[](MachineState state) {
+    state.registers = {};
+    state.index_register = 0x300;
+    return Execute(state, 0xF165);
+  }(kStored)};
+  static_assert(kLoaded.registers[0] == 0x33);
+  static_assert(kLoaded.registers[1] == 0x11 && kLoaded.registers[2] == 0);
+  static_assert(kLoaded.index_register == 0x302);
+
+  constexpr MachineState kOverflowed{[] {
+    MachineState state{WithRegisters(2)};
+    state.index_register = 0xFFF;
+    return Execute(state, 0xF11E);
+  }()};
+  static_assert(kOverflowed.index_register == 0x1001);
+  static_assert(kOverflowed.registers[0xF] == 1);
+}
+
+TEST_CASE("DXYN draws wrapping sprites and reports collisions",
+          "[opcodes]") {
+  // Font sprite of 0 at the bottom right corner wraps to the other edges
+  constexpr MachineState kDrawn{[] {
+    MachineState state{WithRegisters(62, 30)};
+    state.index_register = 0x50;
+    return Execute(state, 0xD125);
+  }()};
+  static_assert(kDrawn.screen[30 * 64 + 62] && kDrawn.screen[30 * 64 + 1]);
+  static_assert(kDrawn.screen[62] && !kDrawn.screen[63] && kDrawn.screen[1]);
+  static_assert(kDrawn.registers[0xF] == 0);
+
+  constexpr MachineState kErased{Execute(kDrawn, 0xD125)};
+  static_assert(kErased.registers[0xF] == 1);
+  static_assert(kErased.screen == MachineState{}.screen);
+  static_assert(Execute(kDrawn, 0x00E0).screen == MachineState{}.screen);
+}
+
+TEST_CASE("Key opcodes check the key numbered by X", "[opcodes]") {
+  constexpr MachineState kHeld{[] {
+    MachineState state{WithRegisters(0)};
+    state.keys[1] = 1;
+    state.keys[5] = 1;
+    return state;
+  }()};
+  static_assert(Execute(kHeld, 0xE19E).program_counter == 0x204);
+  static_assert(Execute(kHeld, 0xE29E).program_counter == 0x202);
+  static_assert(Execute(kHeld, 0xE2A1).program_counter == 0x204);
+  static_assert(Execute(kHeld, 0xF30A).registers[3] == 5);
+  static_assert(Execute(kHeld, 0xF30A).program_counter == 0x202);
+  static_assert(Execute(MachineState{}, 0xF30A).program_counter == 0x200);
+}
+
+TEST_CASE("Unknown opcodes only notify the policy", "[opcodes]") {
+  constexpr uint64_t kUnknown{[] {
+    chip8::core::StaticPolicy policy;
+    MachineState state;
+    for (const uint16_t opcode : {0x0123, 0x8128, 0x8129, 0xE1FF, 0xF1FF}) {
+      state.opcode = opcode;
+      chip8::core::ExecuteOpcode(state, policy);
+    }
+    return policy.unknown_opcodes;
+  }()};
+  static_assert(kUnknown == 5);
+}
+
+TEST_CASE("ROMs boot at compile time like on the cpu", "[opcodes][boot]") {
+  static_assert(kBooted.registers[0] == 10);
+  static_assert(kBooted.index_register == 0x50 + 50);
+  static_assert(kBooted.program_counter == 0x20C);
+  static_assert(kBooted.screen[0] && kBooted.screen[3] && !kBooted.screen[4]);
+  static_assert(kBooted.delay_timer == 0 && kBooted.registers[0xF] == 0);
+
+  chip8::core::Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(
+      cpu, std::vector<uint8_t>(kBootRom.begin(), kBootRom.end())));
+  cpu.RunFrame(50);
+  cpu.RunFrame(50);
+  REQUIRE(cpu.GetState() == kBooted);
+
+  chip8::core::Cpu restored;
+  restored.SetState(kBooted);
+  chip8::tests::RequireSameState(restored, cpu);
+  for (int frame{}; frame < 10; ++frame) {
+    cpu.RunFrame(50);
+    restored.RunFrame(50);
+  }
+  chip8::tests::RequireSameState(restored, cpu);
+}
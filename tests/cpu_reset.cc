@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/core/cpu_pool.h>
+
+#include <test_utils.h>
+
+#include <type_traits>
+
+using chip8::core::Cpu;
+using chip8::core::CpuPool;
+using chip8::core::RomImage;
+
+namespace {
+
+// Draws a random sprite, stores random bytes and calls a subroutine.
+const std::vector<uint8_t> kRandomProgram{
+    0xC0, 0xFF,  // 0x200: RND V0, 0xFF
+    0xC1, 0x1F,  // 0x202: RND V1, 0x1F
+    0xF0, 0x29,  // 0x204: LD F, V0
+    0xD0, 0x15,  // 0x206: DRW V0, V1, 5
+    0xA3, 0x00,  // 0x208: LD I, 0x300
+    0xF1, 0x55,  // 0x20A: LD [I], V1
+    0x22, 0x10,  // 0x20C: CALL 0x210
+    0x12, 0x00,  // 0x20E: JP 0x200
+    0x6A, 0x3C,  // 0x210: LD VA, 60
+    0xFA, 0x15,  // 0x212: LD DT, VA
+    0x00, 0xEE,  // 0x214: RET
+};
+
+}  // namespace
+
+TEST_CASE("Cpu is copyable", "[reset]") {
+  STATIC_REQUIRE(std::is_copy_constructible_v<Cpu>);
+  STATIC_REQUIRE(std::is_copy_assignable_v<Cpu>);
+}
+
+TEST_CASE("Reset restores power-on state", "[reset]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kRandomProgram));
+  cpu.SetFusion(false);
+  cpu.SetKey(0x3, true);
+  for (size_t frame{}; frame < 20; ++frame) {
+    cpu.RunFrame(9);
+  }
+
+  cpu.Reset();
+
+  const Cpu fresh;
+  chip8::tests::RequireSameState(cpu, fresh);
+  REQUIRE(cpu.GetFusedInstructionCount() == 0);
+}
+
+TEST_CASE("Stack errors halt the cpu until reset", "[reset]") {
+  Cpu cpu;
+  SECTION("Overflow") {
+    REQUIRE(chip8::tests::LoadProgram(cpu, {0x22, 0x00}));  // CALL 0x200
+    cpu.RunFrame(100);
+    REQUIRE(cpu.GetCriticalError() == chip8::core::CritErrors::kStackOverflow);
+    REQUIRE(cpu.GetStackPointer() == cpu.GetStack().size());
+  }
+  SECTION("Underflow") {
+    REQUIRE(chip8::tests::LoadProgram(cpu, {0x00, 0xEE}));  // RET
+    cpu.RunFrame(100);
+    REQUIRE(cpu.GetCriticalError() ==
+            chip8::core::CritErrors::kStackUnderflow);
+    REQUIRE(cpu.GetStackPointer() == 0);
+  }
+
+  const uint16_t program_counter{cpu.GetProgramCounter()};
+  REQUIRE(cpu.Step(10) == 0);
+  cpu.RunFrame(10);
+  REQUIRE(cpu.GetProgramCounter() == program_counter);
+
+  cpu.Reset();
+  REQUIRE(cpu.GetCriticalError() == chip8::core::CritErrors::kNone);
+}
+
+TEST_CASE("ROM image loads the same memory as a file", "[reset]") {
+  const std::optional<RomImage> image{RomImage::FromBytes(kRandomProgram)};
+  REQUIRE(image.has_value());
+
+  Cpu from_file;
+  REQUIRE(chip8::tests::LoadProgram(from_file, kRandomProgram));
+  Cpu from_image;
+  from_image.LoadROM(*image);
+
+  chip8::tests::RequireSameState(from_file, from_image);
+}
+
+TEST_CASE("ROM image rejects invalid ROMs", "[reset]") {
+  REQUIRE_FALSE(RomImage::FromBytes({}).has_value());
+  REQUIRE_FALSE(
+      RomImage::FromBytes(std::vector<uint8_t>(4096 - 0x200 + 1)).has_value());
+  REQUIRE(RomImage::FromBytes(std::vector<uint8_t>(4096 - 0x200)).has_value());
+  REQUIRE_FALSE(RomImage::Load("missing_rom.ch8").has_value());
+
+  // Files are sized before reading, whole or not at all
+  Cpu cpu;
+  REQUIRE_FALSE(
+      chip8::tests::LoadProgram(cpu, std::vector<uint8_t>(1 << 20, 0x12)));
+  REQUIRE_FALSE(chip8::tests::LoadProgram(cpu, {}));
+  REQUIRE(chip8::tests::LoadProgram(cpu, std::vector<uint8_t>(4096 - 0x200)));
+}
+
+TEST_CASE("Seeded cpus are reproducible", "[reset]") {
+  const std::optional<RomImage> image{RomImage::FromBytes(kRandomProgram)};
+  REQUIRE(image.has_value());
+
+  Cpu first;
+  first.SeedRNG(1234);
+  first.LoadROM(*image);
+
+  Cpu second;
+  second.LoadROM(*image);
+  for (size_t frame{}; frame < 5; ++frame) {
+    second.RunFrame(7);
+  }
+  second.Reset();
+  second.SeedRNG(1234);
+  second.LoadROM(*image);
+
+  for (size_t frame{}; frame < 30; ++frame) {
+    first.RunFrame(7);
+    second.RunFrame(7);
+    chip8::tests::RequireSameState(first, second);
+  }
+}
+
+TEST_CASE("Pool reuses released cpus", "[reset]") {
+  CpuPool pool(1);
+  REQUIRE(pool.GetIdleCount() == 1);
+
+  const Cpu* reused{};
+  {
+    CpuPool::Handle cpu{pool.Acquire()};
+    REQUIRE(pool.GetIdleCount() == 0);
+    REQUIRE(chip8::tests::LoadProgram(*cpu, kRandomProgram));
+    cpu->RunFrame(10);
+    reused = cpu.get();
+  }
+  REQUIRE(pool.GetIdleCount() == 1);
+
+  CpuPool::Handle first{pool.Acquire()};
+  CpuPool::Handle second{pool.Acquire()};
+  REQUIRE(first.get() == reused);
+  REQUIRE(second.get() != reused);
+  chip8::tests::RequireSameState(*first, Cpu{});
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/debug/debugger.h>
+
+#include <test_utils.h>
+
+using chip8::core::Cpu;
+using chip8::debug::BreakCondition;
+using chip8::debug::Comparison;
+using chip8::debug::Debugger;
+using chip8::debug::Stop;
+using chip8::debug::StopReason;
+using chip8::debug::WatchKind;
+
+namespace {
+
+// Counts in V0, stores it through a subroutine and draws a digit.
+const std::vector<uint8_t> kProgram{
+    0x70, 0x01,  // 0x200: ADD V0, 1
+    0x22, 0x0A,  // 0x202: CALL 0x20A
+    0xF0, 0x29,  // 0x204: LD F, V0
+    0xD1, 0x15,  // 0x206: DRW V1, V1, 5
+    0x12, 0x00,  // 0x208: JP 0x200
+    0xA3, 0x00,  // 0x20A: LD I, 0x300
+    0xF0, 0x55,  // 0x20C: LD [I], V0
+    0x00, 0xEE,  // 0x20E: RET
+};
+
+}  // namespace
+
+TEST_CASE("Unarmed debugger runs frames like the cpu", "[debugger]") {
+  Cpu reference;
+  REQUIRE(chip8::tests::LoadProgram(reference, kProgram));
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kProgram));
+  Debugger debugger(cpu, 7);
+
+  REQUIRE_FALSE(debugger.IsArmed());
+  REQUIRE(debugger.RunFrames(30).reason == StopReason::kDone);
+  for (size_t frame{}; frame < 30; ++frame) {
+    reference.RunFrame(7);
+  }
+  chip8::tests::RequireSameState(cpu, reference);
+  REQUIRE(debugger.GetFrameCount() == 30);
+}
+
+TEST_CASE("Armed debugger keeps frame timing", "[debugger]") {
+  Cpu reference;
+  REQUIRE(chip8::tests::LoadProgram(reference, kProgram));
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kProgram));
+  Debugger debugger(cpu, 7);
+  // Never hit, but forces instruction by instruction execution.
+  debugger.AddBreakpoint(0x400);
+  debugger.AddWatchpoint(0x500, 4, WatchKind::kReadWrite);
+
+  REQUIRE(debugger.RunFrames(30).reason == StopReason::kDone);
+  for (size_t frame{}; frame < 30; ++frame) {
+    reference.RunFrame(7);
+  }
+  chip8::tests::RequireSameState(cpu, reference);
+}
+
+TEST_CASE("Breakpoints stop before the instruction", "[debugger]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kProgram));
+  Debugger debugger(cpu, 10);
+  debugger.AddBreakpoint(0x206);
+
+  Stop stop{debugger.RunFrames(10)};
+  REQUIRE(stop.reason == StopReason::kBreakpoint);
+  REQUIRE(stop.address == 0x206);
+  REQUIRE(cpu.GetProgramCounter() == 0x206);
+  REQUIRE(cpu.GetRegisters()[0] == 1);
+
+  // Resuming executes the instruction instead of stopping again.
+  stop = debugger.RunFrames(10);
+  REQUIRE(stop.reason == StopReason::kBreakpoint);
+  REQUIRE(cpu.GetRegisters()[0] == 2);
+
+  debugger.RemoveBreakpoint(0x206);
+  REQUIRE_FALSE(debugger.IsArmed());
+  REQUIRE(debugger.RunFrames(1).reason == StopReason::kDone);
+}
+
+TEST_CASE("Conditional breakpoints check registers", "[debugger]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kProgram));
+  Debugger debugger(cpu, 10);
+  debugger.AddBreakpoint(0x202, BreakCondition{0, Comparison::kEqual, 5});
+  debugger.AddBreakpoint(0x202,
+                         BreakCondition{0, Comparison::kGreaterEqual, 9});
+
+  REQUIRE(debugger.RunFrames(100).reason == StopReason::kBreakpoint);
+  REQUIRE(cpu.GetRegisters()[0] == 5);
+  REQUIRE(debugger.RunFrames(100).reason == StopReason::kBreakpoint);
+  REQUIRE(cpu.GetRegisters()[0] == 9);
+  REQUIRE(debugger.RunFrames(100).reason == StopReason::kBreakpoint);
+  REQUIRE(cpu.GetRegisters()[0] == 10);
+}
+
+TEST_CASE("Watchpoints stop before memory accesses", "[debugger]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kProgram));
+  Debugger debugger(cpu, 10);
+
+  SECTION("Write") {
+    debugger.AddWatchpoint(0x300, 1, WatchKind::kWrite);
+    const Stop stop{debugger.RunFrames(10)};
+    REQUIRE(stop.reason == StopReason::kWatchWrite);
+    REQUIRE(stop.address == 0x300);
+    REQUIRE(cpu.GetProgramCounter() == 0x20C);
+    REQUIRE(cpu.GetMemory()[0x300] == 0);
+  }
+  SECTION("Read") {
+    // Font sprite of digit 1 drawn by DRW.
+    debugger.AddWatchpoint(chip8::core::kFontsetStartAddress + 5, 5,
+                           WatchKind::kRead);
+    const Stop stop{debugger.RunFrames(10)};
+    REQUIRE(stop.reason == StopReason::kWatchRead);
+    REQUIRE(stop.address == chip8::core::kFontsetStartAddress + 5);
+    REQUIRE(cpu.GetProgramCounter() == 0x206);
+  }
+  SECTION("Writes are not reads") {
+    debugger.AddWatchpoint(0x300, 1, WatchKind::kRead);
+    REQUIRE(debugger.RunFrames(10).reason == StopReason::kDone);
+  }
+}
+
+TEST_CASE("Step over and out follow the stack", "[debugger]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kProgram));
+  Debugger debugger(cpu, 10);
+
+  REQUIRE(debugger.StepInstruction().reason == StopReason::kDone);
+  REQUIRE(cpu.GetProgramCounter() == 0x202);
+
+  REQUIRE(debugger.StepOver().reason == StopReason::kDone);
+  REQUIRE(cpu.GetProgramCounter() == 0x204);
+  REQUIRE(cpu.GetStackPointer() == 0);
+  REQUIRE(cpu.GetMemory()[0x300] == 1);
+
+  REQUIRE(debugger.RunFrames(0).reason == StopReason::kDone);
+  debugger.StepInstruction();
+  debugger.StepInstruction();
+  debugger.StepInstruction();
+  debugger.StepInstruction();
+  debugger.StepInstruction();
+  REQUIRE(cpu.GetProgramCounter() == 0x20A);
+  REQUIRE(cpu.GetStackPointer() == 1);
+  REQUIRE(debugger.StepOut().reason == StopReason::kDone);
+  REQUIRE(cpu.GetProgramCounter() == 0x204);
+  REQUIRE(cpu.GetStackPointer() == 0);
+}
+
+TEST_CASE("Inspector formats registers and memory", "[debugger]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kProgram));
+  Debugger debugger(cpu, 10);
+
+  const std::string registers{debugger.FormatRegisters()};
+  REQUIRE(registers.find("PC 0200") != std::string::npos);
+  REQUIRE(registers.find("VF 00") != std::string::npos);
+  REQUIRE(registers.find("Next: 0200  7001") != std::string::npos);
+
+  REQUIRE(debugger.FormatMemory(0x200, 4) == "0200: 70 01 22 0A\n");
+  REQUIRE(debugger.FormatMemory(0xFFF, 2) == "0FFF: 00 00\n");
+}
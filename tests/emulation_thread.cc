@@ -0,0 +1,200 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/runtime/emulation_thread.h>
+#include <chip8/utils/histogram.h>
+#include <chip8/utils/spsc_queue.h>
+#include <chip8/utils/triple_buffer.h>
+
+#include <test_utils.h>
+
+#include <array>
+#include <chrono>
+#include <thread>
+
+using chip8::core::Cpu;
+using chip8::core::CycleRate;
+using chip8::runtime::EmulationThread;
+using chip8::utils::Histogram;
+using chip8::utils::SpscQueue;
+using chip8::utils::TripleBuffer;
+
+namespace {
+
+// Waits for a key, then counts in V0 while it is held.
+const std::vector<uint8_t> kKeyProgram{
+    0xF1, 0x0A,  // 0x200: LD V1, K
+    0x70, 0x01,  // 0x202: ADD V0, 1
+    0x12, 0x00,  // 0x204: JP 0x200
+};
+
+// Waits until the emulation thread publishes a frame matching predicate.
+template <typename Predicate>
+bool WaitForFrame(EmulationThread& emulation, Predicate predicate) {
+  const auto deadline{std::chrono::steady_clock::now() +
+                      std::chrono::seconds{5}};
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (emulation.Update() && predicate(emulation.GetFrame())) {
+      return true;
+    }
+    std::this_thread::yield();
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST_CASE("Triple buffer passes the latest value", "[triple_buffer]") {
+  TripleBuffer<int> buffer;
+  REQUIRE_FALSE(buffer.Update());
+
+  buffer.GetBack() = 1;
+  buffer.Publish();
+  buffer.GetBack() = 2;
+  buffer.Publish();
+  REQUIRE(buffer.Update());
+  REQUIRE(buffer.GetFront() == 2);
+  REQUIRE_FALSE(buffer.Update());
+  REQUIRE(buffer.GetFront() == 2);
+
+  buffer.GetBack() = 3;
+  buffer.Publish();
+  REQUIRE(buffer.Update());
+  REQUIRE(buffer.GetFront() == 3);
+}
+
+TEST_CASE("Triple buffer never tears values", "[triple_buffer]") {
+  TripleBuffer<std::array<uint32_t, 64>> buffer;
+  constexpr uint32_t kValues{100000};
+
+  std::thread writer([&buffer] {
+    for (uint32_t value{1}; value <= kValues; ++value) {
+      buffer.GetBack().fill(value);
+      buffer.Publish();
+    }
+  });
+
+  uint32_t last{};
+  bool torn{}, backwards{};
+  while (last != kValues) {
+    if (!buffer.Update()) {
+      continue;
+    }
+    const auto& value{buffer.GetFront()};
+    for (uint32_t element : value) {
+      torn |= element != value[0];
+    }
+    backwards |= value[0] <= last;
+    last = value[0];
+  }
+  writer.join();
+
+  REQUIRE_FALSE(torn);
+  REQUIRE_FALSE(backwards);
+}
+
+TEST_CASE("SPSC queue keeps order and capacity", "[spsc_queue]") {
+  SpscQueue<int, 4> queue;
+  REQUIRE_FALSE(queue.TryPop());
+  for (int i{}; i < 4; ++i) {
+    REQUIRE(queue.TryPush(i));
+  }
+  REQUIRE_FALSE(queue.TryPush(4));
+  REQUIRE(queue.TryPop() == 0);
+  REQUIRE(queue.TryPush(4));
+  for (int i{1}; i <= 4; ++i) {
+    REQUIRE(queue.TryPop() == i);
+  }
+  REQUIRE_FALSE(queue.TryPop());
+
+  SpscQueue<uint32_t, 64> shared;
+  constexpr uint32_t kValues{100000};
+  std::thread producer([&shared] {
+    for (uint32_t value{}; value < kValues;) {
+      value += shared.TryPush(value) ? 1 : 0;
+    }
+  });
+  bool ordered{true};
+  for (uint32_t expected{}; expected < kValues;) {
+    if (const auto value{shared.TryPop()}) {
+      ordered &= *value == expected++;
+    }
+  }
+  producer.join();
+  REQUIRE(ordered);
+}
+
+TEST_CASE("Histogram reports percentiles within bucket precision",
+          "[histogram]") {
+  Histogram histogram;
+  REQUIRE(histogram.GetPercentile(50).count() == 0);
+
+  for (int64_t value{1}; value <= 1000; ++value) {
+    histogram.Record(std::chrono::microseconds{value});
+  }
+  REQUIRE(histogram.GetCount() == 1000);
+  REQUIRE(histogram.GetMax() == std::chrono::microseconds{1000});
+  REQUIRE(histogram.GetMean() == std::chrono::nanoseconds{500500});
+
+  for (double percentile : {10.0, 50.0, 90.0, 99.0}) {
+    const double expected{percentile * 10'000.0};
+    const auto actual{
+        static_cast<double>(histogram.GetPercentile(percentile).count())};
+    REQUIRE(actual <= expected);
+    REQUIRE(actual >= expected * 0.875);
+  }
+  REQUIRE_FALSE(histogram.Summarize().empty());
+}
+
+TEST_CASE("Cycle rates carry the remainder across frames", "[emulation]") {
+  // 3 ms per cycle is 333.3 cycles per second, 5.56 per frame.
+  constexpr CycleRate kRate{CycleRate::FromCycleDelay(3, 60)};
+  static_assert(kRate.cycles == 50 && kRate.frames == 9);
+  static_assert(kRate.GetRoundedCycles() == 6);
+
+  size_t cycles{};
+  for (uint64_t frame{}; frame < 60 * 9; ++frame) {
+    const size_t frame_cycles{kRate.GetCycles(frame)};
+    REQUIRE((frame_cycles == 5 || frame_cycles == 6));
+    cycles += frame_cycles;
+  }
+  REQUIRE(cycles == 60 * 50);
+
+  // Slower than one cycle per frame, 1000 / 40 cycles per second.
+  constexpr CycleRate kSlow{CycleRate::FromCycleDelay(40, 60)};
+  cycles = 0;
+  for (uint64_t frame{}; frame < 120; ++frame) {
+    cycles += kSlow.GetCycles(frame);
+  }
+  REQUIRE(cycles == 50);
+  static_assert(CycleRate{10}.GetCycles(12345) == 10);
+}
+
+TEST_CASE("Emulation thread applies keys and publishes frames",
+          "[emulation_thread]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kKeyProgram));
+
+  std::atomic<uint64_t> published{};
+  EmulationThread emulation(cpu, CycleRate{10}, std::chrono::milliseconds{1},
+                            [&published] { ++published; });
+  emulation.Start();
+
+  // The cpu stalls in FX0A, so the thread publishes a frame and sleeps.
+  REQUIRE(WaitForFrame(emulation, [](const auto& frame) {
+    return frame.number == 1;
+  }));
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  REQUIRE(published == 1);
+
+  REQUIRE(emulation.PushKey(0x5, true));
+  REQUIRE(WaitForFrame(emulation, [](const auto& frame) {
+    return frame.number >= 3;
+  }));
+  REQUIRE(emulation.PushKey(0x5, false));
+  emulation.Stop();
+
+  REQUIRE(cpu.GetRegisters()[1] == 0x5);
+  REQUIRE(cpu.GetRegisters()[0] > 0);
+  REQUIRE(emulation.GetFrameTimes().GetCount() == published);
+  REQUIRE(emulation.GetDroppedKeyCount() == 0);
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/runtime/vector_environment.h>
+
+#include <test_utils.h>
+
+using chip8::core::RomImage;
+using chip8::runtime::Environment;
+using chip8::runtime::EnvironmentConfig;
+using chip8::runtime::Framebuffer;
+using chip8::runtime::StepResult;
+using chip8::runtime::VectorEnvironment;
+
+namespace {
+
+// Draws font digits at random positions.
+const std::vector<uint8_t> kRandomDrawProgram{
+    0xC0, 0x3F,  // 0x200: RND V0, 0x3F
+    0xC1, 0x1F,  // 0x202: RND V1, 0x1F
+    0xC2, 0x0F,  // 0x204: RND V2, 0x0F
+    0xF2, 0x29,  // 0x206: LD F, V2
+    0xD0, 0x15,  // 0x208: DRW V0, V1, 5
+    0x12, 0x00,  // 0x20A: JP 0x200
+};
+
+// Increments the byte at 0x300 while key 1 is held.
+const std::vector<uint8_t> kCounterProgram{
+    0x61, 0x01,  // 0x200: LD V1, 1
+    0xA3, 0x00,  // 0x202: LD I, 0x300
+    0xE1, 0x9E,  // 0x204: SKP V1
+    0x12, 0x00,  // 0x206: JP 0x200
+    0xF0, 0x65,  // 0x208: LD V0, [I]
+    0x70, 0x01,  // 0x20A: ADD V0, 1
+    0xA3, 0x00,  // 0x20C: LD I, 0x300
+    0xF0, 0x55,  // 0x20E: LD [I], V0
+    0x12, 0x00,  // 0x210: JP 0x200
+};
+
+std::shared_ptr<const RomImage> MakeRom(const std::vector<uint8_t>& program) {
+  std::optional<RomImage> image{RomImage::FromBytes(program)};
+  REQUIRE(image.has_value());
+  return std::make_shared<const RomImage>(std::move(*image));
+}
+
+EnvironmentConfig MakeCounterConfig() {
+  EnvironmentConfig config{};
+  config.cycles_per_frame = 8;
+  config.frame_skip = 2;
+  config.watched_addresses = {0x300};
+  config.reward = [](std::span<const uint8_t> before,
+                     std::span<const uint8_t> after) {
+    return static_cast<float>(after[0] - before[0]);
+  };
+  config.terminal = [](std::span<const uint8_t> values) {
+    return values[0] >= 10;
+  };
+  return config;
+}
+
+}  // namespace
+
+TEST_CASE("Observation is the packed screen", "[environment]") {
+  Environment environment(MakeRom(kRandomDrawProgram), EnvironmentConfig{});
+  environment.Reset(7);
+
+  for (size_t step{}; step < 10; ++step) {
+    environment.Step(0);
+    const Framebuffer& observation{environment.GetObservation()};
+    const auto& pixels{environment.GetCpu().GetPixels()};
+    for (size_t y{}; y < 32; ++y) {
+      for (size_t x{}; x < 64; ++x) {
+        REQUIRE(((observation[y] >> x) & 1u) == pixels[y * 64 + x]);
+      }
+    }
+  }
+}
+
+TEST_CASE("Episodes are reproducible from a seed", "[environment]") {
+  const std::shared_ptr<const RomImage> rom{MakeRom(kRandomDrawProgram)};
+  Environment first(rom, EnvironmentConfig{});
+  Environment second(rom, EnvironmentConfig{});
+
+  first.Reset(42);
+  second.Reset(1);
+  second.Step(0);
+  second.Reset(42);
+
+  for (size_t step{}; step < 20; ++step) {
+    first.Step(0);
+    second.Step(0);
+    REQUIRE(first.GetObservation() == second.GetObservation());
+  }
+  REQUIRE(first.GetEpisodeFrames() == 20 * EnvironmentConfig{}.frame_skip);
+}
+
+TEST_CASE("Reward and terminal hooks read watched memory", "[environment]") {
+  Environment environment(MakeRom(kCounterProgram), MakeCounterConfig());
+  environment.Reset(0);
+
+  REQUIRE(environment.Step(0).reward == 0.0f);
+
+  float total{};
+  StepResult result{};
+  for (size_t step{}; step < 100 && !result.terminated; ++step) {
+    result = environment.Step(1u << 1);
+    total += result.reward;
+  }
+  REQUIRE(result.terminated);
+  REQUIRE(total == static_cast<float>(environment.GetCpu().GetMemory()[0x300]));
+}
+
+TEST_CASE("Episodes are truncated", "[environment]") {
+  EnvironmentConfig config{};
+  config.frame_skip = 4;
+  config.max_episode_frames = 8;
+  Environment environment(MakeRom(kCounterProgram), config);
+  environment.Reset(0);
+
+  REQUIRE_FALSE(environment.Step(0).truncated);
+  REQUIRE(environment.Step(0).truncated);
+}
+
+TEST_CASE("Episodes end when the cpu halts", "[environment]") {
+  const std::vector<uint8_t> program{
+      0x12, 0x04,  // 0x200: JP 0x204
+      0x00, 0xEE,  // 0x202: RET
+      0xE1, 0x9E,  // 0x204: SKP V1
+      0x12, 0x04,  // 0x206: JP 0x204
+      0x12, 0x02,  // 0x208: JP 0x202
+  };
+  EnvironmentConfig config{};
+  config.frame_skip = 1;
+  Environment environment(MakeRom(program), config);
+  environment.Reset(0);
+
+  REQUIRE_FALSE(environment.Step(0).terminated);
+  const StepResult result{environment.Step(1u << 1)};
+  REQUIRE(result.terminated);
+  REQUIRE_FALSE(result.truncated);
+  REQUIRE(environment.GetCpu().GetCriticalError() ==
+          chip8::core::CritErrors::kStackUnderflow);
+}
+
+TEST_CASE("Vector environment matches single environments", "[environment]") {
+  const std::shared_ptr<const RomImage> rom{MakeRom(kRandomDrawProgram)};
+  VectorEnvironment batch(rom, EnvironmentConfig{}, 6, 3);
+  REQUIRE(batch.GetSize() == 6);
+  batch.Reset(100);
+
+  std::vector<std::unique_ptr<Environment>> singles;
+  for (size_t i{}; i < 6; ++i) {
+    singles.push_back(std::make_unique<Environment>(rom, EnvironmentConfig{}));
+    singles.back()->Reset(100 + static_cast<unsigned int>(i));
+  }
+
+  const std::vector<uint16_t> actions(6, 0);
+  for (size_t step{}; step < 15; ++step) {
+    batch.Step(actions);
+    for (size_t i{}; i < 6; ++i) {
+      singles[i]->Step(0);
+      REQUIRE(batch.GetObservations()[i] == singles[i]->GetObservation());
+    }
+  }
+}
+
+TEST_CASE("Vector environment resets finished episodes", "[environment]") {
+  VectorEnvironment batch(MakeRom(kCounterProgram), MakeCounterConfig(), 4,
+                          2);
+  batch.Reset(0);
+
+  const std::vector<uint16_t> actions{1u << 1, 0, 1u << 1, 0};
+  size_t episodes{};
+  for (size_t step{}; step < 50; ++step) {
+    const std::span<const StepResult> results{batch.Step(actions)};
+    REQUIRE_FALSE(results[1].terminated);
+    REQUIRE_FALSE(results[3].terminated);
+    if (results[0].terminated) {
+      ++episodes;
+      REQUIRE(batch.GetEnvironment(0).GetCpu().GetMemory()[0x300] >= 10);
+    }
+  }
+  REQUIRE(episodes >= 2);
+  REQUIRE(batch.GetEnvironment(0).GetEpisodeFrames() < 50 * 2);
+}
+
+TEST_CASE("Vector environment refuses partial batches", "[environment]") {
+  VectorEnvironment batch(MakeRom(kCounterProgram), MakeCounterConfig(), 4,
+                          2);
+  batch.Reset(0);
+
+  const std::vector<uint16_t> actions{1u << 1, 1u << 1};
+  REQUIRE(batch.Step(actions).empty());
+  REQUIRE(batch.GetEnvironment(0).GetEpisodeFrames() == 0);
+  REQUIRE(batch.Step(std::vector<uint16_t>(5)).empty());
+  REQUIRE(batch.Step(std::vector<uint16_t>(4)).size() == 4);
+}
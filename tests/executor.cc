@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/runtime/executor.h>
+
+#include <test_utils.h>
+
+using chip8::core::Cpu;
+using chip8::runtime::Executor;
+using chip8::runtime::SessionConfig;
+
+namespace {
+
+// Counts in V0 and polls the delay timer every 16 iterations.
+const std::vector<uint8_t> kCounterProgram{
+    0x70, 0x01,  // 0x200: ADD V0, 1
+    0x61, 0x0F,  // 0x202: LD V1, 0x0F
+    0x81, 0x02,  // 0x204: AND V1, V0
+    0x31, 0x00,  // 0x206: SE V1, 0
+    0x12, 0x00,  // 0x208: JP 0x200
+    0x62, 0x02,  // 0x20A: LD V2, 2
+    0xF2, 0x15,  // 0x20C: LD DT, V2
+    0xF3, 0x07,  // 0x20E: LD V3, DT
+    0x33, 0x00,  // 0x210: SE V3, 0
+    0x12, 0x0E,  // 0x212: JP 0x20E
+    0x12, 0x00,  // 0x214: JP 0x200
+};
+
+// Waits for a key, then counts in V0 while it is held.
+const std::vector<uint8_t> kKeyProgram{
+    0xF1, 0x0A,  // 0x200: LD V1, K
+    0x70, 0x01,  // 0x202: ADD V0, 1
+    0x12, 0x00,  // 0x204: JP 0x200
+};
+
+}  // namespace
+
+TEST_CASE("Sessions match frames run directly", "[executor]") {
+  Executor executor(false);
+  const Executor::Clock::time_point start{executor.Now()};
+
+  const size_t cycles[]{1, 7, 20};
+  Cpu cpus[3];
+  size_t callbacks{};
+  for (size_t i{}; i < 3; ++i) {
+    REQUIRE(chip8::tests::LoadProgram(cpus[i], kCounterProgram));
+    executor.Spawn(cpus[i], SessionConfig{cycles[i], 50,
+                                          [&callbacks](const Cpu&) {
+                                            ++callbacks;
+                                          }});
+  }
+  REQUIRE(executor.GetActiveCount() == 3);
+
+  executor.Run();
+
+  REQUIRE(executor.GetActiveCount() == 0);
+  REQUIRE(callbacks == 150);
+  REQUIRE(executor.Now() - start ==
+          50 * (std::chrono::duration_cast<Executor::Clock::duration>(
+                    std::chrono::seconds{1}) /
+                chip8::core::kTimerFrequency));
+
+  for (size_t i{}; i < 3; ++i) {
+    Cpu reference;
+    REQUIRE(chip8::tests::LoadProgram(reference, kCounterProgram));
+    for (size_t frame{}; frame < 50; ++frame) {
+      reference.RunFrame(cycles[i]);
+    }
+    chip8::tests::RequireSameState(reference, cpus[i]);
+
+    REQUIRE(executor.IsFinished(i));
+    REQUIRE(executor.GetStats(i).frames == 50);
+    REQUIRE(executor.GetStats(i).deadline_misses == 0);
+  }
+  REQUIRE(executor.GetStats(0).idle_frames == 0);
+  REQUIRE(executor.GetStats(2).idle_frames > 0);
+}
+
+TEST_CASE("Sessions blocked on a key are not resumed", "[executor]") {
+  Executor executor(false);
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kKeyProgram));
+  const size_t id{executor.Spawn(cpu, SessionConfig{10, 0, {}})};
+
+  executor.Run();
+  REQUIRE(executor.IsWaitingForKey(id));
+  REQUIRE(executor.GetStats(id).frames == 1);
+  REQUIRE(executor.GetStats(id).key_waits == 1);
+
+  executor.SetKey(id, 0x5, true);
+  REQUIRE_FALSE(executor.IsWaitingForKey(id));
+  executor.RunUntil(executor.Now());
+  REQUIRE(executor.GetStats(id).frames == 2);
+  REQUIRE(cpu.GetRegisters()[1] == 0x5);
+  REQUIRE(cpu.GetRegisters()[0] == 3);
+
+  executor.SetKey(id, 0x5, false);
+  executor.RunUntil(executor.Now() + std::chrono::seconds{1});
+  REQUIRE(executor.IsWaitingForKey(id));
+  REQUIRE(executor.GetStats(id).frames == 3);
+
+  executor.Stop(id);
+  executor.Run();
+  REQUIRE(executor.IsFinished(id));
+  REQUIRE(executor.GetActiveCount() == 0);
+}
+
+TEST_CASE("Sessions finish when the cpu halts", "[executor]") {
+  // Calls itself until the stack overflows.
+  const std::vector<uint8_t> program{
+      0x22, 0x00,  // 0x200: CALL 0x200
+  };
+  Executor executor(false);
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, program));
+  const size_t id{executor.Spawn(cpu, SessionConfig{10})};
+
+  executor.Run();
+
+  REQUIRE(executor.IsFinished(id));
+  REQUIRE(executor.GetActiveCount() == 0);
+  const chip8::runtime::SessionStats& stats{executor.GetStats(id)};
+  REQUIRE(stats.error == chip8::core::CritErrors::kStackOverflow);
+  REQUIRE(stats.frames == 2);
+  REQUIRE(stats.idle_frames == 1);
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/verify/lockstep.h>
+
+#include <test_utils.h>
+
+using chip8::core::Cpu;
+using chip8::verify::LockstepConfig;
+using chip8::verify::LockstepHarness;
+
+namespace {
+
+// Counts in V0, polls the delay timer and draws V0 as a digit while key 2
+// is held.
+const std::vector<uint8_t> kProgram{
+    0x70, 0x01,  // 0x200: ADD V0, 1
+    0x61, 0x0F,  // 0x202: LD V1, 0x0F
+    0x81, 0x02,  // 0x204: AND V1, V0
+    0x31, 0x00,  // 0x206: SE V1, 0
+    0x12, 0x00,  // 0x208: JP 0x200
+    0x62, 0x02,  // 0x20A: LD V2, 2
+    0xF2, 0x15,  // 0x20C: LD DT, V2
+    0xF3, 0x07,  // 0x20E: LD V3, DT
+    0x33, 0x00,  // 0x210: SE V3, 0
+    0x12, 0x0E,  // 0x212: JP 0x20E
+    0xE2, 0xA1,  // 0x214: SKNP V2
+    0xD0, 0x05,  // 0x216: DRW V0, V0, 5
+    0x12, 0x00,  // 0x218: JP 0x200
+};
+
+}  // namespace
+
+TEST_CASE("Fast paths run in lockstep with the interpreter", "[lockstep]") {
+  Cpu reference, candidate;
+  REQUIRE(chip8::tests::LoadProgram(reference, kProgram));
+  REQUIRE(chip8::tests::LoadProgram(candidate, kProgram));
+
+  LockstepConfig config;
+  config.frames = 300;
+  config.cycles_per_frame = 20;
+  config.keys = [](uint64_t frame) {
+    return static_cast<uint16_t>((frame / 10) % 2 == 0 ? 0x0004 : 0x0000);
+  };
+  LockstepHarness harness(reference, candidate, config);
+
+  const auto divergence{harness.Run()};
+  if (divergence) {
+    FAIL(divergence->Format());
+  }
+  REQUIRE(harness.GetStats().frames == 300);
+  REQUIRE(harness.GetStats().instructions == 300 * 20);
+  REQUIRE(harness.GetStats().steps < harness.GetStats().instructions);
+  REQUIRE(harness.GetStats().comparisons ==
+          harness.GetStats().steps + harness.GetStats().frames);
+  REQUIRE(candidate.GetFusedInstructionCount() > 0);
+  chip8::tests::RequireSameState(reference, candidate);
+}
+
+TEST_CASE("Comparison interval reduces comparisons", "[lockstep]") {
+  Cpu reference, candidate;
+  REQUIRE(chip8::tests::LoadProgram(reference, kProgram));
+  REQUIRE(chip8::tests::LoadProgram(candidate, kProgram));
+
+  LockstepConfig config;
+  config.frames = 100;
+  config.cycles_per_frame = 20;
+  config.compare_interval = 1000;
+  LockstepHarness harness(reference, candidate, config);
+
+  REQUIRE_FALSE(harness.Run());
+  REQUIRE(harness.GetStats().comparisons == 100);
+}
+
+TEST_CASE("First divergence is reported with a trace", "[lockstep]") {
+  std::vector<uint8_t> broken{kProgram};
+  broken[0x16] = 0xD1;  // DRW V1, V0, 5
+
+  Cpu reference, candidate;
+  REQUIRE(chip8::tests::LoadProgram(reference, kProgram));
+  REQUIRE(chip8::tests::LoadProgram(candidate, broken));
+
+  LockstepConfig config;
+  config.frames = 100;
+  config.compare_interval = 1000;
+  config.trace_window = 4;
+  config.keys = [](uint64_t) { return uint16_t{0x0004}; };
+  LockstepHarness harness(reference, candidate, config);
+
+  // Memory differs from the start, so the first comparison catches it.
+  const auto divergence{harness.Run()};
+  REQUIRE(divergence);
+  REQUIRE(divergence->frame == 0);
+  REQUIRE(divergence->field == "memory[0x216]");
+  REQUIRE(divergence->reference == "0xd0");
+  REQUIRE(divergence->candidate == "0xd1");
+  REQUIRE(divergence->trace.size() == 4);
+  REQUIRE(divergence->trace.back().instruction ==
+          divergence->instruction - 1);
+  REQUIRE(divergence->Format().find("divergence in frame 0") == 0);
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/runtime/emulation_thread.h>
+#include <chip8/runtime/emulator_metrics.h>
+#include <chip8/runtime/metrics_exporter.h>
+#include <chip8/utils/metrics.h>
+
+#include <test_utils.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using chip8::core::Cpu;
+using chip8::runtime::EmulationThread;
+using chip8::runtime::EmulatorMetrics;
+using chip8::runtime::MetricsExporter;
+using chip8::runtime::MetricsExporterConfig;
+using chip8::utils::MetricsRegistry;
+using std::chrono::microseconds;
+
+namespace {
+
+#if !defined(_WIN32)
+// Sends a GET request to the local endpoint and returns the whole response.
+std::string HttpGet(uint16_t port, const std::string& path) {
+  const int client{socket(AF_INET, SOCK_STREAM, 0)};
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  if (connect(client, reinterpret_cast<const sockaddr*>(&address),
+              sizeof(address)) != 0) {
+    close(client);
+    return {};
+  }
+  const std::string request{"GET " + path + " HTTP/1.1\r\nHost: x\r\n\r\n"};
+  send(client, request.data(), request.size(), 0);
+
+  std::string response;
+  char buffer[1024];
+  ssize_t received;
+  while ((received = recv(client, buffer, sizeof(buffer), 0)) > 0) {
+    response.append(buffer, static_cast<size_t>(received));
+  }
+  close(client);
+  return response;
+}
+#endif
+
+}  // namespace
+
+TEST_CASE("Metrics render in Prometheus format", "[metrics]") {
+  MetricsRegistry registry;
+  registry.AddCounter("test_total", "Test counter.").Add(3);
+  registry.AddGauge("test_depth", "Test gauge.").Set(1.5);
+  auto& histogram{registry.AddHistogram(
+      "test_seconds", "Test histogram.", {microseconds{10}, microseconds{100}})};
+  histogram.Record(microseconds{5});
+  histogram.Record(microseconds{10});
+  histogram.Record(microseconds{50});
+  histogram.Record(microseconds{500});
+
+  REQUIRE(registry.FormatPrometheus() ==
+          "# HELP test_total Test counter.\n"
+          "# TYPE test_total counter\n"
+          "test_total 3\n"
+          "# HELP test_depth Test gauge.\n"
+          "# TYPE test_depth gauge\n"
+          "test_depth 1.5\n"
+          "# HELP test_seconds Test histogram.\n"
+          "# TYPE test_seconds histogram\n"
+          "test_seconds_bucket{le=\"1e-05\"} 2\n"
+          "test_seconds_bucket{le=\"0.0001\"} 3\n"
+          "test_seconds_bucket{le=\"+Inf\"} 4\n"
+          "test_seconds_sum 0.000565\n"
+          "test_seconds_count 4\n");
+  REQUIRE(registry.FormatJson() ==
+          "{\"test_total\":3,\"test_depth\":1.5,\"test_seconds\":"
+          "{\"count\":4,\"sum\":0.000565,"
+          "\"buckets\":[[1e-05,2],[0.0001,3]]}}");
+}
+
+TEST_CASE("Emulation thread reports frame health", "[metrics]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {
+                                             0x80, 0x0F,  // unknown opcode
+                                             0x00, 0xEE,  // RET underflows
+                                         }));
+  MetricsRegistry registry;
+  EmulatorMetrics metrics(registry);
+  EmulationThread emulation(cpu, chip8::core::CycleRate{10},
+                            std::chrono::milliseconds{1});
+  emulation.SetMetrics(&metrics);
+  emulation.Start();
+
+  // A halted cpu stalls the thread after its first frame.
+  const auto deadline{std::chrono::steady_clock::now() +
+                      std::chrono::seconds{5}};
+  while (metrics.frames_emulated.Get() == 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  emulation.Stop();
+
+  REQUIRE(metrics.frames_emulated.Get() == 1);
+  REQUIRE(metrics.instructions.Get() == 2);
+  REQUIRE(metrics.unknown_opcodes.Get() == 1);
+  REQUIRE(metrics.critical_errors.Get() == 1);
+  REQUIRE(metrics.instructions_per_second.Get() == 0);
+  REQUIRE(registry.FormatPrometheus().find(
+              "chip8_frame_time_seconds_count 1\n") != std::string::npos);
+}
+
+TEST_CASE("Exporter writes JSON dumps", "[metrics]") {
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "chip8_test_metrics.json"};
+  std::filesystem::remove(path);
+
+  MetricsRegistry registry;
+  registry.AddCounter("test_total", "Test counter.").Add(7);
+  MetricsExporterConfig config;
+  config.json_path = path;
+  auto exporter{MetricsExporter::Start(registry, config)};
+  REQUIRE(exporter != nullptr);
+  REQUIRE(exporter->GetPort() == 0);
+  exporter->Stop();
+
+  std::ifstream in_stream(path);
+  const std::string dump{std::istreambuf_iterator<char>(in_stream),
+                         std::istreambuf_iterator<char>()};
+  REQUIRE(dump == "{\"test_total\":7}\n");
+  std::filesystem::remove(path);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Exporter serves metrics over HTTP", "[metrics]") {
+  MetricsRegistry registry;
+  registry.AddCounter("test_total", "Test counter.").Add(5);
+  MetricsExporterConfig config;
+  config.http_port = 0;
+  auto exporter{MetricsExporter::Start(registry, config)};
+  REQUIRE(exporter != nullptr);
+  REQUIRE(exporter->GetPort() != 0);
+
+  const std::string text{HttpGet(exporter->GetPort(), "/metrics")};
+  REQUIRE(text.starts_with("HTTP/1.1 200 OK\r\n"));
+  REQUIRE(text.ends_with("\r\n\r\n" + registry.FormatPrometheus()));
+
+  const std::string json{HttpGet(exporter->GetPort(), "/metrics.json")};
+  REQUIRE(json.ends_with("\r\n\r\n{\"test_total\":5}"));
+
+  REQUIRE(HttpGet(exporter->GetPort(), "/").starts_with(
+      "HTTP/1.1 404 Not Found\r\n"));
+}
+#endif
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/runtime/movie.h>
+
+#include <test_utils.h>
+
+#include <filesystem>
+#include <random>
+
+using chip8::core::Cpu;
+using chip8::core::RomImage;
+using chip8::runtime::MovieHeader;
+using chip8::runtime::MovieReader;
+using chip8::runtime::MovieWriter;
+
+namespace {
+
+// Adds random bytes to V0 while key 1 is held and counts frames in V2.
+const std::vector<uint8_t> kRandomProgram{
+    0x61, 0x01,  // 0x200: LD V1, 1
+    0xE1, 0xA1,  // 0x202: SKNP V1
+    0x12, 0x0A,  // 0x204: JP 0x20A
+    0x72, 0x01,  // 0x206: ADD V2, 1
+    0x12, 0x02,  // 0x208: JP 0x202
+    0xC3, 0xFF,  // 0x20A: RND V3, 0xFF
+    0x80, 0x34,  // 0x20C: ADD V0, V3
+    0x12, 0x02,  // 0x20E: JP 0x202
+};
+
+std::filesystem::path GetMoviePath() {
+  return std::filesystem::temp_directory_path() / "chip8_test_movie.c8m";
+}
+
+// Records a run with key 1 toggled at random frames.
+uint64_t RecordMovie(const RomImage& rom, size_t frames) {
+  MovieHeader header;
+  header.rom_hash = rom.GetHash();
+  header.seed = 1234;
+  header.cycles_per_frame = 7;
+
+  Cpu cpu;
+  cpu.SeedRNG(header.seed);
+  cpu.LoadROM(rom);
+  std::unique_ptr<MovieWriter> movie{
+      MovieWriter::Open(GetMoviePath(), header)};
+  REQUIRE(movie);
+  cpu.SetFrameCallback(
+      [&movie](const Cpu& frame) { movie->AddFrame(frame.GetKeyMask()); });
+
+  std::mt19937 gen(5);
+  for (size_t frame{}; frame < frames; ++frame) {
+    if (gen() % 50 == 0) {
+      cpu.SetKey(0x1, cpu.GetKeyMask() == 0);
+    }
+    cpu.RunFrame(header.cycles_per_frame);
+  }
+  REQUIRE(movie->GetFrameCount() == frames);
+  REQUIRE(movie->Close(cpu.GetStateHash()));
+  return cpu.GetStateHash();
+}
+
+}  // namespace
+
+TEST_CASE("Key masks set and return all keys", "[movie]") {
+  Cpu cpu;
+  cpu.SetKeyMask(0x8421);
+  REQUIRE(cpu.GetKeyMask() == 0x8421);
+  cpu.SetKey(0x1, true);
+  REQUIRE(cpu.GetKeyMask() == 0x8423);
+}
+
+TEST_CASE("Replaying a movie reproduces the recorded run", "[movie]") {
+  const std::optional<RomImage> rom{RomImage::FromBytes(kRandomProgram)};
+  REQUIRE(rom);
+  const uint64_t state_hash{RecordMovie(*rom, 3000)};
+
+  // Inputs change about every 50 frames, so the movie stays small.
+  REQUIRE(std::filesystem::file_size(GetMoviePath()) < 300);
+
+  std::unique_ptr<MovieReader> movie{MovieReader::Open(GetMoviePath())};
+  REQUIRE(movie);
+  REQUIRE(movie->GetHeader().seed == 1234);
+  REQUIRE(movie->GetHeader().cycles_per_frame == 7);
+
+  Cpu cpu;
+  cpu.SeedRNG(99);
+  size_t frames{};
+  const auto result{chip8::runtime::Replay(
+      *rom, *movie, cpu, [&frames](const Cpu&) { ++frames; })};
+  REQUIRE(result);
+  REQUIRE(result->frames == 3000);
+  REQUIRE(frames == 3000);
+  REQUIRE(result->complete);
+  REQUIRE(result->matched);
+  REQUIRE(result->state_hash == state_hash);
+  REQUIRE(cpu.GetRegisters()[0x2] > 0);
+
+  std::filesystem::remove(GetMoviePath());
+}
+
+TEST_CASE("Truncated movies replay up to the cut", "[movie]") {
+  const std::optional<RomImage> rom{RomImage::FromBytes(kRandomProgram)};
+  REQUIRE(rom);
+  RecordMovie(*rom, 3000);
+  std::filesystem::resize_file(GetMoviePath(),
+                               std::filesystem::file_size(GetMoviePath()) -
+                                   20);
+
+  std::unique_ptr<MovieReader> movie{MovieReader::Open(GetMoviePath())};
+  REQUIRE(movie);
+  Cpu cpu;
+  const auto result{chip8::runtime::Replay(*rom, *movie, cpu)};
+  REQUIRE(result);
+  REQUIRE(result->frames > 0);
+  REQUIRE(result->frames < 3000);
+  REQUIRE_FALSE(result->complete);
+  REQUIRE_FALSE(result->matched);
+
+  std::filesystem::remove(GetMoviePath());
+}
+
+TEST_CASE("Movies are rejected for another ROM", "[movie]") {
+  const std::optional<RomImage> rom{RomImage::FromBytes(kRandomProgram)};
+  REQUIRE(rom);
+  RecordMovie(*rom, 10);
+
+  std::vector<uint8_t> other_program{kRandomProgram};
+  other_program[1] = 0x02;
+  const std::optional<RomImage> other{RomImage::FromBytes(other_program)};
+  REQUIRE(other);
+
+  std::unique_ptr<MovieReader> movie{MovieReader::Open(GetMoviePath())};
+  REQUIRE(movie);
+  Cpu cpu;
+  REQUIRE_FALSE(chip8::runtime::Replay(*other, *movie, cpu));
+
+  std::filesystem::remove(GetMoviePath());
+}
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/utils/perf_counters.h>
+
+#include <cstdint>
+
+using chip8::utils::PerfCounters;
+using chip8::utils::PerfPhase;
+using chip8::utils::PerfSample;
+using chip8::utils::PerfScope;
+
+namespace {
+
+// Keeps the cpu busy for a measurable amount of instructions.
+uint64_t Spin(uint64_t iterations) {
+  volatile uint64_t sum{};
+  for (uint64_t i{}; i < iterations; ++i) {
+    sum = sum + i;
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST_CASE("Counter samples subtract and accumulate", "[perf]") {
+  PerfSample total{10, 20, 30, 4, 5};
+  total += PerfSample{1, 2, 3, 4, 5};
+  const PerfSample difference{total - PerfSample{1, 2, 3, 4, 5}};
+  REQUIRE(difference.cycles == 10);
+  REQUIRE(difference.instructions == 20);
+  REQUIRE(difference.branches == 30);
+  REQUIRE(difference.branch_misses == 4);
+  REQUIRE(difference.l1d_misses == 5);
+}
+
+TEST_CASE("Nested phases are counted exclusively", "[perf]") {
+  PerfCounters::Clear();
+  {
+    PerfScope dispatch{PerfPhase::kDispatch};
+    Spin(10000);
+    {
+      const PerfScope draw{PerfPhase::kDraw};
+      Spin(100000);
+    }
+    dispatch.SetUnits(100);
+  }
+
+  const auto totals{PerfCounters::GetTotals()};
+  const auto& dispatch{totals[static_cast<size_t>(PerfPhase::kDispatch)]};
+  const auto& draw{totals[static_cast<size_t>(PerfPhase::kDraw)]};
+  if (!PerfCounters::IsAvailable()) {
+    WARN("Hardware performance counters are not available");
+    REQUIRE(dispatch.units == 0);
+    REQUIRE(draw.units == 0);
+    return;
+  }
+
+  REQUIRE(dispatch.units == 100);
+  REQUIRE(draw.units == 1);
+  REQUIRE(dispatch.counters.instructions > 0);
+  // The inner loop is ten times longer and is not counted as dispatch.
+  REQUIRE(draw.counters.instructions > dispatch.counters.instructions);
+  REQUIRE(PerfCounters::Report().find("dispatch") != std::string::npos);
+  PerfCounters::Clear();
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/utils/profiler.h>
+
+#include <string>
+#include <thread>
+
+using chip8::utils::Profiler;
+using chip8::utils::ScopedZone;
+
+namespace {
+
+size_t CountOccurrences(const std::string& text, const std::string& part) {
+  size_t count{};
+  for (size_t position{text.find(part)}; position != std::string::npos;
+       position = text.find(part, position + part.size())) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST_CASE("Zones of every thread are exported", "[profiler]") {
+  Profiler::Clear();
+  {
+    const ScopedZone outer{"outer"};
+    const ScopedZone inner{"inner"};
+  }
+  std::thread worker([] {
+    Profiler::SetThreadName("Worker");
+    for (size_t i{}; i < 3; ++i) {
+      const ScopedZone zone{"worker \"zone\""};
+    }
+  });
+  worker.join();
+
+  const std::string trace{Profiler::FormatChromeTrace()};
+  REQUIRE(trace.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  REQUIRE(trace.ends_with("]}\n"));
+  REQUIRE(CountOccurrences(trace, "{\"name\":\"outer\",\"ph\":\"X\"") == 1);
+  REQUIRE(CountOccurrences(trace, "{\"name\":\"inner\",\"ph\":\"X\"") == 1);
+  REQUIRE(CountOccurrences(trace, "\"worker \\\"zone\\\"\"") == 3);
+  REQUIRE(CountOccurrences(trace, "\"args\":{\"name\":\"Worker\"}") == 1);
+  REQUIRE(Profiler::GetDroppedCount() == 0);
+
+  Profiler::Clear();
+  REQUIRE(CountOccurrences(Profiler::FormatChromeTrace(), "\"ph\":\"X\"") == 0);
+}
+
+TEST_CASE("Zones beyond thread capacity are dropped", "[profiler]") {
+  Profiler::Clear();
+  std::thread worker([] {
+    for (size_t i{}; i < Profiler::kThreadCapacity + 5; ++i) {
+      Profiler::Record("zone", 0, 1);
+    }
+  });
+  worker.join();
+
+  REQUIRE(Profiler::GetDroppedCount() == 5);
+  Profiler::Clear();
+  REQUIRE(Profiler::GetDroppedCount() == 0);
+}
+
+TEST_CASE("Zone macros compile out unless enabled", "[profiler]") {
+  Profiler::Clear();
+  {
+    CHIP8_ZONE("macro");
+  }
+  const std::string trace{Profiler::FormatChromeTrace()};
+#ifdef CHIP8_PROFILE
+  REQUIRE(CountOccurrences(trace, "\"macro\"") == 1);
+#else
+  REQUIRE(CountOccurrences(trace, "\"macro\"") == 0);
+#endif
+}
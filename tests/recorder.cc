@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/video/recorder.h>
+
+#include <test_utils.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using chip8::core::Cpu;
+using chip8::core::Framebuffer;
+using chip8::video::Container;
+using chip8::video::Recorder;
+using chip8::video::RecorderConfig;
+
+namespace {
+
+// Draws the font sprite of digit 0, then waits for a key forever.
+const std::vector<uint8_t> kDrawProgram{
+    0x60, 0x00,  // 0x200: LD V0, 0
+    0xF0, 0x29,  // 0x202: LD F, V0
+    0xD0, 0x05,  // 0x204: DRW V0, V0, 5
+    0xF1, 0x0A,  // 0x206: LD V1, K
+    0x12, 0x06,  // 0x208: JP 0x206
+};
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream in_stream(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in_stream),
+          std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+TEST_CASE("Frame callback runs after every frame", "[recorder]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kDrawProgram));
+
+  size_t calls{};
+  cpu.SetFrameCallback([&calls](const Cpu& frame) {
+    REQUIRE(frame.GetDelayTimer() == 0);
+    ++calls;
+  });
+  cpu.RunFrame(10);
+  cpu.RunFrame(10);
+  REQUIRE(calls == 2);
+
+  cpu.Reset();
+  cpu.RunFrame(10);
+  REQUIRE(calls == 2);
+}
+
+TEST_CASE("Recorder writes repeated frames as runs", "[recorder]") {
+  const std::filesystem::path directory{
+      std::filesystem::temp_directory_path()};
+  const std::filesystem::path video{directory / "chip8_test_recording.y4m"};
+  const std::filesystem::path log{directory / "chip8_test_recording.log"};
+
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kDrawProgram));
+
+  RecorderConfig config;
+  config.scale = 1;
+  config.hash_log = log;
+  std::unique_ptr<Recorder> recorder{Recorder::Open(video, config)};
+  REQUIRE(recorder);
+
+  // The first frame ends before DRW, the remaining ones show the digit.
+  cpu.SetFrameCallback(
+      [&recorder](const Cpu& frame) { recorder->AddFrame(frame); });
+  cpu.RunFrame(2);
+  for (size_t i{}; i < 99; ++i) {
+    cpu.RunFrame(10);
+  }
+  REQUIRE(recorder->GetStats().frames == 100);
+  REQUIRE(recorder->GetStats().runs == 2);
+  REQUIRE(recorder->Close());
+
+  const std::string header{"YUV4MPEG2 W64 H32 F60:1 Ip A1:1 Cmono\n"};
+  const std::string frame_header{"FRAME\n"};
+  const std::string content{ReadFile(video)};
+  REQUIRE(content.size() == header.size() + 100 * (frame_header.size() + 2048));
+  REQUIRE(content.compare(0, header.size(), header) == 0);
+
+  // The digit's top row is 0xF0: four lit pixels at the top left corner.
+  const size_t last_frame{content.size() - 2048};
+  REQUIRE(content.compare(last_frame - frame_header.size(),
+                          frame_header.size(), frame_header) == 0);
+  for (size_t x{}; x < 8; ++x) {
+    REQUIRE(static_cast<uint8_t>(content[last_frame + x]) ==
+            (x < 4 ? 0xFF : 0x00));
+  }
+
+  Framebuffer digit;
+  chip8::core::PackFramebuffer(cpu.GetPixels(), digit);
+  char expected[80];
+  std::snprintf(expected, sizeof(expected), "0 1 %016llx\n1 99 %016llx\n",
+                static_cast<unsigned long long>(Recorder::HashFrame({})),
+                static_cast<unsigned long long>(Recorder::HashFrame(digit)));
+  REQUIRE(ReadFile(log) == expected);
+
+  std::filesystem::remove(video);
+  std::filesystem::remove(log);
+}
+
+TEST_CASE("Raw recordings contain only scaled frames", "[recorder]") {
+  const std::filesystem::path video{std::filesystem::temp_directory_path() /
+                                    "chip8_test_recording.raw"};
+
+  RecorderConfig config;
+  config.container = Container::kRaw;
+  config.pixel_format = chip8::video::PixelFormat::kRgb24;
+  config.scale = 2;
+  std::unique_ptr<Recorder> recorder{Recorder::Open(video, config)};
+  REQUIRE(recorder);
+
+  Framebuffer framebuffer{};
+  for (size_t i{}; i < 300; ++i) {
+    framebuffer[0] = i / 100;
+    recorder->AddFrame(framebuffer);
+  }
+  REQUIRE(recorder->GetStats().runs == 3);
+  REQUIRE(recorder->Close());
+
+  const std::string content{ReadFile(video)};
+  const size_t frame_size{128 * 64 * 3};
+  REQUIRE(content.size() == 300 * frame_size);
+  REQUIRE(static_cast<uint8_t>(content[99 * frame_size]) == 0x00);
+  REQUIRE(static_cast<uint8_t>(content[100 * frame_size]) == 0xFF);
+  REQUIRE(static_cast<uint8_t>(content[100 * frame_size + 6]) == 0x00);
+  REQUIRE(static_cast<uint8_t>(content[200 * frame_size]) == 0x00);
+
+  std::filesystem::remove(video);
+}
+
+TEST_CASE("Y4M recordings reject colour pixel formats", "[recorder]") {
+  RecorderConfig config;
+  config.pixel_format = chip8::video::PixelFormat::kArgb8888;
+  REQUIRE_FALSE(Recorder::Open(std::filesystem::temp_directory_path() /
+                                   "chip8_test_recording.y4m",
+                               config));
+}
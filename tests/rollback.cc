@@ -0,0 +1,262 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/runtime/netplay.h>
+#include <chip8/runtime/rollback.h>
+
+#include <test_utils.h>
+
+#include <chrono>
+#include <deque>
+#include <thread>
+
+using chip8::core::Cpu;
+using chip8::runtime::Netplay;
+using chip8::runtime::NetplayConfig;
+using chip8::runtime::RollbackConfig;
+using chip8::runtime::RollbackSession;
+
+namespace {
+
+// Counts frames with key 1 (player one) and key C (player two) held, and
+// sums random numbers, so mispredictions show in registers and RNG state.
+// The core checks the key numbered by x in EXA1.
+const std::vector<uint8_t> kTwoPlayers{
+    0xE1, 0xA1,  // 0x200: SKNP 1
+    0x71, 0x01,  // 0x202: ADD V1, 1
+    0xEC, 0xA1,  // 0x204: SKNP C
+    0x72, 0x01,  // 0x206: ADD V2, 1
+    0xC3, 0xFF,  // 0x208: RND V3, 0xFF
+    0x84, 0x34,  // 0x20A: ADD V4, V3
+    0x12, 0x00,  // 0x20C: JP 0x200
+};
+
+constexpr uint16_t kPlayerOne{0x0FFF};
+constexpr uint16_t kPlayerTwo{0xF000};
+
+uint16_t PlayerOneKeys(uint64_t frame) {
+  return (frame / 3) % 2 == 0 ? 0x0002 : 0;
+}
+
+uint16_t PlayerTwoKeys(uint64_t frame) {
+  return (frame / 5) % 3 == 0 ? 0x1000 : 0;
+}
+
+void LoadSeeded(Cpu& cpu) {
+  cpu.SeedRNG(7);
+  REQUIRE(chip8::tests::LoadProgram(cpu, kTwoPlayers));
+}
+
+void RunReference(Cpu& cpu, uint64_t frames, size_t cycles_per_frame) {
+  for (uint64_t frame{}; frame < frames; ++frame) {
+    cpu.SetKeyMask(PlayerOneKeys(frame) | PlayerTwoKeys(frame));
+    cpu.RunFrame(cycles_per_frame);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Rollbacks converge to the run with known inputs", "[rollback]") {
+  constexpr uint64_t kFrames{120};
+  constexpr uint64_t kLatency{3};
+
+  Cpu reference;
+  LoadSeeded(reference);
+  RunReference(reference, kFrames, 10);
+
+  Cpu cpu_one;
+  LoadSeeded(cpu_one);
+  Cpu cpu_two;
+  LoadSeeded(cpu_two);
+  RollbackSession one(cpu_one, RollbackConfig{10, kPlayerOne, 8});
+  RollbackSession two(cpu_two, RollbackConfig{10, kPlayerTwo, 8});
+
+  // Inputs reach the other player kLatency frames after they were made.
+  struct Delivery {
+    uint64_t due;
+    uint64_t frame;
+    uint16_t keys;
+  };
+  std::deque<Delivery> to_one, to_two;
+  for (uint64_t frame{}; frame < kFrames; ++frame) {
+    while (!to_one.empty() && to_one.front().due <= frame) {
+      one.AddRemoteInput(to_one.front().frame, to_one.front().keys);
+      to_one.pop_front();
+    }
+    while (!to_two.empty() && to_two.front().due <= frame) {
+      two.AddRemoteInput(to_two.front().frame, to_two.front().keys);
+      to_two.pop_front();
+    }
+    REQUIRE(one.AdvanceFrame(PlayerOneKeys(frame)));
+    REQUIRE(two.AdvanceFrame(PlayerTwoKeys(frame)));
+    to_two.push_back(Delivery{frame + kLatency, frame, PlayerOneKeys(frame)});
+    to_one.push_back(Delivery{frame + kLatency, frame, PlayerTwoKeys(frame)});
+  }
+  for (const Delivery& delivery : to_one) {
+    one.AddRemoteInput(delivery.frame, delivery.keys);
+  }
+  for (const Delivery& delivery : to_two) {
+    two.AddRemoteInput(delivery.frame, delivery.keys);
+  }
+  one.Synchronize();
+  two.Synchronize();
+
+  REQUIRE(one.GetConfirmedFrame() == kFrames);
+  chip8::tests::RequireSameState(cpu_one, reference);
+  chip8::tests::RequireSameState(cpu_two, reference);
+
+  const chip8::runtime::RollbackStats& stats{one.GetStats()};
+  REQUIRE(stats.frames == kFrames);
+  REQUIRE(stats.rollbacks > 0);
+  REQUIRE(stats.max_depth <= kLatency);
+  REQUIRE(stats.resimulation_times.GetCount() == stats.rollbacks);
+  REQUIRE(stats.resimulation_times.GetMax() < std::chrono::milliseconds{16});
+}
+
+TEST_CASE("Rollback sessions stall at the end of the window",
+          "[rollback]") {
+  Cpu cpu;
+  LoadSeeded(cpu);
+  RollbackSession session(cpu, RollbackConfig{10, kPlayerOne, 4});
+
+  for (uint64_t frame{}; frame < 4; ++frame) {
+    REQUIRE(session.AdvanceFrame(0));
+  }
+  REQUIRE_FALSE(session.AdvanceFrame(0));
+  REQUIRE(session.GetStats().stalls == 1);
+  REQUIRE(session.GetFrame() == 4);
+
+  // Repeated and local keys change nothing.
+  session.AddRemoteInput(0, kPlayerOne);
+  session.AddRemoteInput(0, 0x1000);
+  REQUIRE(session.GetConfirmedFrame() == 1);
+  REQUIRE(session.AdvanceFrame(0));
+  REQUIRE(session.GetStats().rollbacks == 0);
+}
+
+TEST_CASE("Rollbacks only restore the state of the cpu", "[rollback]") {
+  Cpu cpu;
+  LoadSeeded(cpu);
+  RollbackSession session(cpu, RollbackConfig{10, kPlayerOne, 4});
+  REQUIRE(session.AdvanceFrame(0));
+  REQUIRE(session.AdvanceFrame(0));
+
+  // Set after the snapshots were taken, still used by re-simulated frames.
+  uint64_t callbacks{};
+  cpu.SetFrameCallback([&callbacks](const Cpu&) { ++callbacks; });
+  session.AddRemoteInput(0, 0x1000);
+  REQUIRE(session.AdvanceFrame(0));
+  REQUIRE(session.GetStats().rollbacks == 1);
+  REQUIRE(callbacks == 3);
+
+  Cpu reference;
+  LoadSeeded(reference);
+  // Frames after the confirmed one predict its input.
+  reference.SetKeyMask(0x1000);
+  for (int frame{}; frame < 3; ++frame) {
+    reference.RunFrame(10);
+  }
+  chip8::tests::RequireSameState(cpu, reference);
+}
+
+TEST_CASE("Netplay exchanges input over UDP", "[rollback]") {
+  constexpr uint64_t kFrames{60};
+
+  Cpu reference;
+  LoadSeeded(reference);
+  RunReference(reference, kFrames, 10);
+
+  Cpu cpu_host;
+  LoadSeeded(cpu_host);
+  NetplayConfig host_config;
+  host_config.rollback = RollbackConfig{10, kPlayerOne, 8};
+  const std::unique_ptr<Netplay> host{Netplay::Open(cpu_host, host_config)};
+  if (!host) {
+    WARN("UDP sockets are not available");
+    return;
+  }
+
+  Cpu cpu_guest;
+  LoadSeeded(cpu_guest);
+  NetplayConfig guest_config;
+  guest_config.remote_host = "127.0.0.1";
+  guest_config.remote_port = host->GetPort();
+  guest_config.rollback = RollbackConfig{10, kPlayerTwo, 8};
+  const std::unique_ptr<Netplay> guest{Netplay::Open(cpu_guest, guest_config)};
+  REQUIRE(guest);
+
+  const auto deadline{std::chrono::steady_clock::now() +
+                      std::chrono::seconds{10}};
+  while ((host->GetSession().GetFrame() < kFrames ||
+          guest->GetSession().GetFrame() < kFrames ||
+          host->GetSession().GetConfirmedFrame() < kFrames ||
+          guest->GetSession().GetConfirmedFrame() < kFrames) &&
+         std::chrono::steady_clock::now() < deadline) {
+    const uint64_t host_frame{host->GetSession().GetFrame()};
+    if (host_frame < kFrames) {
+      host->RunFrame(PlayerOneKeys(host_frame));
+    } else {
+      host->Poll();
+    }
+    const uint64_t guest_frame{guest->GetSession().GetFrame()};
+    if (guest_frame < kFrames) {
+      guest->RunFrame(PlayerTwoKeys(guest_frame));
+    } else {
+      guest->Poll();
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds{100});
+  }
+  host->Poll();
+  guest->Poll();
+
+  REQUIRE(host->IsConnected());
+  REQUIRE(guest->IsConnected());
+  REQUIRE(host->GetSession().GetConfirmedFrame() >= kFrames);
+  REQUIRE(guest->GetSession().GetConfirmedFrame() >= kFrames);
+  chip8::tests::RequireSameState(cpu_host, reference);
+  chip8::tests::RequireSameState(cpu_guest, reference);
+}
+
+TEST_CASE("Netplay rejects players with another ROM or speed",
+          "[rollback]") {
+  Cpu cpu_host;
+  LoadSeeded(cpu_host);
+  NetplayConfig host_config;
+  host_config.rom_hash = 0x1234;
+  host_config.rollback = RollbackConfig{10, kPlayerOne, 4};
+  const std::unique_ptr<Netplay> host{Netplay::Open(cpu_host, host_config)};
+  if (!host) {
+    WARN("UDP sockets are not available");
+    return;
+  }
+
+  const auto run_guest{[&host](uint64_t rom_hash, size_t cycles_per_frame) {
+    Cpu cpu_guest;
+    LoadSeeded(cpu_guest);
+    NetplayConfig guest_config;
+    guest_config.remote_host = "127.0.0.1";
+    guest_config.remote_port = host->GetPort();
+    guest_config.rom_hash = rom_hash;
+    guest_config.rollback = RollbackConfig{cycles_per_frame, kPlayerTwo, 4};
+    const std::unique_ptr<Netplay> guest{
+        Netplay::Open(cpu_guest, guest_config)};
+    REQUIRE(guest);
+
+    // Both sides run ahead until the window is full, then keep polling.
+    for (int i{}; i < 200; ++i) {
+      host->RunFrame(0);
+      guest->RunFrame(0);
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+    REQUIRE(guest->IsMismatched());
+    REQUIRE_FALSE(guest->IsConnected());
+    REQUIRE(guest->GetSession().GetConfirmedFrame() == 0);
+  }};
+
+  SECTION("Another ROM") { run_guest(0x5678, 10); }
+  SECTION("Another speed") { run_guest(0x1234, 11); }
+
+  REQUIRE(host->IsMismatched());
+  REQUIRE_FALSE(host->IsConnected());
+  REQUIRE(host->GetSession().GetConfirmedFrame() == 0);
+  REQUIRE(host->GetSession().GetStats().stalls > 0);
+}
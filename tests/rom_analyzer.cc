@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/analysis/disassembler.h>
+#include <chip8/analysis/rom_analyzer.h>
+
+#include <test_utils.h>
+
+using chip8::analysis::ByteKind;
+using chip8::analysis::CodeMap;
+using chip8::analysis::RomAnalyzer;
+
+namespace {
+
+const std::vector<uint8_t> kSpriteProgram{
+    0x60, 0x00,  // 0x200: LD V0, 0
+    0xA2, 0x10,  // 0x202: LD I, 0x210
+    0xD0, 0x03,  // 0x204: DRW V0, V0, 3
+    0x22, 0x0A,  // 0x206: CALL 0x20A
+    0x12, 0x08,  // 0x208: JP 0x208
+    0xA2, 0x13,  // 0x20A: LD I, 0x213
+    0xF1, 0x65,  // 0x20C: LD V1, [I]
+    0x00, 0xEE,  // 0x20E: RET
+    0xFF, 0x81, 0xFF,  // 0x210: sprite
+    0x12, 0x34,        // 0x213: data
+};
+
+}  // namespace
+
+TEST_CASE("Analyzer builds basic blocks and marks data", "[analysis]") {
+  const CodeMap map{RomAnalyzer(kSpriteProgram).Analyze()};
+
+  REQUIRE(map.blocks.size() == 3);
+  REQUIRE(map.blocks.at(0).start == 0x200);
+  REQUIRE(map.blocks.at(0).end == 0x208);
+  REQUIRE(map.blocks.at(0).successors == std::vector<uint16_t>{0x20A, 0x208});
+  REQUIRE(map.blocks.at(1).start == 0x208);
+  REQUIRE(map.blocks.at(2).start == 0x20A);
+  REQUIRE(map.blocks.at(2).successors.empty());
+
+  REQUIRE(map.instructions[0x20E]);
+  REQUIRE_FALSE(map.instructions[0x210]);
+  REQUIRE(map.kinds.at(0x20F) == ByteKind::kCode);
+  REQUIRE(map.kinds.at(0x210) == ByteKind::kSprite);
+  REQUIRE(map.kinds.at(0x212) == ByteKind::kSprite);
+  REQUIRE(map.kinds.at(0x213) == ByteKind::kData);
+  REQUIRE(map.kinds.at(0x214) == ByteKind::kData);
+  REQUIRE(map.kinds.at(0x215) == ByteKind::kUnknown);
+  REQUIRE(map.self_modifying.empty());
+}
+
+TEST_CASE("Analyzer resolves BNNN with a constant V0", "[analysis]") {
+  const CodeMap map{RomAnalyzer(std::vector<uint8_t>{
+                                    0x60, 0x04,  // 0x200: LD V0, 4
+                                    0xB2, 0x04,  // 0x202: JP V0, 0x204
+                                    0x00, 0x00,  // 0x204
+                                    0x12, 0x06,  // 0x206: JP 0x206
+                                    0x12, 0x08,  // 0x208: JP 0x208
+                                })
+                        .Analyze()};
+
+  REQUIRE(map.blocks.size() == 2);
+  REQUIRE_FALSE(map.blocks.at(0).computed_jump);
+  REQUIRE(map.blocks.at(0).successors == std::vector<uint16_t>{0x208});
+  REQUIRE_FALSE(map.instructions[0x204]);
+  REQUIRE(map.instructions[0x208]);
+}
+
+TEST_CASE("Analyzer flags self-modifying writes", "[analysis]") {
+  const CodeMap map{RomAnalyzer(std::vector<uint8_t>{
+                                    0xA2, 0x04,  // 0x200: LD I, 0x204
+                                    0xF1, 0x55,  // 0x202: LD [I], V1
+                                    0xB3, 0x00,  // 0x204: JP V0, 0x300
+                                })
+                        .Analyze()};
+
+  REQUIRE(map.blocks.size() == 1);
+  REQUIRE(map.blocks.at(0).computed_jump);
+  REQUIRE(map.self_modifying.size() == 1);
+  REQUIRE(map.self_modifying.at(0).instruction == 0x202);
+  REQUIRE(map.self_modifying.at(0).address == 0x204);
+  REQUIRE(map.self_modifying.at(0).size == 2);
+}
+
+TEST_CASE("Code map survives saving and loading", "[analysis]") {
+  const CodeMap map{RomAnalyzer(kSpriteProgram).Analyze()};
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "chip8_test_code_map.txt"};
+
+  REQUIRE(RomAnalyzer::Save(map, path));
+  const std::optional<CodeMap> loaded{RomAnalyzer::Load(path)};
+
+  REQUIRE(loaded);
+  REQUIRE(loaded->kinds == map.kinds);
+  REQUIRE(loaded->instructions == map.instructions);
+  REQUIRE(loaded->blocks.size() == map.blocks.size());
+  for (size_t i{}; i < map.blocks.size(); ++i) {
+    REQUIRE(loaded->blocks.at(i).start == map.blocks.at(i).start);
+    REQUIRE(loaded->blocks.at(i).end == map.blocks.at(i).end);
+    REQUIRE(loaded->blocks.at(i).successors == map.blocks.at(i).successors);
+  }
+}
+
+TEST_CASE("Prewarmed cpu runs like a cold one", "[analysis][cpu]") {
+  chip8::core::Cpu cold;
+  chip8::core::Cpu warm;
+  REQUIRE(chip8::tests::LoadProgram(cold, kSpriteProgram));
+  REQUIRE(chip8::tests::LoadProgram(warm, kSpriteProgram));
+  warm.PrewarmDecodeCache(RomAnalyzer(kSpriteProgram).Analyze());
+
+  for (size_t frame{}; frame < 5; ++frame) {
+    cold.RunFrame(7);
+    warm.RunFrame(7);
+    chip8::tests::RequireSameState(cold, warm);
+  }
+}
+
+TEST_CASE("Disassembler produces mnemonics", "[analysis]") {
+  REQUIRE(chip8::analysis::Disassemble(0x00E0) == "CLS");
+  REQUIRE(chip8::analysis::Disassemble(0x1234) == "JP 0x234");
+  REQUIRE(chip8::analysis::Disassemble(0xD125) == "DRW V1, V2, 5");
+  REQUIRE(chip8::analysis::Disassemble(0xF365) == "LD V3, [I]");
+  REQUIRE(chip8::analysis::Disassemble(0x5121) == "DW 0x5121");
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/core/rom_image.h>
+#include <chip8/library/rom_library.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using chip8::library::Platform;
+using chip8::library::RomLibrary;
+using chip8::library::RomProfile;
+
+namespace {
+
+const std::vector<uint8_t> kChip8Rom{
+    0x00, 0xE0,  // 0x200: CLS
+    0x12, 0x00,  // 0x202: JP 0x200
+};
+
+const std::vector<uint8_t> kSuperChipRom{
+    0x00, 0xFF,  // 0x200: HIGH
+    0xD0, 0x10,  // 0x202: DRW V0, V1, 0
+    0x12, 0x02,  // 0x204: JP 0x202
+};
+
+const std::vector<uint8_t> kXoChipRom{
+    0x00, 0xFF,  // 0x200: HIGH
+    0x50, 0x32,  // 0x202: SAVE V0 - V3
+    0x12, 0x02,  // 0x204: JP 0x202
+};
+
+/// <summary>
+/// Temporary directory removed at the end of a test.
+/// </summary>
+class TemporaryDirectory {
+ public:
+  TemporaryDirectory()
+      : path_(std::filesystem::temp_directory_path() /
+              ("chip8_library_" + std::to_string(std::random_device{}()))) {
+    std::filesystem::create_directories(path_);
+  }
+
+  ~TemporaryDirectory() {
+    std::error_code error;
+    std::filesystem::remove_all(path_, error);
+  }
+
+  const std::filesystem::path& Get() const { return path_; }
+
+ private:
+  std::filesystem::path path_;
+};
+
+void WriteFile(const std::filesystem::path& path,
+               const std::vector<uint8_t>& bytes) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream out_stream(path, std::ios::binary);
+  out_stream.write(reinterpret_cast<const char*>(bytes.data()),
+                   static_cast<std::streamsize>(bytes.size()));
+}
+
+uint64_t Hash(const std::vector<uint8_t>& bytes) {
+  return chip8::core::RomImage::FromBytes(bytes)->GetHash();
+}
+
+}  // namespace
+
+TEST_CASE("Platforms are detected from reachable instructions",
+          "[rom_library]") {
+  REQUIRE(chip8::library::DetectPlatform(kChip8Rom) == Platform::kChip8);
+  REQUIRE(chip8::library::DetectPlatform(kSuperChipRom) ==
+          Platform::kSuperChip);
+  REQUIRE(chip8::library::DetectPlatform(kXoChipRom) == Platform::kXoChip);
+
+  // Unreachable bytes are data, whatever they look like.
+  std::vector<uint8_t> data{kChip8Rom};
+  data.insert(data.end(), {0x00, 0xFF, 0x50, 0x32});
+  REQUIRE(chip8::library::DetectPlatform(data) == Platform::kChip8);
+
+  // Only XO-CHIP has room for ROMs over 3.5 KiB.
+  std::vector<uint8_t> large(4000);
+  std::copy(kChip8Rom.begin(), kChip8Rom.end(), large.begin());
+  REQUIRE(chip8::library::DetectPlatform(large) == Platform::kXoChip);
+}
+
+TEST_CASE("ROM library scans, saves and looks up ROMs", "[rom_library]") {
+  const TemporaryDirectory directory;
+  const std::filesystem::path roms{directory.Get() / "roms"};
+  WriteFile(roms / "Pong.ch8", kChip8Rom);
+  WriteFile(roms / "schip" / "Car.SC8", kSuperChipRom);
+  WriteFile(roms / "xo" / "Sokoban.xo8", kXoChipRom);
+  WriteFile(roms / "copy" / "Pong (copy).ch8", kChip8Rom);
+  WriteFile(roms / "empty.ch8", {});
+  WriteFile(roms / "readme.txt", kChip8Rom);
+
+  RomLibrary library;
+  const chip8::library::ScanStats stats{library.Scan(roms, 2)};
+  REQUIRE(stats.files == 5);
+  REQUIRE(stats.added == 3);
+  REQUIRE(stats.duplicates == 1);
+  REQUIRE(stats.failed == 1);
+  REQUIRE(library.GetProfiles().size() == 3);
+
+  const RomProfile* pong{library.Find(Hash(kChip8Rom))};
+  REQUIRE(pong != nullptr);
+  REQUIRE(pong->title == "Pong");
+  REQUIRE(pong->size == kChip8Rom.size());
+  REQUIRE(pong->platform == Platform::kChip8);
+  REQUIRE(pong->quirks == 0);
+  REQUIRE(pong->cycles_per_frame == 10);
+  REQUIRE(pong->path == std::filesystem::absolute(roms / "Pong.ch8"));
+  REQUIRE(library.Find(Hash(kSuperChipRom))->platform == Platform::kSuperChip);
+  REQUIRE(library.Find(Hash(kXoChipRom))->cycles_per_frame == 1000);
+
+  // Tuned values survive saving and scanning again.
+  RomProfile tuned{*pong};
+  tuned.cycles_per_frame = 25;
+  tuned.title = "Pong (1 player)";
+  library.Add(tuned);
+  const std::filesystem::path index{directory.Get() / "library.c8l"};
+  REQUIRE(library.Save(index));
+
+  std::optional<RomLibrary> loaded{RomLibrary::Load(index)};
+  REQUIRE(loaded);
+  REQUIRE(loaded->Scan(roms).added == 0);
+  REQUIRE(loaded->GetProfiles().size() == 3);
+  for (const RomProfile& profile : library.GetProfiles()) {
+    const RomProfile* copy{loaded->Find(profile.hash)};
+    REQUIRE(copy != nullptr);
+    REQUIRE(copy->title == profile.title);
+    REQUIRE(copy->platform == profile.platform);
+    REQUIRE(copy->quirks == profile.quirks);
+    REQUIRE(copy->cycles_per_frame == profile.cycles_per_frame);
+    REQUIRE(copy->path == profile.path);
+
+    const std::optional<RomProfile> found{
+        RomLibrary::Lookup(index, profile.hash)};
+    REQUIRE(found);
+    REQUIRE(found->title == profile.title);
+    REQUIRE(found->cycles_per_frame == profile.cycles_per_frame);
+  }
+  REQUIRE(RomLibrary::Lookup(index, Hash(kChip8Rom))->cycles_per_frame == 25);
+  REQUIRE_FALSE(RomLibrary::Lookup(index, 42));
+}
+
+TEST_CASE("ROM library rejects malformed indices", "[rom_library]") {
+  const TemporaryDirectory directory;
+  const std::filesystem::path index{directory.Get() / "library.c8l"};
+  REQUIRE_FALSE(RomLibrary::Lookup(index, 0));
+
+  WriteFile(index, {'C', '8', 'L', 1, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+  REQUIRE_FALSE(RomLibrary::Load(index));
+  REQUIRE_FALSE(RomLibrary::Lookup(index, 0));
+
+  REQUIRE(RomLibrary{}.Save(index));
+  const std::optional<RomLibrary> empty{RomLibrary::Load(index)};
+  REQUIRE(empty);
+  REQUIRE(empty->GetProfiles().empty());
+  REQUIRE_FALSE(RomLibrary::Lookup(index, 0));
+}
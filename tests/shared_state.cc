@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/core/framebuffer.h>
+#include <chip8/runtime/shared_state.h>
+
+#include <test_utils.h>
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+
+using chip8::core::Cpu;
+using chip8::runtime::SharedFrame;
+using chip8::runtime::SharedStateReader;
+using chip8::runtime::SharedStateWriter;
+
+namespace {
+
+std::string UniqueName() {
+  return "/chip8-test-" + std::to_string(std::random_device{}());
+}
+
+/// <summary>
+/// Frame whose every field is derived from its number, so a torn copy shows.
+/// </summary>
+SharedFrame MakeFrame(uint64_t number) {
+  SharedFrame frame{};
+  frame.number = number;
+  for (uint64_t& row : frame.pixels) {
+    row = number * 0x9E3779B97F4A7C15ull;
+  }
+  for (uint8_t& byte : frame.memory) {
+    byte = static_cast<uint8_t>(number);
+  }
+  frame.program_counter = static_cast<uint16_t>(number);
+  frame.registers[15] = static_cast<uint8_t>(number);
+  return frame;
+}
+
+bool IsConsistent(const SharedFrame& frame) {
+  const SharedFrame expected{MakeFrame(frame.number)};
+  for (size_t i{}; i < 32; ++i) {
+    if (frame.pixels[i] != expected.pixels[i]) {
+      return false;
+    }
+  }
+  for (size_t i{}; i < sizeof(frame.memory); ++i) {
+    if (frame.memory[i] != expected.memory[i]) {
+      return false;
+    }
+  }
+  return frame.program_counter == expected.program_counter &&
+         frame.registers[15] == expected.registers[15];
+}
+
+}  // namespace
+
+TEST_CASE("Shared memory exports the cpu state", "[shared_state]") {
+  const std::string name{UniqueName()};
+  REQUIRE_FALSE(SharedStateReader::Open(name));
+
+  std::unique_ptr<SharedStateWriter> writer{SharedStateWriter::Create(name)};
+  if (!writer) {
+    WARN("Shared memory is not available");
+    return;
+  }
+  const std::unique_ptr<SharedStateReader> reader{
+      SharedStateReader::Open(name)};
+  REQUIRE(reader);
+  REQUIRE(reader->GetSequence() == 0);
+  REQUIRE_FALSE(reader->Read());
+
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, {
+                                             0x60, 0x2A,  // LD V0, 0x2A
+                                             0xA0, 0x50,  // LD I, 0x050
+                                             0xD0, 0x05,  // DRW V0, V0, 5
+                                             0x12, 0x06,  // JP 0x206
+                                         }));
+  cpu.SetFrameCallback([&writer](const Cpu& frame) { writer->Publish(frame); });
+  cpu.SetKeyMask(0x0010);
+  cpu.RunFrame(10);
+  cpu.RunFrame(10);
+  REQUIRE(writer->GetPublishedCount() == 2);
+  REQUIRE(reader->GetSequence() == 4);
+
+  const std::optional<SharedFrame> frame{reader->Read()};
+  REQUIRE(frame);
+  REQUIRE(frame->number == 2);
+  REQUIRE(frame->program_counter == cpu.GetProgramCounter());
+  REQUIRE(frame->index_register == 0x050);
+  REQUIRE(frame->registers[0] == 0x2A);
+  REQUIRE(frame->keys == 0x0010);
+  REQUIRE(frame->halted == 0);
+  REQUIRE(frame->memory[0x200] == 0x60);
+  chip8::core::Framebuffer pixels;
+  chip8::core::PackFramebuffer(cpu.GetPixels(), pixels);
+  for (size_t y{}; y < pixels.size(); ++y) {
+    REQUIRE(frame->pixels[y] == pixels[y]);
+  }
+  REQUIRE(frame->pixels[0x2A - 32] != 0);
+
+  cpu.SetFrameCallback(nullptr);
+  REQUIRE_FALSE(reader->IsClosed());
+  writer.reset();
+  REQUIRE(reader->IsClosed());
+  REQUIRE(reader->Read()->number == 2);
+  REQUIRE_FALSE(SharedStateReader::Open(name));
+}
+
+TEST_CASE("Shared memory readers never see torn frames", "[shared_state]") {
+  constexpr uint64_t kFrames{20000};
+  const std::string name{UniqueName()};
+  const std::unique_ptr<SharedStateWriter> writer{
+      SharedStateWriter::Create(name)};
+  if (!writer) {
+    WARN("Shared memory is not available");
+    return;
+  }
+  const std::unique_ptr<SharedStateReader> reader{
+      SharedStateReader::Open(name)};
+  REQUIRE(reader);
+
+  std::atomic<bool> done{false};
+  std::thread publisher([&] {
+    for (uint64_t number{1}; number <= kFrames; ++number) {
+      writer->Publish(MakeFrame(number));
+    }
+    done = true;
+  });
+
+  uint64_t reads{};
+  uint64_t torn{};
+  uint64_t last{};
+  bool ordered{true};
+  while (!done || last < kFrames) {
+    const std::optional<SharedFrame> frame{reader->Read()};
+    if (!frame) {
+      continue;
+    }
+    ++reads;
+    torn += IsConsistent(*frame) ? 0 : 1;
+    ordered = ordered && frame->number >= last;
+    last = frame->number;
+  }
+  publisher.join();
+
+  REQUIRE(reads > 0);
+  REQUIRE(torn == 0);
+  REQUIRE(ordered);
+  REQUIRE(last == kFrames);
+  REQUIRE(reader->GetSequence() == 2 * kFrames);
+}
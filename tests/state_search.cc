@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/search/state_search.h>
+
+#include <test_utils.h>
+
+using chip8::core::Cpu;
+using chip8::search::HashState;
+using chip8::search::Search;
+using chip8::search::SearchConfig;
+using chip8::search::SearchResult;
+using chip8::search::Strategy;
+
+namespace {
+
+// Reaches V2 = 1 only if key 5 is pressed and then key 9. The core checks
+// the key numbered by x in EX9E and EXA1.
+const std::vector<uint8_t> kCombination{
+    0x60, 0x05,  // 0x200: LD V0, 5
+    0xE5, 0x9E,  // 0x202: SKP 5
+    0x12, 0x02,  // 0x204: JP 0x202
+    0xE9, 0x9E,  // 0x206: SKP 9
+    0x12, 0x06,  // 0x208: JP 0x206
+    0x62, 0x01,  // 0x20A: LD V2, 1
+    0x12, 0x0C,  // 0x20C: JP 0x20C
+};
+
+// Counts in 0x301 while key 5 is held.
+const std::vector<uint8_t> kCounter{
+    0x60, 0x05,  // 0x200: LD V0, 5
+    0xE5, 0xA1,  // 0x202: SKNP 5
+    0x71, 0x01,  // 0x204: ADD V1, 1
+    0xA3, 0x00,  // 0x206: LD I, 0x300
+    0xF1, 0x55,  // 0x208: LD [I], V1
+    0x12, 0x02,  // 0x20A: JP 0x202
+};
+
+}  // namespace
+
+TEST_CASE("State hash ignores held keys", "[search]") {
+  Cpu cpu;
+  REQUIRE(chip8::tests::LoadProgram(cpu, kCounter));
+  const uint64_t hash{HashState(cpu)};
+  cpu.SetKeyMask(0xFFFF);
+  REQUIRE(HashState(cpu) == hash);
+  cpu.RunFrame(1);
+  REQUIRE(HashState(cpu) != hash);
+}
+
+TEST_CASE("Breadth first search finds a key combination", "[search]") {
+  Cpu start;
+  REQUIRE(chip8::tests::LoadProgram(start, kCombination));
+
+  SearchConfig config;
+  config.strategy = Strategy::kBreadthFirst;
+  config.max_depth = 4;
+  config.goal = [](const Cpu& cpu) { return cpu.GetRegisters()[2] == 1; };
+
+  config.threads = 1;
+  const SearchResult serial{Search(start, config)};
+  REQUIRE(serial.found);
+  REQUIRE(serial.inputs == std::vector<uint16_t>{1u << 5, 1u << 9});
+  REQUIRE(serial.depth == 2);
+  // Every key but 5 leaves the first wait loop in the same state.
+  REQUIRE(serial.duplicates >= 15);
+
+  config.threads = 4;
+  const SearchResult parallel{Search(start, config)};
+  REQUIRE(parallel.found);
+  REQUIRE(parallel.inputs == serial.inputs);
+  REQUIRE(parallel.states_explored == serial.states_explored);
+  REQUIRE(parallel.duplicates == serial.duplicates);
+}
+
+TEST_CASE("Beam search follows the score", "[search]") {
+  Cpu start;
+  REQUIRE(chip8::tests::LoadProgram(start, kCounter));
+
+  SearchConfig config;
+  config.strategy = Strategy::kBeam;
+  config.max_depth = 3;
+  config.frontier_size = 4;
+  config.score = chip8::search::ScoreMemory({{0x301, 1.0}});
+  const SearchResult result{Search(start, config)};
+
+  REQUIRE_FALSE(result.found);
+  REQUIRE(result.depth == 3);
+  REQUIRE(result.inputs == std::vector<uint16_t>(3, 1u << 5));
+  REQUIRE(result.best_score > 0);
+  REQUIRE(result.states_explored > 0);
+  REQUIRE(result.states_per_second > 0);
+}
+
+TEST_CASE("Novelty search keeps states reaching new cells", "[search]") {
+  Cpu start;
+  REQUIRE(chip8::tests::LoadProgram(start, kCounter));
+
+  SearchConfig config;
+  config.strategy = Strategy::kNovelty;
+  config.max_depth = 3;
+  config.frontier_size = 1;
+  config.novelty_addresses = {0x301};
+  config.score = chip8::search::ScoreMemory({{0x301, 1.0}});
+  const SearchResult result{Search(start, config)};
+
+  // Only holding key 5 changes the counter, so the state kept at every
+  // depth is the one reaching a new cell.
+  REQUIRE(result.states_explored == 3 * 17);
+  REQUIRE(result.cells == 4);
+  REQUIRE(result.inputs == std::vector<uint16_t>(3, 1u << 5));
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/video/terminal_renderer.h>
+
+#include <string>
+
+using chip8::core::Framebuffer;
+using chip8::video::TerminalCells;
+using chip8::video::TerminalRenderer;
+
+namespace {
+
+const std::string kClear{"\x1b[2J"};
+const std::string kUpperHalf{"\xE2\x96\x80"};
+const std::string kLowerHalf{"\xE2\x96\x84"};
+const std::string kFullBlock{"\xE2\x96\x88"};
+
+void SetPixel(Framebuffer& frame, size_t x, size_t y) {
+  frame[y] |= uint64_t{1} << x;
+}
+
+std::string Render(TerminalRenderer& renderer, const Framebuffer& frame) {
+  std::string out;
+  renderer.Render(frame, out);
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("Terminal renderer clears the screen once", "[terminal]") {
+  TerminalRenderer renderer;
+  REQUIRE(renderer.GetRows() == 16);
+  REQUIRE(renderer.GetColumns() == 64);
+
+  Framebuffer frame{};
+  REQUIRE(Render(renderer, frame) == kClear);
+  REQUIRE(Render(renderer, frame).empty());
+
+  SetPixel(frame, 0, 0);
+  SetPixel(frame, 0, 1);
+  REQUIRE(Render(renderer, frame) == "\x1b[1;1H" + kFullBlock);
+  REQUIRE(Render(renderer, frame).empty());
+
+  // Everything lit is drawn again after the terminal was lost.
+  renderer.Invalidate();
+  REQUIRE(Render(renderer, frame) == kClear + "\x1b[1;1H" + kFullBlock);
+}
+
+TEST_CASE("Terminal renderer writes only changed cells", "[terminal]") {
+  TerminalRenderer renderer;
+  Framebuffer frame{};
+  Render(renderer, frame);
+
+  SetPixel(frame, 5, 2);
+  REQUIRE(Render(renderer, frame) == "\x1b[2;6H" + kUpperHalf);
+
+  // The blank cell in between is cheaper to write again than to skip.
+  SetPixel(frame, 5, 3);
+  SetPixel(frame, 7, 3);
+  REQUIRE(Render(renderer, frame) ==
+          "\x1b[2;6H" + kFullBlock + " " + kLowerHalf);
+
+  // Far cells on a row are reached by a relative move, the next row by a
+  // line feed.
+  SetPixel(frame, 20, 2);
+  SetPixel(frame, 0, 5);
+  REQUIRE(Render(renderer, frame) ==
+          "\x1b[12C" + kUpperHalf + "\r\n" + kLowerHalf);
+
+  frame = Framebuffer{};
+  REQUIRE(Render(renderer, frame) == "\x1b[2;6H   \x1b[12C \r\n ");
+}
+
+TEST_CASE("Terminal renderer forgets the cursor after the last column",
+          "[terminal]") {
+  TerminalRenderer renderer;
+  Framebuffer frame{};
+  Render(renderer, frame);
+
+  SetPixel(frame, 63, 0);
+  SetPixel(frame, 0, 2);
+  REQUIRE(Render(renderer, frame) ==
+          "\x1b[1;64H" + kUpperHalf + "\x1b[2;1H" + kUpperHalf);
+}
+
+TEST_CASE("Terminal renderer draws braille patterns", "[terminal]") {
+  TerminalRenderer renderer(TerminalCells::kBraille, 3, 2);
+  REQUIRE(renderer.GetRows() == 8);
+  REQUIRE(renderer.GetColumns() == 32);
+
+  Framebuffer frame{};
+  SetPixel(frame, 0, 0);
+  // Dots 1 and 8 of the second cell of the second row.
+  SetPixel(frame, 2, 4);
+  SetPixel(frame, 3, 7);
+  REQUIRE(Render(renderer, frame) == kClear + "\x1b[3;2H\xE2\xA0\x81" +
+                                         "\x1b[4;3H\xE2\xA2\x81");
+}
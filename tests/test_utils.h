@@ -0,0 +1,47 @@
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/core/cpu.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+/// <summary>
+/// Helpers shared by unit tests.
+/// </summary>
+namespace chip8::tests {
+
+/// <summary>
+/// Writes given program to a temporary file and loads it into cpu memory.
+/// </summary>
+inline bool LoadProgram(core::Cpu& cpu, const std::vector<uint8_t>& program) {
+  const std::filesystem::path path{std::filesystem::temp_directory_path() /
+                                   "chip8_test_program.ch8"};
+  {
+    std::ofstream out_stream(path, std::ios::binary | std::ios::trunc);
+    out_stream.write(reinterpret_cast<const char*>(program.data()),
+                     static_cast<std::streamsize>(program.size()));
+  }
+  return cpu.LoadROM(path);
+}
+
+/// <summary>
+/// Checks that every observable part of two cpus is equal.
+/// </summary>
+inline void RequireSameState(const core::Cpu& lhs, const core::Cpu& rhs) {
+  REQUIRE(lhs.GetProgramCounter() == rhs.GetProgramCounter());
+  REQUIRE(lhs.GetIndexRegister() == rhs.GetIndexRegister());
+  REQUIRE(lhs.GetOpcode() == rhs.GetOpcode());
+  REQUIRE(lhs.GetRegisters() == rhs.GetRegisters());
+  REQUIRE(lhs.GetStack() == rhs.GetStack());
+  REQUIRE(lhs.GetStackPointer() == rhs.GetStackPointer());
+  REQUIRE(lhs.GetDelayTimer() == rhs.GetDelayTimer());
+  REQUIRE(lhs.GetSoundTimer() == rhs.GetSoundTimer());
+  REQUIRE(lhs.GetMemory() == rhs.GetMemory());
+  REQUIRE(lhs.GetPixels() == rhs.GetPixels());
+}
+
+}  // namespace chip8::tests
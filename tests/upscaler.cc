@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chip8/video/upscaler.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+using chip8::core::Framebuffer;
+using chip8::video::Kernel;
+using chip8::video::PixelFormat;
+using chip8::video::Upscaler;
+
+namespace {
+
+/// <summary>
+/// Renders like Screen::UpdateDisplay(): white kPixelSize squares on black.
+/// </summary>
+std::vector<uint8_t> RenderReference(const Framebuffer& framebuffer,
+                                     PixelFormat format, size_t scale) {
+  const size_t bytes_per_pixel{chip8::video::GetBytesPerPixel(format)};
+  const size_t width{64 * scale};
+  std::vector<uint8_t> image(width * 32 * scale * bytes_per_pixel);
+  for (size_t y{}; y < 32 * scale; ++y) {
+    for (size_t x{}; x < width; ++x) {
+      const bool lit{((framebuffer[y / scale] >> (x / scale)) & 1u) != 0};
+      uint8_t* pixel{image.data() + (y * width + x) * bytes_per_pixel};
+      if (format == PixelFormat::kArgb8888) {
+        const uint32_t argb{lit ? 0xFFFFFFFFu : 0xFF000000u};
+        std::memcpy(pixel, &argb, sizeof(argb));
+      } else {
+        std::fill_n(pixel, bytes_per_pixel, lit ? 0xFF : 0x00);
+      }
+    }
+  }
+  return image;
+}
+
+Framebuffer MakeRandomFramebuffer(unsigned int seed) {
+  std::mt19937_64 gen(seed);
+  Framebuffer framebuffer{};
+  for (uint64_t& row : framebuffer) {
+    row = gen();
+  }
+  return framebuffer;
+}
+
+}  // namespace
+
+TEST_CASE("Upscaler output matches the SDL renderer", "[upscaler]") {
+  const Framebuffer framebuffer{MakeRandomFramebuffer(3)};
+
+  for (PixelFormat format :
+       {PixelFormat::kArgb8888, PixelFormat::kRgb24, PixelFormat::kY8}) {
+    const std::vector<uint8_t> expected{
+        RenderReference(framebuffer, format, chip8::core::kPixelSize)};
+
+    for (Kernel kernel : {Kernel::kScalar, Kernel::kSse2, Kernel::kAvx2}) {
+      Upscaler upscaler(format);
+      if (!upscaler.SetKernel(kernel)) {
+        continue;
+      }
+      REQUIRE(upscaler.GetWidth() == chip8::core::kScreenWidth);
+      REQUIRE(upscaler.GetHeight() == chip8::core::kScreenHeight);
+
+      std::vector<uint8_t> image(upscaler.GetFrameSize());
+      REQUIRE(upscaler.Scale(framebuffer, image));
+      REQUIRE(image == expected);
+    }
+  }
+}
+
+TEST_CASE("Upscaler falls back to scalar for odd spans", "[upscaler]") {
+  const Framebuffer framebuffer{MakeRandomFramebuffer(9)};
+  Upscaler upscaler(PixelFormat::kRgb24, 5);
+
+  REQUIRE(upscaler.GetKernel() == Kernel::kScalar);
+  REQUIRE_FALSE(upscaler.SetKernel(Kernel::kSse2));
+
+  std::vector<uint8_t> image(upscaler.GetFrameSize());
+  REQUIRE(upscaler.Scale(framebuffer, image));
+  REQUIRE(image == RenderReference(framebuffer, PixelFormat::kRgb24, 5));
+
+  std::vector<uint8_t> too_small(upscaler.GetFrameSize() - 1);
+  REQUIRE_FALSE(upscaler.Scale(framebuffer, too_small));
+}
+
+TEST_CASE("Upscaler kernels agree on custom palettes", "[upscaler]") {
+  const Framebuffer framebuffer{MakeRandomFramebuffer(5)};
+  const chip8::video::Palette palette{0xFF336699u, 0xFFCC1122u};
+
+  for (PixelFormat format :
+       {PixelFormat::kArgb8888, PixelFormat::kRgb24, PixelFormat::kY8}) {
+    Upscaler upscaler(format, chip8::core::kPixelSize, palette);
+    REQUIRE(upscaler.SetKernel(Kernel::kScalar));
+    std::vector<uint8_t> expected(upscaler.GetFrameSize());
+    REQUIRE(upscaler.Scale(framebuffer, expected));
+
+    for (Kernel kernel : {Kernel::kSse2, Kernel::kAvx2}) {
+      if (!upscaler.SetKernel(kernel)) {
+        continue;
+      }
+      std::vector<uint8_t> image(upscaler.GetFrameSize());
+      REQUIRE(upscaler.Scale(framebuffer, image));
+      REQUIRE(image == expected);
+    }
+  }
+}